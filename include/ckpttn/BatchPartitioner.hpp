@@ -0,0 +1,81 @@
+/**
+ * @file BatchPartitioner.hpp
+ * @brief Partitioning of many small netlists at once
+ */
+
+#pragma once
+
+#include <ckpttn/FMGainScratch.hpp>  // for FMGainScratch
+#include <cstddef>                   // for size_t
+#include <cstdint>                   // for uint8_t, uint32_t
+#include <netlistx/netlist.hpp>      // for SimpleNetlist
+#include <span>                      // for span
+#include <vector>                    // for vector
+
+/**
+ * @brief Options of a batch (shared by all netlists)
+ */
+struct BatchOptions {
+    /// @brief Number of partitions
+    std::uint8_t num_parts{2};
+    /// @brief Balance tolerance
+    double bal_tol{0.05};
+    /// @brief Seed of the initial partitions (netlist `i` uses `seed + i`)
+    std::uint32_t seed{1U};
+    /// @brief Number of extra V-cycles (see `MLPartMgr::set_num_vcycles`)
+    size_t num_vcycles{0U};
+};
+
+/**
+ * @brief Buffers of the workers of `partition_batch`
+ *
+ * Each worker reuses its gain buckets, vertex links and gain buffers for
+ * all the levels of all its netlists, so that they are sized once, to the
+ * largest netlist the worker has seen. Keep a `BatchScratch` from one batch
+ * to the next to skip these allocations in later batches too.
+ */
+struct BatchScratch {
+    /// @brief The buffers of each worker
+    std::vector<FMGainScratch<SimpleNetlist::node_t>> workers;
+};
+
+/**
+ * @brief Partitions a batch of independent netlists.
+ *
+ * Meant for thousands of small sub-blocks (hundreds to a few thousand
+ * modules), where one `MLPartMgr` run is too short to be worth splitting
+ * into parallel tasks. Instead, the netlists are spread over the threads of
+ * `TaskScheduler::current()`: every worker takes the next netlist, largest
+ * first, and runs it serially on a private one-thread scheduler with its own
+ * `MLPartMgr` and gain buffers (see `BatchScratch`), which are kept from one
+ * netlist to the next.
+ *
+ * The initial partition of netlist `i` only depends on `options.seed + i`,
+ * so the results do not depend on the number of threads.
+ *
+ * @param[in] netlists The netlists
+ * @param[out] parts The partitions, one per netlist (resized)
+ * @param[in] options The options
+ * @return The cost of each partition
+ * @throw std::invalid_argument if the spans differ in size or `num_parts < 2`
+ */
+auto partition_batch(std::span<const SimpleNetlist> netlists,
+                     std::span<std::vector<std::uint8_t>> parts, const BatchOptions& options)
+    -> std::vector<int>;
+
+/**
+ * @brief Partitions a batch of independent netlists with the given buffers.
+ *
+ * Same as above, but the workers use (and keep) the buffers of `scratch`,
+ * one per worker. The scratch must not be used by two batches at once.
+ *
+ * @param[in] netlists The netlists
+ * @param[out] parts The partitions, one per netlist (resized)
+ * @param[in] options The options
+ * @param[in,out] scratch The buffers of the workers
+ * @return The cost of each partition
+ * @throw std::invalid_argument if the spans differ in size or `num_parts < 2`
+ */
+auto partition_batch(std::span<const SimpleNetlist> netlists,
+                     std::span<std::vector<std::uint8_t>> parts, const BatchOptions& options,
+                     BatchScratch& scratch) -> std::vector<int>;
@@ -0,0 +1,67 @@
+/**
+ * @file BatchPipeline.hpp
+ * @brief Pipelined partitioning of a manifest of jobs
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <istream>  // for istream
+#include <ostream>  // for ostream
+
+/**
+ * @brief Options of `run_batch_pipeline`
+ */
+struct PipelineOptions {
+    /// @brief Number of parser threads
+    size_t num_parsers{2U};
+    /// @brief Number of partition workers (0 = one per thread of the scheduler)
+    size_t num_workers{0U};
+    /// @brief Capacity of each queue between two stages
+    size_t queue_capacity{4U};
+    /// @brief Maximum number of parsed netlists kept for later jobs
+    size_t cache_capacity{8U};
+};
+
+/**
+ * @brief Summary of `run_batch_pipeline`
+ */
+struct PipelineSummary {
+    /// @brief Number of jobs of the manifest
+    size_t num_jobs{};
+    /// @brief Number of jobs that failed
+    size_t num_failed{};
+};
+
+/**
+ * @brief Runs the partitioning jobs of a manifest in a three-stage pipeline.
+ *
+ * Each line of the manifest is a job, given by the `key=value` pairs of a
+ * `partition` request of `PartitionServer` (`file=`, `k=`, `epsilon=`,
+ * `format=`, `fixed=`, `seed=`, `mode=`, `vcycles=`) plus an optional
+ * `output=<path>`, by default `<file>.part.<k>` as for hMetis. Empty lines
+ * and lines starting with `#` are skipped. The same file may appear with
+ * several parameter sets.
+ *
+ * 1. Parser threads take the next lines of the manifest and read their
+ *    netlists into a `NetlistCache`, so that a netlist is parsed, reduced
+ *    and coarsened once for all its jobs.
+ * 2. Partition workers run the jobs (see `run_partition_job`); their
+ *    parallel steps share `TaskScheduler::current()` of the caller.
+ * 3. A writer thread writes the partitions, in the hMetis format, and one
+ *    report line per job as the jobs complete:
+ *    `<line> ok cost=<cost> cached=<0|1> output=<path>` or
+ *    `<line> error <message>`, where `<line>` is the line number in the
+ *    manifest.
+ *
+ * The stages are connected by bounded queues, so that the parsers wait
+ * when the workers fall behind and the workers wait for a slow writer,
+ * which bounds the number of netlists and partitions in memory.
+ *
+ * @param[in] manifest The manifest
+ * @param[out] report The report
+ * @param[in] options The options
+ * @return The summary
+ */
+auto run_batch_pipeline(std::istream& manifest, std::ostream& report,
+                        const PipelineOptions& options) -> PipelineSummary;
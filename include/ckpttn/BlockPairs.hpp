@@ -0,0 +1,87 @@
+/**
+ * @file BlockPairs.hpp
+ * @brief Scheduling of block pairs into rounds of disjoint pairs
+ */
+
+#pragma once
+
+#include <algorithm>  // for min, max
+#include <cstdint>    // for uint8_t
+#include <span>       // for span
+#include <utility>    // for move, pair
+#include <vector>     // for vector
+
+/// @brief Two blocks (parts) of a K-way partition
+using BlockPair = std::pair<std::uint8_t, std::uint8_t>;
+
+/**
+ * @brief Groups block pairs into rounds in which no block occurs twice.
+ *
+ * The pairs are assigned greedily in the given order: each pair goes into
+ * the first round in which neither of its blocks is used yet. Hence the
+ * pairs of a round can be refined concurrently, and a pair given early (for
+ * example, one with a large cut) is scheduled early.
+ *
+ * @param[in] pairs The block pairs, in order of priority.
+ * @param[in] num_parts The number of blocks.
+ * @return The rounds; each round keeps the order of `pairs`.
+ */
+inline auto disjoint_pair_rounds(std::span<const BlockPair> pairs, std::uint8_t num_parts)
+    -> std::vector<std::vector<BlockPair>> {
+    auto rounds = std::vector<std::vector<BlockPair>>{};
+    // used[r * num_parts + k] is 1 if block k is used in round r
+    auto used = std::vector<std::uint8_t>{};
+    for (const auto& pair : pairs) {
+        auto round = size_t{0U};
+        for (; round != rounds.size(); ++round) {
+            if (used[round * num_parts + pair.first] == 0U
+                && used[round * num_parts + pair.second] == 0U) {
+                break;
+            }
+        }
+        if (round == rounds.size()) {
+            rounds.emplace_back();
+            used.resize(used.size() + num_parts, 0U);
+        }
+        rounds[round].push_back(pair);
+        used[round * num_parts + pair.first] = 1U;
+        used[round * num_parts + pair.second] = 1U;
+    }
+    return rounds;
+}
+
+/**
+ * @brief Returns all block pairs as a round-robin tournament.
+ *
+ * Uses the circle method: block `K' - 1` stays in place while the others
+ * rotate, where `K'` is `num_parts` rounded up to an even number (the
+ * extra block of an odd `num_parts` is a bye). Hence every pair occurs in
+ * exactly one of the `K' - 1` rounds, and each round holds `K / 2`
+ * disjoint pairs.
+ *
+ * @param[in] num_parts The number of blocks.
+ * @return The rounds; each pair is ordered as (smaller, larger).
+ */
+inline auto round_robin_rounds(std::uint8_t num_parts) -> std::vector<std::vector<BlockPair>> {
+    const auto num_slots = static_cast<unsigned>(num_parts + (num_parts % 2U));
+    auto rounds = std::vector<std::vector<BlockPair>>{};
+    if (num_slots < 2U) {
+        return rounds;
+    }
+    const auto num_rotating = num_slots - 1U;
+    for (auto round = 0U; round != num_rotating; ++round) {
+        auto pairs = std::vector<BlockPair>{};
+        auto add_pair = [&](unsigned a, unsigned b) {
+            if (a < num_parts && b < num_parts) {
+                pairs.emplace_back(static_cast<std::uint8_t>(std::min(a, b)),
+                                   static_cast<std::uint8_t>(std::max(a, b)));
+            }
+        };
+        add_pair(round, num_rotating);
+        for (auto k = 1U; k != num_slots / 2U; ++k) {
+            add_pair((round + k) % num_rotating, (round + num_rotating - k) % num_rotating);
+        }
+        rounds.push_back(std::move(pairs));
+    }
+    return rounds;
+}
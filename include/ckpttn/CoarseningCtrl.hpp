@@ -0,0 +1,241 @@
+/**
+ * @file CoarseningCtrl.hpp
+ * @brief Coarsening controller of the multilevel partitioner
+ */
+
+#pragma once
+
+#include <ckpttn/CsrNetlist.hpp>       // for CsrNetlist
+#include <ckpttn/HierNetlist.hpp>      // for SimpleHierNetlist, CsrHierNetlist
+#include <cstddef>                     // for size_t
+#include <cstdint>                     // for uint8_t, uint32_t
+#include <memory>                      // for unique_ptr
+#include <netlistx/netlist.hpp>        // for SimpleNetlist
+#include <span>                        // for span
+#include <utility>                     // for move
+#include <vector>                      // for vector
+#include <xnetwork/classes/graph.hpp>  // for SimpleGraph
+
+/**
+ * @brief Statistics of one coarsening level
+ */
+struct CoarseningLevel {
+    /// @brief Number of modules before the contraction
+    size_t num_modules;
+    /// @brief Number of modules after the contraction
+    size_t num_modules2;
+    /// @brief Cluster weight bound that was finally used
+    unsigned int max_cluster_weight;
+    /// @brief Contraction ratio (num_modules2 / num_modules)
+    double ratio;
+};
+
+class CoarseningHierarchy;
+
+/**
+ * @brief Coarsening Controller
+ *
+ * Decides when the multilevel partitioner stops coarsening and how each level
+ * is contracted:
+ *
+ * - coarsening stops once the hypergraph has fewer modules than the coarsest
+ *   size, which is `coarsest_factor * num_parts` unless set explicitly;
+ * - a new cluster may not be heavier than the balance slack of a part (or the
+ *   average module weight of the coarsest level, whichever is larger), so
+ *   that the coarse levels can still be balanced;
+ * - a level must shrink the module count to at most `max_ratio` times the
+ *   previous one. When it does not, the contraction is retried with a doubled
+ *   weight bound, but never above the maximum weight of a part under the
+ *   balance constraint; if that does not help either, coarsening stops.
+ *
+ * The accepted levels are recorded and can be queried with `get_levels`.
+ *
+ * The first level of a given hypergraph can also be seeded with a clustering
+ * of its modules, e.g. the instances of the design hierarchy (see
+ * `set_seed_clusters`), instead of being found by matching.
+ *
+ * The levels of a prebuilt hierarchy can be reused instead of being
+ * contracted again (see `set_hierarchy` and `reuse`).
+ */
+class CoarseningCtrl {
+  private:
+    /// @brief Balance tolerance for partition constraints
+    double bal_tol;
+    /// @brief Number of partitions
+    std::uint8_t num_parts;
+    /// @brief Explicit coarsest size (0 = coarsest_factor * num_parts)
+    size_t limitsize{0U};
+    /// @brief Coarsest size per partition
+    size_t coarsest_factor{160U};
+    /// @brief Maximum accepted contraction ratio of a level
+    double max_ratio{2.0 / 3.0};
+    /// @brief Number of relaxed retries when a contraction stalls
+    size_t max_retries{2U};
+    /// @brief Statistics of the accepted levels
+    std::vector<CoarseningLevel> levels;
+    /// @brief The hypergraph whose first level is seeded (null = none)
+    const SimpleNetlist* seed_netlist{nullptr};
+    /// @brief The seed cluster label of each module of `seed_netlist`
+    std::vector<std::uint32_t> seed_clusters;
+    /// @brief The hierarchy whose levels are reused (null = none)
+    const CoarseningHierarchy* hierarchy{nullptr};
+
+    auto part_weight_bound(unsigned int total_weight) const -> unsigned int;
+    auto cluster_weight_bound(unsigned int total_weight) const -> unsigned int;
+    template <typename Gnl>
+    auto contract(const Gnl& hyprgraph, std::span<const std::uint32_t> keep)
+        -> std::unique_ptr<HierNetlist<xnetwork::SimpleGraph, Gnl>>;
+
+  public:
+    /**
+     * @brief Constructs a new CoarseningCtrl object.
+     *
+     * @param[in] bal_tol The balance tolerance for the partitioning.
+     * @param[in] num_parts The number of partitions.
+     */
+    CoarseningCtrl(double bal_tol, std::uint8_t num_parts)
+        : bal_tol{bal_tol}, num_parts{num_parts} {}
+
+    /**
+     * @brief Sets the coarsest size explicitly.
+     *
+     * @param[in] limit The coarsest size (0 = proportional to the number of partitions).
+     */
+    void set_limitsize(size_t limit) { this->limitsize = limit; }
+
+    /**
+     * @brief Sets the coarsest size per partition.
+     *
+     * @param[in] factor The coarsest size per partition.
+     */
+    void set_coarsest_factor(size_t factor) { this->coarsest_factor = factor; }
+
+    /**
+     * @brief Sets the maximum accepted contraction ratio of a level.
+     *
+     * @param[in] ratio The maximum ratio, in (0, 1).
+     */
+    void set_max_ratio(double ratio) { this->max_ratio = ratio; }
+
+    /**
+     * @brief Sets the number of relaxed retries when a contraction stalls.
+     *
+     * @param[in] retries The number of retries.
+     */
+    void set_max_retries(size_t retries) { this->max_retries = retries; }
+
+    /**
+     * @brief Seeds the first level of a hypergraph with a clustering.
+     *
+     * When `coarsen` starts a new hierarchy (no recorded level) from
+     * `hyprgraph`, the modules with the same label are merged into clusters
+     * of at most `max_cluster_weight`, within the parts of the partition to
+     * be preserved, if any. The matching takes over at the next level, and
+     * also at the first one if the seeded contraction does not shrink the
+     * hypergraph.
+     *
+     * @param[in] hyprgraph The hypergraph, which must outlive the seed.
+     * @param[in] clusters The cluster label of each module (empty = no seed).
+     */
+    void set_seed_clusters(const SimpleNetlist& hyprgraph, std::vector<std::uint32_t> clusters) {
+        this->seed_netlist = clusters.empty() ? nullptr : &hyprgraph;
+        this->seed_clusters = std::move(clusters);
+    }
+
+    /**
+     * @brief Sets a hierarchy whose levels are reused.
+     *
+     * @param[in] hierarchy The hierarchy, which must outlive its use (null = none).
+     */
+    void set_hierarchy(const CoarseningHierarchy* hierarchy) { this->hierarchy = hierarchy; }
+
+    /**
+     * @brief Returns the module count below which coarsening stops.
+     *
+     * @return The coarsest size.
+     */
+    auto coarsest_size() const -> size_t {
+        return this->limitsize != 0U ? this->limitsize : this->coarsest_factor * this->num_parts;
+    }
+
+    /**
+     * @brief Returns whether the hypergraph is large enough to be coarsened.
+     *
+     * @tparam Gnl The hypergraph type
+     * @param[in] hyprgraph The hypergraph.
+     * @return true if it should be coarsened.
+     */
+    template <typename Gnl> auto should_coarsen(const Gnl& hyprgraph) const -> bool {
+        return hyprgraph.number_of_modules() >= this->coarsest_size();
+    }
+
+    /**
+     * @brief Returns the maximum weight of a part under the balance constraint.
+     *
+     * @param[in] hyprgraph The hypergraph.
+     * @return The maximum weight of a part.
+     */
+    auto max_part_weight(const SimpleNetlist& hyprgraph) const -> unsigned int;
+
+    /**
+     * @brief Returns the initial cluster weight bound for a hypergraph.
+     *
+     * @param[in] hyprgraph The hypergraph.
+     * @return The maximum weight of a new cluster.
+     */
+    auto max_cluster_weight(const SimpleNetlist& hyprgraph) const -> unsigned int;
+
+    /**
+     * @brief Contracts one level, retrying with a relaxed bound when it stalls.
+     *
+     * @param[in] hyprgraph The hypergraph to contract.
+     * @param[in] keep The labels to be preserved, e.g. a partition (empty = none).
+     * @return The contracted netlist, or nullptr if coarsening has stalled.
+     */
+    auto coarsen(const SimpleNetlist& hyprgraph, std::span<const std::uint32_t> keep = {})
+        -> std::unique_ptr<SimpleHierNetlist>;
+
+    /**
+     * @brief Contracts the first level of a CSR netlist (see above).
+     *
+     * The seed clusters do not apply to a CSR netlist.
+     *
+     * @param[in] hyprgraph The hypergraph to contract.
+     * @param[in] keep The labels to be preserved, e.g. a partition (empty = none).
+     * @return The contracted netlist, or nullptr if coarsening has stalled.
+     */
+    auto coarsen(const CsrNetlist& hyprgraph, std::span<const std::uint32_t> keep = {})
+        -> std::unique_ptr<CsrHierNetlist>;
+
+    /**
+     * @brief Returns the level of the hierarchy contracted from a hypergraph.
+     *
+     * The level is reused if none of its modules is heavier than both
+     * `max_cluster_weight` and the heaviest module of `hyprgraph`, i.e. if
+     * its clusters are admissible under the current number of parts and
+     * balance tolerance. It is then recorded as an accepted level.
+     *
+     * @param[in] hyprgraph The hypergraph to contract.
+     * @return The level, or nullptr if there is none or it is not admissible.
+     */
+    auto reuse(const SimpleNetlist& hyprgraph) -> const SimpleHierNetlist*;
+
+    /**
+     * @brief Returns no level: a hierarchy is built over `SimpleNetlist` levels.
+     *
+     * @return nullptr
+     */
+    auto reuse(const CsrNetlist& /* hyprgraph */) -> const CsrHierNetlist* { return nullptr; }
+
+    /**
+     * @brief Returns the statistics of the accepted levels.
+     *
+     * @return The levels, from the finest to the coarsest.
+     */
+    auto get_levels() const -> const std::vector<CoarseningLevel>& { return this->levels; }
+
+    /**
+     * @brief Forgets the recorded levels.
+     */
+    void clear_levels() { this->levels.clear(); }
+};
@@ -0,0 +1,115 @@
+/**
+ * @file CoarseningHierarchy.hpp
+ * @brief Reusable coarsening hierarchy of the multilevel partitioner
+ */
+
+#pragma once
+
+#include <ckpttn/CoarseningCtrl.hpp>  // for CoarseningCtrl, CoarseningLevel
+#include <ckpttn/HierNetlist.hpp>     // for SimpleHierNetlist
+#include <cstddef>                    // for size_t
+#include <memory>                     // for unique_ptr
+#include <netlistx/netlist.hpp>       // for SimpleNetlist
+#include <string>                     // for string
+#include <vector>                     // for vector
+
+/**
+ * @brief Coarsening hierarchy of a hypergraph
+ *
+ * Keeps the levels that `MLPartMgr` would otherwise rebuild and discard at
+ * every run: level `i` is a `SimpleHierNetlist` whose parent is level
+ * `i - 1` (the hypergraph for the first level), with its `node_up_map`
+ * (the cluster of each module of the parent), module weights and net
+ * weights. Once set on a `CoarseningCtrl` (see
+ * `CoarseningCtrl::set_hierarchy`), the levels replace the contractions of
+ * the initial multilevel pass, so that runs with another number of parts,
+ * balance tolerance or initial partition skip the coarsening.
+ *
+ * The hierarchy can be saved to a compact binary file and loaded again
+ * through a memory map. A loaded level is contracted from a labeling (see
+ * `HierNetlist`), which projects the partitions exactly as the original
+ * level.
+ */
+class CoarseningHierarchy {
+  private:
+    /// @brief The hypergraph of the finest level
+    const SimpleNetlist* hyprgraph;
+    /// @brief The levels, from the finest to the coarsest
+    std::vector<std::unique_ptr<SimpleHierNetlist>> levels;
+    /// @brief Statistics of the levels
+    std::vector<CoarseningLevel> stats;
+
+  public:
+    /**
+     * @brief Constructs an empty hierarchy of a hypergraph.
+     *
+     * @param[in] hyprgraph The hypergraph, which must outlive the hierarchy.
+     */
+    explicit CoarseningHierarchy(const SimpleNetlist& hyprgraph) : hyprgraph{&hyprgraph} {}
+
+    /**
+     * @brief Builds the levels as the initial multilevel pass does.
+     *
+     * The hypergraph is contracted by `ctrl` until it is small enough or
+     * coarsening stalls. The levels of `ctrl` are cleared first.
+     *
+     * @param[in,out] ctrl The coarsening controller, with the number of parts
+     * and the balance tolerance of the runs (and its seed, if any).
+     */
+    void build(CoarseningCtrl& ctrl);
+
+    /**
+     * @brief Saves the hierarchy to a binary file.
+     *
+     * @param[in] filename The file name
+     * @throw std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& filename) const;
+
+    /**
+     * @brief Replaces the levels by the ones of a binary file.
+     *
+     * @param[in] filename The file name
+     * @throw std::runtime_error if the file cannot be read, is malformed, or
+     * was saved for another hypergraph (pins, module weights or fixed
+     * modules)
+     */
+    void load(const std::string& filename);
+
+    /**
+     * @brief Returns the hypergraph of the finest level.
+     *
+     * @return The hypergraph.
+     */
+    auto get_netlist() const -> const SimpleNetlist& { return *this->hyprgraph; }
+
+    /**
+     * @brief Returns the number of levels.
+     *
+     * @return The number of levels.
+     */
+    auto size() const -> size_t { return this->levels.size(); }
+
+    /**
+     * @brief Returns a level.
+     *
+     * @param[in] i The index of the level (0 = the finest).
+     * @return The contracted netlist.
+     */
+    auto get_level(size_t i) const -> const SimpleHierNetlist& { return *this->levels[i]; }
+
+    /**
+     * @brief Returns the statistics of the levels.
+     *
+     * @return The statistics, from the finest to the coarsest.
+     */
+    auto get_stats() const -> const std::vector<CoarseningLevel>& { return this->stats; }
+
+    /**
+     * @brief Returns the level contracted from a hypergraph.
+     *
+     * @param[in] hgr The hypergraph (the finest one or a level of this hierarchy).
+     * @return The index of the level whose parent is `hgr`, or `size()` if none.
+     */
+    auto find_coarser(const SimpleNetlist& hgr) const -> size_t;
+};
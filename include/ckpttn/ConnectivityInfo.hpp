@@ -0,0 +1,134 @@
+/**
+ * @file ConnectivityInfo.hpp
+ * @brief Shared per-net pin counts and per-part weights for parallel refinement
+ */
+
+#pragma once
+
+#include <atomic>   // for atomic
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t, uint32_t
+#include <span>     // for span
+#include <vector>   // for vector
+
+/**
+ * @brief Connectivity information of a partition, safe for concurrent moves
+ *
+ * Keeps one atomic pin counter per (net, part) and one atomic weight counter
+ * per part, so that several threads can move modules of a shared partition
+ * at the same time. Only nets with 2 to `FM_MAX_DEGREE` pins are tracked,
+ * like in the FM gain calculators, and the cost is the same (K-1)
+ * connectivity cost.
+ *
+ * @tparam Gnl The hypergraph type
+ */
+template <typename Gnl> class ConnectivityInfo {
+  public:
+    using node_t = typename Gnl::node_t;
+
+  private:
+    /// @brief Reference to the hypergraph being partitioned
+    const Gnl& hyprgraph;
+    /// @brief Number of modules
+    std::uint32_t num_modules;
+    /// @brief Number of partitions
+    std::uint32_t num_parts;
+    /// @brief Weight of each part
+    std::vector<std::atomic<unsigned int>> part_weight;
+    /// @brief Number of pins of each net in each part
+    std::vector<std::atomic<unsigned int>> pin_count;
+
+  public:
+    /**
+     * @brief Constructs a new ConnectivityInfo object.
+     *
+     * @param[in] hyprgraph The hypergraph.
+     * @param[in] num_parts The number of partitions.
+     */
+    ConnectivityInfo(const Gnl& hyprgraph, std::uint8_t num_parts);
+
+    /**
+     * @brief Computes the counters of a partition (in parallel).
+     *
+     * @param[in] part The partition.
+     * @param[in] num_tasks The number of tasks on `TaskScheduler::current()`.
+     */
+    void init(std::span<const std::uint8_t> part, size_t num_tasks);
+
+    /**
+     * @brief Returns the (K-1) connectivity cost (in parallel).
+     *
+     * @return The cost.
+     */
+    auto cost() const -> int;
+
+    /**
+     * @brief Returns whether a net is tracked.
+     *
+     * @param[in] net The net.
+     * @return true if the net has 2 to `FM_MAX_DEGREE` pins.
+     */
+    auto is_active(const node_t& net) const -> bool;
+
+    /**
+     * @brief Returns the current weight of a part.
+     *
+     * @param[in] k The part.
+     * @return The weight.
+     */
+    auto get_part_weight(std::uint32_t k) const -> unsigned int {
+        return this->part_weight[k].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the number of pins of a (tracked) net in a part.
+     *
+     * @param[in] net The net.
+     * @param[in] k The part.
+     * @return The number of pins.
+     */
+    auto get_pin_count(const node_t& net, std::uint32_t k) const -> unsigned int {
+        return this->pin_count[(net - this->num_modules) * this->num_parts + k].load(
+            std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Computes the gain of moving a module to every part.
+     *
+     * @param[in] v The module.
+     * @param[in] from_part The part of the module.
+     * @param[out] gain The gain of moving to each part (gain[from_part] = 0).
+     */
+    void compute_gains(const node_t& v, std::uint8_t from_part, std::span<int> gain) const;
+
+    /**
+     * @brief Computes the gain of moving a module to one part.
+     *
+     * @param[in] v The module.
+     * @param[in] from_part The part of the module.
+     * @param[in] to_part The target part.
+     * @return The gain.
+     */
+    auto move_gain(const node_t& v, std::uint8_t from_part, std::uint8_t to_part) const -> int;
+
+    /**
+     * @brief Moves a module if the source part stays at or above the lower bound.
+     *
+     * @param[in] v The module.
+     * @param[in] from_part The part of the module.
+     * @param[in] to_part The target part.
+     * @param[in] lowerbound The lower bound of the weight of every part.
+     * @return true if the module was moved.
+     */
+    auto try_move(const node_t& v, std::uint8_t from_part, std::uint8_t to_part,
+                  unsigned int lowerbound) -> bool;
+
+    /**
+     * @brief Moves a module unconditionally (e.g. to revert a move).
+     *
+     * @param[in] v The module.
+     * @param[in] from_part The part of the module.
+     * @param[in] to_part The target part.
+     */
+    void move(const node_t& v, std::uint8_t from_part, std::uint8_t to_part);
+};
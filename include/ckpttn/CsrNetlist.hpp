@@ -0,0 +1,121 @@
+/**
+ * @file CsrNetlist.hpp
+ * @brief Netlist over compressed sparse row (CSR) arrays
+ */
+
+#pragma once
+
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint32_t
+#include <netlistx/netlist.hpp>  // for Netlist
+#include <py2cpp/range.hpp>      // for Range
+#include <span>                  // for span
+#include <vector>                // for vector
+
+/**
+ * @brief A bipartite module/net graph over CSR arrays
+ *
+ * The nodes are numbered as in `SimpleGraph`: the modules first, then the
+ * nets. The pins of the nets are read from CSR arrays, which are either
+ * viewed (e.g. arrays owned by the caller of `partition_csr`, which must
+ * outlive the graph) or owned. The nets of the modules are the transpose of
+ * the pins, which is always owned. A net must not repeat a module.
+ *
+ * Unlike `SimpleGraph`, the graph is immutable and is read through spans, so
+ * that building a netlist from the arrays of a caller costs one transpose
+ * instead of one set insertion per pin.
+ */
+class CsrGraph {
+  public:
+    using node_t = std::uint32_t;
+    using nodeview_t = py::Range<std::uint32_t>;
+
+    /**
+     * @brief Constructs a graph viewing CSR arrays.
+     *
+     * @param[in] num_modules The number of modules
+     * @param[in] net_offsets Start of the pins of each net, plus the number of pins
+     * @param[in] pins The modules of the pins, which must outlive the graph
+     */
+    CsrGraph(std::uint32_t num_modules, std::span<const node_t> net_offsets,
+             std::span<const node_t> pins);
+
+    /**
+     * @brief Constructs a graph owning its CSR arrays.
+     *
+     * @param[in] num_modules The number of modules
+     * @param[in] net_offsets Start of the pins of each net, plus the number of pins
+     * @param[in] pins The modules of the pins
+     */
+    CsrGraph(std::uint32_t num_modules, std::vector<node_t> net_offsets,
+             std::vector<node_t> pins);
+
+    // The spans may point into the owned arrays, which a move keeps in place
+    CsrGraph(const CsrGraph&) = delete;
+    auto operator=(const CsrGraph&) -> CsrGraph& = delete;
+    CsrGraph(CsrGraph&&) noexcept = default;
+    auto operator=(CsrGraph&&) noexcept -> CsrGraph& = default;
+    ~CsrGraph() = default;
+
+    /**
+     * @brief Returns the neighbors of a node.
+     *
+     * @param[in] node A module or a net
+     * @return The nets of a module, or the modules of a net
+     */
+    auto operator[](const node_t& node) const -> std::span<const node_t> {
+        if (node < this->num_modules) {
+            return std::span<const node_t>(this->module_nets)
+                .subspan(this->module_offsets[node],
+                         this->module_offsets[node + 1U] - this->module_offsets[node]);
+        }
+        const auto i_net = node - this->num_modules;
+        return this->pins.subspan(this->net_offsets[i_net],
+                                  this->net_offsets[i_net + 1U] - this->net_offsets[i_net]);
+    }
+
+    /**
+     * @brief Returns the degree of a node.
+     *
+     * @param[in] node A module or a net
+     * @return The number of neighbors
+     */
+    auto degree(const node_t& node) const -> size_t { return (*this)[node].size(); }
+
+    /**
+     * @brief Returns the number of nodes.
+     *
+     * @return The number of modules plus the number of nets
+     */
+    auto number_of_nodes() const -> size_t {
+        return this->num_modules + this->net_offsets.size() - 1U;
+    }
+
+    /**
+     * @brief Returns the number of edges, i.e. of pins.
+     *
+     * @return size_t
+     */
+    auto number_of_edges() const -> size_t { return this->pins.size(); }
+
+  private:
+    /// @brief Number of modules
+    std::uint32_t num_modules;
+    /// @brief Storage of `net_offsets` when the graph owns it
+    std::vector<node_t> owned_net_offsets;
+    /// @brief Storage of `pins` when the graph owns it
+    std::vector<node_t> owned_pins;
+    /// @brief Start of the pins of each net, plus the number of pins
+    std::span<const node_t> net_offsets;
+    /// @brief The modules of the pins
+    std::span<const node_t> pins;
+    /// @brief Start of the nets of each module, plus the number of pins
+    std::vector<node_t> module_offsets;
+    /// @brief The nets of the modules
+    std::vector<node_t> module_nets;
+
+    /// @brief Builds `module_offsets` and `module_nets` from the pins
+    void transpose();
+};
+
+using CsrNetlist = Netlist<CsrGraph>;
@@ -0,0 +1,112 @@
+/**
+ * @file CsrPartitioner.hpp
+ * @brief Partitioning of a hypergraph given as caller-owned CSR arrays
+ */
+
+#pragma once
+
+#include <ckpttn/CsrNetlist.hpp>  // for CsrNetlist
+#include <cstddef>                // for size_t
+#include <cstdint>                // for uint8_t, uint32_t
+#include <netlistx/netlist.hpp>   // for SimpleNetlist
+#include <span>                   // for span
+
+/**
+ * @brief A hypergraph in compressed sparse row (CSR) form, over arrays owned
+ * by the caller (e.g. NumPy arrays)
+ *
+ * The pins of net `i` are `pins[net_offsets[i]]` to
+ * `pins[net_offsets[i + 1] - 1]`, as in `HypergraphCsr`. The view does not
+ * own or copy the arrays, which must outlive it; `partition_csr` partitions
+ * a `CsrNetlist` that reads the 32-bit arrays in place (see
+ * `to_csr_netlist`).
+ *
+ * @tparam Index The integer type of the arrays
+ */
+template <typename Index> struct HypergraphCsrView {
+    /// @brief Number of modules
+    std::uint32_t num_modules{};
+    /// @brief Start of the pins of each net, plus the total number of pins
+    std::span<const Index> net_offsets;
+    /// @brief The modules of the pins
+    std::span<const Index> pins;
+    /// @brief Weight of each module (empty = unit weights)
+    std::span<const Index> module_weight;
+};
+
+/// @brief Refinement algorithm of `partition_csr`
+enum class CsrRefiner {
+    /// @brief FM (bipartition gains for 2 parts, K-way gains otherwise)
+    FM,
+    /// @brief No-Nonsense partitioning (`NNPartMgr`)
+    NN,
+    /// @brief FM with K-way gains, also for 2 parts
+    KWay
+};
+
+/**
+ * @brief Options of `partition_csr`
+ */
+struct CsrPartitionOptions {
+    /// @brief Number of partitions
+    std::uint8_t num_parts{2};
+    /// @brief Balance tolerance
+    double bal_tol{0.05};
+    /// @brief Refinement algorithm of every level
+    CsrRefiner refiner{CsrRefiner::FM};
+    /// @brief Number of extra V-cycles (see `MLPartMgr::set_num_vcycles`)
+    size_t num_vcycles{0U};
+    /// @brief Seed of the random initial partition
+    std::uint32_t seed{1U};
+    /// @brief Whether to start from the given partition instead of a random one
+    bool use_initial{false};
+};
+
+/**
+ * @brief Builds a `SimpleNetlist` from a CSR view.
+ *
+ * @tparam Index The integer type of the arrays
+ * @param[in] csr The hypergraph
+ * @return The netlist
+ * @throw std::invalid_argument if the offsets are not a non-decreasing
+ * sequence from 0 to the number of pins, if a pin is not a module, or if the
+ * weights are not one per module
+ */
+template <typename Index> auto to_netlist(const HypergraphCsrView<Index>& csr) -> SimpleNetlist;
+
+/**
+ * @brief Builds a `CsrNetlist` from a CSR view.
+ *
+ * When the arrays are 32-bit and no net repeats a module, the netlist reads
+ * the offsets and the pins in place, so they must outlive it; otherwise it
+ * owns a copy, without the repeated pins. Either way, it builds the nets of
+ * the modules, i.e. one array as large as the pins.
+ *
+ * @tparam Index The integer type of the arrays
+ * @param[in] csr The hypergraph
+ * @return The netlist
+ * @throw std::invalid_argument as `to_netlist`, or if there are more than
+ * 2^32 - 1 pins
+ */
+template <typename Index> auto to_csr_netlist(const HypergraphCsrView<Index>& csr) -> CsrNetlist;
+
+/**
+ * @brief Partitions a hypergraph given as CSR arrays with `MLPartMgr`.
+ *
+ * The partition is written in place into `part`, which is also the initial
+ * partition if `options.use_initial` is set. Everything runs on
+ * `TaskScheduler::current()` and touches no state shared with other calls,
+ * so that several threads may partition at the same time.
+ *
+ * @tparam Index The integer type of the arrays
+ * @param[in] csr The hypergraph
+ * @param[in,out] part The partition, one entry per module
+ * @param[in] options The options
+ * @return The cost of the partition
+ * @throw std::invalid_argument if the arrays are inconsistent (see
+ * `to_csr_netlist`), if `part` is not one entry per module, or if
+ * `options.num_parts < 2`
+ */
+template <typename Index>
+auto partition_csr(const HypergraphCsrView<Index>& csr, std::span<std::uint8_t> part,
+                   const CsrPartitionOptions& options) -> int;
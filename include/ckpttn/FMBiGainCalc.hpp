@@ -5,13 +5,14 @@
 
 #pragma once
 
-// #include <cstddef>   // for byte
+// #include <cstddef>             // for byte
 #include <cstdint>             // for uint8_t
 #include <mywheel/dllist.hpp>  // for Dllink
 #include <span>                // for span
 #include <utility>             // for pair
 #include <vector>              // for vector
 
+#include "FMGainScratch.hpp"  // for FMGainScratch
 #include "FMPmrConfig.hpp"
 // #include "moveinfo.hpp"  // for MoveInfo
 
@@ -39,10 +40,12 @@ template <typename Gnl> class FMBiGainCalc {
   private:
     /// @brief Reference to the hypergraph being partitioned
     const Gnl& hyprgraph;
+    /// @brief Buffers of this calculator when no shared scratch is given
+    FMGainScratch<node_t> own_scratch;
     /// @brief List of vertex links for bucket-based gain management
-    std::vector<Item> vertex_list;
+    std::vector<Item>& vertex_list;
     /// @brief Initial gain values for each vertex
-    std::vector<int> init_gain_list;
+    std::vector<int>& init_gain_list;
     /// @brief Total cost of the current partitioning
     int total_cost{0};
     /// @brief Stack buffer size for PMR memory resource (tunable per workload)
@@ -67,13 +70,17 @@ template <typename Gnl> class FMBiGainCalc {
      * @brief Constructs a new FMBiGainCalc object.
      *
      * @param[in] hyprgraph The hypergraph to use for the FMBiGainCalc object.
+     * @param[in] scratch The buffers to reuse (null = own buffers).
      */
-    explicit FMBiGainCalc(const Gnl& hyprgraph, std::uint8_t /*num_parts*/)
+    explicit FMBiGainCalc(const Gnl& hyprgraph, std::uint8_t /*num_parts*/,
+                          FMGainScratch<node_t>* scratch = nullptr)
         : hyprgraph{hyprgraph},
-          vertex_list(hyprgraph.number_of_modules()),
-          init_gain_list(hyprgraph.number_of_modules(), 0),
+          vertex_list{(scratch != nullptr ? *scratch : this->own_scratch).bi_vertex_list},
+          init_gain_list{(scratch != nullptr ? *scratch : this->own_scratch).bi_init_gain_list},
           rsrc(stack_buf, sizeof stack_buf),
           idx_vec(&rsrc) {
+        this->vertex_list.resize(hyprgraph.number_of_modules());
+        this->init_gain_list.assign(hyprgraph.number_of_modules(), 0);
         for (const auto& v : this->hyprgraph) {
             this->vertex_list[v].data = std::make_pair(v, uint32_t(0));
         }
@@ -84,7 +91,8 @@ template <typename Gnl> class FMBiGainCalc {
      *
      * This function initializes the FMBiGainCalc object by resetting the total cost, vertex list,
      * and initial gain list. It then calls the _init_gain function for each net in the hypergraph
-     * to initialize the gain values.
+     * to initialize the gain values. Large hypergraphs are initialized in parallel on
+     * `TaskScheduler::current()` instead (see `_init_parallel`), with the same result.
      *
      * @param[in] part The partition information.
      * @return The total cost of the initial partition.
@@ -94,6 +102,9 @@ template <typename Gnl> class FMBiGainCalc {
         for (auto& vlink : this->vertex_list) {
             vlink.data.second = 0U;
         }
+        if (this->_init_parallel(part)) {
+            return this->total_cost;
+        }
         for (auto& elem : this->init_gain_list) {
             elem = 0;
         }
@@ -204,6 +215,20 @@ template <typename Gnl> class FMBiGainCalc {
         this->init_gain_list[w] -= weight;
     }
 
+    /**
+     * @brief Initializes the gain values of all modules in parallel.
+     *
+     * First counts the pins of every net in each part (in parallel over the
+     * nets, also summing the cost in a fixed order), then sums the gain of
+     * every module over its nets (in parallel over the modules), so that no
+     * two tasks write the same entry.
+     *
+     * @param[in] part The current partition information.
+     * @return true if the hypergraph was large enough to be initialized in
+     * parallel; otherwise nothing is done.
+     */
+    auto _init_parallel(std::span<const std::uint8_t> part) -> bool;
+
     /**
      * @brief Initializes the gain values for a net.
      *
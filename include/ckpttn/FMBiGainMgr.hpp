@@ -40,8 +40,11 @@ template <typename Gnl> class FMBiGainMgr
      * @brief Constructs a new FMBiGainMgr object with the given hypergraph.
      *
      * @param[in] hyprgraph The hypergraph to be used for the FMBiGainMgr object.
+     * @param[in] scratch The buffers to reuse (null = own buffers).
      */
-    FMBiGainMgr(const Gnl& hyprgraph, std::uint8_t /* num_parts */) : Base{hyprgraph, 2} {}
+    FMBiGainMgr(const Gnl& hyprgraph, std::uint8_t /* num_parts */,
+                FMGainScratch<node_t>* scratch = nullptr)
+        : Base{hyprgraph, 2, scratch} {}
 
     /**
      * @brief Initializes the FMBiGainMgr object with the given partition.
@@ -108,4 +108,11 @@ template <typename Gnl> class FMConstrMgr {
      * @param[in] part The partition information to check.
      */
     auto final_check(std::span<const std::uint8_t> part) -> bool;
+
+    /**
+     * @brief Returns the lower bound of the weight of every partition.
+     *
+     * @return unsigned int The lower bound.
+     */
+    auto get_lowerbound() const -> unsigned int { return this->lowerbound; }
 };
@@ -6,13 +6,17 @@
 #pragma once
 
 // #include <algorithm> // for all_of
+#include <cstddef>              // for size_t
 #include <cstdint>              // for uint8_t
 #include <mywheel/bpqueue.hpp>  // for BPQueue
 #include <mywheel/dllist.hpp>   // for Dllink
 #include <span>                 // for span
+
+#include "FMGainScratch.hpp"  // for FMGainScratch
 // #include <tuple>                // for tuple
-#include <utility>  // for pair
-#include <vector>   // for vector<>::const_iterator, vector
+#include <type_traits>  // for conditional_t, decay_t, is_same_v
+#include <utility>      // for pair, declval
+#include <vector>       // for vector<>::const_iterator, vector
 
 template <typename Node> struct MoveInfo;
 template <typename Node> struct MoveInfoV;
@@ -33,16 +37,33 @@ template <typename Gnl, typename GainCalc, class Derived> class FMGainMgr {
     Derived& self = *static_cast<Derived*>(this);
     using node_t = typename Gnl::node_t;
     using Item = Dllink<std::pair<node_t, uint32_t>>;
+    static constexpr bool scalar_delta
+        = std::is_same_v<std::decay_t<decltype(std::declval<GainCalc&>().delta_gain_w)>, int>;
+    /// @brief Delta gain of a neighbor: `int` (2-way) or one `int` per part (k-way)
+    using DeltaGain = std::conditional_t<scalar_delta, int, std::span<const int>>;
+    static constexpr auto no_slot = ~uint32_t(0);
 
   protected:
     /// @brief Waiting list for vertices awaiting movement
     Dllist<std::pair<node_t, uint32_t>> waiting_list{std::make_pair(node_t{}, uint32_t(0))};
     /// @brief Reference to the hypergraph being partitioned
     const Gnl& hyprgraph;
+    /// @brief Buffers of this gain manager when no shared scratch is given
+    FMGainScratch<node_t> own_scratch;
+    /// @brief Buffers in use (`own_scratch` or a shared scratch)
+    FMGainScratch<node_t>& scratch;
     /// @brief Gain buckets for each partition (used in bucket-based gain management)
-    std::vector<BPQueue<node_t>> gain_bucket;
+    std::vector<BPQueue<node_t>>& gain_bucket;
     /// @brief Number of partitions
     std::uint8_t num_parts;
+    /// @brief Number of ints per delta gain in `batch_delta` (1 or `num_parts`)
+    std::size_t delta_stride;
+    /// @brief Slot of each module in `batch_nodes` during `update_move`, or `no_slot`
+    std::vector<uint32_t>& batch_slot;
+    /// @brief Neighbors with a pending delta gain, in the order of their first update
+    std::vector<node_t>& batch_nodes;
+    /// @brief Pending (aggregated) delta gains, `delta_stride` ints per neighbor
+    std::vector<int>& batch_delta;
 
   public:
     /// @brief Gain calculator instance
@@ -57,8 +78,10 @@ template <typename Gnl, typename GainCalc, class Derived> class FMGainMgr {
      *
      * @param[in] hyprgraph The hypergraph to manage the gains for.
      * @param[in] num_parts The number of partitions in the hypergraph.
+     * @param[in] shared_scratch The buffers to reuse (null = own buffers).
      */
-    FMGainMgr(const Gnl& hyprgraph, std::uint8_t num_parts);
+    FMGainMgr(const Gnl& hyprgraph, std::uint8_t num_parts,
+              FMGainScratch<node_t>* shared_scratch = nullptr);
 
     /**
      * @brief Initializes the FMGainMgr with the given partition information.
@@ -110,6 +133,11 @@ template <typename Gnl, typename GainCalc, class Derived> class FMGainMgr {
     /**
      * @brief Updates the gain information for the given set of moves.
      *
+     * The delta gains of all incident nets are first collected in a scratch
+     * buffer, where the deltas of a neighbor that shares several nets with the
+     * moved vertex are summed up. The buckets are then updated with a single
+     * `modify_key` per neighbor.
+     *
      * @param[in] part The current partition information.
      * @param[in] move_info_v The set of moves to update the gain information for.
      */
@@ -117,6 +145,21 @@ template <typename Gnl, typename GainCalc, class Derived> class FMGainMgr {
         -> void;
 
   private:
+    /**
+     * @brief Adds a delta gain of the neighbor `w` to the scratch buffer.
+     *
+     * @param[in] w The neighbor of the moved vertex.
+     * @param[in] delta_gain The delta gain (one per part in k-way partitioning).
+     */
+    auto _add_delta(const node_t& w, DeltaGain delta_gain) -> void;
+
+    /**
+     * @brief Applies the aggregated delta gains to the gain buckets and clears the buffer.
+     *
+     * @param[in] part The current partition information.
+     */
+    auto _flush_delta(std::span<const std::uint8_t> part) -> void;
+
     /**
      * @brief Updates the gain information for a 2-pin net after a move.
      *
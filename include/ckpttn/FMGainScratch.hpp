@@ -0,0 +1,49 @@
+/**
+ * @file FMGainScratch.hpp
+ * @brief Reusable buffers of the FM gain managers
+ */
+
+#pragma once
+
+#include <cstdint>              // for uint32_t
+#include <mywheel/bpqueue.hpp>  // for BPQueue
+#include <mywheel/dllist.hpp>   // for Dllink
+#include <utility>              // for pair
+#include <vector>               // for vector
+
+/**
+ * @brief Buffers of an FM gain manager that can outlive it
+ *
+ * A gain manager allocates its gain buckets, its vertex links and its gain
+ * buffers for the hypergraph it is built for. When many gain managers are
+ * built one after the other, e.g. for every level of many small netlists,
+ * they can share one `FMGainScratch` instead: each of them resizes the
+ * buffers to its hypergraph, which only allocates when the hypergraph is
+ * larger than every one seen before, and clears the buckets.
+ *
+ * At most one gain manager (or gain calculator) may use a scratch at a time.
+ *
+ * @tparam Node The node type of the hypergraph
+ */
+template <typename Node> struct FMGainScratch {
+    using Item = Dllink<std::pair<Node, std::uint32_t>>;
+
+    /// @brief Gain buckets, one per partition
+    std::vector<BPQueue<Node>> gain_bucket;
+    /// @brief Gain range of `gain_bucket` (-1 = not built yet)
+    int bucket_range{-1};
+    /// @brief Vertex links of `FMBiGainCalc`
+    std::vector<Item> bi_vertex_list;
+    /// @brief Initial gains of `FMBiGainCalc`
+    std::vector<int> bi_init_gain_list;
+    /// @brief Vertex links of `FMKWayGainCalc`, one list per partition
+    std::vector<std::vector<Item>> kway_vertex_list;
+    /// @brief Initial gains of `FMKWayGainCalc`, one list per partition
+    std::vector<std::vector<int>> kway_init_gain_list;
+    /// @brief Slot of each module in `batch_nodes` (see `FMGainMgr::update_move`)
+    std::vector<std::uint32_t> batch_slot;
+    /// @brief Neighbors with a pending delta gain
+    std::vector<Node> batch_nodes;
+    /// @brief Pending delta gains
+    std::vector<int> batch_delta;
+};
@@ -5,7 +5,7 @@
 
 #pragma once
 
-// #include <algorithm>   // for fill
+// #include <algorithm>           // for fill
 #include <cstdint>             // for uint8_t
 #include <mywheel/dllist.hpp>  // for Dllink
 #include <mywheel/robin.hpp>   // for fun::Robin<>...
@@ -13,7 +13,8 @@
 #include <utility>             // for pair
 #include <vector>              // for vector
 
-#include "FMPmrConfig.hpp"  // for FMPmr::monotonic_buffer_resource, FMPmr::vector
+#include "FMGainScratch.hpp"  // for FMGainScratch
+#include "FMPmrConfig.hpp"    // for FMPmr::monotonic_buffer_resource, FMPmr::vector
 
 // forward declare
 template <typename Gnl> class FMKWayGainMgr;
@@ -51,10 +52,12 @@ template <typename Gnl> class FMKWayGainCalc {
     uint8_t stack_buf[stack_buf_size];
     /// @brief Monotonic memory resource for efficient allocation
     FMPmr::monotonic_buffer_resource rsrc;
+    /// @brief Buffers of this calculator when no shared scratch is given
+    FMGainScratch<node_t> own_scratch;
     /// @brief Vertex lists for each partition
-    std::vector<std::vector<Item>> vertex_list{};
+    std::vector<std::vector<Item>>& vertex_list;
     /// @brief Initial gain lists for each partition
-    std::vector<std::vector<int>> init_gain_list;
+    std::vector<std::vector<int>>& init_gain_list;
     /// @brief Delta gain vector for vertices
     FMPmr::vector<int> delta_gain_v;
 
@@ -71,23 +74,28 @@ template <typename Gnl> class FMKWayGainCalc {
      *
      * @param[in] hyprgraph The netlist.
      * @param[in] num_parts The number of partitions.
+     * @param[in] scratch The buffers to reuse (null = own buffers).
      */
-    FMKWayGainCalc(const Gnl& hyprgraph, std::uint8_t num_parts)
+    FMKWayGainCalc(const Gnl& hyprgraph, std::uint8_t num_parts,
+                   FMGainScratch<node_t>* scratch = nullptr)
         : hyprgraph{hyprgraph},
           num_parts{num_parts},
           rr{num_parts},
           rsrc(stack_buf, sizeof stack_buf),
-          init_gain_list(num_parts, std::vector<int>(hyprgraph.number_of_modules(), 0)),
+          vertex_list{(scratch != nullptr ? *scratch : this->own_scratch).kway_vertex_list},
+          init_gain_list{(scratch != nullptr ? *scratch : this->own_scratch).kway_init_gain_list},
           delta_gain_v(num_parts, 0, &rsrc),
           delta_gain_w(num_parts, 0, &rsrc),
           idx_vec(&rsrc) {
+        this->vertex_list.resize(num_parts);
+        this->init_gain_list.resize(num_parts);
         for (auto part_idx = 0U; part_idx != this->num_parts; ++part_idx) {
-            auto vec = std::vector<Item>{};
-            vec.reserve(hyprgraph.number_of_modules());
+            auto& vec = this->vertex_list[part_idx];
+            vec.resize(hyprgraph.number_of_modules());
             for (const auto& v : this->hyprgraph) {
-                vec.emplace_back(Item(std::make_pair(v, 0)));
+                vec[v].data = std::make_pair(v, uint32_t(0));
             }
-            this->vertex_list.emplace_back(std::move(vec));
+            this->init_gain_list[part_idx].assign(hyprgraph.number_of_modules(), 0);
         }
     }
 
@@ -95,7 +103,9 @@ template <typename Gnl> class FMKWayGainCalc {
      * @brief Initializes the FMKWayGainCalc object.
      *
      * This function resets the total cost, initializes the vertex list and init gain list to 0,
-     * and then calls the _init_gain function for each net in the hypergraph.
+     * and then calls the _init_gain function for each net in the hypergraph. Large hypergraphs
+     * are initialized in parallel on `TaskScheduler::current()` instead (see
+     * `_init_parallel`), with the same result.
      *
      * @param[in] part The partition to initialize.
      * @return The total cost after initialization.
@@ -107,6 +117,9 @@ template <typename Gnl> class FMKWayGainCalc {
                 vlink.data.second = 0U;
             }
         }
+        if (this->_init_parallel(part)) {
+            return this->total_cost;
+        }
         for (auto& vec : this->init_gain_list) {
             for (auto& elem : vec) {
                 elem = 0;
@@ -237,6 +250,20 @@ template <typename Gnl> class FMKWayGainCalc {
         }
     }
 
+    /**
+     * @brief Initializes the gain values of all modules in parallel.
+     *
+     * First counts the pins of every net in each part (in parallel over the
+     * nets, also summing the cost in a fixed order), then sums the gains of
+     * every module over its nets (in parallel over the modules), so that no
+     * two tasks write the same entry.
+     *
+     * @param[in] part The current partitioning of the vertices.
+     * @return true if the hypergraph was large enough to be initialized in
+     * parallel; otherwise nothing is done.
+     */
+    auto _init_parallel(std::span<const std::uint8_t> part) -> bool;
+
     /**
      * @brief Initializes the gain values for a net in the partitioning.
      *
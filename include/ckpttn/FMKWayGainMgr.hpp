@@ -39,9 +39,11 @@ template <typename Gnl> class FMKWayGainMgr
      *
      * @param[in] hyprgraph The hypergraph to use.
      * @param[in] num_parts The number of partitions.
+     * @param[in] scratch The buffers to reuse (null = own buffers).
      */
-    FMKWayGainMgr(const Gnl& hyprgraph, std::uint8_t num_parts)
-        : Base{hyprgraph, num_parts}, rr{num_parts} {}
+    FMKWayGainMgr(const Gnl& hyprgraph, std::uint8_t num_parts,
+                  FMGainScratch<node_t>* scratch = nullptr)
+        : Base{hyprgraph, num_parts, scratch}, rr{num_parts} {}
 
     /**
      * @brief Initializes the gain manager with the given partition information.
@@ -24,4 +24,6 @@ namespace FMPmr = std::pmr;
 /// @brief Maximum number of partitions supported by the FM algorithm
 const auto FM_MAX_NUM_PARTITIONS = 255U;
 /// @brief Maximum degree (net size) supported by the FM algorithm
-const auto FM_MAX_DEGREE = 500U;
\ No newline at end of file
+const auto FM_MAX_DEGREE = 500U;
+/// @brief Number of nets (or modules) per task of the parallel gain initialization
+const auto FM_GAIN_INIT_BLOCK_SIZE = 4096U;
\ No newline at end of file
@@ -0,0 +1,117 @@
+/**
+ * @file FlowNetwork.hpp
+ * @brief Push-relabel maximum flow on a directed network
+ */
+
+#pragma once
+
+#include <cstdint>  // for int64_t, uint32_t, uint8_t
+#include <vector>   // for vector
+
+/**
+ * @brief Directed flow network with a push-relabel max-flow solver
+ *
+ * `max_flow` runs the FIFO push-relabel algorithm with periodic global
+ * relabeling until no node has excess, so that the result is a maximum
+ * flow (not only a maximum preflow). Both extreme minimum cuts can then be
+ * queried:
+ *
+ * - `source_side` returns the smallest source side (the nodes reachable
+ *   from the source in the residual network);
+ * - `sink_side` returns the smallest sink side (the nodes that can reach
+ *   the sink in the residual network).
+ *
+ * Capacities are integers; "infinite" edges should use a capacity larger
+ * than the sum of all finite capacities.
+ */
+class FlowNetwork {
+  public:
+    using cap_t = std::int64_t;
+
+  private:
+    /// @brief Residual edge
+    struct Edge {
+        /// @brief Head of the edge
+        std::uint32_t to;
+        /// @brief Index of the reverse edge in `adj[to]`
+        std::uint32_t rev;
+        /// @brief Residual capacity
+        cap_t cap;
+    };
+
+    /// @brief Residual edges of each node
+    std::vector<std::vector<Edge>> adj;
+    /// @brief Label (distance estimate) of each node
+    std::vector<std::uint32_t> height;
+    /// @brief Excess of each node
+    std::vector<cap_t> excess;
+    /// @brief Current arc of each node
+    std::vector<std::uint32_t> current;
+    /// @brief Source of the last `max_flow`
+    std::uint32_t source{0U};
+    /// @brief Sink of the last `max_flow`
+    std::uint32_t sink{0U};
+
+  public:
+    /**
+     * @brief Constructs a network without edges.
+     *
+     * @param[in] num_nodes The number of nodes.
+     */
+    explicit FlowNetwork(std::uint32_t num_nodes) : adj(num_nodes) {}
+
+    /**
+     * @brief Returns the number of nodes.
+     *
+     * @return The number of nodes.
+     */
+    auto num_nodes() const -> std::uint32_t { return static_cast<std::uint32_t>(adj.size()); }
+
+    /**
+     * @brief Adds a node.
+     *
+     * @return The index of the new node.
+     */
+    auto add_node() -> std::uint32_t {
+        this->adj.emplace_back();
+        return this->num_nodes() - 1U;
+    }
+
+    /**
+     * @brief Adds a directed edge.
+     *
+     * @param[in] from The tail.
+     * @param[in] to The head.
+     * @param[in] capacity The capacity (non-negative).
+     */
+    void add_edge(std::uint32_t from, std::uint32_t to, cap_t capacity);
+
+    /**
+     * @brief Computes a maximum flow from `source` to `sink`.
+     *
+     * @param[in] source The source.
+     * @param[in] sink The sink.
+     * @return The value of the maximum flow.
+     */
+    auto max_flow(std::uint32_t source, std::uint32_t sink) -> cap_t;
+
+    /**
+     * @brief Returns the smallest source side of a minimum cut (after `max_flow`).
+     *
+     * @return 1 for the nodes on the source side, 0 otherwise.
+     */
+    auto source_side() const -> std::vector<std::uint8_t>;
+
+    /**
+     * @brief Returns the smallest sink side of a minimum cut (after `max_flow`).
+     *
+     * @return 1 for the nodes on the sink side, 0 otherwise.
+     */
+    auto sink_side() const -> std::vector<std::uint8_t>;
+
+  private:
+    /**
+     * @brief Recomputes all labels by backward BFS from the sink, then from the source.
+     */
+    void _global_relabel();
+};
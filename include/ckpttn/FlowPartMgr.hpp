@@ -0,0 +1,162 @@
+/**
+ * @file FlowPartMgr.hpp
+ * @brief Flow-based refinement between pairs of blocks
+ */
+
+#pragma once
+
+#include <ckpttn/BlockPairs.hpp>  // for BlockPair
+#include <cstddef>                // for size_t
+#include <cstdint>                // for uint8_t
+#include <span>                   // for span
+
+enum class LegalCheck;
+
+/**
+ * @brief Refines the cut between two blocks by a minimum cut.
+ *
+ * This is the refinement of one block pair of `FlowPartMgr` (see there).
+ * The region on each side weighs at most the weight of the block above
+ * `lowerbound`, so that applying any cut keeps both blocks at least at
+ * `lowerbound`. Reads the partition from `snapshot` and writes the moved
+ * modules (of the two blocks only) into `part` and the new block weights
+ * into `part_weight`.
+ *
+ * @param[in] hgr The hypergraph
+ * @param[in] snapshot The partition at the start of the round
+ * @param[in,out] part The partition
+ * @param[in] fixed 1 for the fixed modules
+ * @param[in] pair The two blocks
+ * @param[in] cut_nets The nets cut between the two blocks
+ * @param[in,out] part_weight The weight of each block
+ * @param[in] lowerbound The lower bound of the block weights
+ * @param[in] max_region_modules The maximum number of modules in each side of the region
+ * @return The reduction of the cost
+ */
+template <typename Gnl>
+auto refine_block_pair(const Gnl& hgr, std::span<const std::uint8_t> snapshot,
+                       std::span<std::uint8_t> part, std::span<const std::uint8_t> fixed,
+                       const BlockPair& pair, std::span<const typename Gnl::node_t> cut_nets,
+                       std::span<unsigned int> part_weight, unsigned int lowerbound,
+                       size_t max_region_modules) -> int;
+
+/**
+ * @brief Flow-based Partition Manager
+ *
+ * FM only moves one module at a time, so it cannot find an improvement
+ * that needs a whole group of modules to change sides. `FlowPartMgr`
+ * refines the cut between two blocks `a` and `b` with a minimum cut:
+ *
+ * - a region is grown by BFS around the cut between `a` and `b`, on each
+ *   side limited so that the side keeps at least the lower bound of the
+ *   constraint manager even if the whole region moves away;
+ * - the nets of the region are expanded into a graph (Lawler expansion:
+ *   one bridge edge with the weight of the net between two net nodes, and
+ *   edges of infinite capacity to and from its pins); the modules of `a`
+ *   and `b` outside of the region are contracted into the source and sink;
+ * - a push-relabel max-flow (`FlowNetwork`) gives the smallest and the
+ *   largest source side of a minimum cut; the more balanced one is applied
+ *   if it cuts less than the current partition (or as much, but with a
+ *   better balance).
+ *
+ * Block pairs are visited in decreasing order of their cut weight, grouped
+ * into rounds of disjoint pairs (`disjoint_pair_rounds`); the pairs of a
+ * round run concurrently on `TaskScheduler::current()`. Since they touch
+ * different blocks, their improvements add up exactly and the result does
+ * not depend on the number of threads.
+ *
+ * `optimize` runs FM, then the flow passes, then FM again if the flow
+ * passes improved the cut. `legalize` is the serial FM legalization. It
+ * has the same interface as `FMPartMgr`, so that it can be used as the
+ * `PartMgr` argument of `MLPartMgr::run_Partition`, which applies it on
+ * every level.
+ *
+ * @tparam Gnl
+ * @tparam GainMgr
+ * @tparam ConstrMgr
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+class FlowPartMgr {
+  public:
+    using GainCalc_ = typename GainMgr::GainCalc_;
+    using GainMgr_ = GainMgr;
+    using ConstrMgr_ = ConstrMgr;
+
+  protected:
+    /// @brief Reference to the hypergraph being partitioned
+    const Gnl& hyprgraph;
+    /// @brief Gain manager (used for FM and the legalization)
+    GainMgr& gain_mgr;
+    /// @brief Constraint manager for validating partition constraints
+    ConstrMgr& validator;
+    /// @brief Number of partitions
+    size_t num_parts;
+    /// @brief Maximum number of tasks (0 = the threads of the scheduler)
+    size_t num_threads{0U};
+    /// @brief Maximum number of passes over all block pairs
+    size_t max_passes{4U};
+    /// @brief Maximum number of modules in each side of a region
+    size_t max_region_modules{2000U};
+
+  public:
+    int total_cost{};
+
+    /**
+     * @brief Construct a new FlowPartMgr object
+     *
+     * @param[in] hyprgraph
+     * @param[in,out] gain_mgr
+     * @param[in,out] constr_mgr
+     * @param[in] num_parts
+     */
+    FlowPartMgr(const Gnl& hyprgraph, GainMgr& gain_mgr, ConstrMgr& constr_mgr, size_t num_parts)
+        : hyprgraph{hyprgraph}, gain_mgr{gain_mgr}, validator{constr_mgr}, num_parts{num_parts} {}
+
+    /**
+     * @brief Sets the number of worker threads.
+     *
+     * @param[in] num_threads The maximum number of tasks (0 = the threads of
+     * `TaskScheduler::current()`).
+     */
+    void set_num_threads(size_t num_threads) { this->num_threads = num_threads; }
+
+    /**
+     * @brief Sets the maximum number of passes over all block pairs.
+     *
+     * @param[in] max_passes The maximum number of passes.
+     */
+    void set_max_passes(size_t max_passes) { this->max_passes = max_passes; }
+
+    /**
+     * @brief Sets the maximum number of modules in each side of a region.
+     *
+     * @param[in] max_region_modules The maximum number of modules.
+     */
+    void set_max_region_modules(size_t max_region_modules) {
+        this->max_region_modules = max_region_modules;
+    }
+
+    /**
+     * @brief Legalizes the partition to satisfy balance constraints.
+     *
+     * @param[in,out] part The partition to legalize.
+     * @return LegalCheck The result of the legality check.
+     */
+    auto legalize(std::span<std::uint8_t> part) -> LegalCheck;
+
+    /**
+     * @brief Optimizes the partition by FM and flow-based refinement.
+     *
+     * @param[in,out] part The partition to optimize.
+     */
+    void optimize(std::span<std::uint8_t> part);
+
+  private:
+    /**
+     * @brief Runs the flow-based passes over all block pairs.
+     *
+     * @param[in,out] part The partition to refine.
+     * @return The reduction of the cost.
+     */
+    auto _refine_pairs(std::span<std::uint8_t> part) -> int;
+};
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <ckpttn/CsrNetlist.hpp>  // for CsrNetlist
 #include <ckpttn/array_like.hpp>  // for ShiftArray
 #include <cstdint>                // for uint8_t
 #include <netlistx/netlist.hpp>   // for Netlist, Netlist<>::nodeview_t
@@ -30,9 +31,20 @@
  * It maintains additional mappings and weights for hierarchical (coarsening) representations
  * of the netlist during the partitioning process.
  *
+ * A level contracted from nets maps its clusters down through `cluster_down_map`
+ * and its other modules through `node_down_map`. A level contracted from a
+ * labeling of the modules (see `create_clustered_subgraph`) leaves both empty,
+ * and the projections then go through `node_up_map` only.
+ *
+ * The parent level is a `Netlist<graph_t>` unless `parent_t` says otherwise,
+ * e.g. the `CsrNetlist` that the first level of `partition_csr` is
+ * contracted from.
+ *
  * @tparam graph_t The graph type (e.g., xnetwork::SimpleGraph)
+ * @tparam parent_t The type of the parent netlist
  */
-template <typename graph_t> class HierNetlist : public Netlist<graph_t> {
+template <typename graph_t, typename parent_t = Netlist<graph_t>>
+class HierNetlist : public Netlist<graph_t> {
   public:
     using nodeview_t = typename graph_t::nodeview_t;
     using node_t = typename graph_t::node_t;
@@ -40,7 +52,7 @@ template <typename graph_t> class HierNetlist : public Netlist<graph_t> {
 
     /* For multi-level algorithms */
     /// @brief Pointer to the parent netlist in the hierarchy
-    const Netlist<graph_t>* parent;
+    const parent_t* parent;
     /// @brief Mapping from this level's nodes to parent's nodes (upward)
     std::vector<node_t> node_up_map;
     /// @brief Mapping from this level's nodes to children's nodes (downward)
@@ -78,6 +90,15 @@ template <typename graph_t> class HierNetlist : public Netlist<graph_t> {
      */
     void projection_up(std::span<const std::uint8_t> part, std::span<std::uint8_t> part_up) const;
 
+    /**
+     * @brief Projects labels that no cluster crosses up to a higher level.
+     *
+     * @param[in] label The labels at the lower level (the same within every cluster).
+     * @param[out] label_up The projected labels at the higher level.
+     */
+    void projection_up(std::span<const std::uint32_t> label,
+                       std::span<std::uint32_t> label_up) const;
+
     /**
      * @brief Returns the weight of the specified net.
      *
@@ -99,8 +120,9 @@ template <typename graph_t> class HierNetlist : public Netlist<graph_t> {
  * @param[in] modules The nodeview of modules for the HierNetlist.
  * @param[in] nets The nodeview of nets for the HierNetlist.
  */
-template <typename graph_t>
-HierNetlist<graph_t>::HierNetlist(graph_t gr, const nodeview_t& modules, const nodeview_t& nets)
+template <typename graph_t, typename parent_t>
+HierNetlist<graph_t, parent_t>::HierNetlist(graph_t gr, const nodeview_t& modules,
+                                            const nodeview_t& nets)
     : Netlist<graph_t>{std::move(gr), modules, nets} {}
 
 // template <typename graph_t>
@@ -112,3 +134,4 @@ HierNetlist<graph_t>::HierNetlist(graph_t gr, const nodeview_t& modules, const n
 // }
 
 using SimpleHierNetlist = HierNetlist<xnetwork::SimpleGraph>;
+using CsrHierNetlist = HierNetlist<xnetwork::SimpleGraph, CsrNetlist>;
@@ -0,0 +1,133 @@
+/**
+ * @file IncrementalPartMgr.hpp
+ * @brief Incremental repartitioning after an engineering change (ECO)
+ */
+
+#pragma once
+
+#include <cstdint>               // for uint8_t, uint32_t
+#include <netlistx/netlist.hpp>  // for SimpleNetlist
+#include <span>                  // for span
+#include <utility>               // for pair
+#include <vector>                // for vector
+
+enum class LegalCheck;
+
+/**
+ * @brief Changes of a netlist
+ *
+ * The modules are numbered as in the previous netlist, and the added modules
+ * follow them: added module `i` is module `num_modules + i`. Likewise, net
+ * `j` is the j-th net of the previous netlist (node `num_modules + j`) and
+ * the added nets follow the previous ones.
+ */
+struct NetlistDelta {
+    /// @brief Number of added modules
+    std::uint32_t num_added_modules{0U};
+    /// @brief Weights of the added modules (empty = unit weights)
+    std::vector<unsigned int> added_module_weight;
+    /// @brief Removed modules (with all their pins)
+    std::vector<std::uint32_t> removed_modules;
+    /// @brief Removed nets
+    std::vector<std::uint32_t> removed_nets;
+    /// @brief Pins of the added nets
+    std::vector<std::vector<std::uint32_t>> added_nets;
+    /// @brief Added pins, as (net, module)
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> added_pins;
+    /// @brief Removed pins, as (net, module)
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> removed_pins;
+};
+
+/**
+ * @brief A netlist with a delta applied
+ */
+struct PatchedNetlist {
+    /// @brief Marks a removed module in `module_map`
+    static constexpr std::uint32_t REMOVED = ~std::uint32_t{0U};
+
+    /// @brief The new netlist: the remaining modules and nets in their
+    /// previous order, then the added ones
+    SimpleNetlist netlist;
+    /// @brief The new module of every module of the delta numbering (or `REMOVED`)
+    std::vector<std::uint32_t> module_map;
+    /// @brief The new modules touched by the delta (sorted)
+    std::vector<std::uint32_t> affected;
+};
+
+/**
+ * @brief Applies a delta to a netlist.
+ *
+ * The weights and the fixed modules of the remaining modules are kept.
+ *
+ * @param[in] hyprgraph The previous netlist
+ * @param[in] delta The changes
+ * @return The new netlist
+ * @throw std::invalid_argument if the delta refers to a module or net that
+ * does not exist
+ */
+auto apply_netlist_delta(const SimpleNetlist& hyprgraph, const NetlistDelta& delta)
+    -> PatchedNetlist;
+
+/**
+ * @brief Incremental Partition Manager
+ *
+ * Repartitions a netlist after a small change without starting over. The
+ * previous partition is carried over to the new netlist and every added
+ * module joins the part most of its neighbors are in. Then, if the result
+ * is legal, only the neighborhood of the change is refined, by boundary FM
+ * searches (`LocalFMPartMgr`) confined to the affected modules, so that the
+ * gains are computed only there.
+ *
+ * If the cost ends up more than `max_degradation` above the previous one
+ * (e.g. because the change added many cut nets), or if the carried-over
+ * partition is not legal, the multilevel partitioner is run on the whole
+ * netlist instead, starting from the incremental result.
+ */
+class IncrementalPartMgr {
+  private:
+    /// @brief Balance tolerance for partition constraints
+    double bal_tol;
+    /// @brief Number of partitions
+    std::uint8_t num_parts;
+    /// @brief Relative cost increase beyond which a full run is made
+    double max_degradation{0.05};
+
+  public:
+    /// @brief Cost of the partition before the change
+    int previous_cost{};
+    /// @brief Total cost of the current partitioning solution
+    int total_cost{};
+    /// @brief Whether the last run fell back to a full multilevel run
+    bool full_run{false};
+
+    /**
+     * @brief Constructs a new IncrementalPartMgr object.
+     *
+     * @param[in] bal_tol The balance tolerance.
+     * @param[in] num_parts The number of partitions.
+     */
+    IncrementalPartMgr(double bal_tol, std::uint8_t num_parts)
+        : bal_tol{bal_tol}, num_parts{num_parts} {}
+
+    /**
+     * @brief Sets the cost increase that triggers a full run.
+     *
+     * @param[in] ratio The relative increase over the previous cost (0.05 = 5%).
+     */
+    void set_max_degradation(double ratio) { this->max_degradation = ratio; }
+
+    /**
+     * @brief Repartitions a netlist after a change.
+     *
+     * @tparam PartMgr The part manager of the full multilevel run (its gain
+     * and constraint managers are also used by the local refinement).
+     * @param[in] hyprgraph The previous netlist.
+     * @param[in] prev_part The partition of the previous netlist.
+     * @param[in] patched The new netlist (see `apply_netlist_delta`).
+     * @param[out] part The partition of the new netlist.
+     * @return LegalCheck The legality check result of the partitioning.
+     */
+    template <typename PartMgr>
+    auto run_Partition(const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> prev_part,
+                       const PatchedNetlist& patched, std::span<std::uint8_t> part) -> LegalCheck;
+};
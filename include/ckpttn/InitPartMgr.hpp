@@ -0,0 +1,84 @@
+/**
+ * @file InitPartMgr.hpp
+ * @brief Portfolio initial partition manager for the coarsest level
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t
+#include <span>     // for span
+
+enum class LegalCheck;
+
+/**
+ * @brief Portfolio Initial Partition Manager
+ *
+ * The `InitPartMgr` class computes an initial partition of a small (coarsest)
+ * hypergraph by running a portfolio of heuristics in parallel and keeping the
+ * best legal result. Every member of the portfolio is refined by the given
+ * partition manager before the results are compared:
+ *
+ * - the partition given by the caller (e.g. projected from a finer level),
+ * - random assignments,
+ * - BFS hypergraph growing,
+ * - greedy hypergraph growing,
+ * - label propagation,
+ * - the exhaustive `MidLvlPartMgr` when the instance is small enough.
+ *
+ * Fixed modules keep the part given by the caller in every member.
+ */
+class InitPartMgr {
+  private:
+    /// @brief Balance tolerance for partition constraints
+    double bal_tol;
+    /// @brief Number of partitions
+    std::uint8_t num_parts;
+    /// @brief Maximum number of concurrent members (0 = the threads of the scheduler)
+    size_t num_threads{0U};
+    /// @brief Number of random members in the portfolio
+    size_t num_random{2U};
+    /// @brief Maximum number of modules for the exhaustive member
+    size_t exact_limit{20U};
+    /// @brief Seed for the randomized members
+    std::uint32_t seed{1U};
+
+  public:
+    /// @brief Total cost of the best partitioning found
+    int total_cost{};
+
+    /**
+     * @brief Constructs a new InitPartMgr object.
+     *
+     * @param[in] bal_tol The balance tolerance for the partitioning.
+     * @param[in] num_parts The number of partitions to create.
+     */
+    InitPartMgr(double bal_tol, std::uint8_t num_parts) : bal_tol{bal_tol}, num_parts{num_parts} {}
+
+    /**
+     * @brief Sets the number of worker threads.
+     *
+     * @param[in] num_threads The maximum number of members run concurrently on
+     * `TaskScheduler::current()` (0 = the threads of the scheduler).
+     */
+    void set_num_threads(size_t num_threads) { this->num_threads = num_threads; }
+
+    /**
+     * @brief Sets the seed of the randomized portfolio members.
+     *
+     * @param[in] seed The random seed.
+     */
+    void set_seed(std::uint32_t seed) { this->seed = seed; }
+
+    /**
+     * @brief Runs the portfolio and stores the best legal partition in `part`.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam PartMgr The type of the partition manager used for refinement.
+     * @param[in] hyprgraph The input hypergraph to partition.
+     * @param[in,out] part The partition vector; its content is also a portfolio member.
+     * @return LegalCheck The legality check result of the chosen partition.
+     */
+    template <typename Gnl, typename PartMgr>
+    auto run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+};
@@ -0,0 +1,108 @@
+/**
+ * @file LPPartMgr.hpp
+ * @brief Parallel label propagation partitioning manager
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t
+#include <span>     // for span
+
+enum class LegalCheck;
+
+/**
+ * @brief Parallel Label Propagation Partition Manager
+ *
+ * `LPPartMgr` refines a partition by parallel label propagation instead of
+ * the serial gain buckets of `PartMgrBase` and `NNPartMgr`. In every round the
+ * modules are split into contiguous blocks, one per thread, and every module
+ * moves to the part with the largest positive gain:
+ *
+ * - gains are computed from per-net pin counts (one atomic counter per net
+ *   and part), with the same (K-1) connectivity cost as the FM gain
+ *   calculators, ignoring nets larger than `FM_MAX_DEGREE`;
+ * - a move is only applied if the atomic weight counter of the source part
+ *   stays at or above the lower bound of the constraint manager;
+ * - a round that does not reduce the cost is reverted and ends the
+ *   refinement, so the result is never worse than the input.
+ *
+ * Since the modules of a round are moved concurrently, gains may be based
+ * on slightly stale pin counts; the exact cost is recomputed after each
+ * round. In deterministic mode (see `TaskScheduler::set_deterministic`)
+ * the moves are instead proposed in parallel and applied in module order, so
+ * that the result does not depend on the number of threads. `legalize` is
+ * the serial FM legalization.
+ *
+ * It has the same interface as `FMPartMgr`, so that it can be used as the
+ * `PartMgr` argument of `MLPartMgr::run_Partition`.
+ *
+ * @tparam Gnl
+ * @tparam GainMgr
+ * @tparam ConstrMgr
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+class LPPartMgr {
+  public:
+    using GainCalc_ = typename GainMgr::GainCalc_;
+    using GainMgr_ = GainMgr;
+    using ConstrMgr_ = ConstrMgr;
+
+  protected:
+    /// @brief Reference to the hypergraph being partitioned
+    const Gnl& hyprgraph;
+    /// @brief Gain manager (used for the legalization)
+    GainMgr& gain_mgr;
+    /// @brief Constraint manager for validating partition constraints
+    ConstrMgr& validator;
+    /// @brief Number of partitions
+    size_t num_parts;
+    /// @brief Maximum number of tasks (0 = the threads of the scheduler)
+    size_t num_threads{0U};
+    /// @brief Maximum number of label propagation rounds
+    size_t max_rounds{32U};
+
+  public:
+    int total_cost{};
+
+    /**
+     * @brief Construct a new LPPartMgr object
+     *
+     * @param[in] hyprgraph
+     * @param[in,out] gain_mgr
+     * @param[in,out] constr_mgr
+     * @param[in] num_parts
+     */
+    LPPartMgr(const Gnl& hyprgraph, GainMgr& gain_mgr, ConstrMgr& constr_mgr, size_t num_parts)
+        : hyprgraph{hyprgraph}, gain_mgr{gain_mgr}, validator{constr_mgr}, num_parts{num_parts} {}
+
+    /**
+     * @brief Sets the number of worker threads.
+     *
+     * @param[in] num_threads The maximum number of tasks (0 = the threads of
+     * `TaskScheduler::current()`).
+     */
+    void set_num_threads(size_t num_threads) { this->num_threads = num_threads; }
+
+    /**
+     * @brief Sets the maximum number of label propagation rounds.
+     *
+     * @param[in] max_rounds The maximum number of rounds.
+     */
+    void set_max_rounds(size_t max_rounds) { this->max_rounds = max_rounds; }
+
+    /**
+     * @brief Legalizes the partition to satisfy balance constraints.
+     *
+     * @param[in,out] part The partition to legalize.
+     * @return LegalCheck The result of the legality check.
+     */
+    auto legalize(std::span<std::uint8_t> part) -> LegalCheck;
+
+    /**
+     * @brief Optimizes the partition by parallel label propagation.
+     *
+     * @param[in,out] part The partition to optimize.
+     */
+    void optimize(std::span<std::uint8_t> part);
+};
@@ -0,0 +1,135 @@
+/**
+ * @file LocalFMPartMgr.hpp
+ * @brief Localized parallel multi-try FM partitioning manager
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t
+#include <span>     // for span
+#include <vector>   // for vector
+
+enum class LegalCheck;
+
+/**
+ * @brief Localized Parallel Multi-try FM Partition Manager
+ *
+ * `PartMgrBase` runs one global FM pass over a single set of gain buckets.
+ * `LocalFMPartMgr` instead runs many small FM searches concurrently on a
+ * shared partition (held in a `ConnectivityInfo`):
+ *
+ * - every search starts from a few unclaimed boundary modules and grows
+ *   around them with its own small gain queue, claiming each module it
+ *   inserts, so that a module is moved by at most one search per round;
+ * - moves are applied to the shared partition at once, gated by the atomic
+ *   weight counter of the source part, so that concurrent searches see each
+ *   other's moves;
+ * - each search keeps only its best prefix of moves and reverts the rest.
+ *
+ * Since the searches interfere, the gains they observed may be wrong. At the
+ * end of a round all applied moves are replayed serially in the order they
+ * were made, with exact gains, and only the best legal prefix of that global
+ * sequence is kept. Rounds repeat until one brings no improvement.
+ *
+ * A region (see `set_region`) restricts the searches to some modules, e.g.
+ * the neighborhood of an engineering change, so that the gains are only
+ * computed there and no other module moves.
+ *
+ * In deterministic mode (see `TaskScheduler::set_deterministic`) the local
+ * searches run one after the other, in seed order, so that the result does
+ * not depend on the number of threads; the other steps stay parallel.
+ *
+ * It has the same interface as `FMPartMgr`, so that it can be used as the
+ * `PartMgr` argument of `MLPartMgr::run_Partition`.
+ *
+ * @tparam Gnl
+ * @tparam GainMgr
+ * @tparam ConstrMgr
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+class LocalFMPartMgr {
+  public:
+    using GainCalc_ = typename GainMgr::GainCalc_;
+    using GainMgr_ = GainMgr;
+    using ConstrMgr_ = ConstrMgr;
+
+    using node_t = typename Gnl::node_t;
+
+  protected:
+    /// @brief Reference to the hypergraph being partitioned
+    const Gnl& hyprgraph;
+    /// @brief Gain manager (used for the legalization)
+    GainMgr& gain_mgr;
+    /// @brief Constraint manager for validating partition constraints
+    ConstrMgr& validator;
+    /// @brief Number of partitions
+    size_t num_parts;
+    /// @brief Maximum number of tasks (0 = the threads of the scheduler)
+    size_t num_threads{0U};
+    /// @brief Maximum number of rounds
+    size_t max_rounds{8U};
+    /// @brief Number of seed modules of each local search
+    size_t num_seeds{4U};
+    /// @brief Number of moves without improvement that stop a local search
+    size_t max_fruitless_moves{25U};
+    /// @brief Modules the searches may move (empty = all modules)
+    std::vector<node_t> region;
+
+  public:
+    int total_cost{};
+
+    /**
+     * @brief Construct a new LocalFMPartMgr object
+     *
+     * @param[in] hyprgraph
+     * @param[in,out] gain_mgr
+     * @param[in,out] constr_mgr
+     * @param[in] num_parts
+     */
+    LocalFMPartMgr(const Gnl& hyprgraph, GainMgr& gain_mgr, ConstrMgr& constr_mgr,
+                   size_t num_parts)
+        : hyprgraph{hyprgraph}, gain_mgr{gain_mgr}, validator{constr_mgr}, num_parts{num_parts} {}
+
+    /**
+     * @brief Sets the number of worker threads.
+     *
+     * @param[in] num_threads The maximum number of tasks (0 = the threads of
+     * `TaskScheduler::current()`).
+     */
+    void set_num_threads(size_t num_threads) { this->num_threads = num_threads; }
+
+    /**
+     * @brief Sets the maximum number of rounds.
+     *
+     * @param[in] max_rounds The maximum number of rounds.
+     */
+    void set_max_rounds(size_t max_rounds) { this->max_rounds = max_rounds; }
+
+    /**
+     * @brief Restricts the local searches to a region.
+     *
+     * Only the boundary modules of the region seed the searches, and only
+     * the modules of the region are moved.
+     *
+     * @param[in] modules The modules of the region (empty = all modules).
+     */
+    void set_region(std::span<const node_t> modules) {
+        this->region.assign(modules.begin(), modules.end());
+    }
+
+    /**
+     * @brief Legalizes the partition to satisfy balance constraints.
+     *
+     * @param[in,out] part The partition to legalize.
+     * @return LegalCheck The result of the legality check.
+     */
+    auto legalize(std::span<std::uint8_t> part) -> LegalCheck;
+
+    /**
+     * @brief Optimizes the partition by localized parallel FM searches.
+     *
+     * @param[in,out] part The partition to optimize.
+     */
+    void optimize(std::span<std::uint8_t> part);
+};
@@ -8,12 +8,16 @@
 // **Special code for two-pin nets**
 // Take a snapshot when a move make **negative** gain.
 // Snapshot in the form of "interface"???
-// #include "FMPartMgr.hpp" // import FMPartMgr
+// #include "FMPartMgr.hpp"  // import FMPartMgr
 // #include <netlistx/netlist.hpp>
-// #include <memory>  // std::unique_ptr
-#include <span>  // for span
+// #include <memory>                     // std::unique_ptr
+#include <ckpttn/CoarseningCtrl.hpp>  // for CoarseningCtrl, CoarseningLevel
+#include <ckpttn/FMGainScratch.hpp>   // for FMGainScratch
+#include <netlistx/netlist.hpp>       // for SimpleNetlist
+#include <span>                       // for span
+#include <vector>                     // for vector
 // #include <py2cpp/range.hpp>  // for range
-// #include <ckpttn/FMConstrMgr.hpp>   // import LegalCheck
+// #include <ckpttn/FMConstrMgr.hpp>  // import LegalCheck
 
 // forward declare
 // template <typename nodeview_t, typename nodemap_t> struct Netlist;
@@ -26,6 +30,7 @@
 //     -> std::unique_ptr<SimpleHierNetlist>;
 
 enum class LegalCheck;
+class TaskScheduler;
 
 /**
  * @brief Multilevel Partition Manager
@@ -37,8 +42,18 @@ class MLPartMgr {
     double bal_tol;
     /// @brief Number of partitions
     std::uint8_t num_parts;
-    /// @brief Size limit for transitioning from multi-level to flat FM
-    size_t limitsize{50U};
+    /// @brief Controls when and how the hypergraph is coarsened
+    CoarseningCtrl coarsening;
+    /// @brief Number of extra V-cycles run after the initial multilevel pass
+    size_t num_vcycles{0U};
+    /// @brief Time budget in seconds for the V-cycles (0 = unlimited)
+    double time_limit{0.0};
+    /// @brief Whether to run the initial partitioning portfolio at the coarsest level
+    bool init_portfolio{true};
+    /// @brief Scheduler for the parallel steps (null = `TaskScheduler::current()`)
+    TaskScheduler* scheduler{nullptr};
+    /// @brief Buffers shared by the gain managers of the levels (null = none)
+    FMGainScratch<SimpleNetlist::node_t>* gain_scratch{nullptr};
 
   public:
     /// @brief Total cost of the current partitioning solution
@@ -59,14 +74,90 @@ class MLPartMgr {
      * @param[in] bal_tol The balance tolerance for the partitioning.
      * @param[in] num_parts The number of partitions to create.
      */
-    MLPartMgr(double bal_tol, std::uint8_t num_parts) : bal_tol{bal_tol}, num_parts{num_parts} {}
+    MLPartMgr(double bal_tol, std::uint8_t num_parts)
+        : bal_tol{bal_tol}, num_parts{num_parts}, coarsening{bal_tol, num_parts} {}
 
     /**
      * @brief Sets the limit size for the partitioning.
      *
-     * @param[in] limit The new limit size for the partitioning.
+     * By default the limit is proportional to the number of partitions (see
+     * `CoarseningCtrl`).
+     *
+     * @param[in] limit The new limit size for the partitioning (0 = default).
+     */
+    void set_limitsize(size_t limit) { this->coarsening.set_limitsize(limit); }
+
+    /**
+     * @brief Returns the coarsening controller, e.g. to tune its parameters.
+     *
+     * @return CoarseningCtrl& The coarsening controller.
+     */
+    auto get_coarsening() -> CoarseningCtrl& { return this->coarsening; }
+
+    /**
+     * @brief Returns the statistics of the last coarsening hierarchy.
+     *
+     * @return The levels, from the finest to the coarsest.
+     */
+    auto get_coarsening_levels() const -> const std::vector<CoarseningLevel>& {
+        return this->coarsening.get_levels();
+    }
+
+    /**
+     * @brief Sets the number of iterated V-cycles.
+     *
+     * Each V-cycle re-coarsens the hypergraph without contracting any cut
+     * net, so that the current solution survives the contraction, and then
+     * refines it again level by level. A cycle that does not improve the
+     * cost is reverted and stops the iteration.
+     *
+     * @param[in] num_vcycles The maximum number of V-cycles (0 = disabled).
      */
-    void set_limitsize(size_t limit) { this->limitsize = limit; }
+    void set_num_vcycles(size_t num_vcycles) { this->num_vcycles = num_vcycles; }
+
+    /**
+     * @brief Sets the time budget for the iterated V-cycles.
+     *
+     * @param[in] seconds The time budget in seconds (0 = unlimited).
+     */
+    void set_time_limit(double seconds) { this->time_limit = seconds; }
+
+    /**
+     * @brief Enables or disables the initial partitioning portfolio.
+     *
+     * When enabled, the coarsest level is partitioned by `InitPartMgr`,
+     * which runs several heuristics in parallel and keeps the best legal
+     * result, instead of only refining the partition projected from above.
+     *
+     * @param[in] enable Whether to use the portfolio.
+     */
+    void set_init_portfolio(bool enable) { this->init_portfolio = enable; }
+
+    /**
+     * @brief Sets the scheduler of the parallel steps.
+     *
+     * The coarsening, the gain initialization, the projections and the
+     * parallel refiners of `run_Partition` run on this scheduler. By default
+     * they run on `TaskScheduler::current()`, i.e. on the process-wide
+     * scheduler unless the caller installed another one.
+     *
+     * @param[in] scheduler The scheduler (null = default).
+     */
+    void set_scheduler(TaskScheduler* scheduler) { this->scheduler = scheduler; }
+
+    /**
+     * @brief Sets buffers for the gain managers of the levels.
+     *
+     * The gain managers of `run_Partition` are built one at a time, so they
+     * can all reuse the same buffers, which then only grow for a hypergraph
+     * larger than every one seen before (see `FMGainScratch`). The scratch
+     * must not be shared with another partitioner running at the same time.
+     *
+     * @param[in] scratch The buffers (null = each gain manager has its own).
+     */
+    void set_gain_scratch(FMGainScratch<SimpleNetlist::node_t>* scratch) {
+        this->gain_scratch = scratch;
+    }
 
     /**
      * @brief Runs the Fiduccia-Mattheyses (FM) partitioning algorithm on the given hypergraph.
@@ -79,4 +170,48 @@ class MLPartMgr {
      */
     template <typename Gnl, typename PartMgr>
     auto run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+    /**
+     * @brief Recombines two legal partitions into a child (memetic crossover).
+     *
+     * Runs one V-cycle from `part` whose contraction crosses neither the
+     * cut of `part` nor the cut of `other`, so that both parents are exact
+     * at every coarse level and the refinement can move whole blocks of
+     * `other`. The child, stored in `part`, is never worse than `part`.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam PartMgr The type of the partition manager.
+     * @param[in] hyprgraph The input hypergraph to partition.
+     * @param[in,out] part The first (better) parent, replaced by the child.
+     * @param[in] other The second parent.
+     */
+    template <typename Gnl, typename PartMgr>
+    auto run_Recombine(const Gnl& hyprgraph, std::span<std::uint8_t> part,
+                       std::span<const std::uint8_t> other) -> void;
+
+  private:
+    /**
+     * @brief Runs one multilevel pass (legalize, coarsen, recurse, refine).
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam PartMgr The type of the partition manager.
+     * @param[in] hyprgraph The input hypergraph to partition.
+     * @param[in,out] part The partition vector to store the partitioning results.
+     * @return LegalCheck The legality check result of the partitioning.
+     */
+    template <typename Gnl, typename PartMgr>
+    auto _run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+    /**
+     * @brief Runs one V-cycle starting from a legal partition.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam PartMgr The type of the partition manager.
+     * @param[in] hyprgraph The input hypergraph to partition.
+     * @param[in,out] part The partition vector, refined in place.
+     * @param[in] keep Labels whose cut no contraction may cross (a refinement of `part`).
+     */
+    template <typename Gnl, typename PartMgr>
+    auto _run_VCycle(const Gnl& hyprgraph, std::span<std::uint8_t> part,
+                     std::span<const std::uint32_t> keep) -> void;
 };
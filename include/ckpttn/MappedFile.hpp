@@ -0,0 +1,47 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Read-only view of a whole file
+ */
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+/**
+ * @brief A read-only view of a whole file
+ *
+ * The file is memory-mapped on POSIX systems and read into a buffer
+ * elsewhere.
+ */
+class MappedFile {
+  public:
+    /**
+     * @brief Opens a file.
+     *
+     * @param[in] filename The file name
+     * @throw std::runtime_error if the file cannot be read
+     */
+    explicit MappedFile(const std::string& filename);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    /**
+     * @brief Returns the contents of the file.
+     *
+     * @return std::string_view
+     */
+    auto view() const -> std::string_view;
+
+  private:
+    size_t size{};
+#if defined(__unix__) || defined(__APPLE__)
+    void* mapped{};
+#else
+    std::string buffer;
+#endif
+};
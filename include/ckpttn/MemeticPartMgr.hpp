@@ -0,0 +1,129 @@
+/**
+ * @file MemeticPartMgr.hpp
+ * @brief Memetic (evolutionary) multilevel partition manager
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t, uint32_t
+#include <span>     // for span
+
+enum class LegalCheck;
+
+/**
+ * @brief Memetic Partition Manager
+ *
+ * Instead of keeping only the best of several independent multilevel runs,
+ * `MemeticPartMgr` evolves a population of partitions:
+ *
+ * - the initial population is the partition given by the caller and random
+ *   partitions, each refined by `MLPartMgr`;
+ * - a child is either the recombination of two parents chosen by tournament
+ *   (`MLPartMgr::run_Recombine`: a V-cycle whose contraction crosses neither
+ *   parent's cut), or a mutation of one parent (a random perturbation of a
+ *   few modules followed by a multilevel pass);
+ * - a child replaces the worst member of the population if it is better and
+ *   not already in the population.
+ *
+ * Every generation creates `population_size` children as tasks on
+ * `TaskScheduler::current()`. The evolution runs until the time budget or the
+ * number of generations is exhausted. Apart from the time budget, the result
+ * only depends on the seed, not on the number of threads.
+ */
+class MemeticPartMgr {
+  private:
+    /// @brief Balance tolerance for partition constraints
+    double bal_tol;
+    /// @brief Number of partitions
+    std::uint8_t num_parts;
+    /// @brief Number of partitions in the population
+    size_t population_size{8U};
+    /// @brief Maximum number of generations (0 = limited by the time budget only)
+    size_t num_generations{8U};
+    /// @brief Time budget in seconds (0 = unlimited)
+    double time_limit{0.0};
+    /// @brief Number of V-cycles of every multilevel pass
+    size_t num_vcycles{0U};
+    /// @brief Fraction of the free modules moved at random by a mutation
+    double mutation_rate{0.05};
+    /// @brief Seed of the random choices
+    std::uint32_t seed{1U};
+
+  public:
+    /// @brief Total cost of the best partitioning found
+    int total_cost{};
+    /// @brief Number of generations run by the last `run_Partition`
+    size_t num_generations_run{};
+
+    /**
+     * @brief Constructs a new MemeticPartMgr object.
+     *
+     * @param[in] bal_tol The balance tolerance for the partitioning.
+     * @param[in] num_parts The number of partitions to create.
+     */
+    MemeticPartMgr(double bal_tol, std::uint8_t num_parts)
+        : bal_tol{bal_tol}, num_parts{num_parts} {}
+
+    /**
+     * @brief Sets the number of partitions in the population.
+     *
+     * @param[in] population_size The population size (at least 1).
+     */
+    void set_population_size(size_t population_size) {
+        this->population_size = population_size != 0U ? population_size : 1U;
+    }
+
+    /**
+     * @brief Sets the maximum number of generations.
+     *
+     * @param[in] num_generations The number of generations (0 = limited by the
+     * time budget only; no generation is run without a time budget).
+     */
+    void set_num_generations(size_t num_generations) { this->num_generations = num_generations; }
+
+    /**
+     * @brief Sets the time budget of the evolution.
+     *
+     * The budget is checked between generations; the initial population is
+     * always completed.
+     *
+     * @param[in] seconds The time budget in seconds (0 = unlimited).
+     */
+    void set_time_limit(double seconds) { this->time_limit = seconds; }
+
+    /**
+     * @brief Sets the number of V-cycles of every multilevel pass.
+     *
+     * @param[in] num_vcycles The number of V-cycles (0 = disabled).
+     */
+    void set_num_vcycles(size_t num_vcycles) { this->num_vcycles = num_vcycles; }
+
+    /**
+     * @brief Sets the fraction of the free modules moved by a mutation.
+     *
+     * @param[in] rate The mutation rate, in [0, 1].
+     */
+    void set_mutation_rate(double rate) { this->mutation_rate = rate; }
+
+    /**
+     * @brief Sets the seed of the random choices.
+     *
+     * @param[in] seed The random seed.
+     */
+    void set_seed(std::uint32_t seed) { this->seed = seed; }
+
+    /**
+     * @brief Evolves the population and stores the best partition in `part`.
+     *
+     * Fixed modules keep the part given in `part` in every member.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam PartMgr The type of the partition manager used for refinement.
+     * @param[in] hyprgraph The input hypergraph to partition.
+     * @param[in,out] part The partition vector; its content is the first member.
+     * @return LegalCheck The legality check result of the best partition.
+     */
+    template <typename Gnl, typename PartMgr>
+    auto run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+};
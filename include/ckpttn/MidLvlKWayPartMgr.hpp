@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <netlistx/netlist.hpp>
 #include <span>
@@ -16,6 +17,15 @@
  * for small hypergraphs with arbitrary number of partitions (k-way).
  * It iterates over partition pairs and uses the middle-levels Gray code
  * algorithm to find optimal partitioning for small instances.
+ *
+ * The pairs are scheduled as a round-robin tournament (`round_robin_rounds`),
+ * so that the pairs of a round share no block and are solved concurrently
+ * on `TaskScheduler::current()` (4 pairs at a time for K = 8). Each pair is
+ * first extracted into a small hypergraph of its own: its modules and, for
+ * each of their nets, the pin counts in the two blocks. The pins in other
+ * blocks cannot move during the round, so the (K-1) cost delta of a flip
+ * only depends on these counts, and the deltas of the pairs of a round add
+ * up exactly. The result does not depend on the number of threads.
  */
 class MidLvlKWayPartMgr {
   public:
@@ -38,12 +48,22 @@ class MidLvlKWayPartMgr {
      */
     void optimize(std::span<std::uint8_t> part, const SimpleNetlist& hyprgraph);
 
+    /**
+     * @brief Sets the number of worker threads
+     *
+     * @param[in] num_threads The maximum number of tasks (0 = the threads of
+     * `TaskScheduler::current()`)
+     */
+    void set_num_threads(size_t num_threads) { this->num_threads_ = num_threads; }
+
   private:
     /// @brief Balance tolerance for partition constraints
     double bal_tol_;
     /// @brief Number of partitions
     std::uint8_t num_parts_;
-    /// @brief Maximum number of FM passes to perform
+    /// @brief Maximum number of tasks (0 = the threads of the scheduler)
+    size_t num_threads_{0U};
+    /// @brief Maximum number of passes over all partition pairs
     static constexpr int max_passes = 5;
     /// @brief Maximum number of modules for pair-wise exhaustive search
     static constexpr size_t max_pair_modules = 15;
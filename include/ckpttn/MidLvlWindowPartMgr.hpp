@@ -0,0 +1,149 @@
+/**
+ * @file MidLvlWindowPartMgr.hpp
+ * @brief Exact refinement of small windows around the cut (middle-levels Gray code)
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t
+#include <span>     // for span
+
+enum class LegalCheck;
+
+/**
+ * @brief Mid-Level Window Partition Manager
+ *
+ * `MidLvlKWayPartMgr` only enumerates two whole blocks, which is hopeless
+ * beyond a handful of modules. `MidLvlWindowPartMgr` instead applies the
+ * middle-levels Gray code (`MidHamCycle`) to small windows around the cut:
+ *
+ * - a window is grown by BFS from a boundary module over small nets, within
+ *   the block of the seed and one neighboring block, and trimmed so that
+ *   the two sides differ by at most one module;
+ * - the rest of the hypergraph is contracted into fixed terminals: each net
+ *   of the window only keeps its pin counts in the two blocks;
+ * - the Gray code visits every assignment of the window whose side sizes
+ *   stay close to each other (every balanced swap of modules, plus up to
+ *   `window_slack` extra modules moving one way), one module flip per step,
+ *   so the cut delta is updated in O(degree) per step; the best legal
+ *   assignment is applied.
+ *
+ * Windows share neither modules nor nets, so they are solved concurrently
+ * on `TaskScheduler::current()` and their improvements add up exactly. The
+ * weight slack of each block is split evenly among the windows touching it,
+ * so that the result stays legal. Windows are built serially in module
+ * order, so the result does not depend on the number of threads.
+ *
+ * `optimize` runs FM, then the window passes, then FM again if the window
+ * passes improved the cut. `legalize` is the serial FM legalization. It has
+ * the same interface as `FMPartMgr`, so that it can be used as the
+ * `PartMgr` argument of `MLPartMgr::run_Partition`.
+ *
+ * @tparam Gnl
+ * @tparam GainMgr
+ * @tparam ConstrMgr
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+class MidLvlWindowPartMgr {
+  public:
+    using GainCalc_ = typename GainMgr::GainCalc_;
+    using GainMgr_ = GainMgr;
+    using ConstrMgr_ = ConstrMgr;
+
+  protected:
+    /// @brief Reference to the hypergraph being partitioned
+    const Gnl& hyprgraph;
+    /// @brief Gain manager (used for FM and the legalization)
+    GainMgr& gain_mgr;
+    /// @brief Constraint manager for validating partition constraints
+    ConstrMgr& validator;
+    /// @brief Number of partitions
+    size_t num_parts;
+    /// @brief Maximum number of tasks (0 = the threads of the scheduler)
+    size_t num_threads{0U};
+    /// @brief Maximum number of passes over the boundary
+    size_t max_passes{2U};
+    /// @brief Maximum number of modules of a window
+    size_t max_window_modules{16U};
+    /// @brief Number of pairs of padding bits of the Gray code
+    size_t window_slack{1U};
+
+  public:
+    int total_cost{};
+
+    /**
+     * @brief Construct a new MidLvlWindowPartMgr object
+     *
+     * @param[in] hyprgraph
+     * @param[in,out] gain_mgr
+     * @param[in,out] constr_mgr
+     * @param[in] num_parts
+     */
+    MidLvlWindowPartMgr(const Gnl& hyprgraph, GainMgr& gain_mgr, ConstrMgr& constr_mgr,
+                        size_t num_parts)
+        : hyprgraph{hyprgraph}, gain_mgr{gain_mgr}, validator{constr_mgr}, num_parts{num_parts} {}
+
+    /**
+     * @brief Sets the number of worker threads.
+     *
+     * @param[in] num_threads The maximum number of tasks (0 = the threads of
+     * `TaskScheduler::current()`).
+     */
+    void set_num_threads(size_t num_threads) { this->num_threads = num_threads; }
+
+    /**
+     * @brief Sets the maximum number of passes over the boundary.
+     *
+     * @param[in] max_passes The maximum number of passes.
+     */
+    void set_max_passes(size_t max_passes) { this->max_passes = max_passes; }
+
+    /**
+     * @brief Sets the maximum number of modules of a window.
+     *
+     * With the padding bits, a window is a bitstring of odd length
+     * `2n + 1`, whose Gray code has `2 * C(2n + 1, n)` steps: with the
+     * default slack, about 2e5 for 16 modules and 3e6 for 20.
+     *
+     * @param[in] max_window_modules The maximum number of modules (at least 2).
+     */
+    void set_max_window_modules(size_t max_window_modules) {
+        this->max_window_modules = max_window_modules < 2U ? 2U : max_window_modules;
+    }
+
+    /**
+     * @brief Sets the slack of the window sizes.
+     *
+     * With slack 0, only the assignments whose sides stay within one module
+     * of each other are visited; each unit of slack lets one more module
+     * move from one side to the other, at the cost of two more bits.
+     *
+     * @param[in] window_slack The number of pairs of padding bits.
+     */
+    void set_window_slack(size_t window_slack) { this->window_slack = window_slack; }
+
+    /**
+     * @brief Legalizes the partition to satisfy balance constraints.
+     *
+     * @param[in,out] part The partition to legalize.
+     * @return LegalCheck The result of the legality check.
+     */
+    auto legalize(std::span<std::uint8_t> part) -> LegalCheck;
+
+    /**
+     * @brief Optimizes the partition by FM and exact window refinement.
+     *
+     * @param[in,out] part The partition to optimize.
+     */
+    void optimize(std::span<std::uint8_t> part);
+
+  private:
+    /**
+     * @brief Runs the window passes.
+     *
+     * @param[in,out] part The partition to refine.
+     * @return The reduction of the cost.
+     */
+    auto _refine_windows(std::span<std::uint8_t> part) -> int;
+};
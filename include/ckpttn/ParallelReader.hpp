@@ -0,0 +1,122 @@
+/**
+ * @file ParallelReader.hpp
+ * @brief Multi-threaded readers of hMetis and netD files over a memory map
+ */
+
+#pragma once
+
+#include <cstddef>                 // for size_t
+#include <cstdint>                 // for uint32_t
+#include <netlistx/netlist.hpp>    // for SimpleNetlist
+#include <netlistx/readwrite.hpp>  // for InputFormat
+#include <string>                  // for string
+#include <vector>                  // for vector
+
+/**
+ * @brief A hypergraph in compressed sparse row (CSR) form
+ *
+ * The pins of net `i` are `pins[net_offsets[i]]` to
+ * `pins[net_offsets[i + 1] - 1]`, in the order of the file.
+ */
+struct HypergraphCsr {
+    /// @brief Number of modules (including the pads)
+    std::uint32_t num_modules{};
+    /// @brief Number of nets
+    std::uint32_t num_nets{};
+    /// @brief Number of pads (netD only)
+    std::uint32_t num_pads{};
+    /// @brief Start of the pins of each net, plus the total number of pins
+    std::vector<size_t> net_offsets;
+    /// @brief The modules of the pins
+    std::vector<std::uint32_t> pins;
+    /// @brief Weight of each module (empty = unit weights)
+    std::vector<unsigned int> module_weight;
+};
+
+/**
+ * @brief Reads an hMetis hypergraph file in parallel.
+ *
+ * The file is memory-mapped and split at line boundaries into chunks, whose
+ * integers are scanned concurrently on `TaskScheduler::current()`; the pin
+ * arrays are then assembled with a prefix sum over the chunks. Lines
+ * starting with `%` are comments. The optional format field of the header
+ * line is honored: net weights (1) are skipped, since `SimpleNetlist` has
+ * unit net weights, and vertex weights (10) are read from the integers that
+ * follow the net lines.
+ *
+ * Module ids are 0-based, as in the test cases of this repository; a file
+ * with 1-based ids (standard hMetis: no id 0, and id `num_vertices` occurs)
+ * is detected and shifted.
+ *
+ * @param[in] filename The file name
+ * @param[in] num_chunks The number of chunks (0 = one per MiB, at most one
+ * per thread)
+ * @return The hypergraph
+ * @throw std::runtime_error if the file cannot be read or is malformed
+ */
+auto read_hmetis_csr(const std::string& filename, size_t num_chunks = 0U) -> HypergraphCsr;
+
+/**
+ * @brief Reads a netD file in parallel.
+ *
+ * Produces the same hypergraph as `readNetD`: pin lines `a<i>` are module
+ * `i`, pin lines `p<i>` are module `pad_offset + i`, and a pin line of type
+ * `s` starts a new net.
+ *
+ * @param[in] filename The file name
+ * @param[in] num_chunks The number of chunks (0 = one per MiB, at most one
+ * per thread)
+ * @return The hypergraph
+ * @throw std::runtime_error if the file cannot be read or is malformed
+ */
+auto read_netd_csr(const std::string& filename, size_t num_chunks = 0U) -> HypergraphCsr;
+
+/**
+ * @brief Reads the module weights of an .are file in parallel.
+ *
+ * @param[in] filename The file name
+ * @param[in] num_modules The number of modules
+ * @param[in] num_pads The number of pads
+ * @param[in] num_chunks The number of chunks (0 = one per MiB, at most one
+ * per thread)
+ * @return The module weights (0 for the modules missing in the file)
+ * @throw std::runtime_error if the file cannot be read or is malformed
+ */
+auto read_are_weights(const std::string& filename, std::uint32_t num_modules,
+                      std::uint32_t num_pads, size_t num_chunks = 0U)
+    -> std::vector<unsigned int>;
+
+/**
+ * @brief Builds a `SimpleNetlist` from a CSR hypergraph.
+ *
+ * The edges are added in the order of the pins, so that the netlist is the
+ * same as the one built by the stream readers.
+ *
+ * @param[in] csr The hypergraph
+ * @return The netlist
+ */
+auto to_netlist(const HypergraphCsr& csr) -> SimpleNetlist;
+
+/**
+ * @brief Reads the module weights of an .are file in parallel (see `readAre`).
+ *
+ * @param[in,out] hyprgraph The netlist
+ * @param[in] filename The file name
+ * @throw std::runtime_error if the file cannot be read or is malformed
+ */
+void read_are_parallel(SimpleNetlist& hyprgraph, const std::string& filename);
+
+/**
+ * @brief Reads a hypergraph, in parallel for the hMetis and netD formats.
+ *
+ * With `InputFormat::auto_detect`, the extensions `.hgr` (hMetis) and
+ * `.net` or `.netD` (netD) select the parallel readers. The other formats
+ * are read by `read_hypergraph`.
+ *
+ * @param[in] filename The file name
+ * @param[in] input_format The format of the file
+ * @return The netlist
+ * @throw std::runtime_error if the file cannot be read or is malformed
+ */
+auto read_hypergraph_parallel(const std::string& filename, InputFormat input_format)
+    -> SimpleNetlist;
@@ -0,0 +1,245 @@
+/**
+ * @file PartitionServer.hpp
+ * @brief Partition daemon with an in-memory netlist cache
+ */
+
+#pragma once
+
+#include <ckpttn/CoarseningHierarchy.hpp>  // for CoarseningHierarchy
+#include <ckpttn/PreprocessedNetlist.hpp>  // for PreprocessedNetlist
+#include <atomic>                          // for atomic
+#include <condition_variable>              // for condition_variable
+#include <cstddef>                         // for size_t
+#include <cstdint>                         // for uint8_t, uint32_t, uint64_t
+#include <istream>                         // for istream
+#include <list>                            // for list
+#include <memory>                          // for shared_ptr, unique_ptr
+#include <mutex>                           // for mutex
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <string>                          // for string
+#include <unordered_map>                   // for unordered_map
+#include <utility>                         // for pair
+#include <vector>                          // for vector
+
+/**
+ * @brief A partitioning job
+ */
+struct PartitionJob {
+    /// @brief The netlist file
+    std::string filename;
+    /// @brief The format: auto, hmetis, netd, json, dimacs or yosys
+    std::string format{"auto"};
+    /// @brief The number of partitions
+    std::uint8_t num_parts{2U};
+    /// @brief The balance tolerance
+    double bal_tol{0.05};
+    /// @brief A file of fixed modules (empty = none)
+    std::string fixed_file;
+    /// @brief The seed of the initial partition
+    std::uint32_t seed{1U};
+    /// @brief Whether to use recursive bisection for more than 2 partitions
+    bool recursive{true};
+    /// @brief The number of V-cycles
+    size_t num_vcycles{0U};
+};
+
+/**
+ * @brief The result of a partitioning job
+ */
+struct PartitionResult {
+    /// @brief The cut cost
+    int cost{};
+    /// @brief Whether the netlist was found in the cache
+    bool cached{false};
+    /// @brief The partition of the modules of the netlist
+    std::vector<std::uint8_t> part;
+};
+
+/**
+ * @brief LRU cache of parsed netlists keyed by content hash
+ *
+ * An entry holds a netlist, its preprocessed reduction, which does not
+ * depend on the number of partitions or the balance tolerance, and the
+ * coarsening hierarchy of the reduction, which the jobs reuse as far as it
+ * suits their number of partitions and balance tolerance. The entries
+ * are immutable and shared, so that the jobs that use an entry keep it alive
+ * while it is evicted. The cache is safe to use from several threads.
+ */
+class NetlistCache {
+  public:
+    /**
+     * @brief A cached netlist
+     */
+    struct Entry {
+        SimpleNetlist netlist;
+        /// @brief The reduction of `netlist` (see `preprocess_netlist`)
+        std::unique_ptr<PreprocessedNetlist> preprocessed;
+        /// @brief The coarsening hierarchy of `preprocessed` for the default job
+        std::unique_ptr<CoarseningHierarchy> hierarchy;
+    };
+
+  private:
+    using key_t = std::uint64_t;
+    using lru_t = std::list<std::pair<key_t, std::shared_ptr<const Entry>>>;
+
+    mutable std::mutex mutex;
+    size_t capacity;
+    /// @brief The entries, the most recently used first
+    lru_t lru;
+    std::unordered_map<key_t, lru_t::iterator> index;
+    size_t num_hits{0U};
+    size_t num_misses{0U};
+
+  public:
+    /**
+     * @brief Constructs a new NetlistCache object.
+     *
+     * @param[in] capacity The maximum number of netlists (at least 1).
+     */
+    explicit NetlistCache(size_t capacity) : capacity{capacity != 0U ? capacity : 1U} {}
+
+    /**
+     * @brief Returns the netlist of a file, reading it on a miss.
+     *
+     * The key is a hash of the content of the file and of the format, so
+     * an edited file is read again whatever its name.
+     *
+     * @param[in] filename The file name
+     * @param[in] format The format (see `PartitionJob::format`)
+     * @param[out] hit Whether the netlist was found in the cache
+     * @return The entry
+     * @throw std::runtime_error if the file cannot be read or is malformed
+     */
+    auto get(const std::string& filename, const std::string& format, bool& hit)
+        -> std::shared_ptr<const Entry>;
+
+    /**
+     * @brief Returns the number of cached netlists.
+     *
+     * @return The number of entries
+     */
+    auto size() const -> size_t;
+
+    /**
+     * @brief Returns the number of hits and misses so far.
+     *
+     * @return The pair {hits, misses}
+     */
+    auto stats() const -> std::pair<size_t, size_t>;
+};
+
+/**
+ * @brief Parses the arguments of a partitioning job.
+ *
+ * The arguments are the `key=value` pairs of a `partition` request (see
+ * `PartitionServer`); `epsilon` may be a percentage, as in the command line.
+ *
+ * @param[in,out] args The stream of the arguments
+ * @return The job
+ * @throw std::runtime_error if an argument is unknown or invalid, or if
+ * `file=` is missing
+ */
+auto parse_partition_job(std::istream& args) -> PartitionJob;
+
+/**
+ * @brief Runs a partitioning job on a cached netlist.
+ *
+ * Follows the standalone partitioner: the reduced netlist is partitioned
+ * from a random initial partition by `MLPartMgr` (or by
+ * `RecursiveBisection`) with FM refinement, and the partition is restored
+ * to the full netlist. The multilevel runs reuse the cached coarsening
+ * hierarchy. A job with fixed modules works on a copy of the netlist, which
+ * is reduced and coarsened again.
+ *
+ * @param[in] entry The cached netlist
+ * @param[in] job The job
+ * @return The result (`cached` is not set)
+ * @throw std::runtime_error if the fixed file cannot be read
+ */
+auto run_partition_job(const NetlistCache::Entry& entry, const PartitionJob& job)
+    -> PartitionResult;
+
+/**
+ * @brief Partition daemon listening on a Unix domain socket
+ *
+ * Each connection is served by its own thread, so jobs run concurrently;
+ * their parallel steps share `TaskScheduler::current()` of the thread that
+ * runs `serve`. The protocol is line-framed: every request line gets one
+ * response line.
+ *
+ * - `partition file=<path> [k=<K>] [epsilon=<tol>] [format=<fmt>]
+ *   [fixed=<path>] [seed=<n>] [mode=direct|recursive] [vcycles=<n>]`
+ *   answers `ok cost=<cost> cached=<0|1> part=<p0>,<p1>,...`
+ * - `stats` answers `ok entries=<n> hits=<n> misses=<n>`
+ * - `shutdown` answers `ok` and stops the server
+ *
+ * Errors are answered with `error <message>`. Paths may not contain blanks.
+ */
+class PartitionServer {
+  private:
+    std::string socket_path;
+    NetlistCache cache;
+    std::atomic<bool> stopping{false};
+    std::mutex connections_mutex;
+    /// @brief Signals that a connection thread has finished
+    std::condition_variable connections_done;
+    /// @brief The sockets of the open connections
+    std::vector<int> connections;
+    /// @brief Number of connection threads still running
+    size_t num_running{0U};
+
+  public:
+    /**
+     * @brief Constructs a new PartitionServer object.
+     *
+     * @param[in] socket_path The path of the socket.
+     * @param[in] cache_capacity The maximum number of cached netlists.
+     */
+    PartitionServer(std::string socket_path, size_t cache_capacity)
+        : socket_path{std::move(socket_path)}, cache{cache_capacity} {}
+
+    /**
+     * @brief Serves connections until `stop` or a `shutdown` request.
+     *
+     * Each connection is served by a thread of its own, which ends with the
+     * connection, and `serve` returns once all of them have ended.
+     *
+     * @throw std::runtime_error if the socket cannot be created, or on a
+     * platform without Unix domain sockets
+     */
+    void serve();
+
+    /**
+     * @brief Asks `serve` to return; may be called from any thread.
+     */
+    void stop();
+
+    /**
+     * @brief Handles one request line.
+     *
+     * @param[in] request The request, without the line feed
+     * @return The response, without the line feed
+     */
+    auto handle_request(const std::string& request) -> std::string;
+
+    /**
+     * @brief Returns the netlist cache.
+     *
+     * @return NetlistCache& The cache.
+     */
+    auto get_cache() -> NetlistCache& { return this->cache; }
+
+  private:
+    void _serve_connection(int fd);
+};
+
+/**
+ * @brief Sends one request to a partition daemon and waits for the response.
+ *
+ * @param[in] socket_path The path of the socket
+ * @param[in] request The request, without the line feed
+ * @return The response, without the line feed
+ * @throw std::runtime_error if the daemon cannot be reached
+ */
+auto send_partition_request(const std::string& socket_path, const std::string& request)
+    -> std::string;
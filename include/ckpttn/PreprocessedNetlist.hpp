@@ -0,0 +1,113 @@
+/**
+ * @file PreprocessedNetlist.hpp
+ * @brief Reversible netlist preprocessing (net removal and twin-module merging)
+ */
+
+#pragma once
+
+#include <ckpttn/FMPmrConfig.hpp>  // for FM_MAX_DEGREE
+#include <cstddef>                 // for size_t
+#include <cstdint>                 // for uint8_t, uint32_t
+#include <memory>                  // for unique_ptr
+#include <netlistx/netlist.hpp>    // for SimpleNetlist, Netlist
+#include <span>                    // for span
+#include <vector>                  // for vector
+
+/**
+ * @brief Preprocessed Netlist
+ *
+ * A reduced copy of a netlist that is partitioned in place of the original:
+ *
+ * - single-pin nets are removed, since they can never be cut;
+ * - nets with more than `max_degree` pins are detached, since the FM gain
+ *   calculation ignores them anyway;
+ * - modules with identical (remaining) net sets are merged into weighted
+ *   supermodules, up to a weight limit. Fixed modules are never merged.
+ *
+ * The reduction is reversible: `projection_down` restores a full-size
+ * partition, and `detached_cost` accounts for the detached nets, so that the
+ * (lambda - 1) cost of the original netlist is the cost of the reduced
+ * netlist plus `detached_cost`.
+ */
+class PreprocessedNetlist : public SimpleNetlist {
+  public:
+    using node_t = SimpleNetlist::node_t;
+
+    /// @brief Pointer to the original netlist
+    const SimpleNetlist* parent{nullptr};
+    /// @brief Mapping from original modules to reduced modules
+    std::vector<node_t> node_up_map;
+    /// @brief Original nets that were detached because of their size
+    std::vector<node_t> detached_nets;
+    /// @brief Number of nets removed because they have (or end up with) a single pin
+    size_t num_removed_nets{0U};
+
+    /**
+     * @brief Constructs a new PreprocessedNetlist object.
+     *
+     * @param[in] gr The graph of the reduced netlist.
+     * @param[in] numModules The number of reduced modules.
+     * @param[in] numNets The number of reduced nets.
+     */
+    PreprocessedNetlist(graph_t gr, uint32_t numModules, uint32_t numNets)
+        : SimpleNetlist{std::move(gr), numModules, numNets} {}
+
+    /**
+     * @brief Projects a partition of the original netlist onto the reduced netlist.
+     *
+     * @param[in] part The partition of the original netlist.
+     * @param[out] part_up The partition of the reduced netlist.
+     */
+    void projection_up(std::span<const std::uint8_t> part, std::span<std::uint8_t> part_up) const;
+
+    /**
+     * @brief Restores a full-size partition from a partition of the reduced netlist.
+     *
+     * @param[in] part The partition of the reduced netlist.
+     * @param[out] part_down The partition of the original netlist.
+     */
+    void projection_down(std::span<const std::uint8_t> part,
+                         std::span<std::uint8_t> part_down) const;
+
+    /**
+     * @brief Returns the cost contributed by the detached nets.
+     *
+     * Every detached net costs its weight times the number of parts it
+     * spans, minus one, like the nets counted by the gain calculation.
+     *
+     * @param[in] part The partition of the original netlist.
+     * @return The (lambda - 1) cost of the detached nets.
+     */
+    auto detached_cost(std::span<const std::uint8_t> part) const -> int;
+};
+
+/**
+ * @brief Builds the reduced netlist of the preprocessing stage.
+ *
+ * @param[in] hyprgraph The original netlist.
+ * @param[in] max_degree Nets with more pins than this are detached.
+ * @param[in] max_twin_weight Weight limit of a supermodule (0 = 1% of the total weight).
+ * @return The reduced netlist with the information to undo the reduction.
+ */
+extern auto preprocess_netlist(const SimpleNetlist& hyprgraph, size_t max_degree = FM_MAX_DEGREE,
+                               unsigned int max_twin_weight = 0U)
+    -> std::unique_ptr<PreprocessedNetlist>;
+
+/**
+ * @brief Returns the cost of the nets ignored by the FM gain calculation.
+ *
+ * The gain managers skip nets with more than `FM_MAX_DEGREE` pins, so the
+ * cost reported by the partitioners leaves them out. Adding this cost gives
+ * the (lambda - 1) cost of the whole netlist; on the original netlist of a
+ * `PreprocessedNetlist` built with the same `max_degree` it equals
+ * `detached_cost`.
+ *
+ * @tparam Gnl The netlist type
+ * @param[in] hyprgraph The netlist.
+ * @param[in] part The partition.
+ * @param[in] max_degree Nets with more pins than this are counted.
+ * @return The (lambda - 1) cost of the nets with more than `max_degree` pins.
+ */
+template <typename Gnl>
+auto large_net_cost(const Gnl& hyprgraph, std::span<const std::uint8_t> part,
+                    size_t max_degree = FM_MAX_DEGREE) -> int;
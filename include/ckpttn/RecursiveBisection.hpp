@@ -0,0 +1,91 @@
+/**
+ * @file RecursiveBisection.hpp
+ * @brief Task-parallel recursive bisection driver
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t
+#include <span>     // for span
+
+enum class LegalCheck;
+
+/**
+ * @brief Recursive Bisection Partition Manager
+ *
+ * Computes a K-way partition by recursive bisection instead of direct K-way
+ * refinement:
+ *
+ * - a block that must be split into k parts is bisected by `MLPartMgr` into
+ *   two sides of ceil(k/2) and floor(k/2) parts;
+ * - every side with more than one part is extracted as a sub-hypergraph
+ *   (keeping only the nets with at least 2 pins in it) and bisected again.
+ *
+ * The balance tolerance of each bisection is derived from the lower bound of
+ * the final K-way partition, the weight of the block and the number of
+ * remaining levels, so that the slack is spread evenly over the levels.
+ * The independent sub-bisections run as tasks on the shared
+ * `TaskScheduler::current()` (or on a private scheduler if a number of
+ * threads is set). Since every sub-bisection only depends on its own block,
+ * the result does not depend on the number of threads.
+ *
+ * For odd numbers of parts the symmetric bisection constraint cannot protect
+ * the larger side exactly: the heavier side of every bisection of a block
+ * without fixed modules is given the ceil(k/2) parts, and the final
+ * partition is legalized by a direct K-way FM pass when needed.
+ */
+class RecursiveBisection {
+  private:
+    /// @brief Balance tolerance of the final K-way partition
+    double bal_tol;
+    /// @brief Number of partitions
+    std::uint8_t num_parts;
+    /// @brief Number of threads of a private scheduler (0 = the shared scheduler)
+    size_t num_threads{0U};
+    /// @brief Number of V-cycles of every bisection
+    size_t num_vcycles{0U};
+
+  public:
+    /// @brief Total cost of the current partitioning solution
+    int total_cost{};
+
+    /**
+     * @brief Constructs a new RecursiveBisection object.
+     *
+     * @param[in] bal_tol The balance tolerance of the final partition.
+     * @param[in] num_parts The number of partitions to create.
+     */
+    RecursiveBisection(double bal_tol, std::uint8_t num_parts)
+        : bal_tol{bal_tol}, num_parts{num_parts} {}
+
+    /**
+     * @brief Sets the number of threads.
+     *
+     * @param[in] num_threads The number of threads of a private scheduler
+     * (0 = run on `TaskScheduler::current()`).
+     */
+    void set_num_threads(size_t num_threads) { this->num_threads = num_threads; }
+
+    /**
+     * @brief Sets the number of V-cycles of every bisection.
+     *
+     * @param[in] num_vcycles The number of V-cycles (0 = disabled).
+     */
+    void set_num_vcycles(size_t num_vcycles) { this->num_vcycles = num_vcycles; }
+
+    /**
+     * @brief Runs the recursive bisection.
+     *
+     * Fixed modules keep the part given in `part`; the other entries are
+     * ignored.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam PartMgr The 2-way partition manager used at every level of `MLPartMgr`.
+     * @param[in] hyprgraph The input hypergraph to partition.
+     * @param[in,out] part The partition vector to store the partitioning results.
+     * @return LegalCheck The legality check result of the final partition.
+     */
+    template <typename Gnl, typename PartMgr>
+    auto run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+};
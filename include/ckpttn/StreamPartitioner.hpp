@@ -0,0 +1,83 @@
+/**
+ * @file StreamPartitioner.hpp
+ * @brief One-pass partitioning of hMetis and netD files that do not fit in memory
+ */
+
+#pragma once
+
+#include <cstddef>                 // for size_t
+#include <cstdint>                 // for uint8_t, uint32_t
+#include <netlistx/readwrite.hpp>  // for InputFormat
+#include <string>                  // for string
+#include <vector>                  // for vector
+
+/**
+ * @brief Options of `partition_stream`
+ */
+struct StreamPartitionOptions {
+    /// @brief Number of parts
+    std::uint8_t num_parts{2U};
+    /// @brief Capacity of a block above the average (0.03 = 3%)
+    double imbalance{0.03};
+    /// @brief Exponent of the load penalty (1.5 as in Fennel)
+    double gamma{1.5};
+    /// @brief Number of nets buffered before their modules are assigned
+    size_t window{4096U};
+    /// @brief Prefix of the partial netlists (empty = none are written)
+    std::string block_prefix;
+};
+
+/**
+ * @brief Result of `partition_stream`
+ */
+struct StreamPartition {
+    /// @brief The part of each module
+    std::vector<std::uint8_t> part;
+    /// @brief The number of modules of each block
+    std::vector<std::uint32_t> block_size;
+    /// @brief The number of nets
+    std::uint32_t num_nets{};
+    /// @brief The K-1 connectivity cost of the partition
+    int cost{};
+};
+
+/**
+ * @brief Partitions a hypergraph file in a single pass.
+ *
+ * The file is read line by line, and only the last `window` nets are kept.
+ * When a net leaves the window, each of its modules that is not assigned
+ * yet joins the block `b` that maximizes
+ *
+ *     pins(v, b) - alpha * gamma * size(b)^(gamma - 1)
+ *
+ * among the blocks below their capacity, where `pins(v, b)` counts the
+ * pins in `b` of the nets of the module in the window and `alpha` is
+ * Fennel's `num_nets * K^(gamma - 1) / num_modules^gamma`. The block of a
+ * module is final, so the cost of a net is known when it leaves the
+ * window. The modules on no net fill the lightest blocks at the end.
+ * Besides the partition, the state is one counter per block and, for the
+ * nets of the window, their pins and one counter per block.
+
+ * Module weights are not known before the nets have been read (hMetis
+ * lists them last, netD in a separate file), so the blocks are balanced by
+ * module count. A block holds at most `ceil((1 + imbalance) * n / K)`
+ * modules.
+ *
+ * With a `block_prefix`, the pins of each net inside block `b` (if there
+ * are at least two) are written as a net of `<prefix><b>.hgr`, an hMetis
+ * file over the modules of the block, and `<prefix><b>.map` lists the
+ * module of the input of each of them, one per line, so that each block
+ * can be loaded and refined in memory.
+ *
+ * @param[in] filename The file name
+ * @param[in] input_format `InputFormat::hmetis`, `InputFormat::netD`, or
+ * `InputFormat::auto_detect` (by the extensions `.hgr`, `.net` and `.netD`)
+ * @param[in] options The options
+ * @return The partition
+ * @throw std::invalid_argument if the format is not supported or
+ * `num_parts` is less than 2
+ * @throw std::runtime_error if a file cannot be read or written, or the
+ * input is malformed
+ */
+auto partition_stream(const std::string& filename, InputFormat input_format,
+                      const StreamPartitionOptions& options) -> StreamPartition;
@@ -0,0 +1,253 @@
+/**
+ * @file TaskScheduler.hpp
+ * @brief Work-stealing task scheduler shared by the whole library
+ */
+
+#pragma once
+
+#include <atomic>              // for atomic
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <deque>               // for deque
+#include <exception>           // for exception_ptr
+#include <functional>          // for function
+#include <memory>              // for unique_ptr
+#include <mutex>               // for mutex
+#include <thread>              // for thread
+#include <vector>              // for vector
+
+/**
+ * @brief Work-stealing Task Scheduler
+ *
+ * Runs tasks that may spawn further tasks, such as the sub-problems of a
+ * recursive bisection or the blocks of a `parallel_for`. Every worker owns a
+ * deque of tasks: it pushes the tasks it spawns and pops them from the back
+ * (depth first), and when its deque is empty it steals from the front of the
+ * other deques (the oldest, usually the largest, tasks).
+ *
+ * A thread that waits for a `TaskGroup` runs queued tasks in the meantime,
+ * so waiting inside a task never deadlocks, and a scheduler with one thread
+ * runs everything on the calling thread, in a fixed order.
+ *
+ * All parallel code of the library runs on `TaskScheduler::current()`: the
+ * scheduler installed on the calling thread by a `TaskScheduler::Scope`, or
+ * else the scheduler of the calling worker, or else the process-wide
+ * `TaskScheduler::global()`. Hence several threads of an application that
+ * call the library share one pool instead of oversubscribing the machine.
+ */
+class TaskScheduler {
+  public:
+    using Task = std::function<void()>;
+
+    class Scope;
+
+  private:
+    friend class TaskGroup;
+
+    /// @brief Task deque of one worker
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /// @brief Task deques (worker 0 is shared by the threads outside the scheduler)
+    std::vector<std::unique_ptr<Worker>> workers;
+    /// @brief Background threads (workers 1 to n-1)
+    std::vector<std::thread> threads;
+    /// @brief Protects the sleeping
+    std::mutex mutex;
+    /// @brief Signals new tasks and finished task groups
+    std::condition_variable cond;
+    /// @brief Number of queued tasks (never below the real count)
+    std::atomic<size_t> num_queued{0U};
+    /// @brief Set when the scheduler is destroyed
+    bool stop{false};
+    /// @brief Whether the algorithms must give the same result for any number of threads
+    bool deterministic{false};
+
+  public:
+    /**
+     * @brief Constructs a new TaskScheduler object.
+     *
+     * @param[in] num_threads The number of threads, including the waiting
+     * thread (0 = hardware concurrency).
+     */
+    explicit TaskScheduler(size_t num_threads = 0U);
+
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    auto operator=(const TaskScheduler&) -> TaskScheduler& = delete;
+
+    /**
+     * @brief Returns the number of threads.
+     *
+     * @return size_t The number of threads.
+     */
+    auto num_threads() const -> size_t { return this->workers.size(); }
+
+    /**
+     * @brief Enables or disables the deterministic mode.
+     *
+     * In deterministic mode, the parallel algorithms that run on this
+     * scheduler avoid every decision that depends on the timing of the
+     * threads (e.g. label propagation applies its moves in a fixed order
+     * instead of concurrently), so that the result is the same for any
+     * number of threads.
+     *
+     * @param[in] enable Whether to enable the deterministic mode.
+     */
+    void set_deterministic(bool enable) { this->deterministic = enable; }
+
+    /**
+     * @brief Returns whether the deterministic mode is enabled.
+     *
+     * @return true if the results must not depend on the number of threads.
+     */
+    auto is_deterministic() const -> bool { return this->deterministic; }
+
+    /**
+     * @brief Returns the process-wide scheduler.
+     *
+     * It is created on first use with the number of threads given to
+     * `set_global_num_threads` (default: hardware concurrency).
+     *
+     * @return TaskScheduler& The process-wide scheduler.
+     */
+    static auto global() -> TaskScheduler&;
+
+    /**
+     * @brief Sets the number of threads of the process-wide scheduler.
+     *
+     * Replaces the process-wide scheduler, so it must not be called while
+     * the library is running.
+     *
+     * @param[in] num_threads The number of threads (0 = hardware concurrency).
+     */
+    static void set_global_num_threads(size_t num_threads);
+
+    /**
+     * @brief Returns the scheduler that parallel code should run on.
+     *
+     * @return TaskScheduler& The scheduler installed by a `Scope`, or the one
+     * of the calling worker, or the process-wide scheduler.
+     */
+    static auto current() -> TaskScheduler&;
+
+  private:
+    /**
+     * @brief Queues a task.
+     *
+     * A task spawned by a worker goes to the back of its own deque; a task
+     * spawned from outside goes to worker 0.
+     *
+     * @param[in] task The task.
+     */
+    void spawn(Task task);
+
+    /**
+     * @brief Takes a task from the own deque, or steals one.
+     *
+     * @param[in] index The index of the worker.
+     * @param[out] task The task.
+     * @return true if a task was taken.
+     */
+    auto take(size_t index, Task& task) -> bool;
+
+    /**
+     * @brief Returns the index of the calling thread as a worker.
+     *
+     * @return size_t The index (0 for the threads outside the scheduler).
+     */
+    auto worker_index() const -> size_t;
+
+    /**
+     * @brief Main loop of a background thread.
+     *
+     * @param[in] index The index of the worker.
+     */
+    void worker_loop(size_t index);
+};
+
+/**
+ * @brief Installs a scheduler as `TaskScheduler::current()` for the calling
+ * thread, for the lifetime of the object.
+ *
+ * A null scheduler keeps the current one.
+ */
+class TaskScheduler::Scope {
+  private:
+    /// @brief Scheduler installed before
+    TaskScheduler* saved;
+
+  public:
+    /**
+     * @brief Installs a scheduler.
+     *
+     * @param[in] scheduler The scheduler (may be null).
+     */
+    explicit Scope(TaskScheduler* scheduler);
+
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    auto operator=(const Scope&) -> Scope& = delete;
+};
+
+/**
+ * @brief A set of tasks that can be waited for
+ *
+ * Tasks run on the given scheduler. `wait` runs queued tasks (of any group)
+ * until all tasks of this group are finished, and rethrows the first
+ * exception thrown by one of them.
+ */
+class TaskGroup {
+  private:
+    /// @brief The scheduler
+    TaskScheduler& scheduler;
+    /// @brief Number of tasks of the group that are not finished
+    std::atomic<size_t> num_pending{0U};
+    /// @brief First exception thrown by a task of the group
+    std::exception_ptr error;
+    /// @brief Protects the first exception
+    std::mutex error_mutex;
+
+  public:
+    /**
+     * @brief Constructs a new TaskGroup object.
+     *
+     * @param[in] scheduler The scheduler (default: `TaskScheduler::current()`).
+     */
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::current())
+        : scheduler{scheduler} {}
+
+    /**
+     * @brief Waits for the remaining tasks (exceptions are dropped).
+     */
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    auto operator=(const TaskGroup&) -> TaskGroup& = delete;
+
+    /**
+     * @brief Spawns a task of the group.
+     *
+     * Can be called from outside or from a running task.
+     *
+     * @param[in] task The task.
+     */
+    void run(TaskScheduler::Task task);
+
+    /**
+     * @brief Runs tasks until all tasks of the group are finished.
+     *
+     * Rethrows the first exception thrown by a task of the group.
+     */
+    void wait();
+
+  private:
+    /**
+     * @brief Runs queued tasks until all tasks of the group are finished.
+     */
+    void help();
+};
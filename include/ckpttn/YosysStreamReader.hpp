@@ -0,0 +1,60 @@
+/**
+ * @file YosysStreamReader.hpp
+ * @brief Streaming readers of Yosys JSON netlists with bounded memory
+ */
+
+#pragma once
+
+#include <cstdint>                // for uint32_t
+#include <netlistx/netlist.hpp>  // for SimpleNetlist
+#include <string>                // for string
+#include <vector>                // for vector
+
+/**
+ * @brief Reads a Yosys JSON netlist without materializing the document.
+ *
+ * Produces the same hypergraph as `read_yosys_json`: the first module of
+ * the document is read; each of its cells is a module, each of its ports
+ * is a pad (after the cells), and each bit id is a net connecting the
+ * cells and ports that use it (constant bits `"0"`, `"1"`, `"x"`, `"z"`
+ * are ignored).
+ *
+ * The file is tokenized through a fixed-size buffer by a pull parser that
+ * descends into `ports[*].bits` and `cells[*].connections` only and skips
+ * everything else (names, parameters, attributes, net names and the other
+ * modules) without storing it. Besides the netlist, the reader keeps one
+ * (bit, node) pair per pin, so the memory stays proportional to the
+ * number of pins rather than to the size of the document.
+ *
+ * @param[in] filename The file name
+ * @return The netlist
+ * @throw std::runtime_error if the file cannot be read or is malformed
+ */
+auto read_yosys_json_stream(const std::string& filename) -> SimpleNetlist;
+
+/**
+ * @brief Reads a hierarchical Yosys JSON netlist and flattens it.
+ *
+ * The top module is the one with the `top` attribute (or the first one).
+ * A cell whose type is another module of the document, unless it is a
+ * blackbox, is an instance of that module and is replaced by its cells,
+ * recursively; the other cells are the modules of the netlist, followed by
+ * one pad per port of the top module. Each net of the flattened design is
+ * a net of the netlist (constant bits are ignored).
+ *
+ * The module definitions are streamed as in `read_yosys_json_stream`, and
+ * only their ports and the types and connections of their cells are kept.
+ *
+ * Besides the netlist, the reader labels each module with its instance:
+ * the cells of the same innermost instance share a label, while each cell
+ * of the top module and each pad gets a label of its own. The labels can
+ * seed the first coarsening level (see `CoarseningCtrl::set_seed_clusters`).
+ *
+ * @param[in] filename The file name
+ * @param[out] instance The instance label of each module
+ * @return The netlist
+ * @throw std::runtime_error if the file cannot be read, is malformed, or
+ * instantiates a module recursively
+ */
+auto read_yosys_json_hier(const std::string& filename, std::vector<std::uint32_t>& instance)
+    -> SimpleNetlist;
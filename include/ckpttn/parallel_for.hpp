@@ -0,0 +1,94 @@
+/**
+ * @file parallel_for.hpp
+ * @brief Block-wise parallel loops over the task scheduler
+ */
+
+#pragma once
+
+#include <algorithm>                 // for min, max
+#include <ckpttn/TaskScheduler.hpp>  // for TaskScheduler, TaskGroup
+#include <cstddef>                   // for size_t
+#include <cstdint>                   // for uint32_t
+#include <vector>                    // for vector
+
+/**
+ * @brief Returns the number of tasks for a parallel loop.
+ *
+ * @param[in] num_threads The requested number of threads (0 = the threads of
+ * `TaskScheduler::current()`)
+ * @param[in] num_items The number of items of the loop
+ * @param[in] min_block The minimum number of items per task
+ * @return The number of tasks (at least 1)
+ */
+inline auto num_parallel_tasks(size_t num_threads, size_t num_items, size_t min_block) -> size_t {
+    if (num_threads == 0U) {
+        num_threads = TaskScheduler::current().num_threads();
+    }
+    return std::max(std::min(num_threads, num_items / std::max(min_block, size_t{1U})),
+                    size_t{1U});
+}
+
+/**
+ * @brief Runs `fn(task, first, last)` over the blocks of [0, num_items).
+ *
+ * The items are split into `num_tasks` contiguous blocks that run on
+ * `TaskScheduler::current()`. With one task, the whole range is processed by
+ * the calling thread as task 0.
+ *
+ * @param[in] num_tasks The number of blocks
+ * @param[in] num_items The number of items
+ * @param[in] fn The function to run on each block
+ */
+template <typename Fn> void parallel_for(size_t num_tasks, std::uint32_t num_items, Fn&& fn) {
+    if (num_tasks <= 1U) {
+        fn(size_t{0U}, std::uint32_t{0U}, num_items);
+        return;
+    }
+    auto group = TaskGroup{};
+    for (auto task = size_t{0U}; task != num_tasks; ++task) {
+        const auto first = static_cast<std::uint32_t>(num_items * task / num_tasks);
+        const auto last = static_cast<std::uint32_t>(num_items * (task + 1U) / num_tasks);
+        group.run([&fn, task, first, last]() { fn(task, first, last); });
+    }
+    group.wait();
+}
+
+/**
+ * @brief Reduces `fn(first, last)` over fixed-size blocks of [0, num_items).
+ *
+ * The block boundaries do not depend on the number of threads, and the
+ * partial results are combined in block order, so the result is the same for
+ * any number of threads even for non-associative operations (e.g. floating
+ * point sums).
+ *
+ * @param[in] num_items The number of items
+ * @param[in] block_size The number of items per block
+ * @param[in] init The initial value
+ * @param[in] fn The function returning the partial result of a block
+ * @param[in] combine The function combining two results
+ * @return The reduced result
+ */
+template <typename T, typename Fn, typename Combine>
+auto parallel_reduce(std::uint32_t num_items, std::uint32_t block_size, T init, Fn&& fn,
+                     Combine&& combine) -> T {
+    block_size = std::max(block_size, std::uint32_t{1U});
+    const auto num_blocks = (num_items + block_size - 1U) / block_size;
+    if (num_blocks <= 1U || TaskScheduler::current().num_threads() == 1U) {
+        for (auto first = std::uint32_t{0U}; first < num_items; first += block_size) {
+            init = combine(init, fn(first, std::min(first + block_size, num_items)));
+        }
+        return init;
+    }
+    auto partials = std::vector<T>(num_blocks, init);
+    const auto num_tasks = num_parallel_tasks(0U, num_blocks, 1U);
+    parallel_for(num_tasks, num_blocks, [&](size_t, auto first_block, auto last_block) {
+        for (auto block = first_block; block != last_block; ++block) {
+            const auto first = block * block_size;
+            partials[block] = fn(first, std::min(first + block_size, num_items));
+        }
+    });
+    for (const auto& partial : partials) {
+        init = combine(init, partial);
+    }
+    return init;
+}
@@ -0,0 +1,287 @@
+/**
+ * @file ckpttn_module.cpp
+ * @brief Python extension module over `partition_csr`
+ *
+ * The arrays are taken through the buffer protocol (NumPy arrays,
+ * `array.array`, `memoryview`, ...), so there is no Python-side copy: the
+ * index arrays are read through `std::span` and converted once to a
+ * `SimpleNetlist`, and the partition is written back into the caller's
+ * `uint8` array. The GIL is released while partitioning.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <ckpttn/CsrPartitioner.hpp>  // for partition_csr, HypergraphCsrView
+#include <cstdint>                    // for int32_t, int64_t, uint8_t, uint32_t
+#include <exception>                  // for exception
+#include <limits>                     // for numeric_limits
+#include <span>                       // for span
+#include <stdexcept>                  // for invalid_argument
+#include <string>                     // for string
+#include <string_view>                // for string_view
+
+/// @brief Integer types of the index arrays
+enum class IndexKind { None, Int32, UInt32, Int64, UInt64 };
+
+/**
+ * @brief A buffer of a Python object, released on destruction
+ */
+class Buffer {
+  public:
+    Py_buffer view{};
+    bool acquired{false};
+
+    Buffer() = default;
+    ~Buffer() {
+        if (this->acquired) {
+            PyBuffer_Release(&this->view);
+        }
+    }
+    Buffer(const Buffer&) = delete;
+    auto operator=(const Buffer&) -> Buffer& = delete;
+
+    /**
+     * @brief Acquires the one-dimensional contiguous buffer of an object.
+     *
+     * @param[in] obj The object
+     * @param[in] name The name of the argument, for the error message
+     * @param[in] writable Whether the buffer must be writable
+     * @return false with a Python exception set on failure
+     */
+    auto acquire(PyObject* obj, const char* name, bool writable) -> bool {
+        const auto flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+        if (PyObject_GetBuffer(obj, &this->view, flags) != 0) {
+            return false;
+        }
+        this->acquired = true;
+        if (this->view.ndim != 1) {
+            PyErr_Format(PyExc_ValueError, "%s must be one-dimensional", name);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Returns the type code of the elements, without the byte order.
+     *
+     * @return The type code (0 if none)
+     */
+    auto type_code() const -> char {
+        const auto* format = this->view.format != nullptr ? this->view.format : "B";
+        if (*format == '@' || *format == '=' || *format == '<' || *format == '!'
+            || *format == '>') {
+            // only the native byte order can be read directly
+            if (*format == '>' || *format == '!') {
+                return 0;
+            }
+            ++format;
+        }
+        return format[1] == '\0' ? format[0] : 0;
+    }
+
+    /**
+     * @brief Returns the integer type of the elements.
+     *
+     * @return The type, or `IndexKind::None` if the elements are not integers
+     */
+    auto index_kind() const -> IndexKind {
+        const auto code = this->type_code();
+        const auto is_signed = code == 'i' || code == 'l' || code == 'q';
+        const auto is_unsigned = code == 'I' || code == 'L' || code == 'Q';
+        if (!is_signed && !is_unsigned) {
+            return IndexKind::None;
+        }
+        switch (this->view.itemsize) {
+            case 4:
+                return is_signed ? IndexKind::Int32 : IndexKind::UInt32;
+            case 8:
+                return is_signed ? IndexKind::Int64 : IndexKind::UInt64;
+            default:
+                return IndexKind::None;
+        }
+    }
+
+    /**
+     * @brief Returns the elements.
+     *
+     * @return The elements
+     */
+    template <typename T> auto span() const -> std::span<const T> {
+        return {static_cast<const T*>(this->view.buf),
+                static_cast<size_t>(this->view.len / this->view.itemsize)};
+    }
+};
+
+/**
+ * @brief Partitions with arrays of a given integer type.
+ *
+ * @param[in] num_modules The number of modules
+ * @param[in] offsets The net offsets
+ * @param[in] pins The pins
+ * @param[in] weights The module weights (may be unset)
+ * @param[in,out] part The partition
+ * @param[in] options The options
+ * @return The cost of the partition
+ */
+template <typename Index>
+static auto run_csr(std::uint32_t num_modules, const Buffer& offsets, const Buffer& pins,
+                    const Buffer& weights, std::span<std::uint8_t> part,
+                    const CsrPartitionOptions& options) -> int {
+    auto csr = HypergraphCsrView<Index>{num_modules, offsets.span<Index>(), pins.span<Index>(),
+                                        {}};
+    if (weights.acquired) {
+        csr.module_weight = weights.span<Index>();
+    }
+    return partition_csr(csr, part, options);
+}
+
+/**
+ * @brief Parses the name of a refiner.
+ *
+ * @param[in] name The name
+ * @param[out] refiner The refiner
+ * @return false if the name is unknown
+ */
+static auto parse_refiner(std::string_view name, CsrRefiner& refiner) -> bool {
+    if (name == "fm") {
+        refiner = CsrRefiner::FM;
+    } else if (name == "nn") {
+        refiner = CsrRefiner::NN;
+    } else if (name == "kway") {
+        refiner = CsrRefiner::KWay;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static auto ckpttn_partition(PyObject* /* self */, PyObject* args, PyObject* kwargs)
+    -> PyObject* {
+    static const char* keywords[]
+        = {"offsets", "pins",        "part", "num_parts", "epsilon", "refiner",
+           "weights", "num_vcycles", "seed", "initial",   nullptr};
+    PyObject* offsets_obj = nullptr;
+    PyObject* pins_obj = nullptr;
+    PyObject* part_obj = nullptr;
+    PyObject* weights_obj = Py_None;
+    auto num_parts = static_cast<unsigned char>(2);
+    auto epsilon = 0.05;
+    const char* refiner_name = "fm";
+    Py_ssize_t num_vcycles = 0;
+    auto seed = 1U;
+    auto initial = 0;
+    if (PyArg_ParseTupleAndKeywords(args, kwargs, "OOO|bdsOnIp", const_cast<char**>(keywords),
+                                    &offsets_obj, &pins_obj, &part_obj, &num_parts, &epsilon,
+                                    &refiner_name, &weights_obj, &num_vcycles, &seed, &initial)
+        == 0) {
+        return nullptr;
+    }
+
+    auto options = CsrPartitionOptions{};
+    options.num_parts = num_parts;
+    options.bal_tol = epsilon;
+    options.num_vcycles = num_vcycles > 0 ? static_cast<size_t>(num_vcycles) : 0U;
+    options.seed = seed;
+    options.use_initial = initial != 0;
+    if (!parse_refiner(refiner_name, options.refiner)) {
+        PyErr_Format(PyExc_ValueError, "Unknown refiner '%s' (fm, nn or kway)", refiner_name);
+        return nullptr;
+    }
+
+    Buffer offsets;
+    Buffer pins;
+    Buffer part;
+    Buffer weights;
+    if (!offsets.acquire(offsets_obj, "offsets", false) || !pins.acquire(pins_obj, "pins", false)
+        || !part.acquire(part_obj, "part", true)
+        || (weights_obj != Py_None && !weights.acquire(weights_obj, "weights", false))) {
+        return nullptr;
+    }
+    const auto kind = offsets.index_kind();
+    if (kind == IndexKind::None || pins.index_kind() != kind
+        || (weights.acquired && weights.index_kind() != kind)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "offsets, pins and weights must share one integer dtype "
+                        "(int32, uint32, int64 or uint64)");
+        return nullptr;
+    }
+    if (part.view.itemsize != 1 || part.type_code() != 'B') {
+        PyErr_SetString(PyExc_TypeError, "part must be an array of uint8");
+        return nullptr;
+    }
+    if (part.view.len > std::numeric_limits<std::uint32_t>::max()) {
+        PyErr_SetString(PyExc_ValueError, "Too many modules");
+        return nullptr;
+    }
+    const auto num_modules = static_cast<std::uint32_t>(part.view.len);
+    const auto part_span
+        = std::span<std::uint8_t>{static_cast<std::uint8_t*>(part.view.buf), num_modules};
+
+    auto cost = 0;
+    auto error = std::string{};
+    auto is_value_error = false;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        switch (kind) {
+            case IndexKind::Int32:
+                cost = run_csr<std::int32_t>(num_modules, offsets, pins, weights, part_span,
+                                             options);
+                break;
+            case IndexKind::UInt32:
+                cost = run_csr<std::uint32_t>(num_modules, offsets, pins, weights, part_span,
+                                              options);
+                break;
+            case IndexKind::Int64:
+                cost = run_csr<std::int64_t>(num_modules, offsets, pins, weights, part_span,
+                                             options);
+                break;
+            case IndexKind::UInt64:
+            default:
+                cost = run_csr<std::uint64_t>(num_modules, offsets, pins, weights, part_span,
+                                              options);
+                break;
+        }
+    } catch (const std::invalid_argument& e) {
+        error = e.what();
+        is_value_error = true;
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS
+
+    if (!error.empty()) {
+        PyErr_SetString(is_value_error ? PyExc_ValueError : PyExc_RuntimeError, error.c_str());
+        return nullptr;
+    }
+    return PyLong_FromLong(cost);
+}
+
+static PyMethodDef ckpttn_methods[] = {
+    {"partition", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(ckpttn_partition)),
+     METH_VARARGS | METH_KEYWORDS,
+     "partition(offsets, pins, part, num_parts=2, epsilon=0.05, refiner='fm', weights=None,\n"
+     "          num_vcycles=0, seed=1, initial=False) -> int\n\n"
+     "Partitions the hypergraph whose net i has the pins pins[offsets[i]:offsets[i + 1]]\n"
+     "into num_parts parts with the multilevel partitioner, and returns the cost.\n"
+     "epsilon is the balance tolerance, as the epsilon of the command line.\n"
+     "The number of modules is len(part). The partition is written into part, a\n"
+     "writable uint8 array, which is also the initial partition if initial is set.\n"
+     "offsets, pins and weights must share one integer dtype; they are read without a\n"
+     "Python-side copy. int32 and uint32 offsets and pins are partitioned in place,\n"
+     "unless a net repeats a module; other dtypes are converted once.\n"
+     "refiner is 'fm', 'nn' (No-Nonsense) or 'kway' (K-way gains even for 2 parts).\n"
+     "The GIL is released while partitioning."},
+    {nullptr, nullptr, 0, nullptr}};
+
+static PyModuleDef ckpttn_module = {PyModuleDef_HEAD_INIT,
+                                    "ckpttn",
+                                    "Circuit partitioning on buffers (NumPy arrays)",
+                                    -1,
+                                    ckpttn_methods,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr};
+
+PyMODINIT_FUNC PyInit_ckpttn() { return PyModule_Create(&ckpttn_module); }
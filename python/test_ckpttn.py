@@ -0,0 +1,133 @@
+"""Tests of the ckpttn extension module.
+
+The arrays are `array.array` objects, which export the same buffers as NumPy
+arrays, so that the tests run without NumPy; the NumPy test is skipped when
+NumPy is not installed.
+"""
+
+import threading
+import unittest
+from array import array
+
+import ckpttn
+
+
+def grid_hypergraph(rows, cols):
+    """Returns the CSR arrays of a grid with a 2-pin net per edge and a
+    4-pin net per square."""
+    pins = []
+    offsets = [0]
+
+    def add_net(*modules):
+        pins.extend(modules)
+        offsets.append(len(pins))
+
+    for r in range(rows):
+        for c in range(cols):
+            v = r * cols + c
+            if c + 1 < cols:
+                add_net(v, v + 1)
+            if r + 1 < rows:
+                add_net(v, v + cols)
+            if r + 1 < rows and c + 1 < cols:
+                add_net(v, v + 1, v + cols, v + cols + 1)
+    return offsets, pins
+
+
+def km1_cost(offsets, pins, part):
+    """Returns the sum over the nets of the number of parts they span minus one."""
+    return sum(
+        len({part[v] for v in pins[offsets[i] : offsets[i + 1]]}) - 1
+        for i in range(len(offsets) - 1)
+    )
+
+
+class TestPartition(unittest.TestCase):
+    def setUp(self):
+        offsets, pins = grid_hypergraph(20, 20)
+        self.offsets = array("q", offsets)
+        self.pins = array("q", pins)
+        self.num_modules = 400
+
+    def check_partition(self, part, cost, num_parts, epsilon):
+        self.assertEqual(cost, km1_cost(self.offsets, self.pins, part))
+        sizes = [0] * num_parts
+        for p in part:
+            sizes[p] += 1
+        # the lower bound of the constraint managers
+        self.assertGreaterEqual(min(sizes), round(self.num_modules * 2.0 / num_parts * epsilon))
+
+    def test_refiners(self):
+        for refiner in ("fm", "nn", "kway"):
+            for num_parts in (2, 4):
+                with self.subTest(refiner=refiner, num_parts=num_parts):
+                    part = array("B", bytes(self.num_modules))
+                    cost = ckpttn.partition(
+                        self.offsets, self.pins, part, num_parts=num_parts, epsilon=0.1,
+                        refiner=refiner,
+                    )
+                    self.assertGreater(cost, 0)
+                    self.check_partition(part, cost, num_parts, 0.1)
+
+    def test_index_types_and_weights(self):
+        part = bytearray(self.num_modules)
+        offsets = array("i", self.offsets)
+        pins = array("i", self.pins)
+        weights = array("i", [1] * self.num_modules)
+        cost = ckpttn.partition(offsets, pins, part, weights=weights, seed=3)
+        self.check_partition(part, cost, 2, 0.05)
+
+        # the result as the initial partition
+        cost2 = ckpttn.partition(offsets, pins, part, weights=weights, initial=True)
+        self.check_partition(part, cost2, 2, 0.05)
+
+    def test_errors(self):
+        part = bytearray(self.num_modules)
+        with self.assertRaises(TypeError):
+            ckpttn.partition(array("i", self.offsets), self.pins, part)
+        with self.assertRaises(TypeError):
+            ckpttn.partition(self.offsets, self.pins, array("i", [0] * self.num_modules))
+        with self.assertRaises(BufferError):
+            ckpttn.partition(self.offsets, self.pins, bytes(self.num_modules))
+        with self.assertRaises(ValueError):
+            ckpttn.partition(self.offsets, self.pins, bytearray(10))
+        with self.assertRaises(ValueError):
+            ckpttn.partition(self.offsets, self.pins, part, refiner="nope")
+        with self.assertRaises(ValueError):
+            ckpttn.partition(self.offsets, self.pins, part, num_parts=1)
+        with self.assertRaises(ValueError):
+            ckpttn.partition(array("q", [0, 2, 1]), array("q", [0, 1]), bytearray(2))
+
+    def test_threads(self):
+        parts = [bytearray(self.num_modules) for _ in range(4)]
+        costs = [0] * len(parts)
+
+        def run(i):
+            costs[i] = ckpttn.partition(
+                self.offsets, self.pins, parts[i], num_parts=2 + i % 2, epsilon=0.1, seed=i + 1
+            )
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(len(parts))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for i, part in enumerate(parts):
+            self.check_partition(part, costs[i], 2 + i % 2, 0.1)
+
+    def test_numpy(self):
+        try:
+            import numpy as np
+        except ImportError:
+            self.skipTest("NumPy is not installed")
+        offsets = np.asarray(self.offsets, dtype=np.int64)
+        pins = np.asarray(self.pins, dtype=np.int64)
+        part = np.zeros(self.num_modules, dtype=np.uint8)
+        cost = ckpttn.partition(offsets, pins, part, num_parts=3, epsilon=0.1)
+        self.check_partition(part, cost, 3, 0.1)
+        with self.assertRaises(ValueError):
+            ckpttn.partition(offsets, pins, np.zeros((20, 20), dtype=np.uint8))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,107 @@
+#include <algorithm>                       // for max, min, sort
+#include <atomic>                          // for atomic
+#include <ckpttn/BatchPartitioner.hpp>     // for BatchOptions, partition_batch
+#include <ckpttn/FMBiConstrMgr.hpp>        // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>          // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>      // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>        // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>            // for FMPartMgr
+#include <ckpttn/MLPartMgr.hpp>            // for MLPartMgr
+#include <ckpttn/PreprocessedNetlist.hpp>  // for large_net_cost
+#include <ckpttn/TaskScheduler.hpp>        // for TaskScheduler, TaskGroup
+#include <cstdint>                         // for uint8_t, uint32_t
+#include <numeric>                         // for iota
+#include <random>                          // for mt19937, uniform_int_distribution
+#include <stdexcept>                       // for invalid_argument
+#include <vector>                          // for vector
+
+/**
+ * @brief Partitions one netlist of a batch.
+ *
+ * @param[in,out] ml_mgr The multilevel partitioner of the worker
+ * @param[in] hyprgraph The netlist
+ * @param[out] part The partition (resized)
+ * @param[in] options The options of the batch
+ * @param[in] index The index of the netlist in the batch
+ * @return The cost of the partition
+ */
+static auto partition_one(MLPartMgr& ml_mgr, const SimpleNetlist& hyprgraph,
+                          std::vector<std::uint8_t>& part, const BatchOptions& options,
+                          size_t index) -> int {
+    using BiPartMgr = FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                                FMBiConstrMgr<SimpleNetlist>>;
+    using KWayPartMgr = FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                  FMKWayConstrMgr<SimpleNetlist>>;
+
+    part.assign(hyprgraph.number_of_modules(), 0);
+    auto gen = std::mt19937{options.seed + static_cast<std::uint32_t>(index)};
+    auto dist = std::uniform_int_distribution<int>(0, options.num_parts - 1);
+    for (auto i = 0U; i != hyprgraph.number_of_modules(); ++i) {
+        if (!hyprgraph.module_fixed.contains(i)) {
+            part[i] = static_cast<std::uint8_t>(dist(gen));
+        }
+    }
+    if (options.num_parts == 2) {
+        ml_mgr.run_Partition<SimpleNetlist, BiPartMgr>(hyprgraph, part);
+    } else {
+        ml_mgr.run_Partition<SimpleNetlist, KWayPartMgr>(hyprgraph, part);
+    }
+    return ml_mgr.total_cost + large_net_cost(hyprgraph, part);
+}
+
+auto partition_batch(std::span<const SimpleNetlist> netlists,
+                     std::span<std::vector<std::uint8_t>> parts, const BatchOptions& options)
+    -> std::vector<int> {
+    auto scratch = BatchScratch{};
+    return partition_batch(netlists, parts, options, scratch);
+}
+
+auto partition_batch(std::span<const SimpleNetlist> netlists,
+                     std::span<std::vector<std::uint8_t>> parts, const BatchOptions& options,
+                     BatchScratch& scratch) -> std::vector<int> {
+    if (netlists.size() != parts.size()) {
+        throw std::invalid_argument("partition_batch: one partition per netlist is required");
+    }
+    if (options.num_parts < 2) {
+        throw std::invalid_argument("partition_batch: at least 2 parts are required");
+    }
+
+    // largest first, so that the last netlists taken are the short ones
+    auto order = std::vector<size_t>(netlists.size());
+    std::iota(order.begin(), order.end(), size_t{0U});
+    std::sort(order.begin(), order.end(), [&netlists](size_t a, size_t b) {
+        return netlists[a].number_of_modules() > netlists[b].number_of_modules();
+    });
+
+    auto& scheduler = TaskScheduler::current();
+    auto costs = std::vector<int>(netlists.size(), 0);
+    auto next = std::atomic<size_t>{0U};
+    auto worker = [&](size_t w) {
+        // nested parallel steps would only add overhead to such small runs
+        auto serial = TaskScheduler{1U};
+        serial.set_deterministic(scheduler.is_deterministic());
+        auto ml_mgr = MLPartMgr{options.bal_tol, options.num_parts};
+        ml_mgr.set_num_vcycles(options.num_vcycles);
+        ml_mgr.set_scheduler(&serial);
+        ml_mgr.set_gain_scratch(&scratch.workers[w]);
+        for (auto i = next++; i < order.size(); i = next++) {
+            const auto index = order[i];
+            costs[index] = partition_one(ml_mgr, netlists[index], parts[index], options, index);
+        }
+    };
+
+    const auto num_workers = std::min(scheduler.num_threads(), netlists.size());
+    if (scratch.workers.size() < std::max(num_workers, size_t{1U})) {
+        scratch.workers.resize(std::max(num_workers, size_t{1U}));
+    }
+    if (num_workers <= 1U) {
+        worker(0U);
+        return costs;
+    }
+    auto group = TaskGroup{scheduler};
+    for (auto w = size_t{0U}; w != num_workers; ++w) {
+        group.run([&worker, w]() { worker(w); });
+    }
+    group.wait();
+    return costs;
+}
@@ -0,0 +1,251 @@
+#include <ckpttn/BatchPipeline.hpp>    // for run_batch_pipeline, PipelineOptions
+#include <ckpttn/PartitionServer.hpp>  // for NetlistCache, PartitionJob, ...
+#include <ckpttn/TaskScheduler.hpp>    // for TaskScheduler
+#include <condition_variable>          // for condition_variable
+#include <cstddef>                     // for size_t
+#include <deque>                       // for deque
+#include <exception>                   // for exception
+#include <fstream>                     // for ofstream
+#include <memory>                      // for shared_ptr
+#include <mutex>                       // for mutex, lock_guard, unique_lock
+#include <netlistx/readwrite.hpp>      // for write_partition, OutputFormat
+#include <optional>                    // for optional
+#include <sstream>                     // for istringstream
+#include <string>                      // for string, getline, to_string
+#include <thread>                      // for thread
+#include <utility>                     // for move
+#include <vector>                      // for vector
+
+/**
+ * @brief A queue of bounded capacity between two stages of the pipeline
+ *
+ * `push` waits while the queue is full and `pop` while it is empty, until
+ * the queue is closed.
+ */
+template <typename T> class BoundedQueue {
+  private:
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::deque<T> items;
+    size_t capacity;
+    bool closed{false};
+
+  public:
+    /**
+     * @brief Constructs a new BoundedQueue object.
+     *
+     * @param[in] capacity The maximum number of items (at least 1).
+     */
+    explicit BoundedQueue(size_t capacity) : capacity{capacity != 0U ? capacity : 1U} {}
+
+    /**
+     * @brief Appends an item, waiting for room.
+     *
+     * @param[in] item The item
+     */
+    void push(T item) {
+        auto lock = std::unique_lock<std::mutex>{this->mutex};
+        this->not_full.wait(lock, [this]() { return this->items.size() < this->capacity; });
+        this->items.push_back(std::move(item));
+        this->not_empty.notify_one();
+    }
+
+    /**
+     * @brief Removes the first item, waiting for one.
+     *
+     * @return The item, or none if the queue is closed and empty
+     */
+    auto pop() -> std::optional<T> {
+        auto lock = std::unique_lock<std::mutex>{this->mutex};
+        this->not_empty.wait(lock, [this]() { return !this->items.empty() || this->closed; });
+        if (this->items.empty()) {
+            return std::nullopt;
+        }
+        auto item = std::move(this->items.front());
+        this->items.pop_front();
+        this->not_full.notify_one();
+        return item;
+    }
+
+    /**
+     * @brief Closes the queue: no more items will be pushed.
+     */
+    void close() {
+        auto lock = std::lock_guard<std::mutex>{this->mutex};
+        this->closed = true;
+        this->not_empty.notify_all();
+    }
+};
+
+/**
+ * @brief A job of the manifest with its netlist
+ */
+struct ParsedJob {
+    /// @brief The line number in the manifest
+    size_t line{};
+    PartitionJob job;
+    /// @brief The partition file
+    std::string output;
+    /// @brief The netlist (null if the job failed)
+    std::shared_ptr<const NetlistCache::Entry> entry;
+    bool cached{false};
+    /// @brief The error of a failed job
+    std::string error;
+};
+
+/**
+ * @brief A finished job
+ */
+struct FinishedJob {
+    /// @brief The line number in the manifest
+    size_t line{};
+    /// @brief The partition file
+    std::string output;
+    PartitionResult result;
+    /// @brief The error of a failed job
+    std::string error;
+};
+
+/**
+ * @brief Parses a line of the manifest.
+ *
+ * @param[in] text The line
+ * @param[out] parsed The job and its output file
+ * @throw std::runtime_error if an argument is unknown or invalid
+ */
+static void parse_manifest_line(const std::string& text, ParsedJob& parsed) {
+    auto tokens = std::istringstream{text};
+    auto args = std::string{};
+    auto token = std::string{};
+    while (tokens >> token) {
+        if (token.rfind("output=", 0) == 0) {
+            parsed.output = token.substr(7);
+        } else {
+            args += token + ' ';
+        }
+    }
+    auto stream = std::istringstream{args};
+    parsed.job = parse_partition_job(stream);
+    if (parsed.output.empty()) {
+        parsed.output = parsed.job.filename + ".part." + std::to_string(parsed.job.num_parts);
+    }
+}
+
+/**
+ * @brief Runs the jobs of a manifest in a three-stage pipeline.
+ *
+ * @param[in] manifest The manifest
+ * @param[out] report The report
+ * @param[in] options The options
+ * @return The summary
+ */
+auto run_batch_pipeline(std::istream& manifest, std::ostream& report,
+                        const PipelineOptions& options) -> PipelineSummary {
+    auto* scheduler = &TaskScheduler::current();
+    const auto num_parsers = options.num_parsers != 0U ? options.num_parsers : 1U;
+    const auto num_workers
+        = options.num_workers != 0U ? options.num_workers : scheduler->num_threads();
+    auto cache = NetlistCache{options.cache_capacity};
+    auto parsed_jobs = BoundedQueue<ParsedJob>{options.queue_capacity};
+    auto finished_jobs = BoundedQueue<FinishedJob>{options.queue_capacity};
+
+    // 1. Parsers: the next line of the manifest, then its netlist
+    auto manifest_mutex = std::mutex{};
+    auto line_count = size_t{0U};
+    auto parse = [&]() {
+        auto text = std::string{};
+        while (true) {
+            auto parsed = ParsedJob{};
+            {
+                auto lock = std::lock_guard<std::mutex>{manifest_mutex};
+                if (!std::getline(manifest, text)) {
+                    return;
+                }
+                parsed.line = ++line_count;
+            }
+            const auto first = text.find_first_not_of(" \t\r");
+            if (first == std::string::npos || text[first] == '#') {
+                continue;
+            }
+            try {
+                parse_manifest_line(text, parsed);
+                parsed.entry = cache.get(parsed.job.filename, parsed.job.format, parsed.cached);
+            } catch (const std::exception& e) {
+                parsed.error = e.what();
+            }
+            parsed_jobs.push(std::move(parsed));
+        }
+    };
+
+    // 2. Workers: the jobs
+    auto work = [&]() {
+        while (auto parsed = parsed_jobs.pop()) {
+            auto finished = FinishedJob{parsed->line, std::move(parsed->output), {},
+                                        std::move(parsed->error)};
+            if (finished.error.empty()) {
+                try {
+                    finished.result = run_partition_job(*parsed->entry, parsed->job);
+                    finished.result.cached = parsed->cached;
+                } catch (const std::exception& e) {
+                    finished.error = e.what();
+                }
+            }
+            parsed->entry.reset();  // the cache may evict the netlist now
+            finished_jobs.push(std::move(finished));
+        }
+    };
+
+    // 3. Writer: the partitions and the report
+    auto summary = PipelineSummary{};
+    auto write = [&]() {
+        while (auto finished = finished_jobs.pop()) {
+            ++summary.num_jobs;
+            if (finished->error.empty()) {
+                auto file = std::ofstream{finished->output};
+                if (file.fail()) {
+                    finished->error = "Can't open " + finished->output;
+                } else {
+                    write_partition(finished->result.part, file, OutputFormat::hmetis);
+                }
+            }
+            if (!finished->error.empty()) {
+                ++summary.num_failed;
+                report << finished->line << " error " << finished->error << '\n';
+            } else {
+                report << finished->line << " ok cost=" << finished->result.cost
+                       << " cached=" << (finished->result.cached ? 1 : 0)
+                       << " output=" << finished->output << '\n';
+            }
+            report.flush();
+        }
+    };
+
+    auto writer = std::thread{write};
+    auto workers = std::vector<std::thread>{};
+    for (auto i = size_t{0U}; i != num_workers; ++i) {
+        workers.emplace_back([&work, scheduler]() {
+            auto scope = TaskScheduler::Scope{scheduler};
+            work();
+        });
+    }
+    auto parsers = std::vector<std::thread>{};
+    for (auto i = size_t{0U}; i != num_parsers; ++i) {
+        parsers.emplace_back([&parse, scheduler]() {
+            auto scope = TaskScheduler::Scope{scheduler};
+            parse();
+        });
+    }
+
+    // each stage ends when the one before it is done
+    for (auto& parser : parsers) {
+        parser.join();
+    }
+    parsed_jobs.close();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    finished_jobs.close();
+    writer.join();
+    return summary;
+}
@@ -0,0 +1,206 @@
+#include <algorithm>                       // for max
+#include <ckpttn/CoarseningCtrl.hpp>       // for CoarseningCtrl, CoarseningLevel
+#include <ckpttn/CoarseningHierarchy.hpp>  // for CoarseningHierarchy
+#include <ckpttn/CsrNetlist.hpp>           // for CsrNetlist
+#include <ckpttn/HierNetlist.hpp>          // for SimpleHierNetlist, CsrHierNetlist
+#include <cmath>                           // for round
+#include <cstdint>                         // for uint32_t
+#include <memory>                          // for unique_ptr
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <py2cpp/set.hpp>                  // for set
+#include <span>                            // for span
+
+using node_t = SimpleNetlist::node_t;
+extern auto create_contracted_subgraph(const SimpleNetlist&, py::set<node_t>,
+                                       std::span<const std::uint32_t>, unsigned int)
+    -> std::unique_ptr<SimpleHierNetlist>;
+extern auto create_contracted_subgraph(const CsrNetlist&, py::set<node_t>,
+                                       std::span<const std::uint32_t>, unsigned int)
+    -> std::unique_ptr<CsrHierNetlist>;
+extern auto create_clustered_subgraph(const SimpleNetlist&, std::span<const std::uint32_t>,
+                                      std::span<const std::uint32_t>, unsigned int)
+    -> std::unique_ptr<SimpleHierNetlist>;
+
+/**
+ * @brief Returns the total module weight of a hypergraph.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] hyprgraph The hypergraph
+ * @return The sum of the module weights
+ */
+template <typename Gnl> static auto total_module_weight(const Gnl& hyprgraph) -> unsigned int {
+    auto total_weight = 0U;
+    for (const auto& v : hyprgraph) {
+        total_weight += hyprgraph.get_module_weight(v);
+    }
+    return total_weight;
+}
+
+/**
+ * @brief Returns the maximum weight of a part under the balance constraint.
+ *
+ * A part may be this heavy while every other part still meets the lower
+ * bound of `FMConstrMgr`.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @return The maximum weight of a part
+ */
+auto CoarseningCtrl::max_part_weight(const SimpleNetlist& hyprgraph) const -> unsigned int {
+    return this->part_weight_bound(total_module_weight(hyprgraph));
+}
+
+/**
+ * @brief Returns the maximum weight of a part, given the total weight.
+ *
+ * @param[in] total_weight The total module weight
+ * @return The maximum weight of a part
+ */
+auto CoarseningCtrl::part_weight_bound(unsigned int total_weight) const -> unsigned int {
+    const auto lowerbound = static_cast<unsigned int>(
+        std::round(total_weight * (2.0 / this->num_parts) * this->bal_tol));
+    const auto others = (this->num_parts - 1U) * lowerbound;
+    return total_weight > others ? total_weight - others : 0U;
+}
+
+/**
+ * @brief Returns the initial cluster weight bound for a hypergraph.
+ *
+ * The balance slack of a part is how much heavier than the average it may
+ * become, i.e. `max_part_weight` minus the average. A cluster heavier than
+ * that can make the coarse levels impossible to balance. When the slack is
+ * tiny, the average module weight of the coarsest level is used instead, so
+ * that coarsening can still reach the coarsest size.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @return The maximum weight of a new cluster
+ */
+auto CoarseningCtrl::max_cluster_weight(const SimpleNetlist& hyprgraph) const -> unsigned int {
+    return this->cluster_weight_bound(total_module_weight(hyprgraph));
+}
+
+/**
+ * @brief Returns the initial cluster weight bound, given the total weight.
+ *
+ * @param[in] total_weight The total module weight
+ * @return The maximum weight of a new cluster
+ */
+auto CoarseningCtrl::cluster_weight_bound(unsigned int total_weight) const -> unsigned int {
+    const auto upperbound = this->part_weight_bound(total_weight);
+    const auto average = (total_weight + this->num_parts - 1U) / this->num_parts;
+    const auto slack = upperbound > average ? upperbound - average : 0U;
+    const auto coarsest = static_cast<unsigned int>(std::max<size_t>(this->coarsest_size(), 1U));
+    const auto per_module = (total_weight + coarsest - 1U) / coarsest;
+    return std::max({slack, per_module, 1U});
+}
+
+/**
+ * @brief Contracts one level, retrying with a relaxed bound when it stalls.
+ *
+ * The first attempt uses `max_cluster_weight`. Each retry doubles the bound,
+ * up to `max_part_weight`, which the last retry uses: a heavier cluster
+ * could not fit in any part. The first contraction whose ratio is within
+ * `max_ratio` is accepted and recorded; if even the last one is not,
+ * coarsening has stalled.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] hyprgraph The hypergraph to contract
+ * @param[in] keep The labels to be preserved, e.g. a partition (empty = none)
+ * @return The contracted netlist, or nullptr if coarsening has stalled
+ */
+template <typename Gnl>
+auto CoarseningCtrl::contract(const Gnl& hyprgraph, std::span<const std::uint32_t> keep)
+    -> std::unique_ptr<HierNetlist<xnetwork::SimpleGraph, Gnl>> {
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto total_weight = total_module_weight(hyprgraph);
+    auto bound = this->cluster_weight_bound(total_weight);
+    const auto cap = std::max(bound, this->part_weight_bound(total_weight));
+    for (auto attempt = 0U; attempt <= this->max_retries; ++attempt) {
+        if (attempt == this->max_retries) {
+            bound = cap;
+        }
+        auto hgr2 = create_contracted_subgraph(hyprgraph, py::set<node_t>{}, keep, bound);
+        const auto num_modules2 = hgr2->number_of_modules();
+        const auto ratio = double(num_modules2) / double(num_modules);
+        if (ratio <= this->max_ratio) {
+            this->levels.push_back({num_modules, num_modules2, bound, ratio});
+            return hgr2;
+        }
+        if (bound == cap) {
+            break;
+        }
+        bound = bound > cap / 2U ? cap : bound * 2U;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Contracts one level, retrying with a relaxed bound when it stalls.
+ *
+ * The first level of the seeded hypergraph is contracted from the seed
+ * clusters, with `max_cluster_weight` as the bound, and is accepted if it has
+ * fewer modules. Otherwise, the level is contracted by matching (see
+ * `contract`).
+ *
+ * @param[in] hyprgraph The hypergraph to contract
+ * @param[in] keep The labels to be preserved, e.g. a partition (empty = none)
+ * @return The contracted netlist, or nullptr if coarsening has stalled
+ */
+auto CoarseningCtrl::coarsen(const SimpleNetlist& hyprgraph, std::span<const std::uint32_t> keep)
+    -> std::unique_ptr<SimpleHierNetlist> {
+    if (&hyprgraph == this->seed_netlist && this->levels.empty()) {
+        const auto num_modules = hyprgraph.number_of_modules();
+        const auto bound = this->max_cluster_weight(hyprgraph);
+        auto hgr2 = create_clustered_subgraph(hyprgraph, this->seed_clusters, keep, bound);
+        const auto num_modules2 = hgr2->number_of_modules();
+        if (num_modules2 < num_modules) {
+            const auto ratio = double(num_modules2) / double(num_modules);
+            this->levels.push_back({num_modules, num_modules2, bound, ratio});
+            return hgr2;
+        }
+    }
+    return this->contract(hyprgraph, keep);
+}
+
+/**
+ * @brief Contracts the first level of a CSR netlist.
+ *
+ * @param[in] hyprgraph The hypergraph to contract
+ * @param[in] keep The labels to be preserved, e.g. a partition (empty = none)
+ * @return The contracted netlist, or nullptr if coarsening has stalled
+ */
+auto CoarseningCtrl::coarsen(const CsrNetlist& hyprgraph, std::span<const std::uint32_t> keep)
+    -> std::unique_ptr<CsrHierNetlist> {
+    return this->contract(hyprgraph, keep);
+}
+
+/**
+ * @brief Returns the level of the hierarchy contracted from a hypergraph.
+ *
+ * A module of the level that is heavier than the current bound is
+ * admissible only if it is not heavier than the heaviest module of
+ * `hyprgraph`, e.g. a large macro that was not merged.
+ *
+ * @param[in] hyprgraph The hypergraph to contract
+ * @return The level, or nullptr if there is none or it is not admissible
+ */
+auto CoarseningCtrl::reuse(const SimpleNetlist& hyprgraph) -> const SimpleHierNetlist* {
+    if (this->hierarchy == nullptr) {
+        return nullptr;
+    }
+    const auto i = this->hierarchy->find_coarser(hyprgraph);
+    if (i == this->hierarchy->size()) {
+        return nullptr;
+    }
+    const auto& hgr2 = this->hierarchy->get_level(i);
+    auto bound = this->max_cluster_weight(hyprgraph);
+    for (const auto& v : hyprgraph) {
+        bound = std::max(bound, hyprgraph.get_module_weight(v));
+    }
+    for (const auto& v : hgr2) {
+        if (hgr2.get_module_weight(v) > bound) {
+            return nullptr;
+        }
+    }
+    this->levels.push_back(this->hierarchy->get_stats()[i]);
+    return &hgr2;
+}
@@ -0,0 +1,282 @@
+#include <ckpttn/CoarseningCtrl.hpp>       // for CoarseningCtrl, CoarseningLevel
+#include <ckpttn/CoarseningHierarchy.hpp>  // for CoarseningHierarchy
+#include <ckpttn/HierNetlist.hpp>          // for SimpleHierNetlist
+#include <ckpttn/MappedFile.hpp>           // for MappedFile
+#include <cstdint>                         // for uint32_t, uint64_t
+#include <cstring>                         // for memcpy
+#include <fstream>                         // for ofstream
+#include <memory>                          // for unique_ptr, make_unique
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <py2cpp/range.hpp>                // for range
+#include <span>                            // for span
+#include <stdexcept>                       // for runtime_error
+#include <string>                          // for string
+#include <string_view>                     // for string_view
+#include <utility>                         // for move
+#include <vector>                          // for vector
+#include <xnetwork/classes/graph.hpp>      // for SimpleGraph
+
+// File layout (native byte order), every section padded to 8 bytes:
+//
+//   HierarchyFileHeader
+//   for each level:
+//     HierarchyLevelHeader
+//     uint32_t node_up_map[number of modules of the parent]
+//     uint32_t module_weight[num_modules]
+//     uint32_t net_weight[num_nets]        (if has_net_weight)
+//     uint64_t net_offsets[num_nets + 1]
+//     uint32_t pins[num_pins]              (modules of the level)
+
+/// @brief Magic number of a hierarchy file
+static constexpr char HIERARCHY_MAGIC[8] = {'C', 'K', 'P', 'T', 'H', 'I', 'E', 'R'};
+/// @brief Version of the hierarchy file format
+static constexpr std::uint32_t HIERARCHY_VERSION = 1U;
+
+struct HierarchyFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t num_levels;
+    /// @brief Fingerprint of the finest hypergraph (see `netlist_fingerprint`)
+    std::uint64_t fingerprint;
+};
+
+struct HierarchyLevelHeader {
+    std::uint32_t num_modules;
+    std::uint32_t num_nets;
+    /// @brief Cluster weight bound that was used (see `CoarseningLevel`)
+    std::uint32_t max_cluster_weight;
+    std::uint32_t has_net_weight;
+    std::uint64_t num_pins;
+};
+
+/**
+ * @brief Mixes a value into a hash (splitmix64 finalizer).
+ *
+ * @param[in] x The value
+ * @return The hash of the value
+ */
+static auto mix64(std::uint64_t x) -> std::uint64_t {
+    x += 0x9e3779b97f4a7c15U;
+    x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9U;
+    x = (x ^ (x >> 27U)) * 0x94d049bb133111ebU;
+    return x ^ (x >> 31U);
+}
+
+/**
+ * @brief Returns a fingerprint of the pins, module weights and fixed modules.
+ *
+ * The pins of a net and the fixed modules are combined in any order, so that
+ * the fingerprint does not depend on the iteration order of the sets.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @return The fingerprint
+ */
+static auto netlist_fingerprint(const SimpleNetlist& hyprgraph) -> std::uint64_t {
+    auto hash = mix64(hyprgraph.number_of_modules()) ^ mix64(~hyprgraph.number_of_nets());
+    for (const auto& net : hyprgraph.nets) {
+        auto pins = std::uint64_t{0U};
+        for (const auto& v : hyprgraph.gr[net]) {
+            pins += mix64(v);
+        }
+        hash = mix64(hash ^ pins);
+    }
+    for (const auto& v : hyprgraph) {
+        hash = mix64(hash ^ hyprgraph.get_module_weight(v));
+    }
+    auto fixed = std::uint64_t{0U};
+    for (const auto& v : hyprgraph.module_fixed) {
+        fixed += mix64(v);
+    }
+    return mix64(hash ^ fixed);
+}
+
+void CoarseningHierarchy::build(CoarseningCtrl& ctrl) {
+    ctrl.clear_levels();
+    this->levels.clear();
+    const SimpleNetlist* current = this->hyprgraph;
+    while (ctrl.should_coarsen(*current)) {
+        auto hgr2 = ctrl.coarsen(*current);
+        if (hgr2 == nullptr) {
+            break;
+        }
+        current = hgr2.get();
+        this->levels.push_back(std::move(hgr2));
+    }
+    this->stats = ctrl.get_levels();
+}
+
+auto CoarseningHierarchy::find_coarser(const SimpleNetlist& hgr) const -> size_t {
+    for (auto i = 0U; i != this->levels.size(); ++i) {
+        if (this->levels[i]->parent == &hgr) {
+            return i;
+        }
+    }
+    return this->levels.size();
+}
+
+/**
+ * @brief Writes an array, padded to 8 bytes.
+ *
+ * @param[in,out] out The stream
+ * @param[in] data The array
+ */
+template <typename T> static void write_array(std::ofstream& out, std::span<const T> data) {
+    static constexpr char padding[8] = {};
+    const auto num_bytes = data.size_bytes();
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(num_bytes));
+    out.write(padding, static_cast<std::streamsize>((8U - num_bytes % 8U) % 8U));
+}
+
+void CoarseningHierarchy::save(const std::string& filename) const {
+    auto out = std::ofstream{filename, std::ios::binary};
+    if (out.fail()) {
+        throw std::runtime_error("Can't open " + filename);
+    }
+    auto header = HierarchyFileHeader{};
+    std::memcpy(header.magic, HIERARCHY_MAGIC, sizeof(header.magic));
+    header.version = HIERARCHY_VERSION;
+    header.num_levels = static_cast<std::uint32_t>(this->levels.size());
+    header.fingerprint = netlist_fingerprint(*this->hyprgraph);
+    write_array(out, std::span<const HierarchyFileHeader>{&header, 1U});
+
+    auto pins = std::vector<std::uint32_t>{};
+    auto offsets = std::vector<std::uint64_t>{};
+    auto buffer = std::vector<std::uint32_t>{};
+    for (auto i = 0U; i != this->levels.size(); ++i) {
+        const auto& hgr = *this->levels[i];
+        const auto num_modules = static_cast<std::uint32_t>(hgr.number_of_modules());
+        const auto num_nets = static_cast<std::uint32_t>(hgr.number_of_nets());
+
+        pins.clear();
+        offsets.assign(1U, 0U);
+        for (const auto& net : hgr.nets) {
+            for (const auto& v : hgr.gr[net]) {
+                pins.push_back(static_cast<std::uint32_t>(v));
+            }
+            offsets.push_back(pins.size());
+        }
+        const auto level_header = HierarchyLevelHeader{
+            num_modules, num_nets, this->stats[i].max_cluster_weight,
+            hgr.net_weight.empty() ? 0U : 1U, pins.size()};
+        write_array(out, std::span<const HierarchyLevelHeader>{&level_header, 1U});
+
+        buffer.assign(hgr.node_up_map.begin(), hgr.node_up_map.end());
+        write_array(out, std::span<const std::uint32_t>{buffer});
+        buffer.resize(num_modules);
+        for (const auto& v : hgr) {
+            buffer[v] = hgr.get_module_weight(v);
+        }
+        write_array(out, std::span<const std::uint32_t>{buffer});
+        if (!hgr.net_weight.empty()) {
+            buffer.resize(num_nets);
+            for (auto net = 0U; net != num_nets; ++net) {
+                buffer[net] = hgr.net_weight[net];
+            }
+            write_array(out, std::span<const std::uint32_t>{buffer});
+        }
+        write_array(out, std::span<const std::uint64_t>{offsets});
+        write_array(out, std::span<const std::uint32_t>{pins});
+    }
+    if (out.flush().fail()) {
+        throw std::runtime_error("Can't write " + filename);
+    }
+}
+
+/**
+ * @brief Sequential reader of the sections of a mapped hierarchy file
+ */
+class HierarchyReader {
+  private:
+    std::string_view data;
+    size_t pos{0U};
+
+  public:
+    explicit HierarchyReader(std::string_view data) : data{data} {}
+
+    /**
+     * @brief Returns the next array, which is used in place.
+     *
+     * @param[in] count The number of elements
+     * @return The array
+     * @throw std::runtime_error if the file is too short
+     */
+    template <typename T> auto take(size_t count) -> std::span<const T> {
+        const auto num_bytes = count * sizeof(T);
+        if (count > this->data.size() / sizeof(T) || this->pos > this->data.size()
+            || this->data.size() - this->pos < num_bytes) {
+            throw std::runtime_error("Truncated hierarchy file");
+        }
+        // the sections are 8-byte aligned, as is the mapping
+        const auto* first = reinterpret_cast<const T*>(this->data.data() + this->pos);
+        this->pos += (num_bytes + 7U) / 8U * 8U;
+        return {first, count};
+    }
+};
+
+void CoarseningHierarchy::load(const std::string& filename) {
+    const auto file = MappedFile{filename};
+    auto reader = HierarchyReader{file.view()};
+    const auto& header = reader.take<HierarchyFileHeader>(1U)[0];
+    if (std::memcmp(header.magic, HIERARCHY_MAGIC, sizeof(header.magic)) != 0
+        || header.version != HIERARCHY_VERSION) {
+        throw std::runtime_error(filename + " is not a hierarchy file");
+    }
+    if (header.fingerprint != netlist_fingerprint(*this->hyprgraph)) {
+        throw std::runtime_error(filename + " is the hierarchy of another netlist");
+    }
+
+    auto levels2 = std::vector<std::unique_ptr<SimpleHierNetlist>>{};
+    auto stats2 = std::vector<CoarseningLevel>{};
+    const SimpleNetlist* parent = this->hyprgraph;
+    for (auto i = 0U; i != header.num_levels; ++i) {
+        const auto& level_header = reader.take<HierarchyLevelHeader>(1U)[0];
+        const auto num_modules = level_header.num_modules;
+        const auto num_nets = level_header.num_nets;
+        const auto num_modules1 = parent->number_of_modules();
+        const auto node_up_map = reader.take<std::uint32_t>(num_modules1);
+        const auto module_weight = reader.take<std::uint32_t>(num_modules);
+        const auto net_weight = reader.take<std::uint32_t>(
+            level_header.has_net_weight != 0U ? num_nets : 0U);
+        const auto offsets = reader.take<std::uint64_t>(num_nets + size_t{1U});
+        const auto pins = reader.take<std::uint32_t>(level_header.num_pins);
+
+        auto gr = xnetwork::SimpleGraph(num_modules + num_nets);
+        for (auto net = 0U; net != num_nets; ++net) {
+            if (offsets[net] > offsets[net + 1] || offsets[net + 1] > pins.size()) {
+                throw std::runtime_error("Malformed hierarchy file " + filename);
+            }
+            for (auto j = offsets[net]; j != offsets[net + 1]; ++j) {
+                if (pins[j] >= num_modules) {
+                    throw std::runtime_error("Malformed hierarchy file " + filename);
+                }
+                gr.add_edge(pins[j], num_modules + net);
+            }
+        }
+        auto hgr2 = std::make_unique<SimpleHierNetlist>(
+            std::move(gr), py::range(num_modules), py::range(num_modules, num_modules + num_nets));
+        for (const auto& v : node_up_map) {
+            if (v >= num_modules) {
+                throw std::runtime_error("Malformed hierarchy file " + filename);
+            }
+        }
+        hgr2->node_up_map.assign(node_up_map.begin(), node_up_map.end());
+        hgr2->module_weight.assign(module_weight.begin(), module_weight.end());
+        if (!net_weight.empty()) {
+            hgr2->net_weight.set_start(0);
+            hgr2->net_weight.assign(net_weight.begin(), net_weight.end());
+        }
+        // a cluster is fixed if one of its modules is
+        for (const auto& v : parent->module_fixed) {
+            hgr2->module_fixed.insert(hgr2->node_up_map[v]);
+        }
+        hgr2->has_fixed_modules = !hgr2->module_fixed.empty();
+        hgr2->parent = parent;
+
+        stats2.push_back({num_modules1, num_modules, level_header.max_cluster_weight,
+                          double(num_modules) / double(num_modules1)});
+        parent = hgr2.get();
+        levels2.push_back(std::move(hgr2));
+    }
+    this->levels = std::move(levels2);
+    this->stats = std::move(stats2);
+}
@@ -0,0 +1,239 @@
+#include <algorithm>                    // for fill
+#include <atomic>                       // for atomic, memory_order_relaxed
+#include <ckpttn/ConnectivityInfo.hpp>  // for ConnectivityInfo
+#include <ckpttn/FMPmrConfig.hpp>       // for FM_MAX_DEGREE
+#include <ckpttn/parallel_for.hpp>      // for parallel_for, parallel_reduce
+#include <cstdint>                      // for uint8_t, uint32_t
+#include <span>                         // for span
+#include <vector>                       // for vector
+
+/// @brief Number of nets per block of the cost reduction
+static constexpr std::uint32_t COST_BLOCK_SIZE = 4096U;
+
+/**
+ * @brief Constructs a new ConnectivityInfo object.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] hyprgraph The hypergraph
+ * @param[in] num_parts The number of partitions
+ */
+template <typename Gnl>
+ConnectivityInfo<Gnl>::ConnectivityInfo(const Gnl& hyprgraph, std::uint8_t num_parts)
+    : hyprgraph{hyprgraph},
+      num_modules{static_cast<std::uint32_t>(hyprgraph.number_of_modules())},
+      num_parts{num_parts},
+      part_weight(num_parts),
+      pin_count(hyprgraph.number_of_nets() * num_parts) {}
+
+/**
+ * @brief Computes the counters of a partition (in parallel).
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] part The partition
+ * @param[in] num_tasks The number of tasks
+ */
+template <typename Gnl>
+void ConnectivityInfo<Gnl>::init(std::span<const std::uint8_t> part, size_t num_tasks) {
+    const auto& hgr = this->hyprgraph;
+    for (auto& weight : this->part_weight) {
+        weight.store(0U, std::memory_order_relaxed);
+    }
+    parallel_for(num_tasks, this->num_modules, [&](size_t, auto first, auto last) {
+        auto weight = std::vector<unsigned int>(this->num_parts, 0U);
+        for (auto v = first; v != last; ++v) {
+            weight[part[v]] += hgr.get_module_weight(v);
+        }
+        for (auto k = 0U; k != this->num_parts; ++k) {
+            this->part_weight[k].fetch_add(weight[k], std::memory_order_relaxed);
+        }
+    });
+    const auto num_nets = static_cast<std::uint32_t>(hgr.number_of_nets());
+    parallel_for(num_tasks, num_nets, [&](size_t, auto first, auto last) {
+        for (auto i_net = first; i_net != last; ++i_net) {
+            auto* count = &this->pin_count[i_net * this->num_parts];
+            for (auto k = 0U; k != this->num_parts; ++k) {
+                count[k].store(0U, std::memory_order_relaxed);
+            }
+            const auto net = this->num_modules + i_net;
+            if (!this->is_active(net)) {
+                continue;
+            }
+            for (const auto& v : hgr.gr[net]) {
+                count[part[v]].fetch_add(1U, std::memory_order_relaxed);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Returns the (K-1) connectivity cost (in parallel).
+ *
+ * @tparam Gnl The hypergraph type
+ * @return The cost
+ */
+template <typename Gnl> auto ConnectivityInfo<Gnl>::cost() const -> int {
+    const auto& hgr = this->hyprgraph;
+    const auto num_nets = static_cast<std::uint32_t>(hgr.number_of_nets());
+    return parallel_reduce(
+        num_nets, COST_BLOCK_SIZE, 0,
+        [&](auto first, auto last) {
+            auto cost = 0;
+            for (auto i_net = first; i_net != last; ++i_net) {
+                const auto net = this->num_modules + i_net;
+                if (!this->is_active(net)) {
+                    continue;
+                }
+                const auto* count = &this->pin_count[i_net * this->num_parts];
+                auto connectivity = 0;
+                for (auto k = 0U; k != this->num_parts; ++k) {
+                    if (count[k].load(std::memory_order_relaxed) != 0U) {
+                        ++connectivity;
+                    }
+                }
+                cost += (connectivity - 1) * static_cast<int>(hgr.get_net_weight(net));
+            }
+            return cost;
+        },
+        [](int lhs, int rhs) { return lhs + rhs; });
+}
+
+/**
+ * @brief Returns whether a net is tracked.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] net The net
+ * @return true if the net has 2 to FM_MAX_DEGREE pins
+ */
+template <typename Gnl> auto ConnectivityInfo<Gnl>::is_active(const node_t& net) const -> bool {
+    const auto degree = this->hyprgraph.gr.degree(net);
+    return degree >= 2 && degree <= FM_MAX_DEGREE;
+}
+
+/**
+ * @brief Computes the gain of moving a module to every part.
+ *
+ * Leaving a net where the module is the last pin of its part saves the net
+ * weight; joining a net that has no pin in the target part costs it.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] v The module
+ * @param[in] from_part The part of the module
+ * @param[out] gain The gain of moving to each part (gain[from_part] = 0)
+ */
+template <typename Gnl>
+void ConnectivityInfo<Gnl>::compute_gains(const node_t& v, std::uint8_t from_part,
+                                          std::span<int> gain) const {
+    std::fill(gain.begin(), gain.end(), 0);
+    auto leave_gain = 0;
+    for (const auto& net : this->hyprgraph.gr[v]) {
+        if (!this->is_active(net)) {
+            continue;
+        }
+        const auto weight = static_cast<int>(this->hyprgraph.get_net_weight(net));
+        const auto* count = &this->pin_count[(net - this->num_modules) * this->num_parts];
+        if (count[from_part].load(std::memory_order_relaxed) == 1U) {
+            leave_gain += weight;
+        }
+        for (auto k = 0U; k != this->num_parts; ++k) {
+            if (count[k].load(std::memory_order_relaxed) == 0U) {
+                gain[k] -= weight;
+            }
+        }
+    }
+    for (auto k = 0U; k != this->num_parts; ++k) {
+        gain[k] += leave_gain;
+    }
+    gain[from_part] = 0;
+}
+
+/**
+ * @brief Computes the gain of moving a module to one part.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] v The module
+ * @param[in] from_part The part of the module
+ * @param[in] to_part The target part
+ * @return The gain
+ */
+template <typename Gnl>
+auto ConnectivityInfo<Gnl>::move_gain(const node_t& v, std::uint8_t from_part,
+                                      std::uint8_t to_part) const -> int {
+    auto gain = 0;
+    for (const auto& net : this->hyprgraph.gr[v]) {
+        if (!this->is_active(net)) {
+            continue;
+        }
+        const auto weight = static_cast<int>(this->hyprgraph.get_net_weight(net));
+        const auto* count = &this->pin_count[(net - this->num_modules) * this->num_parts];
+        if (count[from_part].load(std::memory_order_relaxed) == 1U) {
+            gain += weight;
+        }
+        if (count[to_part].load(std::memory_order_relaxed) == 0U) {
+            gain -= weight;
+        }
+    }
+    return gain;
+}
+
+/**
+ * @brief Moves a module if the source part stays at or above the lower bound.
+ *
+ * The weight of the source part is updated with a compare-and-swap, so
+ * that it never drops below the lower bound, even for a moment.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] v The module
+ * @param[in] from_part The part of the module
+ * @param[in] to_part The target part
+ * @param[in] lowerbound The lower bound of the weight of every part
+ * @return true if the module was moved
+ */
+template <typename Gnl>
+auto ConnectivityInfo<Gnl>::try_move(const node_t& v, std::uint8_t from_part,
+                                     std::uint8_t to_part, unsigned int lowerbound) -> bool {
+    const auto weight_v = this->hyprgraph.get_module_weight(v);
+    auto& from_weight = this->part_weight[from_part];
+    auto weight = from_weight.load();
+    do {
+        if (weight < lowerbound + weight_v) {
+            return false;
+        }
+    } while (!from_weight.compare_exchange_weak(weight, weight - weight_v));
+    this->part_weight[to_part].fetch_add(weight_v);
+    for (const auto& net : this->hyprgraph.gr[v]) {
+        if (!this->is_active(net)) {
+            continue;
+        }
+        auto* count = &this->pin_count[(net - this->num_modules) * this->num_parts];
+        count[from_part].fetch_sub(1U, std::memory_order_relaxed);
+        count[to_part].fetch_add(1U, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+/**
+ * @brief Moves a module unconditionally (e.g. to revert a move).
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] v The module
+ * @param[in] from_part The part of the module
+ * @param[in] to_part The target part
+ */
+template <typename Gnl>
+void ConnectivityInfo<Gnl>::move(const node_t& v, std::uint8_t from_part, std::uint8_t to_part) {
+    const auto weight_v = this->hyprgraph.get_module_weight(v);
+    this->part_weight[from_part].fetch_sub(weight_v);
+    this->part_weight[to_part].fetch_add(weight_v);
+    for (const auto& net : this->hyprgraph.gr[v]) {
+        if (!this->is_active(net)) {
+            continue;
+        }
+        auto* count = &this->pin_count[(net - this->num_modules) * this->num_parts];
+        count[from_part].fetch_sub(1U, std::memory_order_relaxed);
+        count[to_part].fetch_add(1U, std::memory_order_relaxed);
+    }
+}
+
+#include <netlistx/netlist.hpp>  // for SimpleNetlist
+
+template class ConnectivityInfo<SimpleNetlist>;
@@ -0,0 +1,49 @@
+#include <ckpttn/CsrNetlist.hpp>  // for CsrGraph, CsrNetlist
+#include <cstdint>                // for uint32_t
+#include <span>                   // for span
+#include <utility>                // for move
+#include <vector>                 // for vector
+
+CsrGraph::CsrGraph(std::uint32_t num_modules, std::span<const node_t> net_offsets,
+                   std::span<const node_t> pins)
+    : num_modules{num_modules}, net_offsets{net_offsets}, pins{pins} {
+    this->transpose();
+}
+
+CsrGraph::CsrGraph(std::uint32_t num_modules, std::vector<node_t> net_offsets,
+                   std::vector<node_t> pins)
+    : num_modules{num_modules},
+      owned_net_offsets{std::move(net_offsets)},
+      owned_pins{std::move(pins)},
+      net_offsets{this->owned_net_offsets},
+      pins{this->owned_pins} {
+    this->transpose();
+}
+
+/**
+ * @brief Builds the nets of the modules from the pins of the nets.
+ *
+ * A counting sort over the pins: the nets of every module come out in
+ * increasing order, so that the graph does not depend on the order of the
+ * pins within a net.
+ */
+void CsrGraph::transpose() {
+    const auto num_nets = static_cast<std::uint32_t>(this->net_offsets.size() - 1U);
+    this->module_offsets.assign(this->num_modules + 1U, 0U);
+    for (const auto& v : this->pins) {
+        ++this->module_offsets[v + 1U];
+    }
+    for (auto v = 0U; v != this->num_modules; ++v) {
+        this->module_offsets[v + 1U] += this->module_offsets[v];
+    }
+    this->module_nets.resize(this->pins.size());
+    auto next = std::vector<node_t>(this->module_offsets.begin(), this->module_offsets.end() - 1);
+    for (auto i_net = 0U; i_net != num_nets; ++i_net) {
+        for (auto pos = this->net_offsets[i_net]; pos != this->net_offsets[i_net + 1U]; ++pos) {
+            this->module_nets[next[this->pins[pos]]++] = this->num_modules + i_net;
+        }
+    }
+}
+
+/// @brief Explicit instantiation of the Netlist template for CsrGraph
+template struct Netlist<CsrGraph>;
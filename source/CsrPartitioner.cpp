@@ -0,0 +1,257 @@
+#include <ckpttn/CsrNetlist.hpp>           // for CsrGraph, CsrNetlist
+#include <ckpttn/CsrPartitioner.hpp>       // for HypergraphCsrView, CsrPartitionOptions
+#include <ckpttn/FMBiConstrMgr.hpp>        // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>          // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>      // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>        // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>            // for FMPartMgr
+#include <ckpttn/MLPartMgr.hpp>            // for MLPartMgr
+#include <ckpttn/NNPartMgr.hpp>            // for NNPartMgr
+#include <ckpttn/PreprocessedNetlist.hpp>  // for large_net_cost
+#include <cstdint>                         // for uint8_t, uint32_t, uint64_t, int64_t
+#include <limits>                          // for numeric_limits
+#include <random>                          // for mt19937, uniform_int_distribution
+#include <span>                            // for span
+#include <stdexcept>                       // for invalid_argument
+#include <string>                          // for string
+#include <type_traits>                     // for is_signed_v
+#include <utility>                         // for move
+#include <vector>                          // for vector
+#include <xnetwork/classes/graph.hpp>      // for SimpleGraph
+
+/**
+ * @brief Converts an entry of a CSR array to an unsigned integer.
+ *
+ * @param[in] value The entry
+ * @param[in] bound The exclusive upper bound
+ * @param[in] what The name of the array, for the error message
+ * @return The entry
+ * @throw std::invalid_argument if the entry is negative or not below `bound`
+ */
+template <typename Index>
+static auto checked(Index value, std::uint64_t bound, const char* what) -> std::uint64_t {
+    if constexpr (std::is_signed_v<Index>) {
+        if (value < 0) {
+            throw std::invalid_argument(std::string("Negative entry in ") + what);
+        }
+    }
+    const auto result = static_cast<std::uint64_t>(value);
+    if (result >= bound) {
+        throw std::invalid_argument(std::string("Entry out of range in ") + what);
+    }
+    return result;
+}
+
+/**
+ * @brief Checks the arrays of a CSR view.
+ *
+ * @param[in] csr The hypergraph
+ * @return Whether a net repeats a module
+ * @throw std::invalid_argument if the arrays are inconsistent (see `to_netlist`)
+ */
+template <typename Index> static auto check_csr(const HypergraphCsrView<Index>& csr) -> bool {
+    if (csr.net_offsets.empty()) {
+        throw std::invalid_argument("The net offsets need at least one entry");
+    }
+    const auto num_nets = csr.net_offsets.size() - 1U;
+    if (num_nets + csr.num_modules > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("Too many nets");
+    }
+    if (!csr.module_weight.empty() && csr.module_weight.size() != csr.num_modules) {
+        throw std::invalid_argument("The module weights must be one per module");
+    }
+    const auto num_pins = std::uint64_t{csr.pins.size()};
+    if (csr.net_offsets[0] != 0 || checked(csr.net_offsets[num_nets], num_pins + 1U,
+                                           "net offsets") != num_pins) {
+        throw std::invalid_argument("The net offsets must run from 0 to the number of pins");
+    }
+
+    // the last net of each module, to find the repeated pins
+    auto last_net = std::vector<std::uint32_t>(csr.num_modules,
+                                               std::numeric_limits<std::uint32_t>::max());
+    auto repeated = false;
+    auto start = std::uint64_t{0U};
+    for (auto i_net = 0U; i_net != num_nets; ++i_net) {
+        const auto stop = checked(csr.net_offsets[i_net + 1U], num_pins + 1U, "net offsets");
+        if (stop < start) {
+            throw std::invalid_argument("The net offsets must be non-decreasing");
+        }
+        for (auto pos = start; pos != stop; ++pos) {
+            const auto v = checked(csr.pins[pos], csr.num_modules, "pins");
+            repeated = repeated || last_net[v] == i_net;
+            last_net[v] = i_net;
+        }
+        start = stop;
+    }
+    return repeated;
+}
+
+/**
+ * @brief Copies the module weights of a checked CSR view into a netlist.
+ *
+ * @tparam Gnl The netlist type
+ * @param[in,out] hyprgraph The netlist
+ * @param[in] csr The hypergraph
+ * @throw std::invalid_argument if a weight does not fit an unsigned int
+ */
+template <typename Gnl, typename Index>
+static void set_module_weight(Gnl& hyprgraph, const HypergraphCsrView<Index>& csr) {
+    if (csr.module_weight.empty()) {
+        return;
+    }
+    hyprgraph.module_weight.resize(csr.num_modules);
+    for (auto v = 0U; v != csr.num_modules; ++v) {
+        hyprgraph.module_weight[v] = static_cast<unsigned int>(checked(
+            csr.module_weight[v], std::numeric_limits<unsigned int>::max(), "module weights"));
+    }
+}
+
+template <typename Index> auto to_netlist(const HypergraphCsrView<Index>& csr) -> SimpleNetlist {
+    check_csr(csr);
+    const auto num_nets = static_cast<std::uint32_t>(csr.net_offsets.size() - 1U);
+    auto gr = xnetwork::SimpleGraph(csr.num_modules + num_nets);
+    for (auto i_net = 0U; i_net != num_nets; ++i_net) {
+        const auto stop = static_cast<std::uint64_t>(csr.net_offsets[i_net + 1U]);
+        for (auto pos = static_cast<std::uint64_t>(csr.net_offsets[i_net]); pos != stop; ++pos) {
+            gr.add_edge(static_cast<std::uint32_t>(csr.pins[pos]), csr.num_modules + i_net);
+        }
+    }
+    auto hyprgraph = SimpleNetlist(std::move(gr), csr.num_modules, num_nets);
+    set_module_weight(hyprgraph, csr);
+    return hyprgraph;
+}
+
+template <typename Index> auto to_csr_netlist(const HypergraphCsrView<Index>& csr) -> CsrNetlist {
+    const auto repeated = check_csr(csr);
+    if (csr.pins.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("Too many pins");
+    }
+    const auto num_nets = static_cast<std::uint32_t>(csr.net_offsets.size() - 1U);
+    auto gr = [&]() {
+        if constexpr (sizeof(Index) == sizeof(std::uint32_t)) {
+            if (!repeated) {
+                // the entries are not negative, so int32 arrays may be read as uint32 ones
+                using node_t = CsrGraph::node_t;
+                const auto as_nodes = [](std::span<const Index> array) {
+                    return std::span<const node_t>(
+                        reinterpret_cast<const node_t*>(array.data()), array.size());
+                };
+                return CsrGraph(csr.num_modules, as_nodes(csr.net_offsets), as_nodes(csr.pins));
+            }
+        }
+        // a copy, without the repeated pins
+        auto net_offsets = std::vector<std::uint32_t>{0U};
+        net_offsets.reserve(num_nets + 1U);
+        auto pins = std::vector<std::uint32_t>{};
+        pins.reserve(csr.pins.size());
+        auto last_net = std::vector<std::uint32_t>(csr.num_modules, num_nets);
+        for (auto i_net = 0U; i_net != num_nets; ++i_net) {
+            const auto stop = static_cast<std::uint64_t>(csr.net_offsets[i_net + 1U]);
+            for (auto pos = static_cast<std::uint64_t>(csr.net_offsets[i_net]); pos != stop;
+                 ++pos) {
+                const auto v = static_cast<std::uint32_t>(csr.pins[pos]);
+                if (last_net[v] != i_net) {
+                    last_net[v] = i_net;
+                    pins.emplace_back(v);
+                }
+            }
+            net_offsets.emplace_back(static_cast<std::uint32_t>(pins.size()));
+        }
+        return CsrGraph(csr.num_modules, std::move(net_offsets), std::move(pins));
+    }();
+    auto hyprgraph = CsrNetlist(std::move(gr), csr.num_modules, num_nets);
+    set_module_weight(hyprgraph, csr);
+    return hyprgraph;
+}
+
+/**
+ * @brief Runs the multilevel partitioner with the part manager of a refiner.
+ *
+ * @tparam Gnl The netlist type
+ * @param[in] hyprgraph The netlist
+ * @param[in,out] part The partition
+ * @param[in] options The options
+ * @return The cost of the partition
+ */
+template <typename Gnl>
+static auto run_refiner(const Gnl& hyprgraph, std::span<std::uint8_t> part,
+                        const CsrPartitionOptions& options) -> int {
+    using BiGainMgr = FMBiGainMgr<Gnl>;
+    using BiConstrMgr = FMBiConstrMgr<Gnl>;
+    using KWayGainMgr = FMKWayGainMgr<Gnl>;
+    using KWayConstrMgr = FMKWayConstrMgr<Gnl>;
+
+    MLPartMgr ml_mgr(options.bal_tol, options.num_parts);
+    ml_mgr.set_num_vcycles(options.num_vcycles);
+    const auto bi = options.num_parts == 2;
+    switch (options.refiner) {
+        case CsrRefiner::NN:
+            if (bi) {
+                ml_mgr.run_Partition<Gnl, NNPartMgr<Gnl, BiGainMgr, BiConstrMgr>>(hyprgraph, part);
+            } else {
+                ml_mgr.run_Partition<Gnl, NNPartMgr<Gnl, KWayGainMgr, KWayConstrMgr>>(hyprgraph,
+                                                                                      part);
+            }
+            break;
+        case CsrRefiner::FM:
+            if (bi) {
+                ml_mgr.run_Partition<Gnl, FMPartMgr<Gnl, BiGainMgr, BiConstrMgr>>(hyprgraph, part);
+                break;
+            }
+            [[fallthrough]];
+        case CsrRefiner::KWay:
+            ml_mgr.run_Partition<Gnl, FMPartMgr<Gnl, KWayGainMgr, KWayConstrMgr>>(hyprgraph, part);
+            break;
+    }
+    return ml_mgr.total_cost + large_net_cost(hyprgraph, part);
+}
+
+template <typename Index>
+auto partition_csr(const HypergraphCsrView<Index>& csr, std::span<std::uint8_t> part,
+                   const CsrPartitionOptions& options) -> int {
+    if (part.size() != csr.num_modules) {
+        throw std::invalid_argument("The partition must have one entry per module");
+    }
+    if (options.num_parts < 2) {
+        throw std::invalid_argument("At least 2 parts are required");
+    }
+    const auto hyprgraph = to_csr_netlist(csr);
+    if (options.use_initial) {
+        for (const auto p : part) {
+            if (p >= options.num_parts) {
+                throw std::invalid_argument("The initial partition has a part out of range");
+            }
+        }
+    } else {
+        auto gen = std::mt19937{options.seed};
+        auto dist = std::uniform_int_distribution<int>(0, options.num_parts - 1);
+        for (auto& p : part) {
+            p = static_cast<std::uint8_t>(dist(gen));
+        }
+    }
+    return run_refiner(hyprgraph, part, options);
+}
+
+// Explicit instantiations for the integer types of NumPy index arrays
+template auto to_netlist(const HypergraphCsrView<std::int32_t>& csr) -> SimpleNetlist;
+template auto to_netlist(const HypergraphCsrView<std::uint32_t>& csr) -> SimpleNetlist;
+template auto to_netlist(const HypergraphCsrView<std::int64_t>& csr) -> SimpleNetlist;
+template auto to_netlist(const HypergraphCsrView<std::uint64_t>& csr) -> SimpleNetlist;
+
+template auto to_csr_netlist(const HypergraphCsrView<std::int32_t>& csr) -> CsrNetlist;
+template auto to_csr_netlist(const HypergraphCsrView<std::uint32_t>& csr) -> CsrNetlist;
+template auto to_csr_netlist(const HypergraphCsrView<std::int64_t>& csr) -> CsrNetlist;
+template auto to_csr_netlist(const HypergraphCsrView<std::uint64_t>& csr) -> CsrNetlist;
+
+template auto partition_csr(const HypergraphCsrView<std::int32_t>& csr,
+                            std::span<std::uint8_t> part, const CsrPartitionOptions& options)
+    -> int;
+template auto partition_csr(const HypergraphCsrView<std::uint32_t>& csr,
+                            std::span<std::uint8_t> part, const CsrPartitionOptions& options)
+    -> int;
+template auto partition_csr(const HypergraphCsrView<std::int64_t>& csr,
+                            std::span<std::uint8_t> part, const CsrPartitionOptions& options)
+    -> int;
+template auto partition_csr(const HypergraphCsrView<std::uint64_t>& csr,
+                            std::span<std::uint8_t> part, const CsrPartitionOptions& options)
+    -> int;
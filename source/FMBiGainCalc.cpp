@@ -1,10 +1,11 @@
 // #include <__config>                    // for std
 #include <array>  // for array
 #include <ckpttn/FMBiGainCalc.hpp>  // for FMBiGainCalc, part, net
-#include <ckpttn/FMPmrConfig.hpp>   // for FM_MAX_DEGREE
+#include <ckpttn/FMPmrConfig.hpp>   // for FM_MAX_DEGREE, FM_GAIN_INIT_BLOCK_SIZE
 #include <ckpttn/moveinfo.hpp>      // for MoveInfo
+#include <ckpttn/parallel_for.hpp>  // for parallel_for, parallel_reduce
 #include <cstddef>                  // for size_t
-#include <cstdint>                  // for uint8_t
+#include <cstdint>                  // for uint8_t, uint32_t
 #include <span>                     // for span
 #include <transrangers.hpp>         // for all, filter, zip2
 #include <vector>                   // for vector
@@ -46,6 +47,68 @@ void FMBiGainCalc<Gnl>::_init_gain(const typename Gnl::node_t& net, std::span<co
     }
 }
 
+/**
+ * @brief Initializes the gain values of all modules in parallel.
+ *
+ * Uses the general rule for every net: a pin gains the net weight if it is
+ * the only pin in its part, and loses it if the other part has no pin. This
+ * gives the same gains as the special handlers of 2-pin and 3-pin nets.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] part The current partition assignment
+ * @return true if the gains were initialized
+ */
+template <typename Gnl> auto FMBiGainCalc<Gnl>::_init_parallel(std::span<const uint8_t> part)
+    -> bool {
+    const auto& hgr = this->hyprgraph;
+    const auto num_modules = static_cast<std::uint32_t>(hgr.number_of_modules());
+    const auto num_nets = static_cast<std::uint32_t>(hgr.number_of_nets());
+    if (num_parallel_tasks(0U, num_nets, FM_GAIN_INIT_BLOCK_SIZE) <= 1U) {
+        return false;
+    }
+
+    auto num = std::vector<array<std::uint32_t, 2>>(num_nets);
+    this->total_cost = parallel_reduce(
+        num_nets, FM_GAIN_INIT_BLOCK_SIZE, 0,
+        [&](auto first, auto last) {
+            auto cost = 0;
+            for (auto i_net = first; i_net != last; ++i_net) {
+                const auto net = num_modules + i_net;
+                const auto degree = hgr.gr.degree(net);
+                if (degree < 2 || degree > FM_MAX_DEGREE) {
+                    continue;
+                }
+                for (const auto& w : hgr.gr[net]) {
+                    ++num[i_net][part[w]];
+                }
+                if (num[i_net][0] > 0 && num[i_net][1] > 0) {
+                    cost += static_cast<int>(hgr.get_net_weight(net));
+                }
+            }
+            return cost;
+        },
+        [](int lhs, int rhs) { return lhs + rhs; });
+
+    const auto num_tasks = num_parallel_tasks(0U, num_modules, FM_GAIN_INIT_BLOCK_SIZE);
+    parallel_for(num_tasks, num_modules, [&](size_t, auto first, auto last) {
+        for (auto v = first; v != last; ++v) {
+            const auto part_v = part[v];
+            auto gain = 0;
+            for (const auto& net : hgr.gr[v]) {
+                const auto& count = num[net - num_modules];
+                const auto weight = static_cast<int>(hgr.get_net_weight(net));
+                if (count[part_v] == 1U) {
+                    gain += weight;
+                } else if (count[1 - part_v] == 0U && count[part_v] != 0U) {
+                    gain -= weight;
+                }
+            }
+            this->init_gain_list[v] = gain;
+        }
+    });
+    return true;
+}
+
 /**
  * @brief Initializes gain values for a 2-pin net in 2-way partitioning.
  *
@@ -127,7 +190,8 @@ void FMBiGainCalc<Gnl>::_init_gain_general_net(const typename Gnl::node_t& net,
                                                std::span<const uint8_t> part) {
     auto num = array<size_t, 2>{0U, 0U};
 
-    auto range = all(this->hyprgraph.gr[net]);
+    const auto& pins = this->hyprgraph.gr[net];
+    auto range = all(pins);
     range([&](const auto& weighted_cell) {
         num[part[*weighted_cell]] += 1;
         return true;
@@ -193,7 +257,8 @@ template <typename Gnl> void FMBiGainCalc<Gnl>::init_idx_vec(const typename Gnl:
     this->idx_vec.clear();
     auto degree = this->hyprgraph.gr.degree(net);
     this->idx_vec.reserve(degree - 1);
-    auto range1 = all(this->hyprgraph.gr[net]);
+    const auto& pins = this->hyprgraph.gr[net];
+    auto range1 = all(pins);
     auto range = filter([&module](const auto& cell) { return cell != module; }, range1);
     range([&](const auto& weighted_cell) {
         this->idx_vec.emplace_back(*weighted_cell);
@@ -294,8 +359,10 @@ auto FMBiGainCalc<Gnl>::update_move_general_net(std::span<const uint8_t> part,
 
 // instantiation
 
+#include <ckpttn/CsrNetlist.hpp>       // for CsrNetlist
 #include <netlistx/netlist.hpp>        // for Netlist, SimpleNetlist
 #include <py2cpp/set.hpp>              // for set
 #include <xnetwork/classes/graph.hpp>  // for Graph
 
 template class FMBiGainCalc<SimpleNetlist>;
+template class FMBiGainCalc<CsrNetlist>;
@@ -38,6 +38,8 @@ template <typename Gnl> auto FMBiGainMgr<Gnl>::init(std::span<const uint8_t> par
 
 // instantiation
 
-#include <netlistx/netlist.hpp>  // for Netlist, SimpleNetlist
+#include <ckpttn/CsrNetlist.hpp>  // for CsrNetlist
+#include <netlistx/netlist.hpp>   // for Netlist, SimpleNetlist
 
 template class FMBiGainMgr<SimpleNetlist>;
+template class FMBiGainMgr<CsrNetlist>;
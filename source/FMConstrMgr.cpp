@@ -135,7 +135,9 @@ template <typename Gnl> auto FMConstrMgr<Gnl>::final_check(std::span<const uint8
 }
 
 // Instantiation
-#include <netlistx/netlist.hpp>  // for Netlist, SimpleNetlist
-#include <py2cpp/range.hpp>      // for _iterator
+#include <ckpttn/CsrNetlist.hpp>  // for CsrNetlist
+#include <netlistx/netlist.hpp>   // for Netlist, SimpleNetlist
+#include <py2cpp/range.hpp>       // for _iterator
 
 template class FMConstrMgr<SimpleNetlist>;
+template class FMConstrMgr<CsrNetlist>;
@@ -1,4 +1,4 @@
-#include <algorithm>  // for all_of, max_element
+#include <algorithm>  // for all_of, max_element, ranges::all_of
 #include <ckpttn/FMGainMgr.hpp>
 #include <ckpttn/FMPmrConfig.hpp>  // for FM_MAX_DEGREE
 #include <iterator>                // for distance
@@ -17,24 +17,48 @@ using namespace std;
  * @brief Constructs a new FMGainMgr object.
  *
  * Initializes the gain buckets for each partition based on the maximum
- * degree of the hypergraph and the number of partitions.
+ * degree of the hypergraph and the number of partitions. With a shared
+ * scratch, the buckets are only rebuilt if their gain range is too small
+ * (or the number of partitions differs), and the other buffers keep their
+ * capacity.
  *
  * @tparam Gnl The hypergraph type
  * @tparam GainCalc The gain calculator type
  * @tparam Derived The derived gain manager type (CRTP)
  * @param[in] hyprgraph The hypergraph to manage gains for
  * @param[in] num_parts The number of partitions
+ * @param[in] shared_scratch The buffers to reuse (null = own buffers)
  */
 template <typename Gnl, typename GainCalc, class Derived>
-FMGainMgr<Gnl, GainCalc, Derived>::FMGainMgr(const Gnl& hyprgraph, uint8_t num_parts)
-    : hyprgraph{hyprgraph}, num_parts{num_parts}, gain_calc{hyprgraph, num_parts} {
+FMGainMgr<Gnl, GainCalc, Derived>::FMGainMgr(const Gnl& hyprgraph, uint8_t num_parts,
+                                             FMGainScratch<node_t>* shared_scratch)
+    : hyprgraph{hyprgraph},
+      scratch{shared_scratch != nullptr ? *shared_scratch : this->own_scratch},
+      gain_bucket{this->scratch.gain_bucket},
+      num_parts{num_parts},
+      delta_stride{scalar_delta ? 1U : size_t(num_parts)},
+      batch_slot{this->scratch.batch_slot},
+      batch_nodes{this->scratch.batch_nodes},
+      batch_delta{this->scratch.batch_delta},
+      gain_calc{hyprgraph, num_parts, &this->scratch} {
     static_assert(is_base_of_v<FMGainMgr<Gnl, GainCalc, Derived>, Derived>,
                   "base derived consistence");
+    this->batch_slot.assign(hyprgraph.number_of_modules(), no_slot);
+    this->batch_nodes.clear();
+    this->batch_delta.clear();
     const auto pmax = int(hyprgraph.get_max_degree());
     const auto range = static_cast<int>(this->num_parts - 1) * pmax;
+    if (this->gain_bucket.size() == this->num_parts && this->scratch.bucket_range >= range) {
+        for (auto& bckt : this->gain_bucket) {
+            bckt.clear();
+        }
+        return;
+    }
+    this->gain_bucket.clear();
     for (auto part_idx = 0U; part_idx != this->num_parts; ++part_idx) {
         this->gain_bucket.emplace_back(BPQueue<typename Gnl::node_t>(-range, range));
     }
+    this->scratch.bucket_range = range;
 }
 
 /**
@@ -135,6 +159,9 @@ auto FMGainMgr<Gnl, GainCalc, Derived>::select_togo(uint8_t to_part)
  *
  * Iterates over all nets connected to the moved vertex and dispatches
  * to specialized handlers based on net degree (2-pin, 3-pin, or general).
+ * The handlers only collect the delta gains of the neighbors; the bucket
+ * keys are modified once per neighbor at the end, so that a neighbor that
+ * shares many nets with the moved vertex is relinked only once.
  *
  * @tparam Gnl The hypergraph type
  * @tparam GainCalc The gain calculator type
@@ -172,12 +199,75 @@ void FMGainMgr<Gnl, GainCalc, Derived>::update_move(
             this->_update_move_general_net(part, move_info);
         }
     }
+    this->_flush_delta(part);
+}
+
+/**
+ * @brief Adds a delta gain of a neighbor to the scratch buffer.
+ *
+ * The first delta gain of a neighbor takes a new slot; later ones are
+ * added to it.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainCalc The gain calculator type
+ * @tparam Derived The derived gain manager type (CRTP)
+ * @param[in] w The neighbor of the moved vertex
+ * @param[in] delta_gain The delta gain of the neighbor
+ */
+template <typename Gnl, typename GainCalc, class Derived>
+void FMGainMgr<Gnl, GainCalc, Derived>::_add_delta(const typename Gnl::node_t& w,
+                                                   DeltaGain delta_gain) {
+    auto& slot = this->batch_slot[w];
+    if (slot == no_slot) {
+        slot = static_cast<uint32_t>(this->batch_nodes.size());
+        this->batch_nodes.emplace_back(w);
+        this->batch_delta.resize(this->batch_delta.size() + this->delta_stride, 0);
+    }
+    auto* delta = this->batch_delta.data() + size_t(slot) * this->delta_stride;
+    if constexpr (scalar_delta) {
+        *delta += delta_gain;
+    } else {
+        for (auto k = 0U; k != this->delta_stride; ++k) {
+            delta[k] += delta_gain[k];
+        }
+    }
+}
+
+/**
+ * @brief Applies the aggregated delta gains to the gain buckets.
+ *
+ * Neighbors are visited in the order of their first update, and those
+ * whose deltas cancel out are skipped. The buffer is cleared afterwards.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainCalc The gain calculator type
+ * @tparam Derived The derived gain manager type (CRTP)
+ * @param[in] part The current partition assignment
+ */
+template <typename Gnl, typename GainCalc, class Derived>
+void FMGainMgr<Gnl, GainCalc, Derived>::_flush_delta(std::span<const uint8_t> part) {
+    const auto* delta = this->batch_delta.data();
+    for (const auto& w : this->batch_nodes) {
+        this->batch_slot[w] = no_slot;
+        const auto keys = std::span<const int>(delta, this->delta_stride);
+        delta += this->delta_stride;
+        if (std::ranges::all_of(keys, [](int key) { return key == 0; })) {
+            continue;
+        }
+        if constexpr (scalar_delta) {
+            self.modify_key(w, part[w], keys[0]);
+        } else {
+            self.modify_key(w, part[w], keys);
+        }
+    }
+    this->batch_nodes.clear();
+    this->batch_delta.clear();
 }
 
 /**
  * @brief Updates gain values for a 2-pin net after a vertex move.
  *
- * Computes the delta gain for the other vertex and applies the key change.
+ * Computes the delta gain for the other vertex and adds it to the scratch buffer.
  *
  * @tparam Gnl The hypergraph type
  * @tparam GainCalc The gain calculator type
@@ -191,14 +281,14 @@ void FMGainMgr<Gnl, GainCalc, Derived>::_update_move_2pin_net(
     // const auto [w, delta_gain_w] =
     //     this->gain_calc.update_move_2pin_net(part, move_info);
     const auto w = this->gain_calc.update_move_2pin_net(part, move_info);
-    self.modify_key(w, part[w], this->gain_calc.delta_gain_w);
+    this->_add_delta(w, this->gain_calc.delta_gain_w);
 }
 
 /**
  * @brief Updates gain values for a 3-pin net after a vertex move.
  *
- * Computes delta gains for the two remaining vertices and applies
- * the corresponding key changes.
+ * Computes delta gains for the two remaining vertices and adds them
+ * to the scratch buffer.
  *
  * @tparam Gnl The hypergraph type
  * @tparam GainCalc The gain calculator type
@@ -217,12 +307,12 @@ void FMGainMgr<Gnl, GainCalc, Derived>::_update_move_3pin_net(
 
     auto dGw_it = delta_gain.begin();
     for (const auto& w : this->gain_calc.idx_vec) {
-        if constexpr (std::is_same_v<std::decay_t<decltype(*dGw_it)>, int>) {
+        if constexpr (scalar_delta) {
             if (*dGw_it != 0) {
-                self.modify_key(w, part[w], *dGw_it);
+                this->_add_delta(w, *dGw_it);
             }
         } else {
-            self.modify_key(w, part[w], *dGw_it);
+            this->_add_delta(w, *dGw_it);
         }
         ++dGw_it;
     }
@@ -231,8 +321,8 @@ void FMGainMgr<Gnl, GainCalc, Derived>::_update_move_3pin_net(
 /**
  * @brief Updates gain values for a general net (degree > 3) after a vertex move.
  *
- * Computes delta gains for all remaining vertices in the net and applies
- * the corresponding key changes.
+ * Computes delta gains for all remaining vertices in the net and adds
+ * them to the scratch buffer.
  *
  * @tparam Gnl The hypergraph type
  * @tparam GainCalc The gain calculator type
@@ -247,26 +337,29 @@ void FMGainMgr<Gnl, GainCalc, Derived>::_update_move_general_net(
 
     auto dGw_it = delta_gain.begin();
     for (const auto& w : this->gain_calc.idx_vec) {
-        if constexpr (std::is_same_v<std::decay_t<decltype(*dGw_it)>, int>) {
+        if constexpr (scalar_delta) {
             if (*dGw_it != 0) {
-                self.modify_key(w, part[w], *dGw_it);
+                this->_add_delta(w, *dGw_it);
             }
         } else {
-            self.modify_key(w, part[w], *dGw_it);
+            this->_add_delta(w, *dGw_it);
         }
         ++dGw_it;
     }
 }
 
+#include <ckpttn/CsrNetlist.hpp>       // for CsrNetlist
 #include <ckpttn/FMBiGainCalc.hpp>     // for FMBiGainCalc
 #include <ckpttn/FMBiGainMgr.hpp>      // for FMBiGainMgr
 #include <netlistx/netlist.hpp>        // for Netlist, Netlist<>::node_t
 #include <xnetwork/classes/graph.hpp>  // for Graph
 
 template class FMGainMgr<SimpleNetlist, FMBiGainCalc<SimpleNetlist>, FMBiGainMgr<SimpleNetlist>>;
+template class FMGainMgr<CsrNetlist, FMBiGainCalc<CsrNetlist>, FMBiGainMgr<CsrNetlist>>;
 
 #include <ckpttn/FMKWayGainCalc.hpp>  // for FMKWayGainCalc
 #include <ckpttn/FMKWayGainMgr.hpp>   // for FMKWayGainMgr
 
 template class FMGainMgr<SimpleNetlist, FMKWayGainCalc<SimpleNetlist>,
                          FMKWayGainMgr<SimpleNetlist>>;
+template class FMGainMgr<CsrNetlist, FMKWayGainCalc<CsrNetlist>, FMKWayGainMgr<CsrNetlist>>;
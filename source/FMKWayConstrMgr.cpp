@@ -47,6 +47,8 @@ auto FMKWayConstrMgr<Gnl>::check_legal(const MoveInfoV<typename Gnl::node_t>& mo
 }
 
 // Instantiation
-#include <netlistx/netlist.hpp>  // for Netlist, SimpleNetlist
+#include <ckpttn/CsrNetlist.hpp>  // for CsrNetlist
+#include <netlistx/netlist.hpp>   // for Netlist, SimpleNetlist
 
 template class FMKWayConstrMgr<SimpleNetlist>;
+template class FMKWayConstrMgr<CsrNetlist>;
@@ -6,8 +6,9 @@
 // __hash_...
 #include <algorithm>                  // for fill
 #include <ckpttn/FMKWayGainCalc.hpp>  // for FMKWayG...
-#include <ckpttn/FMPmrConfig.hpp>     // for FM_MAX_...
+#include <ckpttn/FMPmrConfig.hpp>     // for FM_MAX_..., FM_GAIN_INIT_BLOCK_SIZE
 #include <ckpttn/moveinfo.hpp>        // for MoveInfo
+#include <ckpttn/parallel_for.hpp>    // for parallel_for, parallel_reduce
 #include <mywheel/dllist.hpp>         // for Dllink
 #include <mywheel/robin.hpp>          // for fun::Robin<>...
 #include <span>                       // for span
@@ -53,6 +54,78 @@ template <typename Gnl> void FMKWayGainCalc<Gnl>::_init_gain(const typename Gnl:
     }
 }
 
+/**
+ * @brief Initializes the gain values of all modules in parallel.
+ *
+ * Uses the general rule for every net: a pin that is the only pin in its
+ * part gains the net weight towards every other part, and a pin loses it
+ * towards every part without a pin. This gives the same gains as the special
+ * handlers of 2-pin and 3-pin nets.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] part The current partition assignment
+ * @return true if the gains were initialized
+ */
+template <typename Gnl> auto FMKWayGainCalc<Gnl>::_init_parallel(std::span<const uint8_t> part)
+    -> bool {
+    const auto& hgr = this->hyprgraph;
+    const auto num_modules = static_cast<std::uint32_t>(hgr.number_of_modules());
+    const auto num_nets = static_cast<std::uint32_t>(hgr.number_of_nets());
+    const auto num_parts = static_cast<std::uint32_t>(this->num_parts);
+    if (num_parallel_tasks(0U, num_nets, FM_GAIN_INIT_BLOCK_SIZE) <= 1U) {
+        return false;
+    }
+
+    auto num = std::vector<std::uint32_t>(size_t{num_nets} * num_parts, 0U);
+    this->total_cost = parallel_reduce(
+        num_nets, FM_GAIN_INIT_BLOCK_SIZE, 0,
+        [&](auto first, auto last) {
+            auto cost = 0;
+            for (auto i_net = first; i_net != last; ++i_net) {
+                const auto net = num_modules + i_net;
+                const auto degree = hgr.gr.degree(net);
+                if (degree < 2 || degree > FM_MAX_DEGREE) {
+                    continue;
+                }
+                auto* count = &num[size_t{i_net} * num_parts];
+                for (const auto& w : hgr.gr[net]) {
+                    ++count[part[w]];
+                }
+                auto connectivity = -1;
+                for (auto k = 0U; k != num_parts; ++k) {
+                    connectivity += count[k] != 0U ? 1 : 0;
+                }
+                cost += connectivity * static_cast<int>(hgr.get_net_weight(net));
+            }
+            return cost;
+        },
+        [](int lhs, int rhs) { return lhs + rhs; });
+
+    const auto num_tasks = num_parallel_tasks(0U, num_modules, FM_GAIN_INIT_BLOCK_SIZE);
+    parallel_for(num_tasks, num_modules, [&](size_t, auto first, auto last) {
+        auto gain = std::vector<int>(num_parts, 0);
+        for (auto v = first; v != last; ++v) {
+            const auto part_v = part[v];
+            std::fill(gain.begin(), gain.end(), 0);
+            for (const auto& net : hgr.gr[v]) {
+                const auto* count = &num[size_t{net - num_modules} * num_parts];
+                if (count[part_v] == 0U) {
+                    continue;  // not tracked
+                }
+                const auto weight = static_cast<int>(hgr.get_net_weight(net));
+                const auto alone = count[part_v] == 1U ? weight : 0;
+                for (auto k = 0U; k != num_parts; ++k) {
+                    gain[k] += count[k] == 0U ? alone - weight : alone;
+                }
+            }
+            for (auto k = 0U; k != num_parts; ++k) {
+                this->init_gain_list[k][v] = k == part_v ? 0 : gain[k];
+            }
+        }
+    });
+    return true;
+}
+
 /**
  * @brief Initializes gain values for a 2-pin net in k-way partitioning.
  *
@@ -129,12 +202,13 @@ void FMKWayGainCalc<Gnl>::_init_gain_3pin_net(const typename Gnl::node_t& net,
         // this->_modify_vertex_va(weight, part_v, node_u, node_w);
         // this->_modify_vertex_va(weight, part_w, node_u, node_v);
         // this->_modify_vertex_va(weight, part_u, node_v, node_w);
-        this->_increase_gain(node_u, part_v, weight);
-        this->_increase_gain(node_w, part_v, weight);
-        this->_increase_gain(node_u, part_w, weight);
-        this->_increase_gain(node_v, part_w, weight);
-        this->_increase_gain(node_v, part_u, weight);
-        this->_increase_gain(node_w, part_u, weight);
+        // each pin gains only towards the parts of the other two pins
+        this->init_gain_list[part_v][node_u] += weight;
+        this->init_gain_list[part_v][node_w] += weight;
+        this->init_gain_list[part_w][node_u] += weight;
+        this->init_gain_list[part_w][node_v] += weight;
+        this->init_gain_list[part_u][node_v] += weight;
+        this->init_gain_list[part_u][node_w] += weight;
         return;
     }
 
@@ -175,7 +249,8 @@ void FMKWayGainCalc<Gnl>::_init_gain_general_net(const typename Gnl::node_t& net
     // for (const auto &w : this->hyprgraph.gr[net]) {
     //   num[part[w]] += 1;
     // }
-    auto rng = all(this->hyprgraph.gr[net]);
+    const auto& pins = this->hyprgraph.gr[net];
+    auto rng = all(pins);
     rng([&](const auto& wc) {
         num[part[*wc]] += 1;
         return true;
@@ -323,7 +398,8 @@ template <typename Gnl> void FMKWayGainCalc<Gnl>::init_idx_vec(const typename Gn
     this->idx_vec.clear();
     auto degree = this->hyprgraph.gr.degree(net);
     this->idx_vec.reserve(degree - 1);
-    auto rng1 = all(this->hyprgraph.gr[net]);
+    const auto& pins = this->hyprgraph.gr[net];
+    auto rng1 = all(pins);
     auto rng = filter([&v](const auto& w) { return w != v; }, rng1);
     rng([&](const auto& wc) {
         this->idx_vec.emplace_back(*wc);
@@ -493,8 +569,10 @@ auto FMKWayGainCalc<Gnl>::update_move_general_net(std::span<const uint8_t> part,
 
 // instantiation
 
+#include <ckpttn/CsrNetlist.hpp>       // for CsrNetlist
 #include <netlistx/netlist.hpp>        // for Netlist
 #include <py2cpp/set.hpp>              // for set
 #include <xnetwork/classes/graph.hpp>  // for Graph
 
 template class FMKWayGainCalc<SimpleNetlist>;
+template class FMKWayGainCalc<CsrNetlist>;
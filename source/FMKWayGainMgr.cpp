@@ -74,8 +74,10 @@ void FMKWayGainMgr<Gnl>::update_move_v(const MoveInfoV<typename Gnl::node_t>& mo
 
 // instantiation
 
-#include <netlistx/netlist.hpp>  // for Netlist, SimpleNetlist
-#include <py2cpp/range.hpp>      // for _iterator
-#include <py2cpp/set.hpp>        // for set
+#include <ckpttn/CsrNetlist.hpp>  // for CsrNetlist
+#include <netlistx/netlist.hpp>   // for Netlist, SimpleNetlist
+#include <py2cpp/range.hpp>       // for _iterator
+#include <py2cpp/set.hpp>         // for set
 
 template class FMKWayGainMgr<SimpleNetlist>;
+template class FMKWayGainMgr<CsrNetlist>;
@@ -0,0 +1,177 @@
+#include <algorithm>               // for fill, min
+#include <ckpttn/FlowNetwork.hpp>  // for FlowNetwork
+#include <cstdint>                 // for uint32_t, uint8_t
+#include <deque>                   // for deque
+#include <limits>                  // for numeric_limits
+#include <vector>                  // for vector
+
+/**
+ * @brief Adds a directed edge and its (initially empty) reverse edge.
+ *
+ * @param[in] from The tail
+ * @param[in] to The head
+ * @param[in] capacity The capacity
+ */
+void FlowNetwork::add_edge(std::uint32_t from, std::uint32_t to, cap_t capacity) {
+    const auto rev_from = static_cast<std::uint32_t>(this->adj[to].size());
+    const auto rev_to = static_cast<std::uint32_t>(this->adj[from].size()) + (from == to ? 1U : 0U);
+    this->adj[from].push_back({to, rev_from, capacity});
+    this->adj[to].push_back({from, rev_to, 0});
+}
+
+/**
+ * @brief Recomputes the exact labels.
+ *
+ * A node that can reach the sink in the residual network gets its distance
+ * to the sink. Every other node with a residual path to the source gets
+ * `n` plus its distance to the source, so that its excess flows back to the
+ * source. The remaining nodes are unreachable and get `2n`.
+ */
+void FlowNetwork::_global_relabel() {
+    const auto n = this->num_nodes();
+    std::fill(this->height.begin(), this->height.end(), 2U * n);
+    auto queue = std::deque<std::uint32_t>{};
+    auto bfs = [&](std::uint32_t root, std::uint32_t base) {
+        this->height[root] = base;
+        queue.push_back(root);
+        while (!queue.empty()) {
+            const auto u = queue.front();
+            queue.pop_front();
+            for (const auto& edge : this->adj[u]) {
+                // v can push to u if the reverse edge v -> u has residual capacity
+                const auto v = edge.to;
+                if (this->height[v] == 2U * n && this->adj[v][edge.rev].cap > 0) {
+                    this->height[v] = this->height[u] + 1U;
+                    queue.push_back(v);
+                }
+            }
+        }
+    };
+    bfs(this->sink, 0U);
+    if (this->height[this->source] == 2U * n) {
+        bfs(this->source, n);
+    } else {
+        // the source always keeps label n
+        this->height[this->source] = n;
+    }
+    std::fill(this->current.begin(), this->current.end(), 0U);
+}
+
+/**
+ * @brief Computes a maximum flow by FIFO push-relabel.
+ *
+ * All edges out of the source are saturated first. Active nodes are then
+ * discharged in FIFO order; the labels are recomputed exactly after every
+ * `n` relabel operations. The loop ends when no node except the source and
+ * the sink has excess, i.e. with a maximum flow.
+ *
+ * @param[in] source The source
+ * @param[in] sink The sink
+ * @return The value of the maximum flow
+ */
+auto FlowNetwork::max_flow(std::uint32_t source, std::uint32_t sink) -> cap_t {
+    const auto n = this->num_nodes();
+    this->source = source;
+    this->sink = sink;
+    this->height.assign(n, 0U);
+    this->excess.assign(n, 0);
+    this->current.assign(n, 0U);
+    if (source == sink) {
+        return 0;
+    }
+
+    auto queue = std::deque<std::uint32_t>{};
+    auto push = [&](std::uint32_t u, Edge& edge, cap_t delta) {
+        edge.cap -= delta;
+        this->adj[edge.to][edge.rev].cap += delta;
+        this->excess[u] -= delta;
+        if (this->excess[edge.to] == 0 && edge.to != this->source && edge.to != this->sink) {
+            queue.push_back(edge.to);
+        }
+        this->excess[edge.to] += delta;
+    };
+
+    for (auto& edge : this->adj[source]) {
+        if (edge.cap > 0) {
+            this->excess[source] += edge.cap;
+            push(source, edge, edge.cap);
+        }
+    }
+    this->_global_relabel();
+
+    auto num_relabels = 0U;
+    while (!queue.empty()) {
+        const auto u = queue.front();
+        queue.pop_front();
+        while (this->excess[u] > 0) {
+            auto& arc = this->current[u];
+            if (arc == this->adj[u].size()) {
+                // relabel
+                auto min_height = std::numeric_limits<std::uint32_t>::max();
+                for (const auto& edge : this->adj[u]) {
+                    if (edge.cap > 0) {
+                        min_height = std::min(min_height, this->height[edge.to]);
+                    }
+                }
+                this->height[u] = min_height + 1U;
+                arc = 0U;
+                if (++num_relabels == n) {
+                    num_relabels = 0U;
+                    this->_global_relabel();
+                }
+                continue;
+            }
+            auto& edge = this->adj[u][arc];
+            if (edge.cap > 0 && this->height[u] == this->height[edge.to] + 1U) {
+                push(u, edge, std::min(this->excess[u], edge.cap));
+            } else {
+                ++arc;
+            }
+        }
+    }
+    return this->excess[sink];
+}
+
+/**
+ * @brief Returns the nodes reachable from the source in the residual network.
+ *
+ * @return 1 for the nodes on the source side, 0 otherwise
+ */
+auto FlowNetwork::source_side() const -> std::vector<std::uint8_t> {
+    auto side = std::vector<std::uint8_t>(this->num_nodes(), 0U);
+    auto queue = std::deque<std::uint32_t>{this->source};
+    side[this->source] = 1U;
+    while (!queue.empty()) {
+        const auto u = queue.front();
+        queue.pop_front();
+        for (const auto& edge : this->adj[u]) {
+            if (side[edge.to] == 0U && edge.cap > 0) {
+                side[edge.to] = 1U;
+                queue.push_back(edge.to);
+            }
+        }
+    }
+    return side;
+}
+
+/**
+ * @brief Returns the nodes that can reach the sink in the residual network.
+ *
+ * @return 1 for the nodes on the sink side, 0 otherwise
+ */
+auto FlowNetwork::sink_side() const -> std::vector<std::uint8_t> {
+    auto side = std::vector<std::uint8_t>(this->num_nodes(), 0U);
+    auto queue = std::deque<std::uint32_t>{this->sink};
+    side[this->sink] = 1U;
+    while (!queue.empty()) {
+        const auto u = queue.front();
+        queue.pop_front();
+        for (const auto& edge : this->adj[u]) {
+            if (side[edge.to] == 0U && this->adj[edge.to][edge.rev].cap > 0) {
+                side[edge.to] = 1U;
+                queue.push_back(edge.to);
+            }
+        }
+    }
+    return side;
+}
@@ -0,0 +1,406 @@
+#include <algorithm>                // for copy, stable_sort
+#include <ckpttn/BlockPairs.hpp>    // for BlockPair, disjoint_pair_rounds
+#include <ckpttn/FMConstrMgr.hpp>   // for LegalCheck
+#include <ckpttn/FMPartMgr.hpp>     // for FMPartMgr
+#include <ckpttn/FMPmrConfig.hpp>   // for FM_MAX_DEGREE
+#include <ckpttn/FlowNetwork.hpp>   // for FlowNetwork
+#include <ckpttn/FlowPartMgr.hpp>   // for FlowPartMgr
+#include <ckpttn/parallel_for.hpp>  // for parallel_for, num_parallel_tasks
+#include <cstdint>                  // for uint8_t, uint32_t, int64_t
+#include <deque>                    // for deque
+#include <span>                     // for span
+#include <unordered_map>            // for unordered_map
+#include <vector>                   // for vector
+
+/**
+ * @brief A net of the flow network of a block pair
+ *
+ * @tparam node_t The node type
+ */
+template <typename node_t> struct FlowNet {
+    node_t net;
+    /// @brief Whether a pin in block `a` lies outside of the region
+    bool terminal_a;
+    /// @brief Whether a pin in block `b` lies outside of the region
+    bool terminal_b;
+};
+
+/**
+ * @brief Returns whether a net takes part in the (K-1) cost.
+ *
+ * @param[in] hgr The hypergraph
+ * @param[in] net The net
+ * @return true if the net has 2 to `FM_MAX_DEGREE` pins
+ */
+template <typename Gnl>
+static auto is_flow_net(const Gnl& hgr, const typename Gnl::node_t& net) -> bool {
+    const auto degree = hgr.gr.degree(net);
+    return degree >= 2U && degree <= FM_MAX_DEGREE;
+}
+
+/**
+ * @brief Refines the cut between two blocks by a minimum cut.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] hgr The hypergraph
+ * @param[in] snapshot The partition at the start of the round
+ * @param[in,out] part The partition
+ * @param[in] fixed 1 for the fixed modules
+ * @param[in] pair The two blocks
+ * @param[in] cut_nets The nets cut between the two blocks (at the start of the pass)
+ * @param[in,out] part_weight The weight of each block
+ * @param[in] lowerbound The lower bound of the block weights
+ * @param[in] max_region_modules The maximum number of modules in each side of the region
+ * @return The reduction of the cost
+ */
+template <typename Gnl>
+auto refine_block_pair(const Gnl& hgr, std::span<const std::uint8_t> snapshot,
+                       std::span<std::uint8_t> part, std::span<const std::uint8_t> fixed,
+                       const BlockPair& pair, std::span<const typename Gnl::node_t> cut_nets,
+                       std::span<unsigned int> part_weight, unsigned int lowerbound,
+                       size_t max_region_modules) -> int {
+    using node_t = typename Gnl::node_t;
+    using cap_t = FlowNetwork::cap_t;
+
+    const auto [block_a, block_b] = pair;
+    auto side_of = [&](const node_t& v) -> int {
+        return snapshot[v] == block_a ? 0 : (snapshot[v] == block_b ? 1 : -1);
+    };
+
+    // 1. Region: BFS from the pins of the cut nets, within the weight budget of each side
+    const unsigned int budget[2] = {
+        part_weight[block_a] > lowerbound ? part_weight[block_a] - lowerbound : 0U,
+        part_weight[block_b] > lowerbound ? part_weight[block_b] - lowerbound : 0U};
+    unsigned int region_weight[2] = {0U, 0U};
+    size_t region_size[2] = {0U, 0U};
+    auto region = std::vector<node_t>{};
+    auto region_index = std::unordered_map<node_t, std::uint32_t>{};
+    auto queue = std::deque<node_t>{};
+    auto try_add = [&](const node_t& v) {
+        const auto side = side_of(v);
+        if (side < 0 || fixed[v] != 0U || region_index.contains(v)
+            || region_size[side] == max_region_modules
+            || region_weight[side] + hgr.get_module_weight(v) > budget[side]) {
+            return;
+        }
+        region_index.emplace(v, static_cast<std::uint32_t>(region.size()));
+        region.push_back(v);
+        region_weight[side] += hgr.get_module_weight(v);
+        ++region_size[side];
+        queue.push_back(v);
+    };
+    for (const auto& net : cut_nets) {
+        for (const auto& v : hgr.gr[net]) {
+            try_add(v);
+        }
+    }
+    while (!queue.empty()) {
+        const auto u = queue.front();
+        queue.pop_front();
+        for (const auto& net : hgr.gr[u]) {
+            if (!is_flow_net(hgr, net)) {
+                continue;
+            }
+            for (const auto& v : hgr.gr[net]) {
+                try_add(v);
+            }
+        }
+    }
+    if (region.empty()) {
+        return 0;
+    }
+
+    // 2. Nets of the region that can change their cut status
+    auto nets = std::vector<FlowNet<node_t>>{};
+    auto visited = std::unordered_map<node_t, bool>{};
+    auto current_cut = cap_t{0};
+    auto infinity = cap_t{1};
+    for (const auto& u : region) {
+        for (const auto& net : hgr.gr[u]) {
+            if (!is_flow_net(hgr, net) || !visited.emplace(net, true).second) {
+                continue;
+            }
+            auto flow_net = FlowNet<node_t>{net, false, false};
+            bool has_pin[2] = {false, false};
+            auto num_pins = 0U;
+            for (const auto& v : hgr.gr[net]) {
+                const auto side = side_of(v);
+                if (side < 0) {
+                    continue;
+                }
+                ++num_pins;
+                has_pin[side] = true;
+                if (!region_index.contains(v)) {
+                    (side == 0 ? flow_net.terminal_a : flow_net.terminal_b) = true;
+                }
+            }
+            if (num_pins < 2U || (flow_net.terminal_a && flow_net.terminal_b)) {
+                continue;  // cannot become cut, or stays cut
+            }
+            const auto weight = static_cast<cap_t>(hgr.get_net_weight(net));
+            if (has_pin[0] && has_pin[1]) {
+                current_cut += weight;
+            }
+            infinity += weight;
+            nets.push_back(flow_net);
+        }
+    }
+    if (current_cut == 0) {
+        return 0;
+    }
+
+    // 3. Lawler expansion: source = 0 (block a), sink = 1 (block b), then
+    //    the region modules, then two nodes per net
+    const auto num_region = static_cast<std::uint32_t>(region.size());
+    auto network = FlowNetwork(2U + num_region + 2U * static_cast<std::uint32_t>(nets.size()));
+    auto net_node = 2U + num_region;
+    for (const auto& flow_net : nets) {
+        const auto e_in = net_node++;
+        const auto e_out = net_node++;
+        network.add_edge(e_in, e_out, static_cast<cap_t>(hgr.get_net_weight(flow_net.net)));
+        for (const auto& v : hgr.gr[flow_net.net]) {
+            const auto it = region_index.find(v);
+            if (it == region_index.end()) {
+                continue;
+            }
+            network.add_edge(2U + it->second, e_in, infinity);
+            network.add_edge(e_out, 2U + it->second, infinity);
+        }
+        if (flow_net.terminal_a) {
+            network.add_edge(0U, e_in, infinity);
+        }
+        if (flow_net.terminal_b) {
+            network.add_edge(e_out, 1U, infinity);
+        }
+    }
+    const auto flow = network.max_flow(0U, 1U);
+
+    // 4. Of the two extreme minimum cuts, take the more balanced one
+    const auto source_side = network.source_side();
+    const auto sink_side = network.sink_side();
+    auto imbalance = [&](auto in_a) {
+        auto weight_a = static_cast<std::int64_t>(part_weight[block_a]);
+        auto weight_b = static_cast<std::int64_t>(part_weight[block_b]);
+        for (auto i = 0U; i != num_region; ++i) {
+            const auto v = region[i];
+            const auto weight = static_cast<std::int64_t>(hgr.get_module_weight(v));
+            if (side_of(v) == 0 && !in_a(i)) {
+                weight_a -= weight;
+                weight_b += weight;
+            } else if (side_of(v) == 1 && in_a(i)) {
+                weight_a += weight;
+                weight_b -= weight;
+            }
+        }
+        return weight_a > weight_b ? weight_a - weight_b : weight_b - weight_a;
+    };
+    auto in_a_min = [&](std::uint32_t i) { return source_side[2U + i] != 0U; };
+    auto in_a_max = [&](std::uint32_t i) { return sink_side[2U + i] == 0U; };
+    const auto imbalance_min = imbalance(in_a_min);
+    const auto imbalance_max = imbalance(in_a_max);
+    const auto use_max = imbalance_max < imbalance_min;
+    const auto best_imbalance = use_max ? imbalance_max : imbalance_min;
+    const auto imbalance_now = imbalance([&](std::uint32_t i) { return side_of(region[i]) == 0; });
+    if (flow > current_cut || (flow == current_cut && best_imbalance >= imbalance_now)) {
+        return 0;
+    }
+
+    for (auto i = 0U; i != num_region; ++i) {
+        const auto v = region[i];
+        const auto to_part = (use_max ? in_a_max(i) : in_a_min(i)) ? block_a : block_b;
+        if (to_part != snapshot[v]) {
+            part_weight[snapshot[v]] -= hgr.get_module_weight(v);
+            part_weight[to_part] += hgr.get_module_weight(v);
+            part[v] = to_part;
+        }
+    }
+    return static_cast<int>(current_cut - flow);
+}
+
+/**
+ * @brief Legalizes the partition to satisfy balance constraints.
+ *
+ * Uses the serial FM legalization, since it is run once per level on a
+ * partition that is usually almost legal already.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to legalize
+ * @return LegalCheck The result of the legality check
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+auto FlowPartMgr<Gnl, GainMgr, ConstrMgr>::legalize(std::span<std::uint8_t> part) -> LegalCheck {
+    FMPartMgr<Gnl, GainMgr, ConstrMgr> part_mgr(this->hyprgraph, this->gain_mgr, this->validator,
+                                                this->num_parts);
+    const auto legalcheck = part_mgr.legalize(part);
+    this->total_cost = part_mgr.total_cost;
+    return legalcheck;
+}
+
+/**
+ * @brief Optimizes the partition by FM and flow-based refinement.
+ *
+ * FM first removes the improvements that single moves can find, so that
+ * the (more expensive) flow passes start from a local optimum; FM runs once
+ * more if the flow passes changed the cut.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to optimize
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+void FlowPartMgr<Gnl, GainMgr, ConstrMgr>::optimize(std::span<std::uint8_t> part) {
+    FMPartMgr<Gnl, GainMgr, ConstrMgr> part_mgr(this->hyprgraph, this->gain_mgr, this->validator,
+                                                this->num_parts);
+    part_mgr.optimize(part);
+    this->total_cost = part_mgr.total_cost;
+    if (this->_refine_pairs(part) == 0) {
+        return;
+    }
+    part_mgr.optimize(part);
+    this->total_cost = part_mgr.total_cost;
+}
+
+/**
+ * @brief Runs the flow-based passes over all block pairs.
+ *
+ * Each pass:
+ * 1. Computes the cut weight between every two blocks
+ * 2. Sorts the pairs by decreasing cut weight and groups them into rounds
+ *    of disjoint pairs
+ * 3. Refines the pairs of each round concurrently, all reading the
+ *    partition at the start of the round
+ *
+ * Passes repeat until one brings no improvement.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to refine
+ * @return The reduction of the cost
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+auto FlowPartMgr<Gnl, GainMgr, ConstrMgr>::_refine_pairs(std::span<std::uint8_t> part) -> int {
+    using node_t = typename Gnl::node_t;
+
+    const auto& hgr = this->hyprgraph;
+    const auto num_modules = static_cast<std::uint32_t>(hgr.number_of_modules());
+    const auto num_nets = static_cast<std::uint32_t>(hgr.number_of_nets());
+    const auto num_parts = static_cast<std::uint8_t>(this->num_parts);
+
+    this->validator.init(part);
+    const auto lowerbound = this->validator.get_lowerbound();
+
+    auto fixed = std::vector<std::uint8_t>(num_modules, 0U);
+    for (const auto& v : hgr.module_fixed) {
+        fixed[v] = 1U;
+    }
+
+    auto total_gain = 0;
+    auto snapshot = std::vector<std::uint8_t>(num_modules, 0U);
+    for (auto pass = 0U; pass != this->max_passes; ++pass) {
+        auto part_weight = std::vector<unsigned int>(num_parts, 0U);
+        for (const auto& v : hgr) {
+            part_weight[part[v]] += hgr.get_module_weight(v);
+        }
+
+        // 1. Cut weight and cut nets of every pair
+        auto pair_weight = std::vector<std::int64_t>(num_parts * num_parts, 0);
+        auto pair_nets = std::vector<std::vector<node_t>>(num_parts * num_parts);
+        auto present = std::vector<std::uint8_t>(num_parts, 0U);
+        auto blocks = std::vector<std::uint8_t>{};
+        for (auto i_net = 0U; i_net != num_nets; ++i_net) {
+            const auto net = node_t(num_modules + i_net);
+            if (!is_flow_net(hgr, net)) {
+                continue;
+            }
+            blocks.clear();
+            for (const auto& v : hgr.gr[net]) {
+                if (present[part[v]] == 0U) {
+                    present[part[v]] = 1U;
+                    blocks.push_back(part[v]);
+                }
+            }
+            for (const auto& k : blocks) {
+                present[k] = 0U;
+            }
+            for (auto i = 0U; i != blocks.size(); ++i) {
+                for (auto j = i + 1U; j != blocks.size(); ++j) {
+                    const auto low = std::min(blocks[i], blocks[j]);
+                    const auto high = std::max(blocks[i], blocks[j]);
+                    pair_weight[low * num_parts + high] += hgr.get_net_weight(net);
+                    pair_nets[low * num_parts + high].push_back(net);
+                }
+            }
+        }
+
+        // 2. Rounds of disjoint pairs, heaviest cut first
+        auto pairs = std::vector<BlockPair>{};
+        for (auto low = 0U; low != num_parts; ++low) {
+            for (auto high = low + 1U; high != num_parts; ++high) {
+                if (pair_weight[low * num_parts + high] > 0) {
+                    pairs.emplace_back(low, high);
+                }
+            }
+        }
+        if (pairs.empty()) {
+            break;
+        }
+        std::stable_sort(pairs.begin(), pairs.end(), [&](const auto& lhs, const auto& rhs) {
+            return pair_weight[lhs.first * num_parts + lhs.second]
+                   > pair_weight[rhs.first * num_parts + rhs.second];
+        });
+        const auto rounds = disjoint_pair_rounds(pairs, num_parts);
+
+        // 3. Concurrent refinement of the pairs of each round
+        auto pass_gain = 0;
+        for (const auto& round : rounds) {
+            std::copy(part.begin(), part.end(), snapshot.begin());
+            auto gains = std::vector<int>(round.size(), 0);
+            const auto num_round = static_cast<std::uint32_t>(round.size());
+            const auto num_tasks = num_parallel_tasks(this->num_threads, num_round, 1U);
+            parallel_for(num_tasks, num_round, [&](size_t, auto first, auto last) {
+                for (auto i = first; i != last; ++i) {
+                    const auto& pair = round[i];
+                    gains[i] = refine_block_pair(
+                        hgr, std::span<const std::uint8_t>(snapshot), part,
+                        std::span<const std::uint8_t>(fixed), pair,
+                        std::span<const node_t>(pair_nets[pair.first * num_parts + pair.second]),
+                        std::span<unsigned int>(part_weight), lowerbound,
+                        this->max_region_modules);
+                }
+            });
+            for (const auto& gain : gains) {
+                pass_gain += gain;
+            }
+        }
+        total_gain += pass_gain;
+        if (pass_gain == 0) {
+            break;
+        }
+    }
+    return total_gain;
+}
+
+#include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
+#include <netlistx/netlist.hpp>        // for SimpleNetlist, Netlist
+#include <xnetwork/classes/graph.hpp>
+
+template auto refine_block_pair(const SimpleNetlist& hgr, std::span<const std::uint8_t> snapshot,
+                                std::span<std::uint8_t> part, std::span<const std::uint8_t> fixed,
+                                const BlockPair& pair,
+                                std::span<const SimpleNetlist::node_t> cut_nets,
+                                std::span<unsigned int> part_weight, unsigned int lowerbound,
+                                size_t max_region_modules) -> int;
+
+template class FlowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                           FMKWayConstrMgr<SimpleNetlist>>;
+
+#include <ckpttn/FMBiConstrMgr.hpp>  // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>    // for FMBiGainMgr
+
+template class FlowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                           FMBiConstrMgr<SimpleNetlist>>;
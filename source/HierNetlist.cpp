@@ -1,54 +1,123 @@
 // #include <__config>  // for std
+#include <algorithm>  // for max
 #include <ckpttn/HierNetlist.hpp>
-#include <netlistx/netlist.hpp>  // for Netlist, Netlist<>::nodeview_t
-#include <py2cpp/range.hpp>      // for _iterator, iterable_wrapper
+#include <ckpttn/parallel_for.hpp>  // for parallel_for, num_parallel_tasks
+#include <cstdint>                  // for uint32_t
+#include <netlistx/netlist.hpp>     // for Netlist, Netlist<>::nodeview_t
+#include <py2cpp/range.hpp>         // for _iterator, iterable_wrapper
 
 using namespace std;
 
+/// @brief Minimum number of modules per task of a projection
+static constexpr size_t PROJECTION_BLOCK_SIZE = 8192U;
+
 /**
  * @brief Projects a partition from the current level up to the parent level.
  *
  * Maps each vertex's partition assignment from the current (child) level
- * to the parent level using the upward node mapping.
+ * to the parent level using the upward node mapping. A cluster gets the part
+ * of its last module, and fixed modules take precedence, so that a cluster
+ * containing a fixed module gets its part. Large levels are projected in
+ * parallel over the parent modules, except for the levels contracted from a
+ * labeling, which are projected serially over the child modules.
  *
  * @tparam graph_t The graph type
+ * @tparam parent_t The type of the parent netlist
  * @param[in] part The partition assignment at the current level
  * @param[out] part_up The projected partition assignment at the parent level
  */
-template <typename graph_t>
-void HierNetlist<graph_t>::projection_up(std::span<const uint8_t> part,
-                                         std::span<uint8_t> part_up) const {
+template <typename graph_t, typename parent_t>
+void HierNetlist<graph_t, parent_t>::projection_up(std::span<const uint8_t> part,
+                                                   std::span<uint8_t> part_up) const {
     const auto& hyprgraph = *this->parent;
-    for (const auto& v : hyprgraph) {
+    if (this->node_down_map.empty()) {
+        for (const auto& v : hyprgraph) {
+            part_up[this->node_up_map[v]] = part[v];
+        }
+    } else {
+        const auto num_modules = static_cast<std::uint32_t>(this->number_of_modules());
+        const auto num_tasks = num_parallel_tasks(0U, num_modules, PROJECTION_BLOCK_SIZE);
+        parallel_for(num_tasks, num_modules, [&](size_t, auto first, auto last) {
+            for (auto v = first; v != last; ++v) {
+                if (this->cluster_down_map.contains(v)) {
+                    auto v2 = node_t{0U};
+                    for (const auto& w : hyprgraph.gr[this->cluster_down_map.at(v)]) {
+                        v2 = std::max(v2, w);
+                    }
+                    part_up[v] = part[v2];
+                } else {
+                    part_up[v] = part[this->node_down_map[v]];
+                }
+            }
+        });
+    }
+    // a cluster containing a fixed module must stay in the part of that module
+    for (const auto& v : hyprgraph.module_fixed) {
         part_up[this->node_up_map[v]] = part[v];
     }
 }
 
+/**
+ * @brief Projects labels that no cluster crosses up to a higher level.
+ *
+ * Every cluster takes the label of any of its modules, e.g. the labels kept
+ * by the contraction of a V-cycle (see `MLPartMgr::run_Recombine`).
+ *
+ * @tparam graph_t The graph type
+ * @tparam parent_t The type of the parent netlist
+ * @param[in] label The labels at the current level
+ * @param[out] label_up The projected labels at the parent level
+ */
+template <typename graph_t, typename parent_t>
+void HierNetlist<graph_t, parent_t>::projection_up(std::span<const std::uint32_t> label,
+                                                   std::span<std::uint32_t> label_up) const {
+    for (const auto& v : *this->parent) {
+        label_up[this->node_up_map[v]] = label[v];
+    }
+}
+
 /**
  * @brief Projects a partition from the current level down to the child level.
  *
  * Maps partition assignments from the current (parent) level back to the
- * child level using the downward node and cluster mappings.
+ * child level using the downward node and cluster mappings, or using the
+ * upward node mapping for the levels contracted from a labeling. Large levels
+ * are projected in parallel.
  *
  * @tparam graph_t The graph type
+ * @tparam parent_t The type of the parent netlist
  * @param[in] part The partition assignment at the current level
  * @param[out] part_down The projected partition assignment at the child level
  */
-template <typename graph_t>
-void HierNetlist<graph_t>::projection_down(std::span<const uint8_t> part,
-                                           std::span<uint8_t> part_down) const {
+template <typename graph_t, typename parent_t>
+void HierNetlist<graph_t, parent_t>::projection_down(std::span<const uint8_t> part,
+                                                     std::span<uint8_t> part_down) const {
     const auto& hyprgraph = *this->parent;
-    for (const auto& v : this->modules) {
-        if (this->cluster_down_map.contains(v)) {
-            const auto net = this->cluster_down_map.at(v);
-            for (const auto& v2 : hyprgraph.gr[net]) {
+    if (this->node_down_map.empty()) {
+        const auto num_modules2 = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+        const auto num_tasks = num_parallel_tasks(0U, num_modules2, PROJECTION_BLOCK_SIZE);
+        parallel_for(num_tasks, num_modules2, [&](size_t, auto first, auto last) {
+            for (auto v2 = first; v2 != last; ++v2) {
+                part_down[v2] = part[this->node_up_map[v2]];
+            }
+        });
+        return;
+    }
+    const auto num_modules = static_cast<std::uint32_t>(this->number_of_modules());
+    const auto num_tasks = num_parallel_tasks(0U, num_modules, PROJECTION_BLOCK_SIZE);
+    parallel_for(num_tasks, num_modules, [&](size_t, auto first, auto last) {
+        for (auto v = first; v != last; ++v) {
+            if (this->cluster_down_map.contains(v)) {
+                const auto net = this->cluster_down_map.at(v);
+                for (const auto& v2 : hyprgraph.gr[net]) {
+                    part_down[v2] = part[v];
+                }
+            } else {
+                const auto v2 = this->node_down_map[v];
                 part_down[v2] = part[v];
             }
-        } else {
-            const auto v2 = this->node_down_map[v];
-            part_down[v2] = part[v];
         }
-    }
+    });
     // if (extern_nets.empty()) {
     //     return;
     // }
@@ -60,3 +129,4 @@ void HierNetlist<graph_t>::projection_down(std::span<const uint8_t> part,
 }
 
 template class HierNetlist<xnetwork::SimpleGraph>;
+template class HierNetlist<xnetwork::SimpleGraph, CsrNetlist>;
@@ -0,0 +1,288 @@
+#include <algorithm>                      // for max_element, min_element, sort
+#include <ckpttn/ConnectivityInfo.hpp>    // for ConnectivityInfo
+#include <ckpttn/FMConstrMgr.hpp>         // for LegalCheck
+#include <ckpttn/IncrementalPartMgr.hpp>  // for IncrementalPartMgr, NetlistDelta
+#include <ckpttn/LocalFMPartMgr.hpp>      // for LocalFMPartMgr
+#include <ckpttn/MLPartMgr.hpp>           // for MLPartMgr
+#include <ckpttn/parallel_for.hpp>        // for num_parallel_tasks
+#include <cstdint>                        // for uint8_t, uint32_t, uint64_t
+#include <stdexcept>                      // for invalid_argument
+#include <unordered_set>                  // for unordered_set
+#include <utility>                        // for move
+#include <vector>                         // for vector
+#include <xnetwork/classes/graph.hpp>     // for SimpleGraph
+
+/// @brief Minimum number of modules per task of the cost computation
+static constexpr size_t ECO_MIN_BLOCK_SIZE = 4096U;
+
+/**
+ * @brief Returns the key of a pin in a hash set.
+ *
+ * @param[in] net The net
+ * @param[in] v The module
+ * @return The key
+ */
+static auto pin_key(std::uint32_t net, std::uint32_t v) -> std::uint64_t {
+    return (std::uint64_t{net} << 32U) | v;
+}
+
+auto apply_netlist_delta(const SimpleNetlist& hyprgraph, const NetlistDelta& delta)
+    -> PatchedNetlist {
+    const auto num_modules = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+    const auto num_nets = static_cast<std::uint32_t>(hyprgraph.number_of_nets());
+    const auto total_modules = num_modules + delta.num_added_modules;
+    const auto total_nets = num_nets + static_cast<std::uint32_t>(delta.added_nets.size());
+    if (!delta.added_module_weight.empty()
+        && delta.added_module_weight.size() != delta.num_added_modules) {
+        throw std::invalid_argument("The added module weights must be one per added module");
+    }
+    auto check_module = [&](std::uint32_t v) {
+        if (v >= total_modules) {
+            throw std::invalid_argument("The delta refers to a module that does not exist");
+        }
+    };
+    auto check_net = [&](std::uint32_t net) {
+        if (net >= total_nets) {
+            throw std::invalid_argument("The delta refers to a net that does not exist");
+        }
+    };
+
+    auto affected = std::vector<std::uint8_t>(total_modules, 0U);
+    auto removed_module = std::vector<std::uint8_t>(total_modules, 0U);
+    for (const auto& v : delta.removed_modules) {
+        check_module(v);
+        removed_module[v] = 1U;
+        if (v < num_modules) {
+            // its neighbors lose a connection
+            for (const auto& net : hyprgraph.gr[v]) {
+                for (const auto& u : hyprgraph.gr[net]) {
+                    affected[u] = 1U;
+                }
+            }
+        }
+    }
+    auto removed_net = std::vector<std::uint8_t>(total_nets, 0U);
+    for (const auto& net : delta.removed_nets) {
+        check_net(net);
+        removed_net[net] = 1U;
+        if (net < num_nets) {
+            for (const auto& u : hyprgraph.gr[num_modules + net]) {
+                affected[u] = 1U;
+            }
+        }
+    }
+    auto removed_pins = std::unordered_set<std::uint64_t>{};
+    for (const auto& [net, v] : delta.removed_pins) {
+        check_net(net);
+        check_module(v);
+        removed_pins.insert(pin_key(net, v));
+        affected[v] = 1U;
+    }
+
+    // the pins of every net, in the delta numbering
+    auto added_pins = std::vector<std::vector<std::uint32_t>>(total_nets);
+    for (const auto& [net, v] : delta.added_pins) {
+        check_net(net);
+        check_module(v);
+        added_pins[net].push_back(v);
+        affected[v] = 1U;
+    }
+    for (auto i = 0U; i != delta.num_added_modules; ++i) {
+        affected[num_modules + i] = 1U;
+    }
+    for (const auto& pins : delta.added_nets) {
+        for (const auto& v : pins) {
+            check_module(v);
+            affected[v] = 1U;
+        }
+    }
+
+    auto module_map = std::vector<std::uint32_t>(total_modules, PatchedNetlist::REMOVED);
+    auto num_modules2 = std::uint32_t{0U};
+    for (auto v = 0U; v != total_modules; ++v) {
+        if (removed_module[v] == 0U) {
+            module_map[v] = num_modules2++;
+        }
+    }
+    auto num_nets2 = std::uint32_t{0U};
+    for (auto net = 0U; net != total_nets; ++net) {
+        num_nets2 += removed_net[net] == 0U ? 1U : 0U;
+    }
+
+    auto gr = xnetwork::SimpleGraph(num_modules2 + num_nets2);
+    auto net2 = num_modules2;
+    auto add_pin = [&](std::uint32_t net, std::uint32_t v) {
+        if (removed_module[v] == 0U
+            && (removed_pins.empty() || !removed_pins.contains(pin_key(net, v)))) {
+            gr.add_edge(module_map[v], net2);
+        }
+    };
+    for (auto net = 0U; net != total_nets; ++net) {
+        if (removed_net[net] != 0U) {
+            continue;
+        }
+        if (net < num_nets) {
+            for (const auto& v : hyprgraph.gr[num_modules + net]) {
+                add_pin(net, v);
+            }
+        } else {
+            for (const auto& v : delta.added_nets[net - num_nets]) {
+                add_pin(net, v);
+            }
+        }
+        for (const auto& v : added_pins[net]) {
+            add_pin(net, v);
+        }
+        ++net2;
+    }
+
+    auto patched = PatchedNetlist{SimpleNetlist(std::move(gr), num_modules2, num_nets2),
+                                  std::move(module_map),
+                                  {}};
+    auto& hgr2 = patched.netlist;
+    if (!hyprgraph.module_weight.empty() || !delta.added_module_weight.empty()) {
+        hgr2.module_weight.assign(num_modules2, 1U);
+        for (auto v = 0U; v != total_modules; ++v) {
+            const auto v2 = patched.module_map[v];
+            if (v2 == PatchedNetlist::REMOVED) {
+                continue;
+            }
+            if (v < num_modules) {
+                hgr2.module_weight[v2] = hyprgraph.get_module_weight(v);
+            } else if (!delta.added_module_weight.empty()) {
+                hgr2.module_weight[v2] = delta.added_module_weight[v - num_modules];
+            }
+        }
+    }
+    for (const auto& v : hyprgraph.module_fixed) {
+        if (patched.module_map[v] != PatchedNetlist::REMOVED) {
+            hgr2.module_fixed.insert(patched.module_map[v]);
+        }
+    }
+    hgr2.has_fixed_modules = !hgr2.module_fixed.empty();
+    for (auto v = 0U; v != total_modules; ++v) {
+        if (affected[v] != 0U && patched.module_map[v] != PatchedNetlist::REMOVED) {
+            patched.affected.push_back(patched.module_map[v]);
+        }
+    }
+    return patched;
+}
+
+/**
+ * @brief Repartitions a netlist after a change.
+ *
+ * 1. Computes the cost of the previous partition
+ * 2. Carries the partition over; an added module joins the part with most
+ *    of its pins' neighbors, or else the lightest part
+ * 3. If the result is legal, refines the affected modules by boundary FM
+ * 4. Falls back to a multilevel run if the result is not legal or too
+ *    costly, and keeps the better of the two legal results
+ *
+ * @tparam PartMgr The part manager of the multilevel run
+ * @param[in] hyprgraph The previous netlist
+ * @param[in] prev_part The partition of the previous netlist
+ * @param[in] patched The new netlist
+ * @param[out] part The partition of the new netlist
+ * @return LegalCheck The legality check result of the partitioning
+ */
+template <typename PartMgr>
+auto IncrementalPartMgr::run_Partition(const SimpleNetlist& hyprgraph,
+                                       std::span<const std::uint8_t> prev_part,
+                                       const PatchedNetlist& patched,
+                                       std::span<std::uint8_t> part) -> LegalCheck {
+    using GainMgr = typename PartMgr::GainMgr_;
+    using ConstrMgr = typename PartMgr::ConstrMgr_;
+
+    const auto& hgr = patched.netlist;
+    const auto num_modules = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+    if (prev_part.size() != num_modules || part.size() != hgr.number_of_modules()) {
+        throw std::invalid_argument("The partitions must have one entry per module");
+    }
+
+    // 1. Cost before the change
+    {
+        auto conn = ConnectivityInfo<SimpleNetlist>(hyprgraph, this->num_parts);
+        conn.init(prev_part, num_parallel_tasks(0U, num_modules, ECO_MIN_BLOCK_SIZE));
+        this->previous_cost = conn.cost();
+    }
+
+    // 2. Carried-over partition
+    auto assigned = std::vector<std::uint8_t>(part.size(), 0U);
+    auto part_weight = std::vector<unsigned int>(this->num_parts, 0U);
+    for (auto v = 0U; v != num_modules; ++v) {
+        const auto v2 = patched.module_map[v];
+        if (v2 != PatchedNetlist::REMOVED) {
+            part[v2] = prev_part[v];
+            assigned[v2] = 1U;
+            part_weight[part[v2]] += hgr.get_module_weight(v2);
+        }
+    }
+    auto votes = std::vector<unsigned int>(this->num_parts, 0U);
+    for (auto v = num_modules; v != patched.module_map.size(); ++v) {
+        const auto v2 = patched.module_map[v];
+        if (v2 == PatchedNetlist::REMOVED) {
+            continue;
+        }
+        std::fill(votes.begin(), votes.end(), 0U);
+        for (const auto& net : hgr.gr[v2]) {
+            for (const auto& u : hgr.gr[net]) {
+                if (assigned[u] != 0U) {  // the part of a new module is not set yet
+                    ++votes[part[u]];
+                }
+            }
+        }
+        const auto best = std::max_element(votes.begin(), votes.end());
+        part[v2] = static_cast<std::uint8_t>(
+            *best != 0U ? best - votes.begin()
+                        : std::min_element(part_weight.begin(), part_weight.end())
+                              - part_weight.begin());
+        assigned[v2] = 1U;
+        part_weight[part[v2]] += hgr.get_module_weight(v2);
+    }
+
+    // 3. Local refinement around the change
+    this->full_run = false;
+    GainMgr gain_mgr(hgr, this->num_parts);
+    ConstrMgr constr_mgr(hgr, this->bal_tol, this->num_parts);
+    auto local_legal = constr_mgr.final_check(part);
+    if (local_legal) {
+        LocalFMPartMgr<SimpleNetlist, GainMgr, ConstrMgr> local_mgr(hgr, gain_mgr, constr_mgr,
+                                                                    this->num_parts);
+        local_mgr.set_region(patched.affected);
+        local_mgr.optimize(part);
+        this->total_cost = local_mgr.total_cost;
+        if (this->total_cost <= this->previous_cost * (1.0 + this->max_degradation)) {
+            return LegalCheck::AllSatisfied;
+        }
+    }
+
+    // 4. Full run, from the incremental result
+    this->full_run = true;
+    const auto local_part = std::vector<std::uint8_t>(part.begin(), part.end());
+    const auto local_cost = this->total_cost;
+    MLPartMgr ml_mgr(this->bal_tol, this->num_parts);
+    const auto legalcheck = ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hgr, part);
+    this->total_cost = ml_mgr.total_cost;
+    if (local_legal && (legalcheck != LegalCheck::AllSatisfied || local_cost < this->total_cost)) {
+        std::copy(local_part.begin(), local_part.end(), part.begin());
+        this->total_cost = local_cost;
+        return LegalCheck::AllSatisfied;
+    }
+    return legalcheck;
+}
+
+#include <ckpttn/FMBiConstrMgr.hpp>    // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>      // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>        // for FMPartMgr
+
+template auto IncrementalPartMgr::run_Partition<
+    FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> prev_part,
+    const PatchedNetlist& patched, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto IncrementalPartMgr::run_Partition<
+    FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> prev_part,
+    const PatchedNetlist& patched, std::span<std::uint8_t> part) -> LegalCheck;
@@ -0,0 +1,434 @@
+#include <algorithm>                 // for shuffle, fill, copy, min, max
+#include <atomic>                    // for atomic
+#include <ckpttn/FMConstrMgr.hpp>    // for LegalCheck, LegalCheck::AllSatisfied
+#include <ckpttn/FMPmrConfig.hpp>    // for FM_MAX_DEGREE
+#include <ckpttn/InitPartMgr.hpp>    // for InitPartMgr
+#include <ckpttn/MidLvlPartMgr.hpp>  // for MidLvlPartMgr
+#include <ckpttn/TaskScheduler.hpp>  // for TaskScheduler, TaskGroup
+#include <cmath>                     // for round
+#include <cstdint>                   // for uint8_t, uint32_t
+#include <netlistx/netlist.hpp>      // for SimpleNetlist
+#include <queue>                     // for priority_queue
+#include <random>                    // for mt19937, uniform_int_distribution
+#include <span>                      // for span
+#include <utility>                   // for pair
+#include <vector>                    // for vector
+
+/// @brief Heuristics of the initial partitioning portfolio
+enum class InitMethod { given, random, bfs_growing, greedy_growing, label_propagation, exact };
+
+/**
+ * @brief Assigns every free module to a random part.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in,out] part The partition vector
+ * @param[in] num_parts The number of partitions
+ * @param[in,out] gen The random number generator
+ */
+template <typename Gnl, typename Gen>
+static void random_part(const Gnl& hyprgraph, std::span<std::uint8_t> part,
+                        std::uint8_t num_parts, Gen& gen) {
+    std::uniform_int_distribution<int> dist(0, num_parts - 1);
+    for (const auto& v : hyprgraph) {
+        if (!hyprgraph.module_fixed.contains(v)) {
+            part[v] = static_cast<std::uint8_t>(dist(gen));
+        }
+    }
+}
+
+/**
+ * @brief Hypergraph growing: grows parts 0..K-2 one at a time from a seed module.
+ *
+ * With `greedy` set, the next module is the one connected to the grown
+ * region by the largest number of nets; otherwise modules are taken in
+ * BFS order. The remaining free modules go to the last part.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in,out] part The partition vector
+ * @param[in] num_parts The number of partitions
+ * @param[in,out] gen The random number generator (for choosing seeds)
+ * @param[in] greedy Whether to use greedy instead of BFS growing
+ */
+template <typename Gnl, typename Gen>
+static void growing_part(const Gnl& hyprgraph, std::span<std::uint8_t> part,
+                         std::uint8_t num_parts, Gen& gen, bool greedy) {
+    using node_t = typename Gnl::node_t;
+
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto weight = std::vector<unsigned int>(num_parts, 0U);
+    auto assigned = std::vector<std::uint8_t>(num_modules, 0U);
+    auto free_modules = std::vector<node_t>{};
+    auto total_weight = 0U;
+    for (const auto& v : hyprgraph) {
+        const auto weight_v = hyprgraph.get_module_weight(v);
+        total_weight += weight_v;
+        if (hyprgraph.module_fixed.contains(v)) {
+            assigned[v] = 1U;
+            weight[part[v]] += weight_v;
+        } else {
+            free_modules.emplace_back(v);
+        }
+    }
+    std::shuffle(free_modules.begin(), free_modules.end(), gen);
+
+    const auto target = total_weight / num_parts;
+    auto next_seed = free_modules.begin();
+    auto visited = std::vector<std::uint8_t>(hyprgraph.number_of_nets(), 0U);
+    auto score = std::vector<int>(num_modules, 0);
+
+    for (auto part_idx = std::uint8_t{0}; part_idx + 1 < num_parts; ++part_idx) {
+        std::fill(visited.begin(), visited.end(), 0U);
+        std::fill(score.begin(), score.end(), 0);
+        auto queue = std::priority_queue<std::pair<int, node_t>>{};
+        auto order = 0;
+        while (weight[part_idx] < target) {
+            if (queue.empty()) {
+                while (next_seed != free_modules.end() && assigned[*next_seed] != 0U) {
+                    ++next_seed;
+                }
+                if (next_seed == free_modules.end()) {
+                    break;
+                }
+                queue.emplace(0, *next_seed);
+            }
+            const auto v = queue.top().second;
+            queue.pop();
+            if (assigned[v] != 0U) {
+                continue;
+            }
+            assigned[v] = 1U;
+            part[v] = part_idx;
+            weight[part_idx] += hyprgraph.get_module_weight(v);
+            for (const auto& net : hyprgraph.gr[v]) {
+                const auto i_net = net - num_modules;
+                if (visited[i_net] != 0U || hyprgraph.gr.degree(net) > FM_MAX_DEGREE) {
+                    continue;
+                }
+                visited[i_net] = 1U;
+                for (const auto& u : hyprgraph.gr[net]) {
+                    if (assigned[u] == 0U) {
+                        queue.emplace(greedy ? ++score[u] : --order, u);
+                    }
+                }
+            }
+        }
+    }
+
+    for (const auto& v : free_modules) {
+        if (assigned[v] == 0U) {
+            part[v] = static_cast<std::uint8_t>(num_parts - 1);
+        }
+    }
+}
+
+/**
+ * @brief Size-constrained label propagation starting from a random assignment.
+ *
+ * Each free module moves to the part that holds most of the other pins of
+ * its nets, as long as the part weights stay within the balance bounds.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in,out] part The partition vector
+ * @param[in] num_parts The number of partitions
+ * @param[in] bal_tol The balance tolerance
+ * @param[in,out] gen The random number generator
+ */
+template <typename Gnl, typename Gen>
+static void label_propagation_part(const Gnl& hyprgraph, std::span<std::uint8_t> part,
+                                   std::uint8_t num_parts, double bal_tol, Gen& gen) {
+    using node_t = typename Gnl::node_t;
+    static constexpr int max_rounds = 5;
+
+    random_part(hyprgraph, part, num_parts, gen);
+
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto weight = std::vector<unsigned int>(num_parts, 0U);
+    auto free_modules = std::vector<node_t>{};
+    auto total_weight = 0U;
+    for (const auto& v : hyprgraph) {
+        const auto weight_v = hyprgraph.get_module_weight(v);
+        total_weight += weight_v;
+        weight[part[v]] += weight_v;
+        if (!hyprgraph.module_fixed.contains(v)) {
+            free_modules.emplace_back(v);
+        }
+    }
+    const auto lowerbound
+        = static_cast<unsigned int>(std::round(total_weight * (2.0 / num_parts) * bal_tol));
+    const auto upperbound = total_weight - (num_parts - 1U) * lowerbound;
+
+    auto num_pins = std::vector<unsigned int>(hyprgraph.number_of_nets() * num_parts, 0U);
+    for (const auto& net : hyprgraph.nets) {
+        for (const auto& v : hyprgraph.gr[net]) {
+            ++num_pins[(net - num_modules) * num_parts + part[v]];
+        }
+    }
+
+    auto conn = std::vector<unsigned int>(num_parts, 0U);
+    for (auto pass = 0; pass != max_rounds; ++pass) {
+        std::shuffle(free_modules.begin(), free_modules.end(), gen);
+        auto num_moved = 0U;
+        for (const auto& v : free_modules) {
+            const auto from_part = part[v];
+            std::fill(conn.begin(), conn.end(), 0U);
+            for (const auto& net : hyprgraph.gr[v]) {
+                const auto degree = hyprgraph.gr.degree(net);
+                if (degree < 2 || degree > FM_MAX_DEGREE) {
+                    continue;
+                }
+                const auto offset = (net - num_modules) * num_parts;
+                for (auto part_idx = 0U; part_idx != num_parts; ++part_idx) {
+                    conn[part_idx] += num_pins[offset + part_idx];
+                }
+                --conn[from_part];
+            }
+            const auto weight_v = hyprgraph.get_module_weight(v);
+            if (weight[from_part] < lowerbound + weight_v) {
+                continue;
+            }
+            auto to_part = from_part;
+            for (auto part_idx = 0U; part_idx != num_parts; ++part_idx) {
+                if (conn[part_idx] > conn[to_part] && weight[part_idx] + weight_v <= upperbound) {
+                    to_part = static_cast<std::uint8_t>(part_idx);
+                }
+            }
+            if (to_part == from_part) {
+                continue;
+            }
+            for (const auto& net : hyprgraph.gr[v]) {
+                const auto offset = (net - num_modules) * num_parts;
+                --num_pins[offset + from_part];
+                ++num_pins[offset + to_part];
+            }
+            weight[from_part] -= weight_v;
+            weight[to_part] += weight_v;
+            part[v] = to_part;
+            ++num_moved;
+        }
+        if (num_moved == 0U) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Legalizes (if needed) and refines a partition with the given partition manager.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in,out] part The partition vector
+ * @param[in] bal_tol The balance tolerance
+ * @param[in] num_parts The number of partitions
+ * @return The legality check result and the resulting cost
+ */
+template <typename Gnl, typename PartMgr>
+static auto refine_part(const Gnl& hyprgraph, std::span<std::uint8_t> part, double bal_tol,
+                        std::uint8_t num_parts) -> std::pair<LegalCheck, int> {
+    using GainMgr = PartMgr::GainMgr_;
+    using ConstrMgr = PartMgr::ConstrMgr_;
+
+    GainMgr gain_mgr(hyprgraph, num_parts);
+    ConstrMgr constr_mgr(hyprgraph, bal_tol, num_parts);
+    PartMgr part_mgr(hyprgraph, gain_mgr, constr_mgr, num_parts);
+    auto legalcheck = LegalCheck::AllSatisfied;
+    if (!constr_mgr.final_check(part)) {
+        legalcheck = part_mgr.legalize(part);
+        if (legalcheck != LegalCheck::AllSatisfied) {
+            return {legalcheck, part_mgr.total_cost};
+        }
+    }
+    part_mgr.optimize(part);
+    return {legalcheck, part_mgr.total_cost};
+}
+
+/// @brief Result of one portfolio member
+struct InitResult {
+    LegalCheck legalcheck;
+    int cost;
+    std::vector<std::uint8_t> part;
+};
+
+/**
+ * @brief Runs the initial partitioning portfolio in parallel.
+ *
+ * Every member starts from a copy of `part` (so that fixed modules keep their
+ * parts), applies its heuristic and is refined by `PartMgr`. The legal result
+ * with the lowest cost wins; ties are broken by the member order, so the
+ * outcome does not depend on the thread scheduling.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam PartMgr The partition manager type (e.g., FMPartMgr, NNPartMgr)
+ * @param[in] hyprgraph The input hypergraph to partition
+ * @param[in,out] part The partition vector to store the result
+ * @return LegalCheck The legality check result
+ */
+template <typename Gnl, typename PartMgr>
+auto InitPartMgr::run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck {
+    auto methods = std::vector<InitMethod>{InitMethod::given};
+    for (auto idx = 0U; idx != this->num_random; ++idx) {
+        methods.emplace_back(InitMethod::random);
+    }
+    methods.emplace_back(InitMethod::bfs_growing);
+    methods.emplace_back(InitMethod::greedy_growing);
+    methods.emplace_back(InitMethod::label_propagation);
+    if (this->num_parts == 2 && !hyprgraph.has_fixed_modules
+        && hyprgraph.number_of_modules() <= this->exact_limit) {
+        methods.emplace_back(InitMethod::exact);
+    }
+
+    auto run_member = [&](size_t idx) -> InitResult {
+        auto local_part = std::vector<std::uint8_t>(part.begin(), part.end());
+        auto gen = std::mt19937{this->seed + static_cast<std::uint32_t>(idx) * 104729U};
+        switch (methods[idx]) {
+            case InitMethod::random:
+                random_part(hyprgraph, std::span<std::uint8_t>(local_part), this->num_parts, gen);
+                break;
+            case InitMethod::bfs_growing:
+                growing_part(hyprgraph, std::span<std::uint8_t>(local_part), this->num_parts, gen,
+                             false);
+                break;
+            case InitMethod::greedy_growing:
+                growing_part(hyprgraph, std::span<std::uint8_t>(local_part), this->num_parts, gen,
+                             true);
+                break;
+            case InitMethod::label_propagation:
+                label_propagation_part(hyprgraph, std::span<std::uint8_t>(local_part),
+                                       this->num_parts, this->bal_tol, gen);
+                break;
+            case InitMethod::exact: {
+                MidLvlPartMgr<Gnl> mid_mgr{hyprgraph, this->bal_tol};
+                mid_mgr.optimize(local_part);
+                break;
+            }
+            default:
+                break;
+        }
+        const auto [legalcheck, cost] = refine_part<Gnl, PartMgr>(hyprgraph, local_part,
+                                                                  this->bal_tol, this->num_parts);
+        return {legalcheck, cost, std::move(local_part)};
+    };
+
+    auto num_workers = this->num_threads != 0U ? this->num_threads
+                                               : TaskScheduler::current().num_threads();
+    num_workers = std::min(std::max(num_workers, size_t{1U}), methods.size());
+
+    auto results = std::vector<InitResult>(methods.size());
+    auto next_member = std::atomic<size_t>{0U};
+    const auto run_members = [&]() {
+        for (auto idx = next_member++; idx < methods.size(); idx = next_member++) {
+            results[idx] = run_member(idx);
+        }
+    };
+    if (num_workers == 1U) {
+        run_members();
+    } else {
+        auto group = TaskGroup{};
+        for (auto worker = size_t{0U}; worker != num_workers; ++worker) {
+            group.run(run_members);
+        }
+        group.wait();
+    }
+
+    auto best = size_t{0U};
+    for (auto idx = 1U; idx != results.size(); ++idx) {
+        if (results[idx].legalcheck != LegalCheck::AllSatisfied) {
+            continue;
+        }
+        if (results[best].legalcheck != LegalCheck::AllSatisfied
+            || results[idx].cost < results[best].cost) {
+            best = idx;
+        }
+    }
+
+    std::copy(results[best].part.begin(), results[best].part.end(), part.begin());
+    this->total_cost = results[best].cost;
+    return results[best].legalcheck;
+}
+
+#include <ckpttn/CsrNetlist.hpp>           // for CsrNetlist
+#include <ckpttn/FMBiConstrMgr.hpp>        // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>          // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>      // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>        // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>            // for FMPartMgr
+#include <ckpttn/FlowPartMgr.hpp>          // for FlowPartMgr
+#include <ckpttn/LPPartMgr.hpp>            // for LPPartMgr
+#include <ckpttn/LocalFMPartMgr.hpp>       // for LocalFMPartMgr
+#include <ckpttn/MidLvlWindowPartMgr.hpp>  // for MidLvlWindowPartMgr
+#include <ckpttn/NNPartMgr.hpp>            // for NNPartMgr
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    NNPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    NNPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    CsrNetlist, FMPartMgr<CsrNetlist, FMBiGainMgr<CsrNetlist>, FMBiConstrMgr<CsrNetlist>>>(
+    const CsrNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    CsrNetlist, FMPartMgr<CsrNetlist, FMKWayGainMgr<CsrNetlist>, FMKWayConstrMgr<CsrNetlist>>>(
+    const CsrNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    CsrNetlist, NNPartMgr<CsrNetlist, FMBiGainMgr<CsrNetlist>, FMBiConstrMgr<CsrNetlist>>>(
+    const CsrNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    CsrNetlist, NNPartMgr<CsrNetlist, FMKWayGainMgr<CsrNetlist>, FMKWayConstrMgr<CsrNetlist>>>(
+    const CsrNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    LPPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    LPPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    LocalFMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist, LocalFMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                  FMKWayConstrMgr<SimpleNetlist>>>(const SimpleNetlist& hyprgraph,
+                                                                   std::span<std::uint8_t> part)
+    -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    FlowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    FlowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist,
+    MidLvlWindowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto InitPartMgr::run_Partition<
+    SimpleNetlist, MidLvlWindowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                       FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
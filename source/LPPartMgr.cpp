@@ -0,0 +1,173 @@
+#include <algorithm>                    // for copy
+#include <atomic>                       // for atomic, memory_order_relaxed
+#include <ckpttn/ConnectivityInfo.hpp>  // for ConnectivityInfo
+#include <ckpttn/FMConstrMgr.hpp>       // for LegalCheck
+#include <ckpttn/FMPartMgr.hpp>         // for FMPartMgr
+#include <ckpttn/LPPartMgr.hpp>         // for LPPartMgr
+#include <ckpttn/TaskScheduler.hpp>     // for TaskScheduler
+#include <ckpttn/parallel_for.hpp>      // for parallel_for, num_parallel_tasks
+#include <cstdint>                      // for uint8_t, uint32_t
+#include <span>                         // for span
+#include <vector>                       // for vector
+
+/// @brief Minimum number of modules per thread
+static constexpr size_t LP_MIN_BLOCK_SIZE = 1024U;
+
+/**
+ * @brief Legalizes the partition to satisfy balance constraints.
+ *
+ * Uses the serial FM legalization, since it is run once per level on a
+ * partition that is usually almost legal already.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to legalize
+ * @return LegalCheck The result of the legality check
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+auto LPPartMgr<Gnl, GainMgr, ConstrMgr>::legalize(std::span<std::uint8_t> part) -> LegalCheck {
+    FMPartMgr<Gnl, GainMgr, ConstrMgr> part_mgr(this->hyprgraph, this->gain_mgr, this->validator,
+                                                this->num_parts);
+    const auto legalcheck = part_mgr.legalize(part);
+    this->total_cost = part_mgr.total_cost;
+    return legalcheck;
+}
+
+/**
+ * @brief Optimizes the partition by parallel label propagation.
+ *
+ * Rounds alternate between moves towards higher and towards lower part
+ * indices, so that two connected modules cannot swap parts in the same
+ * round. A round that does not reduce the cost is reverted; two such rounds
+ * in a row (one in each direction) end the refinement.
+ *
+ * In deterministic mode (see `TaskScheduler::set_deterministic`) the target
+ * parts are computed in parallel from the state at the start of the round,
+ * and the moves that still have a positive gain are applied serially in
+ * module order.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to optimize
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+void LPPartMgr<Gnl, GainMgr, ConstrMgr>::optimize(std::span<std::uint8_t> part) {
+    using node_t = typename Gnl::node_t;
+
+    const auto& hgr = this->hyprgraph;
+    const auto num_modules = static_cast<std::uint32_t>(hgr.number_of_modules());
+    const auto num_parts = static_cast<std::uint8_t>(this->num_parts);
+
+    const auto num_tasks = num_parallel_tasks(this->num_threads, num_modules, LP_MIN_BLOCK_SIZE);
+
+    this->validator.init(part);
+    const auto lowerbound = this->validator.get_lowerbound();
+
+    auto fixed = std::vector<std::uint8_t>(num_modules, 0U);
+    for (const auto& v : hgr.module_fixed) {
+        fixed[v] = 1U;
+    }
+
+    auto conn = ConnectivityInfo<Gnl>(hgr, num_parts);
+    conn.init(part, num_tasks);
+    auto cost = conn.cost();
+    auto snapshot = std::vector<std::uint8_t>(num_modules, 0U);
+    const auto deterministic = TaskScheduler::current().is_deterministic();
+    auto target = std::vector<std::uint8_t>(deterministic ? num_modules : 0U, 0U);
+    auto stalls = 0U;
+    for (auto pass = 0U; pass != this->max_rounds && stalls < 2U; ++pass) {
+        const auto upward = pass % 2U == 0U;
+        std::copy(part.begin(), part.end(), snapshot.begin());
+        auto num_moved = std::atomic<size_t>{0U};
+
+        auto best_target = [&](const node_t& v, std::span<int> gain) {
+            const auto from_part = part[v];
+            conn.compute_gains(v, from_part, gain);
+            auto to_part = from_part;
+            auto best_gain = 0;
+            for (auto k = 0U; k != num_parts; ++k) {
+                if (upward ? k <= from_part : k >= from_part) {
+                    continue;
+                }
+                if (gain[k] > best_gain) {
+                    best_gain = gain[k];
+                    to_part = static_cast<std::uint8_t>(k);
+                }
+            }
+            return to_part;
+        };
+
+        if (deterministic) {
+            // proposals from the state at the start of the round, applied in module order
+            parallel_for(num_tasks, num_modules, [&](size_t, auto first, auto last) {
+                auto gain = std::vector<int>(num_parts, 0);
+                for (auto v = first; v != last; ++v) {
+                    target[v] = fixed[v] != 0U ? part[v] : best_target(v, gain);
+                }
+            });
+            for (auto v = 0U; v != num_modules; ++v) {
+                const auto from_part = part[v];
+                const auto to_part = target[v];
+                if (to_part == from_part || conn.move_gain(v, from_part, to_part) <= 0
+                    || !conn.try_move(v, from_part, to_part, lowerbound)) {
+                    continue;
+                }
+                part[v] = to_part;
+                ++num_moved;
+            }
+        } else {
+            parallel_for(num_tasks, num_modules, [&](size_t, auto first, auto last) {
+                auto gain = std::vector<int>(num_parts, 0);
+                auto moved = size_t{0U};
+                for (auto v = first; v != last; ++v) {
+                    if (fixed[v] != 0U) {
+                        continue;
+                    }
+                    const auto from_part = part[v];
+                    const auto to_part = best_target(v, gain);
+                    if (to_part == from_part
+                        || !conn.try_move(v, from_part, to_part, lowerbound)) {
+                        continue;
+                    }
+                    part[v] = to_part;
+                    ++moved;
+                }
+                num_moved.fetch_add(moved, std::memory_order_relaxed);
+            });
+        }
+
+        if (num_moved.load() == 0U) {
+            ++stalls;
+            continue;
+        }
+        const auto cost_after = conn.cost();
+        if (cost_after >= cost) {  // revert the round
+            for (const auto& v : hgr) {
+                if (part[v] != snapshot[v]) {
+                    conn.move(v, part[v], snapshot[v]);
+                    part[v] = snapshot[v];
+                }
+            }
+            ++stalls;
+            continue;
+        }
+        cost = cost_after;
+        stalls = 0U;
+    }
+    this->total_cost = cost;
+}
+
+#include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
+#include <netlistx/netlist.hpp>        // for SimpleNetlist, Netlist
+#include <xnetwork/classes/graph.hpp>
+
+template class LPPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                         FMKWayConstrMgr<SimpleNetlist>>;
+
+#include <ckpttn/FMBiConstrMgr.hpp>  // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>    // for FMBiGainMgr
+
+template class LPPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>;
@@ -0,0 +1,329 @@
+#include <algorithm>                    // for sort, shuffle, max_element, ...
+#include <atomic>                       // for atomic, memory_order_relaxed
+#include <ckpttn/ConnectivityInfo.hpp>  // for ConnectivityInfo
+#include <ckpttn/FMConstrMgr.hpp>       // for LegalCheck
+#include <ckpttn/FMPartMgr.hpp>         // for FMPartMgr
+#include <ckpttn/LocalFMPartMgr.hpp>    // for LocalFMPartMgr
+#include <ckpttn/TaskScheduler.hpp>     // for TaskScheduler
+#include <ckpttn/parallel_for.hpp>      // for parallel_for, num_parallel_tasks
+#include <cstdint>                      // for uint8_t, uint32_t, uint64_t
+#include <limits>                       // for numeric_limits
+#include <queue>                        // for priority_queue
+#include <random>                       // for mt19937
+#include <span>                         // for span
+#include <tuple>                        // for tuple
+#include <vector>                       // for vector
+
+/// @brief Minimum number of modules per thread
+static constexpr size_t LFM_MIN_BLOCK_SIZE = 256U;
+/// @brief A local search grows only along nets with at most this many pins
+static constexpr size_t LFM_MAX_GROW_DEGREE = 32U;
+/// @brief Maximum number of modules inserted into the queue of a local search
+static constexpr size_t LFM_MAX_TOUCHED = 64U;
+
+/**
+ * @brief A move applied to the shared partition during a round
+ *
+ * @tparam node_t The node type
+ */
+template <typename node_t> struct LocalMove {
+    node_t v;
+    std::uint8_t from_part;
+    std::uint8_t to_part;
+    /// @brief Global order in which the move was applied
+    std::uint64_t stamp;
+};
+
+/**
+ * @brief Legalizes the partition to satisfy balance constraints.
+ *
+ * Uses the serial FM legalization, since it is run once per level on a
+ * partition that is usually almost legal already.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to legalize
+ * @return LegalCheck The result of the legality check
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+auto LocalFMPartMgr<Gnl, GainMgr, ConstrMgr>::legalize(std::span<std::uint8_t> part)
+    -> LegalCheck {
+    FMPartMgr<Gnl, GainMgr, ConstrMgr> part_mgr(this->hyprgraph, this->gain_mgr, this->validator,
+                                                this->num_parts);
+    const auto legalcheck = part_mgr.legalize(part);
+    this->total_cost = part_mgr.total_cost;
+    return legalcheck;
+}
+
+/**
+ * @brief Optimizes the partition by localized parallel FM searches.
+ *
+ * Each round:
+ * 1. Collects the boundary modules (pins of cut nets) of the region, best
+ *    gain first
+ * 2. Runs local FM searches on all threads until the seeds are exhausted
+ *    (one after the other in deterministic mode)
+ * 3. Replays the applied moves in global order with exact gains and keeps
+ *    the best legal prefix
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to optimize
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+void LocalFMPartMgr<Gnl, GainMgr, ConstrMgr>::optimize(std::span<std::uint8_t> part) {
+    using node_t = typename Gnl::node_t;
+    using Move = LocalMove<node_t>;
+
+    const auto& hgr = this->hyprgraph;
+    const auto num_modules = static_cast<std::uint32_t>(hgr.number_of_modules());
+    const auto num_parts = static_cast<std::uint8_t>(this->num_parts);
+
+    const auto num_tasks = num_parallel_tasks(this->num_threads, num_modules, LFM_MIN_BLOCK_SIZE);
+
+    this->validator.init(part);
+    const auto lowerbound = this->validator.get_lowerbound();
+
+    // modules no search may claim: the fixed ones, and the ones outside the region
+    auto locked = std::vector<std::uint8_t>(num_modules, this->region.empty() ? 0U : 1U);
+    for (const auto& v : this->region) {
+        locked[v] = 0U;
+    }
+    for (const auto& v : hgr.module_fixed) {
+        locked[v] = 1U;
+    }
+
+    auto conn = ConnectivityInfo<Gnl>(hgr, num_parts);
+    conn.init(part, num_tasks);
+    auto cost = conn.cost();
+    auto gen = std::mt19937{1U};
+    const auto deterministic = TaskScheduler::current().is_deterministic();
+    auto claimed = std::vector<std::atomic<std::uint8_t>>(num_modules);
+    auto task_moves = std::vector<std::vector<Move>>(num_tasks);
+
+    for (auto pass = 0U; pass != this->max_rounds; ++pass) {
+        // 1. Boundary modules (of the region, if any)
+        auto is_boundary = [&](const node_t& v) {
+            for (const auto& net : hgr.gr[v]) {
+                if (conn.is_active(net) && conn.get_pin_count(net, part[v]) != hgr.gr.degree(net)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        auto task_boundary = std::vector<std::vector<node_t>>(num_tasks);
+        parallel_for(num_tasks, num_modules, [&](size_t task, auto first, auto last) {
+            for (auto v = first; v != last; ++v) {
+                claimed[v].store(locked[v], std::memory_order_relaxed);
+                if (this->region.empty() && locked[v] == 0U && is_boundary(v)) {
+                    task_boundary[task].emplace_back(v);
+                }
+            }
+        });
+        for (const auto& v : this->region) {
+            if (locked[v] == 0U && is_boundary(v)) {
+                task_boundary[0].emplace_back(v);
+            }
+        }
+        auto boundary = std::vector<node_t>{};
+        for (const auto& elem : task_boundary) {
+            boundary.insert(boundary.end(), elem.begin(), elem.end());
+        }
+        if (boundary.empty()) {
+            break;
+        }
+        std::shuffle(boundary.begin(), boundary.end(), gen);
+        // Seeds with the highest gain first (ties stay in random order)
+        auto seed_gains = std::vector<int>(num_parts, 0);
+        auto seed_gain = std::vector<int>(num_modules, 0);
+        for (const auto& v : boundary) {
+            conn.compute_gains(v, part[v], seed_gains);
+            seed_gains[part[v]] = std::numeric_limits<int>::min();
+            seed_gain[v] = *std::max_element(seed_gains.begin(), seed_gains.end());
+        }
+        std::stable_sort(boundary.begin(), boundary.end(),
+                         [&](const node_t& lhs, const node_t& rhs) {
+                             return seed_gain[lhs] > seed_gain[rhs];
+                         });
+
+        // 2. Local searches
+        auto next_seed = std::atomic<size_t>{0U};
+        auto next_stamp = std::atomic<std::uint64_t>{0U};
+        auto try_claim = [&](const node_t& v) {
+            auto expected = std::uint8_t{0U};
+            return claimed[v].compare_exchange_strong(expected, 1U);
+        };
+
+        auto search = [&](size_t task) {
+            using Entry = std::tuple<int, node_t, std::uint8_t>;
+            auto gain = std::vector<int>(num_parts, 0);
+            auto moves = std::vector<Move>{};
+            auto touched = std::vector<node_t>{};
+            auto kept = std::vector<node_t>{};
+            auto& applied = task_moves[task];
+            applied.clear();
+
+            auto best_move = [&](const node_t& v) {
+                conn.compute_gains(v, part[v], gain);
+                auto to_part = static_cast<std::uint8_t>(part[v] == 0U ? 1U : 0U);
+                for (auto k = 0U; k != num_parts; ++k) {
+                    if (k != part[v] && gain[k] > gain[to_part]) {
+                        to_part = static_cast<std::uint8_t>(k);
+                    }
+                }
+                return Entry{gain[to_part], v, to_part};
+            };
+
+            while (true) {
+                touched.clear();
+                auto queue = std::priority_queue<Entry>{};
+                for (auto count = 0U; count != this->num_seeds;) {
+                    const auto idx = next_seed.fetch_add(1U, std::memory_order_relaxed);
+                    if (idx >= boundary.size()) {
+                        break;
+                    }
+                    if (try_claim(boundary[idx])) {
+                        touched.emplace_back(boundary[idx]);
+                        queue.push(best_move(boundary[idx]));
+                        ++count;
+                    }
+                }
+                if (queue.empty()) {
+                    break;
+                }
+
+                moves.clear();
+                auto total_gain = 0;
+                auto best_gain = 0;
+                auto best_len = size_t{0U};
+                auto fruitless = size_t{0U};
+                while (!queue.empty() && fruitless < this->max_fruitless_moves) {
+                    const auto v = std::get<1>(queue.top());
+                    const auto gain_v = std::get<0>(queue.top());
+                    queue.pop();
+                    const auto entry = best_move(v);  // the queued gain may be outdated
+                    if (std::get<0>(entry) < gain_v) {
+                        queue.push(entry);
+                        continue;
+                    }
+                    const auto from_part = part[v];
+                    const auto to_part = std::get<2>(entry);
+                    if (!conn.try_move(v, from_part, to_part, lowerbound)) {
+                        continue;
+                    }
+                    part[v] = to_part;
+                    const auto stamp = next_stamp.fetch_add(1U, std::memory_order_relaxed);
+                    moves.push_back({v, from_part, to_part, stamp});
+                    total_gain += std::get<0>(entry);
+                    if (total_gain > best_gain) {
+                        best_gain = total_gain;
+                        best_len = moves.size();
+                        fruitless = 0U;
+                    } else {
+                        ++fruitless;
+                    }
+                    for (const auto& net : hgr.gr[v]) {
+                        if (!conn.is_active(net) || hgr.gr.degree(net) > LFM_MAX_GROW_DEGREE) {
+                            continue;
+                        }
+                        for (const auto& u : hgr.gr[net]) {
+                            if (touched.size() < LFM_MAX_TOUCHED && try_claim(u)) {
+                                touched.emplace_back(u);
+                                queue.push(best_move(u));
+                            }
+                        }
+                    }
+                }
+
+                // Keep the best prefix of this search
+                while (moves.size() > best_len) {
+                    const auto& move = moves.back();
+                    conn.move(move.v, move.to_part, move.from_part);
+                    part[move.v] = move.from_part;
+                    moves.pop_back();
+                }
+                applied.insert(applied.end(), moves.begin(), moves.end());
+
+                // Release the modules that were not moved, for later searches
+                kept.clear();
+                for (const auto& move : moves) {
+                    kept.emplace_back(move.v);
+                }
+                std::sort(kept.begin(), kept.end());
+                for (const auto& u : touched) {
+                    if (!std::binary_search(kept.begin(), kept.end(), u)) {
+                        claimed[u].store(0U, std::memory_order_relaxed);
+                    }
+                }
+            }
+        };
+        if (deterministic) {
+            search(0U);  // one search stream, in seed order
+        } else {
+            parallel_for(num_tasks, static_cast<std::uint32_t>(num_tasks),
+                         [&](size_t task, auto, auto) { search(task); });
+        }
+
+        // 3. Global recalculation of the applied moves
+        auto all_moves = std::vector<Move>{};
+        for (const auto& elem : task_moves) {
+            all_moves.insert(all_moves.end(), elem.begin(), elem.end());
+        }
+        if (all_moves.empty()) {
+            break;
+        }
+        std::sort(all_moves.begin(), all_moves.end(),
+                  [](const Move& lhs, const Move& rhs) { return lhs.stamp < rhs.stamp; });
+        for (const auto& move : all_moves) {  // every module moved at most once
+            conn.move(move.v, move.to_part, move.from_part);
+            part[move.v] = move.from_part;
+        }
+        auto is_legal = [&]() {
+            for (auto k = 0U; k != num_parts; ++k) {
+                if (conn.get_part_weight(k) < lowerbound) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        auto total_gain = 0;
+        auto best_gain = 0;
+        auto best_len = size_t{0U};
+        for (auto idx = size_t{0U}; idx != all_moves.size(); ++idx) {
+            const auto& move = all_moves[idx];
+            total_gain += conn.move_gain(move.v, move.from_part, move.to_part);
+            conn.move(move.v, move.from_part, move.to_part);
+            part[move.v] = move.to_part;
+            if (total_gain > best_gain && is_legal()) {
+                best_gain = total_gain;
+                best_len = idx + 1U;
+            }
+        }
+        for (auto idx = all_moves.size(); idx != best_len; --idx) {
+            const auto& move = all_moves[idx - 1U];
+            conn.move(move.v, move.to_part, move.from_part);
+            part[move.v] = move.from_part;
+        }
+        if (best_gain <= 0) {
+            break;
+        }
+        cost -= best_gain;
+    }
+    this->total_cost = cost;
+}
+
+#include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
+#include <netlistx/netlist.hpp>        // for SimpleNetlist, Netlist
+#include <xnetwork/classes/graph.hpp>
+
+template class LocalFMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                              FMKWayConstrMgr<SimpleNetlist>>;
+
+#include <ckpttn/FMBiConstrMgr.hpp>  // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>    // for FMBiGainMgr
+
+template class LocalFMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                              FMBiConstrMgr<SimpleNetlist>>;
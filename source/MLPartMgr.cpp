@@ -1,28 +1,123 @@
-#include <ckpttn/FMConstrMgr.hpp>  // for LegalCheck, LegalCheck::AllSatisfied
-#include <ckpttn/MLPartMgr.hpp>    // for MLPartMgr
-#include <cstdint>                 // for uint8_t
-#include <iostream>                // for std::cerr
-#include <memory>                  // for unique_ptr
-#include <netlistx/netlist.hpp>    // for SimpleNetlist
-#include <new>                     // for std::bad_alloc
-#include <py2cpp/set.hpp>          // for set
-#include <span>                    // for span
-#include <utility>                 // for pair
-#include <vector>                  // for vector
+#include <algorithm>                 // for copy
+#include <chrono>                    // for steady_clock, duration
+#include <ckpttn/FMConstrMgr.hpp>    // for LegalCheck, LegalCheck::AllSatisfied
+#include <ckpttn/InitPartMgr.hpp>    // for InitPartMgr
+#include <ckpttn/MLPartMgr.hpp>      // for MLPartMgr
+#include <ckpttn/TaskScheduler.hpp>  // for TaskScheduler
+#include <cstdint>                   // for uint8_t, uint32_t
+#include <iostream>                  // for std::cerr
+#include <memory>                    // for unique_ptr
+#include <netlistx/netlist.hpp>      // for SimpleNetlist
+#include <new>                       // for std::bad_alloc
+#include <span>                      // for span
+#include <utility>                   // for pair
+#include <vector>                    // for vector
 
 #include "ckpttn/HierNetlist.hpp"  // for HierNetlist, SimpleHierNetlist
 
-using node_t = SimpleNetlist::node_t;
-extern auto create_contracted_subgraph(const SimpleNetlist&, py::set<node_t>)
-    -> std::unique_ptr<SimpleHierNetlist>;
+/**
+ * @brief The partition manager of the coarse levels
+ *
+ * Every contracted level is a `SimpleGraph` netlist, also when the finest
+ * level is not (e.g. a `CsrNetlist`), so the coarse levels are refined by
+ * the same partition manager rebound to `SimpleNetlist`.
+ *
+ * @tparam PartMgr The partition manager of the finest level
+ */
+template <typename PartMgr> struct CoarsePartMgr;
+
+template <template <typename, typename, typename> class PartMgr,
+          template <typename> class GainMgr, template <typename> class ConstrMgr, typename Gnl>
+struct CoarsePartMgr<PartMgr<Gnl, GainMgr<Gnl>, ConstrMgr<Gnl>>> {
+    using type = PartMgr<SimpleNetlist, GainMgr<SimpleNetlist>, ConstrMgr<SimpleNetlist>>;
+};
+
+/**
+ * @brief Runs the multi-level partitioning followed by iterated V-cycles.
+ *
+ * After the initial multilevel pass, up to `num_vcycles` V-cycles are run
+ * while the time budget allows. A V-cycle that fails to reduce the cost is
+ * rolled back and ends the iteration. All parallel steps run on the
+ * scheduler given by `set_scheduler`, if any.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam PartMgr The partition manager type (e.g., FMPartMgr, NNPartMgr)
+ * @param[in] hyprgraph The input hypergraph to partition
+ * @param[in,out] part The partition vector to store the result
+ * @return LegalCheck The legality check result
+ */
+template <typename Gnl, typename PartMgr>
+auto MLPartMgr::run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck {
+    const auto start = std::chrono::steady_clock::now();
+    const auto scope = TaskScheduler::Scope(this->scheduler);
+    this->coarsening.clear_levels();
+    const auto legalcheck = this->_run_Partition<Gnl, PartMgr>(hyprgraph, part);
+    if (legalcheck != LegalCheck::AllSatisfied || this->num_vcycles == 0U) {
+        return legalcheck;
+    }
+
+    auto out_of_time = [&]() {
+        if (this->time_limit <= 0.0) {
+            return false;
+        }
+        const auto elapsed
+            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return elapsed >= this->time_limit;
+    };
+
+    auto best_part = std::vector<std::uint8_t>(part.begin(), part.end());
+    auto best_cost = this->total_cost;
+    auto keep = std::vector<std::uint32_t>(part.size(), 0U);
+    for (auto cycle = 0U; cycle != this->num_vcycles && !out_of_time(); ++cycle) {
+        this->coarsening.clear_levels();
+        std::copy(part.begin(), part.end(), keep.begin());
+        this->_run_VCycle<Gnl, PartMgr>(hyprgraph, part, keep);
+        if (this->total_cost >= best_cost) {
+            std::copy(best_part.begin(), best_part.end(), part.begin());
+            this->total_cost = best_cost;
+            break;
+        }
+        best_cost = this->total_cost;
+        std::copy(part.begin(), part.end(), best_part.begin());
+    }
+    return legalcheck;
+}
+
+/**
+ * @brief Recombines two legal partitions by one V-cycle.
+ *
+ * The contraction is constrained by the overlay of both parents, i.e. by the
+ * label `part[v] * num_parts + other[v]`, whose cut is the union of the two
+ * cuts. Every coarse module thus lies in one block of each parent. The
+ * labels are 32-bit, so the overlay is exact for any number of partitions.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam PartMgr The partition manager type (e.g., FMPartMgr, NNPartMgr)
+ * @param[in] hyprgraph The input hypergraph to partition
+ * @param[in,out] part The first (better) parent, replaced by the child
+ * @param[in] other The second parent
+ */
+template <typename Gnl, typename PartMgr>
+auto MLPartMgr::run_Recombine(const Gnl& hyprgraph, std::span<std::uint8_t> part,
+                              std::span<const std::uint8_t> other) -> void {
+    const auto scope = TaskScheduler::Scope(this->scheduler);
+    this->coarsening.clear_levels();
+    auto keep = std::vector<std::uint32_t>(part.size(), 0U);
+    for (const auto& v : hyprgraph) {
+        keep[v] = std::uint32_t{part[v]} * this->num_parts + other[v];
+    }
+    this->_run_VCycle<Gnl, PartMgr>(hyprgraph, part, keep);
+}
 
 /**
  * @brief Runs the multi-level Fiduccia-Mattheyses partitioning algorithm.
  *
  * Orchestrates the multi-level partitioning process:
  * 1. Legalizes the initial partition
- * 2. Recursively contracts the hypergraph if it exceeds the size limit
- * 3. Runs FM optimization on the (possibly coarsened) hypergraph
+ * 2. Recursively contracts the hypergraph while the coarsening controller
+ *    accepts a new level (or reuses a level of its hierarchy)
+ * 3. At the coarsest level, runs the initial partitioning portfolio
+ * 4. Runs FM optimization on the (possibly coarsened) hypergraph
  *
  * @tparam Gnl The hypergraph type
  * @tparam PartMgr The partition manager type (e.g., FMPartMgr, NNPartMgr)
@@ -31,12 +126,13 @@ extern auto create_contracted_subgraph(const SimpleNetlist&, py::set<node_t>)
  * @return LegalCheck The legality check result
  */
 template <typename Gnl, typename PartMgr>
-auto MLPartMgr::run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck {
+auto MLPartMgr::_run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck {
     using GainMgr = PartMgr::GainMgr_;
     using ConstrMgr = PartMgr::ConstrMgr_;
+    using CoarseMgr = CoarsePartMgr<PartMgr>::type;
 
     auto legalcheck_fn = [&]() {
-        GainMgr gain_mgr(hyprgraph, this->num_parts);
+        GainMgr gain_mgr(hyprgraph, this->num_parts, this->gain_scratch);
         ConstrMgr constr_mgr(hyprgraph, this->bal_tol, this->num_parts);
         PartMgr part_mgr(hyprgraph, gain_mgr, constr_mgr, this->num_parts);
         auto legalcheck = part_mgr.legalize(part);
@@ -45,7 +141,7 @@ auto MLPartMgr::run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part
     };
 
     auto optimize_fn = [&]() {
-        GainMgr gain_mgr(hyprgraph, this->num_parts);
+        GainMgr gain_mgr(hyprgraph, this->num_parts, this->gain_scratch);
         ConstrMgr constr_mgr(hyprgraph, this->bal_tol, this->num_parts);
         PartMgr part_mgr(hyprgraph, gain_mgr, constr_mgr, this->num_parts);
         part_mgr.optimize(part);
@@ -59,14 +155,22 @@ auto MLPartMgr::run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part
         return legalcheck_cost.first;
     }
 
-    if (hyprgraph.number_of_modules() >= this->limitsize) {  // OK
+    auto coarsened = false;
+    if (this->coarsening.should_coarsen(hyprgraph)) {
         try {
-            const auto hgr2
-                = create_contracted_subgraph(hyprgraph, py::set<typename Gnl::node_t>{});
-            if (hgr2->number_of_modules() * 3 / 2 < hyprgraph.number_of_modules()) {
+            // a level of a prebuilt hierarchy, or else a new contraction
+            auto contracted = decltype(this->coarsening.coarsen(hyprgraph)){};
+            const auto* hgr2 = this->coarsening.reuse(hyprgraph);
+            if (hgr2 == nullptr) {
+                contracted = this->coarsening.coarsen(hyprgraph);
+                hgr2 = contracted.get();
+            }
+            if (hgr2 != nullptr) {
+                coarsened = true;
                 auto part2 = std::vector<std::uint8_t>(hgr2->number_of_modules(), 0);
                 hgr2->projection_up(part, part2);
-                auto legalcheck_recur = this->run_Partition<Gnl, PartMgr>(*hgr2, part2);
+                auto legalcheck_recur
+                    = this->_run_Partition<SimpleNetlist, CoarseMgr>(*hgr2, part2);
                 if (legalcheck_recur == LegalCheck::AllSatisfied) {
                     hgr2->projection_down(part2, part);
                 }
@@ -76,16 +180,72 @@ auto MLPartMgr::run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part
         }
     }
 
+    if (!coarsened && this->init_portfolio) {  // coarsest level
+        InitPartMgr init_mgr(this->bal_tol, this->num_parts);
+        const auto legalcheck = init_mgr.run_Partition<Gnl, PartMgr>(hyprgraph, part);
+        this->total_cost = init_mgr.total_cost;
+        return legalcheck;
+    }
+
     this->total_cost = optimize_fn();
     return legalcheck_cost.first;
 }
 
-#include <ckpttn/FMBiConstrMgr.hpp>    // for FMBiConstrMgr
-#include <ckpttn/FMBiGainMgr.hpp>      // for FMBiGainMgr
-#include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
-#include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
-#include <ckpttn/FMPartMgr.hpp>        // for FMPartMgr
-#include <ckpttn/NNPartMgr.hpp>        // for NNPartMgr
+/**
+ * @brief Runs one V-cycle of the multi-level partitioning.
+ *
+ * Re-coarsens the hypergraph with a contraction that never merges modules
+ * across the cut of `keep`, which is the current partition or a refinement
+ * of it, so that the partition is projected up exactly and stays legal.
+ * The coarse levels are then refined on the way back down.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam PartMgr The partition manager type (e.g., FMPartMgr, NNPartMgr)
+ * @param[in] hyprgraph The input hypergraph to partition
+ * @param[in,out] part The (legal) partition vector, refined in place
+ * @param[in] keep The labels to be preserved by the contraction
+ */
+template <typename Gnl, typename PartMgr>
+auto MLPartMgr::_run_VCycle(const Gnl& hyprgraph, std::span<std::uint8_t> part,
+                            std::span<const std::uint32_t> keep) -> void {
+    using GainMgr = PartMgr::GainMgr_;
+    using ConstrMgr = PartMgr::ConstrMgr_;
+    using CoarseMgr = CoarsePartMgr<PartMgr>::type;
+
+    if (this->coarsening.should_coarsen(hyprgraph)) {
+        try {
+            const auto hgr2 = this->coarsening.coarsen(hyprgraph, keep);
+            if (hgr2 != nullptr) {
+                auto part2 = std::vector<std::uint8_t>(hgr2->number_of_modules(), 0);
+                auto keep2 = std::vector<std::uint32_t>(hgr2->number_of_modules(), 0);
+                hgr2->projection_up(part, part2);
+                hgr2->projection_up(keep, keep2);
+                this->_run_VCycle<SimpleNetlist, CoarseMgr>(*hgr2, part2, keep2);
+                hgr2->projection_down(part2, part);
+            }
+        } catch (const std::bad_alloc& e) {
+            std::cerr << "Out of Memory: " << e.what() << '\n';
+        }
+    }
+
+    GainMgr gain_mgr(hyprgraph, this->num_parts, this->gain_scratch);
+    ConstrMgr constr_mgr(hyprgraph, this->bal_tol, this->num_parts);
+    PartMgr part_mgr(hyprgraph, gain_mgr, constr_mgr, this->num_parts);
+    part_mgr.optimize(part);
+    this->total_cost = part_mgr.total_cost;
+}
+
+#include <ckpttn/CsrNetlist.hpp>           // for CsrNetlist
+#include <ckpttn/FMBiConstrMgr.hpp>        // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>          // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>      // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>        // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>            // for FMPartMgr
+#include <ckpttn/FlowPartMgr.hpp>          // for FlowPartMgr
+#include <ckpttn/LPPartMgr.hpp>            // for LPPartMgr
+#include <ckpttn/LocalFMPartMgr.hpp>       // for LocalFMPartMgr
+#include <ckpttn/MidLvlWindowPartMgr.hpp>  // for MidLvlWindowPartMgr
+#include <ckpttn/NNPartMgr.hpp>            // for NNPartMgr
 
 template auto MLPartMgr::run_Partition<
     SimpleNetlist,
@@ -106,3 +266,132 @@ template auto MLPartMgr::run_Partition<
     SimpleNetlist,
     NNPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
     const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    SimpleNetlist,
+    LPPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    SimpleNetlist,
+    LPPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    SimpleNetlist,
+    LocalFMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    SimpleNetlist, LocalFMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                  FMKWayConstrMgr<SimpleNetlist>>>(const SimpleNetlist& hyprgraph,
+                                                                   std::span<std::uint8_t> part)
+    -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    SimpleNetlist,
+    FlowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    SimpleNetlist,
+    FlowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    SimpleNetlist,
+    MidLvlWindowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    SimpleNetlist, MidLvlWindowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                       FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    CsrNetlist, FMPartMgr<CsrNetlist, FMBiGainMgr<CsrNetlist>, FMBiConstrMgr<CsrNetlist>>>(
+    const CsrNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    CsrNetlist, FMPartMgr<CsrNetlist, FMKWayGainMgr<CsrNetlist>, FMKWayConstrMgr<CsrNetlist>>>(
+    const CsrNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    CsrNetlist, NNPartMgr<CsrNetlist, FMBiGainMgr<CsrNetlist>, FMBiConstrMgr<CsrNetlist>>>(
+    const CsrNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Partition<
+    CsrNetlist, NNPartMgr<CsrNetlist, FMKWayGainMgr<CsrNetlist>, FMKWayConstrMgr<CsrNetlist>>>(
+    const CsrNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    NNPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    NNPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    LPPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    LPPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    LocalFMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist, LocalFMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                  FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    FlowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    FlowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist,
+    MidLvlWindowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
+
+template auto MLPartMgr::run_Recombine<
+    SimpleNetlist, MidLvlWindowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                       FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part,
+    std::span<const std::uint8_t> other) -> void;
@@ -0,0 +1,61 @@
+#include <ckpttn/MappedFile.hpp>  // for MappedFile
+#include <fstream>                // for ifstream
+#include <iterator>               // for istreambuf_iterator
+#include <stdexcept>              // for runtime_error
+#include <string>                 // for string
+#include <string_view>            // for string_view
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>     // for open, O_RDONLY
+#    include <sys/mman.h>  // for mmap, munmap, madvise
+#    include <sys/stat.h>  // for fstat
+#    include <unistd.h>    // for close
+#endif
+
+MappedFile::MappedFile(const std::string& filename) {
+#if defined(__unix__) || defined(__APPLE__)
+    const auto fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Can't open " + filename);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Can't stat " + filename);
+    }
+    this->size = static_cast<size_t>(info.st_size);
+    if (this->size != 0U) {
+        auto* addr = ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Can't map " + filename);
+        }
+        ::madvise(addr, this->size, MADV_SEQUENTIAL);
+        this->mapped = addr;
+    }
+    ::close(fd);
+#else
+    auto file = std::ifstream{filename, std::ios::binary};
+    if (file.fail()) {
+        throw std::runtime_error("Can't open " + filename);
+    }
+    this->buffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    this->size = this->buffer.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (this->mapped != nullptr) {
+        ::munmap(this->mapped, this->size);
+    }
+#endif
+}
+
+auto MappedFile::view() const -> std::string_view {
+#if defined(__unix__) || defined(__APPLE__)
+    return {static_cast<const char*>(this->mapped), this->size};
+#else
+    return {this->buffer.data(), this->size};
+#endif
+}
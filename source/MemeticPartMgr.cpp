@@ -0,0 +1,284 @@
+#include <algorithm>                  // for any_of, copy
+#include <chrono>                     // for steady_clock, duration
+#include <ckpttn/FMConstrMgr.hpp>     // for LegalCheck, LegalCheck::AllSatisfied
+#include <ckpttn/MLPartMgr.hpp>       // for MLPartMgr
+#include <ckpttn/MemeticPartMgr.hpp>  // for MemeticPartMgr
+#include <ckpttn/TaskScheduler.hpp>   // for TaskGroup
+#include <cstdint>                    // for uint8_t, uint32_t
+#include <netlistx/netlist.hpp>       // for SimpleNetlist
+#include <random>                     // for mt19937, uniform_int_distribution
+#include <span>                       // for span
+#include <utility>                    // for move, swap
+#include <vector>                     // for vector
+
+/// @brief Member of the population
+struct Individual {
+    LegalCheck legalcheck;
+    int cost;
+    std::vector<std::uint8_t> part;
+};
+
+/// @brief How a child is created from the population
+struct Offspring {
+    /// @brief The first (better) parent
+    size_t parent;
+    /// @brief The second parent of a recombination, or the first one for a mutation
+    size_t other;
+    /// @brief Seed of the mutation
+    std::uint32_t seed;
+};
+
+/**
+ * @brief Returns whether `lhs` is better than `rhs`: legal first, then the lower cost.
+ *
+ * @param[in] lhs The first member
+ * @param[in] rhs The second member
+ * @return true if `lhs` is strictly better
+ */
+static auto is_better(const Individual& lhs, const Individual& rhs) -> bool {
+    const auto legal_lhs = lhs.legalcheck == LegalCheck::AllSatisfied;
+    const auto legal_rhs = rhs.legalcheck == LegalCheck::AllSatisfied;
+    if (legal_lhs != legal_rhs) {
+        return legal_lhs;
+    }
+    return lhs.cost < rhs.cost;
+}
+
+/**
+ * @brief Moves a fraction of the free modules to random parts.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in,out] part The partition vector
+ * @param[in] num_parts The number of partitions
+ * @param[in] rate The fraction of the free modules to move
+ * @param[in,out] gen The random number generator
+ */
+template <typename Gnl, typename Gen>
+static void perturb_part(const Gnl& hyprgraph, std::span<std::uint8_t> part,
+                         std::uint8_t num_parts, double rate, Gen& gen) {
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<int> dist(0, num_parts - 1);
+    for (const auto& v : hyprgraph) {
+        if (!hyprgraph.module_fixed.contains(v) && coin(gen) < rate) {
+            part[v] = static_cast<std::uint8_t>(dist(gen));
+        }
+    }
+}
+
+/**
+ * @brief Evolves a population of multilevel partitions.
+ *
+ * All random choices (initial partitions, tournaments, operators and
+ * mutations) are drawn serially from one generator before the children of a
+ * generation run in parallel, and the children are inserted in their index
+ * order. Hence, apart from the time budget, the outcome does not depend on
+ * the thread scheduling.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam PartMgr The partition manager type (e.g., FMPartMgr, NNPartMgr)
+ * @param[in] hyprgraph The input hypergraph to partition
+ * @param[in,out] part The partition vector to store the result
+ * @return LegalCheck The legality check result
+ */
+template <typename Gnl, typename PartMgr>
+auto MemeticPartMgr::run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part)
+    -> LegalCheck {
+    const auto start = std::chrono::steady_clock::now();
+    auto gen = std::mt19937{this->seed};
+
+    auto multilevel = [&](std::vector<std::uint8_t> local_part) -> Individual {
+        MLPartMgr ml_mgr{this->bal_tol, this->num_parts};
+        ml_mgr.set_num_vcycles(this->num_vcycles);
+        const auto legalcheck = ml_mgr.run_Partition<Gnl, PartMgr>(hyprgraph, local_part);
+        return {legalcheck, ml_mgr.total_cost, std::move(local_part)};
+    };
+
+    // initial population: the given partition and random ones
+    const auto size = this->population_size;
+    auto population = std::vector<Individual>(size);
+    {
+        auto seeds = std::vector<std::uint32_t>(size);
+        for (auto& member_seed : seeds) {
+            member_seed = static_cast<std::uint32_t>(gen());
+        }
+        auto group = TaskGroup{};
+        for (auto idx = size_t{0U}; idx != size; ++idx) {
+            group.run([&, idx]() {
+                auto local_part = std::vector<std::uint8_t>(part.begin(), part.end());
+                if (idx != 0U) {
+                    auto local_gen = std::mt19937{seeds[idx]};
+                    perturb_part(hyprgraph, std::span<std::uint8_t>(local_part), this->num_parts,
+                                 1.0, local_gen);
+                }
+                population[idx] = multilevel(std::move(local_part));
+            });
+        }
+        group.wait();
+    }
+
+    auto out_of_time = [&]() {
+        if (this->time_limit <= 0.0) {
+            return this->num_generations == 0U;
+        }
+        const auto elapsed
+            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return elapsed >= this->time_limit;
+    };
+
+    auto pick = std::uniform_int_distribution<size_t>(0U, size - 1U);
+    auto tournament = [&]() {
+        const auto lhs = pick(gen);
+        const auto rhs = pick(gen);
+        return is_better(population[rhs], population[lhs]) ? rhs : lhs;
+    };
+
+    this->num_generations_run = 0U;
+    for (auto generation = size_t{0U};
+         generation != this->num_generations || this->num_generations == 0U; ++generation) {
+        if (out_of_time()) {
+            break;
+        }
+
+        auto offspring = std::vector<Offspring>(size);
+        for (auto& child : offspring) {
+            child.parent = tournament();
+            child.other = child.parent;
+            if (size >= 2U && gen() % 2U == 0U) {
+                child.other = tournament();
+                if (child.other == child.parent) {
+                    child.other = (child.parent + 1U) % size;
+                }
+                if (is_better(population[child.other], population[child.parent])) {
+                    std::swap(child.parent, child.other);
+                }
+            }
+            child.seed = static_cast<std::uint32_t>(gen());
+        }
+
+        auto children = std::vector<Individual>(size);
+        auto group = TaskGroup{};
+        for (auto idx = size_t{0U}; idx != size; ++idx) {
+            group.run([&, idx]() {
+                const auto& child = offspring[idx];
+                const auto& parent = population[child.parent];
+                const auto& other = population[child.other];
+                auto local_part = parent.part;
+                if (child.other != child.parent && parent.legalcheck == LegalCheck::AllSatisfied
+                    && other.legalcheck == LegalCheck::AllSatisfied) {
+                    MLPartMgr ml_mgr{this->bal_tol, this->num_parts};
+                    ml_mgr.run_Recombine<Gnl, PartMgr>(hyprgraph, local_part, other.part);
+                    children[idx] = {LegalCheck::AllSatisfied, ml_mgr.total_cost,
+                                     std::move(local_part)};
+                    return;
+                }
+                auto local_gen = std::mt19937{child.seed};
+                perturb_part(hyprgraph, std::span<std::uint8_t>(local_part), this->num_parts,
+                             this->mutation_rate, local_gen);
+                children[idx] = multilevel(std::move(local_part));
+            });
+        }
+        group.wait();
+
+        for (auto& child : children) {
+            const auto duplicate
+                = std::any_of(population.begin(), population.end(), [&](const auto& member) {
+                      return member.cost == child.cost && member.part == child.part;
+                  });
+            if (duplicate) {
+                continue;
+            }
+            auto worst = size_t{0U};
+            for (auto idx = size_t{1U}; idx != size; ++idx) {
+                if (!is_better(population[idx], population[worst])) {
+                    worst = idx;
+                }
+            }
+            if (is_better(child, population[worst])) {
+                population[worst] = std::move(child);
+            }
+        }
+        ++this->num_generations_run;
+    }
+
+    auto best = size_t{0U};
+    for (auto idx = size_t{1U}; idx != size; ++idx) {
+        if (is_better(population[idx], population[best])) {
+            best = idx;
+        }
+    }
+    std::copy(population[best].part.begin(), population[best].part.end(), part.begin());
+    this->total_cost = population[best].cost;
+    return population[best].legalcheck;
+}
+
+#include <ckpttn/FMBiConstrMgr.hpp>        // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>          // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>      // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>        // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>            // for FMPartMgr
+#include <ckpttn/FlowPartMgr.hpp>          // for FlowPartMgr
+#include <ckpttn/LPPartMgr.hpp>            // for LPPartMgr
+#include <ckpttn/LocalFMPartMgr.hpp>       // for LocalFMPartMgr
+#include <ckpttn/MidLvlWindowPartMgr.hpp>  // for MidLvlWindowPartMgr
+#include <ckpttn/NNPartMgr.hpp>            // for NNPartMgr
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    NNPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    NNPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    LPPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    LPPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    LocalFMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist, LocalFMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                  FMKWayConstrMgr<SimpleNetlist>>>(const SimpleNetlist& hyprgraph,
+                                                                   std::span<std::uint8_t> part)
+    -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    FlowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    FlowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist,
+    MidLvlWindowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto MemeticPartMgr::run_Partition<
+    SimpleNetlist, MidLvlWindowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                       FMKWayConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
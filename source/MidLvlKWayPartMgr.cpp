@@ -1,13 +1,198 @@
+#include <algorithm>
+#include <array>
+#include <ckpttn/BlockPairs.hpp>
 #include <ckpttn/FMKWayConstrMgr.hpp>
+#include <ckpttn/FMPmrConfig.hpp>
 #include <ckpttn/MidLvlKWayPartMgr.hpp>
 #include <ckpttn/midlevel/hamcycle.hpp>
 #include <ckpttn/midlevel/vertex.hpp>
-#include <ckpttn/moveinfo.hpp>
+#include <ckpttn/parallel_for.hpp>
 #include <cstdint>
 #include <netlistx/netlist.hpp>
 #include <span>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+using node_t = SimpleNetlist::node_t;
+
+/**
+ * @brief A partition pair, extracted into a small hypergraph of its own
+ *
+ * Only the nets that take part in the (K-1) cost are kept. For each of
+ * them, `count[2 * idx]` and `count[2 * idx + 1]` are its pins in the first
+ * and the second block (the fixed modules and the modules of other blocks
+ * are terminals).
+ */
+struct PairProblem {
+    BlockPair blocks{};
+    /// @brief The free modules of the two blocks
+    std::vector<node_t> modules;
+    /// @brief The local nets of each module
+    std::vector<std::vector<std::uint32_t>> module_nets;
+    std::vector<int> net_weight;
+    std::vector<int> count;
+    /// @brief The best assignment found (1 = the second block)
+    std::vector<std::uint8_t> best_side;
+    /// @brief The reduction of the cost by `best_side`
+    int gain{};
+};
+
+/**
+ * @brief Returns whether a net takes part in the (K-1) cost.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in] net The net
+ * @return true if the net has 2 to `FM_MAX_DEGREE` pins
+ */
+static auto is_cost_net(const SimpleNetlist& hyprgraph, const node_t& net) -> bool {
+    const auto degree = hyprgraph.gr.degree(net);
+    return degree >= 2U && degree <= FM_MAX_DEGREE;
+}
+
+/**
+ * @brief Computes the (K-1) cost of a partition.
+ *
+ * Agrees with `FMKWayGainMgr::init`: nets with less than 2 or more than
+ * `FM_MAX_DEGREE` pins are ignored.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in] part The partition
+ * @return The cost
+ */
+static auto kway_cost(const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> part) -> int {
+    auto cost = 0;
+    auto seen = std::vector<std::uint8_t>{};
+    for (const auto& net : hyprgraph.nets) {
+        if (!is_cost_net(hyprgraph, net)) {
+            continue;
+        }
+        seen.clear();
+        for (const auto& v : hyprgraph.gr[net]) {
+            if (std::find(seen.begin(), seen.end(), part[v]) == seen.end()) {
+                seen.push_back(part[v]);
+            }
+        }
+        const auto weight = static_cast<int>(hyprgraph.get_net_weight(net));
+        cost += (static_cast<int>(seen.size()) - 1) * weight;
+    }
+    return cost;
+}
+
+/**
+ * @brief Extracts a partition pair into a `PairProblem`.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in] part The partition
+ * @param[in] blocks The partition pair
+ * @param[in] modules The free modules of the two blocks
+ * @return The extracted problem
+ */
+static auto extract_pair(const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> part,
+                         const BlockPair& blocks, std::vector<node_t> modules) -> PairProblem {
+    auto problem = PairProblem{blocks, std::move(modules), {}, {}, {}, {}, 0};
+    problem.module_nets.resize(problem.modules.size());
+    auto net_index = std::unordered_map<node_t, std::uint32_t>{};
+    for (auto pos = 0U; pos != problem.modules.size(); ++pos) {
+        for (const auto& net : hyprgraph.gr[problem.modules[pos]]) {
+            if (!is_cost_net(hyprgraph, net)) {
+                continue;
+            }
+            const auto [it, inserted]
+                = net_index.emplace(net, static_cast<std::uint32_t>(problem.net_weight.size()));
+            if (inserted) {
+                problem.net_weight.push_back(static_cast<int>(hyprgraph.get_net_weight(net)));
+                problem.count.resize(problem.count.size() + 2U, 0);
+                for (const auto& w : hyprgraph.gr[net]) {
+                    if (part[w] == blocks.first) {
+                        ++problem.count[2U * it->second];
+                    } else if (part[w] == blocks.second) {
+                        ++problem.count[2U * it->second + 1U];
+                    }
+                }
+            }
+            problem.module_nets[pos].push_back(it->second);
+        }
+    }
+    return problem;
+}
+
+/**
+ * @brief Finds the best balanced split of a partition pair.
+ *
+ * The middle-levels Gray code visits every split of the modules with `n`
+ * or `n + 1` of them in the second block (`2n + 1` bits, one of them a
+ * padding bit if the number of modules is even). The walk starts from the
+ * current assignment, moved to the start vertex; each flip then updates
+ * the cost from the pin counts of the nets of the module only.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in] part The partition
+ * @param[in,out] problem The pair; `best_side` and `gain` are set
+ * @param[in] weight_first The weight of the first block
+ * @param[in] weight_second The weight of the second block
+ * @param[in] lowerbound The minimum weight of a block
+ */
+static void solve_pair(const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> part,
+                       PairProblem& problem, std::int64_t weight_first,
+                       std::int64_t weight_second, std::int64_t lowerbound) {
+    const auto num_modules = static_cast<int>(problem.modules.size());
+    auto side = std::vector<std::uint8_t>(problem.modules.size(), 0U);
+    for (auto pos = 0; pos != num_modules; ++pos) {
+        side[pos] = part[problem.modules[pos]] == problem.blocks.second ? 1U : 0U;
+    }
+    problem.best_side = side;
+    problem.gain = 0;
+
+    auto cost = 0;  // relative to the current assignment
+    auto weight = std::array<std::int64_t, 2>{weight_first, weight_second};
+    auto flip = [&](int pos) {
+        const auto from_side = side[pos];
+        const auto to_side = 1U - from_side;
+        for (const auto& idx : problem.module_nets[pos]) {
+            auto* net_count = &problem.count[2U * idx];
+            const auto before = static_cast<int>(net_count[0] != 0) + (net_count[1] != 0);
+            --net_count[from_side];
+            ++net_count[to_side];
+            const auto after = static_cast<int>(net_count[0] != 0) + (net_count[1] != 0);
+            cost += (after - before) * problem.net_weight[idx];
+        }
+        const auto module_weight
+            = static_cast<std::int64_t>(hyprgraph.get_module_weight(problem.modules[pos]));
+        weight[from_side] -= module_weight;
+        weight[to_side] += module_weight;
+        side[pos] = static_cast<std::uint8_t>(to_side);
+    };
+    auto record = [&]() {
+        if (cost < -problem.gain && weight[0] >= lowerbound && weight[1] >= lowerbound) {
+            problem.gain = -cost;
+            problem.best_side = side;
+        }
+    };
+
+    const auto half_bits = num_modules / 2;
+    auto init_bits = std::vector<int>(2 * half_bits + 1, 0);
+    for (auto pos = 0; pos != half_bits; ++pos) {
+        init_bits[pos] = 1;
+    }
+    for (auto pos = 0; pos != num_modules; ++pos) {
+        if (side[pos] != init_bits[pos]) {
+            flip(pos);
+        }
+    }
+    record();
+
+    auto visit_fn = [&](const std::vector<int>&, int flipped_pos) {
+        if (flipped_pos >= num_modules) {
+            return;
+        }
+        flip(flipped_pos);
+        record();
+    };
+    MidVertex start_vertex(init_bits);
+    MidHamCycle give_me_a_name{start_vertex, -1, visit_fn};
+}
+
 /**
  * @brief Constructs a new MidLvlKWayPartMgr object.
  *
@@ -20,143 +205,100 @@ MidLvlKWayPartMgr::MidLvlKWayPartMgr(double bal_tol, std::uint8_t num_parts)
 /**
  * @brief Optimizes the partition using exhaustive mid-level k-way search.
  *
- * Iterates over all partition pairs and uses the middle-levels Gray code
- * algorithm to find the optimal k-way partitioning for small instances.
+ * Each pass runs the rounds of the round-robin tournament of partition
+ * pairs. For each round:
+ * 1. Extracts the pairs with 2 to `max_pair_modules` free modules
+ * 2. Finds the best legal balanced split of each pair concurrently
+ * 3. Applies the splits and updates the block weights and members
+ *
+ * Passes repeat until one brings no improvement.
  *
  * @param[in,out] part The partition vector to optimize
  * @param[in] hyprgraph The hypergraph to partition
  */
 void MidLvlKWayPartMgr::optimize(std::span<std::uint8_t> part, const SimpleNetlist& hyprgraph) {
-    const auto total_modules = hyprgraph.number_of_modules();
-    auto current_part = std::vector<std::uint8_t>(part.begin(), part.end());
-
-    auto constr_mgr = FMKWayConstrMgr<SimpleNetlist>(hyprgraph, this->bal_tol_, this->num_parts_);
+    const auto num_parts = this->num_parts_;
 
-    auto improved = true;
-    auto pass = 0;
+    auto constr_mgr = FMKWayConstrMgr<SimpleNetlist>(hyprgraph, this->bal_tol_, num_parts);
+    constr_mgr.init(part);
+    const auto lowerbound = static_cast<std::int64_t>(constr_mgr.get_lowerbound());
 
-    while (improved && pass < max_passes) {
-        improved = false;
-        ++pass;
+    // the members of each block, and their weight
+    auto members = std::vector<std::vector<node_t>>(num_parts);
+    auto part_weight = std::vector<std::int64_t>(num_parts, 0);
+    for (const auto& v : hyprgraph) {
+        members[part[v]].push_back(v);
+        part_weight[part[v]] += hyprgraph.get_module_weight(v);
+    }
+    auto is_fixed = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0U);
+    for (const auto& v : hyprgraph.module_fixed) {
+        is_fixed[v] = 1U;
+    }
 
-        for (auto i = 0U; i < num_parts_ - 1U; ++i) {
-            for (auto j = i + 1U; j < num_parts_; ++j) {
-                auto selected = std::vector<std::uint32_t>{};
-                for (auto v = 0U; v < total_modules; ++v) {
-                    if (current_part[v] == i || current_part[v] == j) {
-                        selected.push_back(static_cast<std::uint32_t>(v));
+    this->total_cost = kway_cost(hyprgraph, part);
+    const auto rounds = round_robin_rounds(num_parts);
+    for (auto pass = 0; pass != max_passes; ++pass) {
+        auto pass_gain = 0;
+        for (const auto& round : rounds) {
+            // 1. Extraction
+            auto problems = std::vector<PairProblem>{};
+            for (const auto& blocks : round) {
+                auto modules = std::vector<node_t>{};
+                for (const auto block : {blocks.first, blocks.second}) {
+                    for (const auto& v : members[block]) {
+                        if (is_fixed[v] == 0U) {
+                            modules.push_back(v);
+                        }
                     }
                 }
-                if (selected.size() <= 1 || selected.size() > max_pair_modules) {
+                if (modules.size() <= 1U || modules.size() > max_pair_modules) {
                     continue;
                 }
+                problems.push_back(extract_pair(hyprgraph, part, blocks, std::move(modules)));
+            }
 
-                const auto num_modules = static_cast<int>(selected.size());
-                const auto half_bits = num_modules / 2;
-                const auto total_bits = 2 * half_bits + 1;
-
-                auto init_bits = std::vector<int>(total_bits, 0);
-                auto init_part = std::vector<std::uint8_t>(num_modules, 0);
-                for (auto pos = 0; pos < num_modules; ++pos) {
-                    auto v = selected[pos];
-                    init_part[pos] = (current_part[v] == j) ? 1U : 0U;
-                    if (pos < half_bits) {
-                        init_bits[pos] = 1;
-                    }
+            // 2. Concurrent exhaustive search
+            const auto num_items = static_cast<std::uint32_t>(problems.size());
+            const auto num_tasks = num_parallel_tasks(this->num_threads_, num_items, 1U);
+            parallel_for(num_tasks, num_items, [&](size_t, auto first, auto last) {
+                for (auto i = first; i != last; ++i) {
+                    auto& problem = problems[i];
+                    solve_pair(hyprgraph, part, problem, part_weight[problem.blocks.first],
+                               part_weight[problem.blocks.second], lowerbound);
                 }
+            });
 
-                constr_mgr.init(current_part);
-
-                auto best_part = init_part;
-                auto best_cost = 0;
-                for (const auto& net : hyprgraph.nets) {
-                    auto seen = std::uint8_t{0};
-                    for (const auto& v : hyprgraph.gr[net]) {
-                        seen |= static_cast<std::uint8_t>(1U << current_part[v]);
-                    }
-                    for (auto p = 0U; p < 8U; ++p) {
-                        if ((seen & (1U << p)) != 0U) {
-                            ++best_cost;
-                            break;
-                        }
-                    }
+            // 3. Application
+            for (const auto& problem : problems) {
+                if (problem.gain == 0) {
+                    continue;
                 }
-
-                auto local_part = init_part;
-                auto local_cost = best_cost;
-
-                const auto& hl = hyprgraph;
-                auto visit_fn = [&](const std::vector<int>& bits, int flipped_pos) {
-                    if (flipped_pos >= num_modules) {
-                        return;
-                    }
-                    const auto v = selected[flipped_pos];
-                    const auto to_part = static_cast<std::uint8_t>(bits[flipped_pos] == 0 ? i : j);
-                    const auto from_part
-                        = static_cast<std::uint8_t>(bits[flipped_pos] == 0 ? j : i);
-
-                    const auto move_info_v = MoveInfoV<SimpleNetlist::node_t>{
-                        .v = v, .from_part = from_part, .to_part = to_part};
-
-                    const auto legal = constr_mgr.check_legal(move_info_v);
-
-                    auto delta = 0;
-                    for (const auto& net : hl.gr[v]) {
-                        auto cnt_from = 0;
-                        auto cnt_to = 0;
-                        auto cnt_other = 0;
-                        for (const auto& w : hl.gr[net]) {
-                            if (w == v) {
-                                continue;
-                            }
-                            if (current_part[w] == from_part) {
-                                ++cnt_from;
-                            } else if (current_part[w] == to_part) {
-                                ++cnt_to;
-                            } else {
-                                ++cnt_other;
-                            }
-                        }
-                        const auto wt = static_cast<int>(hl.get_net_weight(net));
-                        const auto before = (cnt_to > 0 || cnt_other > 0);
-                        const auto after = (cnt_from > 0 || cnt_other > 0);
-                        if (!before && after) {
-                            delta += wt;
-                        } else if (before && !after) {
-                            delta -= wt;
-                        }
+                const auto [first, second] = problem.blocks;
+                for (auto pos = 0U; pos != problem.modules.size(); ++pos) {
+                    const auto v = problem.modules[pos];
+                    const auto to_part = problem.best_side[pos] == 1U ? second : first;
+                    if (part[v] != to_part) {
+                        const auto weight
+                            = static_cast<std::int64_t>(hyprgraph.get_module_weight(v));
+                        part_weight[part[v]] -= weight;
+                        part_weight[to_part] += weight;
+                        part[v] = to_part;
                     }
-
-                    local_cost += delta;
-                    current_part[v] = to_part;
-                    local_part[flipped_pos]
-                        = static_cast<std::uint8_t>(bits[flipped_pos] == 0 ? 0U : 1U);
-                    constr_mgr.update_move(move_info_v);
-
-                    if (legal == LegalCheck::AllSatisfied && local_cost < best_cost) {
-                        best_cost = local_cost;
-                        best_part = local_part;
-                    }
-                };
-
-                MidVertex start_vertex(init_bits);
-                MidHamCycle give_me_a_name{start_vertex, -1, visit_fn};
-
-                for (auto pos = 0; pos < num_modules; ++pos) {
-                    auto v = selected[pos];
-                    current_part[v] = (best_part[pos] == 1U) ? static_cast<std::uint8_t>(j)
-                                                             : static_cast<std::uint8_t>(i);
                 }
-
-                if (best_cost < this->total_cost || pass == 1) {
-                    this->total_cost = best_cost;
-                    improved = true;
+                auto pair_members = std::move(members[first]);
+                pair_members.insert(pair_members.end(), members[second].begin(),
+                                    members[second].end());
+                members[first].clear();
+                members[second].clear();
+                for (const auto& v : pair_members) {
+                    members[part[v]].push_back(v);
                 }
+                pass_gain += problem.gain;
             }
         }
-    }
-
-    for (auto v = 0U; v < total_modules; ++v) {
-        part[v] = current_part[v];
+        this->total_cost -= pass_gain;
+        if (pass_gain == 0) {
+            break;
+        }
     }
 }
@@ -1,3 +1,4 @@
+#include <ckpttn/CsrNetlist.hpp>
 #include <ckpttn/FMPmrConfig.hpp>
 #include <ckpttn/MidLvlPartMgr.hpp>
 #include <ckpttn/midlevel/hamcycle.hpp>
@@ -110,3 +111,4 @@ template <typename Gnl> void MidLvlPartMgr<Gnl>::optimize(std::span<std::uint8_t
 }
 
 template class MidLvlPartMgr<SimpleNetlist>;
+template class MidLvlPartMgr<CsrNetlist>;
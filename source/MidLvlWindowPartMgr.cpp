@@ -0,0 +1,380 @@
+#include <algorithm>                       // for copy, fill, min
+#include <ckpttn/FMConstrMgr.hpp>          // for LegalCheck
+#include <ckpttn/FMPartMgr.hpp>            // for FMPartMgr
+#include <ckpttn/FMPmrConfig.hpp>          // for FM_MAX_DEGREE
+#include <ckpttn/MidLvlWindowPartMgr.hpp>  // for MidLvlWindowPartMgr
+#include <ckpttn/midlevel/hamcycle.hpp>    // for MidHamCycle
+#include <ckpttn/midlevel/vertex.hpp>      // for MidVertex
+#include <ckpttn/parallel_for.hpp>         // for parallel_for, num_parallel_tasks
+#include <cstdint>                         // for uint8_t, uint32_t, int64_t
+#include <deque>                           // for deque
+#include <span>                            // for span
+#include <unordered_map>                   // for unordered_map
+#include <utility>                         // for move
+#include <vector>                          // for vector
+
+/// @brief A window grows only along nets with at most this many pins
+static constexpr size_t WIN_MAX_GROW_DEGREE = 16U;
+
+/**
+ * @brief A window of modules in two blocks
+ *
+ * @tparam node_t The node type
+ */
+template <typename node_t> struct Window {
+    /// @brief The block of the seed
+    std::uint8_t block_a;
+    /// @brief The neighboring block
+    std::uint8_t block_b;
+    std::vector<node_t> modules;
+};
+
+/**
+ * @brief Returns whether a net takes part in the (K-1) cost.
+ *
+ * @param[in] hgr The hypergraph
+ * @param[in] net The net
+ * @return true if the net has 2 to `FM_MAX_DEGREE` pins
+ */
+template <typename Gnl>
+static auto is_window_net(const Gnl& hgr, const typename Gnl::node_t& net) -> bool {
+    const auto degree = hgr.gr.degree(net);
+    return degree >= 2U && degree <= FM_MAX_DEGREE;
+}
+
+/**
+ * @brief Finds the best assignment of a window by the middle-levels Gray code.
+ *
+ * The window's modules are the first `m` bits of the Gray code, followed by
+ * `2 * slack` padding bits and one more if `m` is even, so that the
+ * bitstring has odd length `2n + 1`. The padding bits absorb the difference
+ * to `n` ones, so the current assignment is a vertex of the middle levels
+ * and every assignment whose number of modules in block `b` is within
+ * about `slack + 1` of `m / 2` is visited. Only the modules of the window
+ * are written into `part`.
+ *
+ * @param[in] hgr The hypergraph
+ * @param[in,out] part The partition
+ * @param[in] window The window
+ * @param[in] slack The number of pairs of padding bits
+ * @param[in] allow_a The weight that block `a` may lose
+ * @param[in] allow_b The weight that block `b` may lose
+ * @return The reduction of the cost
+ */
+template <typename Gnl>
+static auto solve_window(const Gnl& hgr, std::span<std::uint8_t> part,
+                         const Window<typename Gnl::node_t>& window, int slack,
+                         std::int64_t allow_a, std::int64_t allow_b) -> int {
+    using node_t = typename Gnl::node_t;
+
+    const auto num_window = static_cast<int>(window.modules.size());
+    // pin counts of each net of the window in blocks a and b (the terminals included)
+    auto net_index = std::unordered_map<node_t, std::uint32_t>{};
+    auto net_weight = std::vector<int>{};
+    auto count = std::vector<int>{};
+    auto module_nets = std::vector<std::vector<std::uint32_t>>(window.modules.size());
+    const auto num_padding = 2 * slack + (num_window % 2 == 0 ? 1 : 0);
+    auto bits = std::vector<int>(num_window + num_padding, 0);
+    auto num_ones = 0;
+    for (auto pos = 0; pos != num_window; ++pos) {
+        const auto v = window.modules[pos];
+        bits[pos] = part[v] == window.block_b ? 1 : 0;
+        num_ones += bits[pos];
+        for (const auto& net : hgr.gr[v]) {
+            if (!is_window_net(hgr, net)) {
+                continue;
+            }
+            const auto [it, inserted]
+                = net_index.emplace(net, static_cast<std::uint32_t>(net_weight.size()));
+            if (inserted) {
+                net_weight.emplace_back(static_cast<int>(hgr.get_net_weight(net)));
+                count.resize(count.size() + 2U, 0);
+                for (const auto& w : hgr.gr[net]) {
+                    if (part[w] == window.block_a) {
+                        ++count[2U * it->second];
+                    } else if (part[w] == window.block_b) {
+                        ++count[2U * it->second + 1U];
+                    }
+                }
+            }
+            module_nets[pos].push_back(it->second);
+        }
+    }
+
+    const auto half = static_cast<int>(bits.size()) / 2;
+    for (auto pos = num_window; num_ones < half; ++pos, ++num_ones) {
+        bits[pos] = 1;
+    }
+
+    auto cost = 0;
+    auto best_cost = 0;
+    auto delta_a = std::int64_t{0};  // weight gained by block a
+    auto best_bits = bits;
+    auto visit = [&](const std::vector<int>& y, int flipped) {
+        if (flipped >= num_window) {
+            return;  // padding bit
+        }
+        const auto to_side = y[flipped];
+        const auto from_side = 1 - to_side;
+        for (const auto& idx : module_nets[flipped]) {
+            auto* net_count = &count[2U * idx];
+            const auto cut_before = net_count[0] != 0 && net_count[1] != 0;
+            --net_count[from_side];
+            ++net_count[to_side];
+            const auto cut_after = net_count[0] != 0 && net_count[1] != 0;
+            cost += (static_cast<int>(cut_after) - static_cast<int>(cut_before)) * net_weight[idx];
+        }
+        const auto weight
+            = static_cast<std::int64_t>(hgr.get_module_weight(window.modules[flipped]));
+        delta_a += to_side == 0 ? weight : -weight;
+        if (cost < best_cost && delta_a >= -allow_a && delta_a <= allow_b) {
+            best_cost = cost;
+            std::copy(y.begin(), y.begin() + num_window, best_bits.begin());
+        }
+    };
+    MidHamCycle cycle{MidVertex(bits), -1, visit};
+
+    if (best_cost == 0) {
+        return 0;
+    }
+    for (auto pos = 0; pos != num_window; ++pos) {
+        part[window.modules[pos]] = best_bits[pos] == 1 ? window.block_b : window.block_a;
+    }
+    return -best_cost;
+}
+
+/**
+ * @brief Legalizes the partition to satisfy balance constraints.
+ *
+ * Uses the serial FM legalization, since it is run once per level on a
+ * partition that is usually almost legal already.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to legalize
+ * @return LegalCheck The result of the legality check
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+auto MidLvlWindowPartMgr<Gnl, GainMgr, ConstrMgr>::legalize(std::span<std::uint8_t> part)
+    -> LegalCheck {
+    FMPartMgr<Gnl, GainMgr, ConstrMgr> part_mgr(this->hyprgraph, this->gain_mgr, this->validator,
+                                                this->num_parts);
+    const auto legalcheck = part_mgr.legalize(part);
+    this->total_cost = part_mgr.total_cost;
+    return legalcheck;
+}
+
+/**
+ * @brief Optimizes the partition by FM and exact window refinement.
+ *
+ * FM first removes the improvements that single moves can find; FM runs
+ * once more if the windows changed the cut.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to optimize
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+void MidLvlWindowPartMgr<Gnl, GainMgr, ConstrMgr>::optimize(std::span<std::uint8_t> part) {
+    FMPartMgr<Gnl, GainMgr, ConstrMgr> part_mgr(this->hyprgraph, this->gain_mgr, this->validator,
+                                                this->num_parts);
+    part_mgr.optimize(part);
+    this->total_cost = part_mgr.total_cost;
+    if (this->_refine_windows(part) == 0) {
+        return;
+    }
+    part_mgr.optimize(part);
+    this->total_cost = part_mgr.total_cost;
+}
+
+/**
+ * @brief Runs the window passes.
+ *
+ * Each pass:
+ * 1. Builds windows from the boundary modules in module order; a module
+ *    joins a window only if neither it nor any of its nets belongs to an
+ *    earlier window
+ * 2. Splits the weight slack of each block among the windows touching it
+ * 3. Solves the windows concurrently
+ *
+ * Passes repeat until one brings no improvement.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam GainMgr The gain manager type
+ * @tparam ConstrMgr The constraint manager type
+ * @param[in,out] part The partition vector to refine
+ * @return The reduction of the cost
+ */
+template <typename Gnl, typename GainMgr, typename ConstrMgr>  //
+auto MidLvlWindowPartMgr<Gnl, GainMgr, ConstrMgr>::_refine_windows(std::span<std::uint8_t> part)
+    -> int {
+    using node_t = typename Gnl::node_t;
+
+    const auto& hgr = this->hyprgraph;
+    const auto num_modules = static_cast<std::uint32_t>(hgr.number_of_modules());
+    const auto num_nets = static_cast<std::uint32_t>(hgr.number_of_nets());
+    const auto num_parts = static_cast<std::uint8_t>(this->num_parts);
+    const auto max_window = this->max_window_modules;
+    const auto slack = static_cast<int>(this->window_slack);
+
+    this->validator.init(part);
+    const auto lowerbound = static_cast<std::int64_t>(this->validator.get_lowerbound());
+
+    auto total_gain = 0;
+    auto claimed = std::vector<std::uint8_t>(num_modules, 0U);
+    auto claimed_net = std::vector<std::uint8_t>(num_nets, 0U);
+    auto queued = std::vector<std::uint8_t>(num_modules, 0U);
+    for (auto pass = 0U; pass != this->max_passes; ++pass) {
+        std::fill(claimed.begin(), claimed.end(), 0U);
+        std::fill(claimed_net.begin(), claimed_net.end(), 0U);
+        for (const auto& v : hgr.module_fixed) {
+            claimed[v] = 1U;
+        }
+
+        auto is_free = [&](const node_t& v) {
+            if (claimed[v] != 0U) {
+                return false;
+            }
+            for (const auto& net : hgr.gr[v]) {
+                if (is_window_net(hgr, net) && claimed_net[net - num_modules] != 0U) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // 1. Windows
+        auto windows = std::vector<Window<node_t>>{};
+        for (auto seed = node_t(0U); seed != num_modules; ++seed) {
+            if (!is_free(seed)) {
+                continue;
+            }
+            const auto block_a = part[seed];
+            auto block_b = block_a;
+            for (const auto& net : hgr.gr[seed]) {
+                if (!is_window_net(hgr, net)) {
+                    continue;
+                }
+                for (const auto& w : hgr.gr[net]) {
+                    if (part[w] != block_a) {
+                        block_b = part[w];
+                        break;
+                    }
+                }
+                if (block_b != block_a) {
+                    break;
+                }
+            }
+            if (block_b == block_a) {
+                continue;  // not on the boundary
+            }
+
+            auto window = Window<node_t>{block_a, block_b, {}};
+            auto sides = std::vector<std::vector<node_t>>(2U);
+            auto touched = std::vector<node_t>{seed};
+            auto queue = std::deque<node_t>{seed};
+            queued[seed] = 1U;
+            const auto side_cap = (max_window + 1U) / 2U;
+            while (!queue.empty() && (sides[0].size() < side_cap || sides[1].size() < side_cap)) {
+                const auto u = queue.front();
+                queue.pop_front();
+                const auto side = part[u] == block_a ? 0U : 1U;
+                if (sides[side].size() == side_cap || !is_free(u)) {
+                    continue;
+                }
+                sides[side].push_back(u);
+                for (const auto& net : hgr.gr[u]) {
+                    if (!is_window_net(hgr, net) || hgr.gr.degree(net) > WIN_MAX_GROW_DEGREE) {
+                        continue;
+                    }
+                    for (const auto& w : hgr.gr[net]) {
+                        if (queued[w] == 0U && (part[w] == block_a || part[w] == block_b)) {
+                            queued[w] = 1U;
+                            touched.push_back(w);
+                            queue.push_back(w);
+                        }
+                    }
+                }
+            }
+            for (const auto& w : touched) {
+                queued[w] = 0U;
+            }
+            // the two sides differ by at most one module, and the window fits
+            auto num_a = std::min(sides[0].size(), sides[1].size() + 1U);
+            auto num_b = std::min(sides[1].size(), sides[0].size() + 1U);
+            if (num_a + num_b > max_window) {
+                --num_a;  // both sides are full and `max_window` is odd
+            }
+            if (num_a == 0U || num_b == 0U) {
+                continue;
+            }
+            window.modules.assign(sides[0].begin(), sides[0].begin() + num_a);
+            window.modules.insert(window.modules.end(), sides[1].begin(),
+                                  sides[1].begin() + num_b);
+            for (const auto& v : window.modules) {
+                claimed[v] = 1U;
+                for (const auto& net : hgr.gr[v]) {
+                    if (is_window_net(hgr, net)) {
+                        claimed_net[net - num_modules] = 1U;
+                    }
+                }
+            }
+            windows.push_back(std::move(window));
+        }
+        if (windows.empty()) {
+            break;
+        }
+
+        // 2. Weight slack of each block, split among its windows
+        auto part_weight = std::vector<std::int64_t>(num_parts, 0);
+        for (const auto& v : hgr) {
+            part_weight[part[v]] += hgr.get_module_weight(v);
+        }
+        auto num_windows = std::vector<std::int64_t>(num_parts, 0);
+        for (const auto& window : windows) {
+            ++num_windows[window.block_a];
+            ++num_windows[window.block_b];
+        }
+        auto allow = [&](std::uint8_t k) {
+            const auto slack = part_weight[k] > lowerbound ? part_weight[k] - lowerbound : 0;
+            return slack / num_windows[k];
+        };
+
+        // 3. Concurrent exact refinement
+        auto gains = std::vector<int>(windows.size(), 0);
+        const auto num_items = static_cast<std::uint32_t>(windows.size());
+        const auto num_tasks = num_parallel_tasks(this->num_threads, num_items, 1U);
+        parallel_for(num_tasks, num_items, [&](size_t, auto first, auto last) {
+            for (auto i = first; i != last; ++i) {
+                const auto& window = windows[i];
+                gains[i] = solve_window(hgr, part, window, slack, allow(window.block_a),
+                                        allow(window.block_b));
+            }
+        });
+        auto pass_gain = 0;
+        for (const auto& gain : gains) {
+            pass_gain += gain;
+        }
+        total_gain += pass_gain;
+        if (pass_gain == 0) {
+            break;
+        }
+    }
+    return total_gain;
+}
+
+#include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
+#include <netlistx/netlist.hpp>        // for SimpleNetlist, Netlist
+#include <xnetwork/classes/graph.hpp>
+
+template class MidLvlWindowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                   FMKWayConstrMgr<SimpleNetlist>>;
+
+#include <ckpttn/FMBiConstrMgr.hpp>  // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>    // for FMBiGainMgr
+
+template class MidLvlWindowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                                   FMBiConstrMgr<SimpleNetlist>>;
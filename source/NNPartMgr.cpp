@@ -151,6 +151,7 @@ void NNPartMgr<Gnl, GainMgr, ConstrMgr>::optimize(std::span<std::uint8_t> part)
     }
 }
 
+#include <ckpttn/CsrNetlist.hpp>       // for CsrNetlist
 #include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
 #include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
 #include <ckpttn/FMPartMgr.hpp>        // for FMPartMgr
@@ -159,8 +160,10 @@ void NNPartMgr<Gnl, GainMgr, ConstrMgr>::optimize(std::span<std::uint8_t> part)
 
 template class NNPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
                          FMKWayConstrMgr<SimpleNetlist>>;
+template class NNPartMgr<CsrNetlist, FMKWayGainMgr<CsrNetlist>, FMKWayConstrMgr<CsrNetlist>>;
 
 #include <ckpttn/FMBiConstrMgr.hpp>  // for FMBiConstrMgr
 #include <ckpttn/FMBiGainMgr.hpp>    // for FMBiGainMgr
 
-template class NNPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>;
\ No newline at end of file
+template class NNPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>;
+template class NNPartMgr<CsrNetlist, FMBiGainMgr<CsrNetlist>, FMBiConstrMgr<CsrNetlist>>;
@@ -0,0 +1,506 @@
+#include <algorithm>                   // for min, max, lower_bound
+#include <ckpttn/MappedFile.hpp>       // for MappedFile
+#include <ckpttn/ParallelReader.hpp>   // for HypergraphCsr, read_hmetis_csr, ...
+#include <ckpttn/parallel_for.hpp>     // for parallel_for, num_parallel_tasks
+#include <cstdint>                     // for uint32_t
+#include <cstring>                     // for memchr
+#include <netlistx/netlist.hpp>        // for SimpleNetlist, graph_t
+#include <netlistx/readwrite.hpp>      // for read_hypergraph, InputFormat
+#include <stdexcept>                   // for runtime_error
+#include <string>                      // for string
+#include <string_view>                 // for string_view
+#include <utility>                     // for move
+#include <vector>                      // for vector
+#include <xnetwork/classes/graph.hpp>  // for SimpleGraph
+
+#include "TextScan.hpp"  // for scan_uint, skip_blanks, ends_with
+
+/// @brief Default number of bytes per chunk
+static constexpr size_t PARSE_CHUNK_BYTES = size_t{1U} << 20U;
+
+/**
+ * @brief Returns the number of chunks of a file.
+ *
+ * @param[in] num_bytes The size of the text to split
+ * @param[in] num_chunks The requested number of chunks (0 = automatic)
+ * @return The number of chunks (at least 1)
+ */
+static auto chunk_count(size_t num_bytes, size_t num_chunks) -> size_t {
+    return num_chunks != 0U ? num_chunks : num_parallel_tasks(0U, num_bytes, PARSE_CHUNK_BYTES);
+}
+
+/**
+ * @brief Splits `text[first, size)` into chunks that start at line starts.
+ *
+ * @param[in] text The text
+ * @param[in] first The start of the first chunk
+ * @param[in] num_chunks The number of chunks
+ * @return The `num_chunks + 1` boundaries of the chunks
+ */
+static auto split_lines(std::string_view text, size_t first, size_t num_chunks)
+    -> std::vector<size_t> {
+    auto bounds = std::vector<size_t>(num_chunks + 1U, text.size());
+    bounds[0] = first;
+    for (auto i = size_t{1U}; i != num_chunks; ++i) {
+        auto pos = std::max(first + (text.size() - first) * i / num_chunks, bounds[i - 1U]);
+        if (pos != first && pos < text.size()) {
+            // the first line start at or after `pos`
+            const auto* eol = static_cast<const char*>(
+                std::memchr(text.data() + pos - 1U, '\n', text.size() - pos + 1U));
+            pos = eol == nullptr ? text.size() : static_cast<size_t>(eol - text.data()) + 1U;
+        }
+        bounds[i] = pos;
+    }
+    return bounds;
+}
+
+/**
+ * @brief Calls `fn(first, last)` for each line of `[first, last)`.
+ *
+ * The line ends are found with `memchr`, which the C library vectorizes.
+ *
+ * @param[in] first The start of the text
+ * @param[in] last The end of the text
+ * @param[in] fn The function to call
+ */
+template <typename Fn> static void for_each_line(const char* first, const char* last, Fn&& fn) {
+    while (first != last) {
+        const auto* eol
+            = static_cast<const char*>(std::memchr(first, '\n', static_cast<size_t>(last - first)));
+        if (eol == nullptr) {
+            eol = last;
+        }
+        fn(first, eol);
+        first = eol == last ? last : eol + 1;
+    }
+}
+
+/**
+ * @brief The data lines of a chunk of an hMetis file
+ */
+struct HmetisChunk {
+    /// @brief The integers of the lines
+    std::vector<std::uint32_t> values;
+    /// @brief The end of each line in `values`
+    std::vector<size_t> line_ends;
+};
+
+/**
+ * @brief Scans the data lines of a chunk of an hMetis file.
+ *
+ * @param[in] first The start of the chunk
+ * @param[in] last The end of the chunk
+ * @param[out] chunk The integers of the lines
+ */
+static void scan_hmetis_chunk(const char* first, const char* last, HmetisChunk& chunk) {
+    for_each_line(first, last, [&](const char* cur, const char* eol) {
+        cur = skip_blanks(cur, eol);
+        if (cur == eol || *cur == '%') {
+            return;  // empty or comment line
+        }
+        auto value = std::uint32_t{0U};
+        while (scan_uint(cur, eol, value)) {
+            chunk.values.push_back(value);
+        }
+        chunk.line_ends.push_back(chunk.values.size());
+    });
+}
+
+/**
+ * @brief Reads an hMetis hypergraph file in parallel.
+ *
+ * @param[in] filename The file name
+ * @param[in] num_chunks The number of chunks (0 = automatic)
+ * @return The hypergraph
+ */
+auto read_hmetis_csr(const std::string& filename, size_t num_chunks) -> HypergraphCsr {
+    const auto file = MappedFile{filename};
+    const auto text = file.view();
+    const auto* const base = text.data();
+
+    // 1. Header line: num_nets num_vertices [fmt], after the comments
+    auto header = std::vector<std::uint32_t>{};
+    auto body = text.size();
+    for (auto pos = size_t{0U}; pos != text.size();) {
+        const auto* first = base + pos;
+        const auto* last = static_cast<const char*>(std::memchr(first, '\n', text.size() - pos));
+        if (last == nullptr) {
+            last = base + text.size();
+        }
+        pos = std::min(static_cast<size_t>(last - base) + 1U, text.size());
+        first = skip_blanks(first, last);
+        if (first == last || *first == '%') {
+            continue;
+        }
+        auto value = std::uint32_t{0U};
+        while (scan_uint(first, last, value)) {
+            header.push_back(value);
+        }
+        body = pos;
+        break;
+    }
+    if (header.size() < 2U) {
+        throw std::runtime_error("Missing hMetis header in " + filename);
+    }
+    auto csr = HypergraphCsr{};
+    csr.num_nets = header[0];
+    csr.num_modules = header[1];
+    const auto fmt = header.size() > 2U ? header[2] : 0U;
+    const auto has_net_weights = fmt % 10U == 1U;
+    const auto has_module_weights = (fmt / 10U) % 10U == 1U;
+
+    // 2. Concurrent scan of the chunks
+    const auto bounds = split_lines(text, body, chunk_count(text.size() - body, num_chunks));
+    const auto count = static_cast<std::uint32_t>(bounds.size() - 1U);
+    auto chunks = std::vector<HmetisChunk>(count);
+    parallel_for(count, count, [&](size_t, auto first, auto last) {
+        for (auto c = first; c != last; ++c) {
+            scan_hmetis_chunk(base + bounds[c], base + bounds[c + 1U], chunks[c]);
+        }
+    });
+
+    // 3. Prefix sums over the chunks: first line, first pin, first weight
+    const auto skip = has_net_weights ? size_t{1U} : size_t{0U};
+    auto first_line = std::vector<size_t>(count + 1U, 0U);
+    auto first_pin = std::vector<size_t>(count + 1U, 0U);
+    auto first_weight = std::vector<size_t>(count + 1U, 0U);
+    for (auto c = 0U; c != count; ++c) {
+        const auto& chunk = chunks[c];
+        auto num_pins = size_t{0U};
+        auto num_weights = size_t{0U};
+        auto start = size_t{0U};
+        for (auto i = size_t{0U}; i != chunk.line_ends.size(); ++i) {
+            const auto len = chunk.line_ends[i] - start;
+            if (first_line[c] + i < csr.num_nets) {
+                num_pins += len > skip ? len - skip : 0U;
+            } else {
+                num_weights += len;
+            }
+            start = chunk.line_ends[i];
+        }
+        first_line[c + 1U] = first_line[c] + chunk.line_ends.size();
+        first_pin[c + 1U] = first_pin[c] + num_pins;
+        first_weight[c + 1U] = first_weight[c] + num_weights;
+    }
+
+    // 4. Concurrent assembly
+    const auto num_pins = first_pin[count];
+    csr.net_offsets.assign(csr.num_nets + 1U, num_pins);
+    csr.pins.resize(num_pins);
+    if (has_module_weights) {
+        csr.module_weight.assign(csr.num_modules, 1U);
+    }
+    auto min_pin = std::vector<std::uint32_t>(count, ~std::uint32_t{0U});
+    auto max_pin = std::vector<std::uint32_t>(count, 0U);
+    parallel_for(count, count, [&](size_t, auto first, auto last) {
+        for (auto c = first; c != last; ++c) {
+            const auto& chunk = chunks[c];
+            auto pin = first_pin[c];
+            auto weight = first_weight[c];
+            auto start = size_t{0U};
+            for (auto i = size_t{0U}; i != chunk.line_ends.size(); ++i) {
+                const auto line = first_line[c] + i;
+                const auto end = chunk.line_ends[i];
+                if (line < csr.num_nets) {
+                    csr.net_offsets[line] = pin;
+                    for (auto pos = std::min(start + skip, end); pos != end; ++pos) {
+                        const auto v = chunk.values[pos];
+                        min_pin[c] = std::min(min_pin[c], v);
+                        max_pin[c] = std::max(max_pin[c], v);
+                        csr.pins[pin++] = v;
+                    }
+                } else if (has_module_weights) {
+                    for (auto pos = start; pos != end && weight < csr.num_modules; ++pos) {
+                        csr.module_weight[weight++] = chunk.values[pos];
+                    }
+                }
+                start = end;
+            }
+        }
+    });
+
+    // 5. Module ids: 0-based, unless they are 1-based
+    if (num_pins != 0U) {
+        const auto lowest = *std::min_element(min_pin.begin(), min_pin.end());
+        const auto highest = *std::max_element(max_pin.begin(), max_pin.end());
+        if (lowest >= 1U && highest == csr.num_modules) {
+            const auto num_items = static_cast<std::uint32_t>(count);
+            parallel_for(count, num_items, [&](size_t, auto first, auto last) {
+                for (auto pos = first_pin[first]; pos != first_pin[last]; ++pos) {
+                    --csr.pins[pos];
+                }
+            });
+        } else if (highest >= csr.num_modules) {
+            throw std::runtime_error("Module id out of range in " + filename);
+        }
+    }
+    return csr;
+}
+
+/**
+ * @brief The pin lines of a chunk of a netD file
+ */
+struct NetdChunk {
+    /// @brief The module of each pin
+    std::vector<std::uint32_t> pins;
+    /// @brief The position in `pins` of each pin that starts a net
+    std::vector<size_t> starts;
+    /// @brief Whether a module id is out of range
+    bool out_of_range{};
+};
+
+/**
+ * @brief Scans the pin lines of a chunk of a netD file.
+ *
+ * @param[in] first The start of the chunk
+ * @param[in] last The end of the chunk
+ * @param[in] num_modules The number of modules
+ * @param[in] pad_offset The id of pad 0
+ * @param[out] chunk The pins
+ */
+static void scan_netd_chunk(const char* first, const char* last, std::uint32_t num_modules,
+                            std::uint32_t pad_offset, NetdChunk& chunk) {
+    for_each_line(first, last, [&](const char* cur, const char* eol) {
+        cur = skip_blanks(cur, eol);
+        if (cur == eol) {
+            return;
+        }
+        const auto is_pad = *cur == 'p';
+        auto v = std::uint32_t{0U};
+        if (!scan_uint(cur, eol, v)) {
+            return;
+        }
+        if (is_pad) {
+            v += pad_offset;
+        }
+        chunk.out_of_range |= v >= num_modules;
+        cur = skip_blanks(cur, eol);
+        if (cur != eol && *cur == 's') {
+            chunk.starts.push_back(chunk.pins.size());  // the source of a new net
+        }
+        chunk.pins.push_back(v);
+    });
+}
+
+/**
+ * @brief Reads a netD file in parallel.
+ *
+ * @param[in] filename The file name
+ * @param[in] num_chunks The number of chunks (0 = automatic)
+ * @return The hypergraph
+ */
+auto read_netd_csr(const std::string& filename, size_t num_chunks) -> HypergraphCsr {
+    const auto file = MappedFile{filename};
+    const auto text = file.view();
+    const auto* const base = text.data();
+
+    // 1. Header: 0, num_pins, num_nets, num_modules, pad_offset
+    const auto* cur = base;
+    const auto* const end = base + text.size();
+    auto header = std::vector<std::uint32_t>(5U, 0U);
+    for (auto& value : header) {
+        if (!scan_uint(cur, end, value)) {
+            throw std::runtime_error("Missing netD header in " + filename);
+        }
+    }
+    const auto num_pins = static_cast<size_t>(header[1]);
+    const auto pad_offset = header[4];
+    auto csr = HypergraphCsr{};
+    csr.num_nets = header[2];
+    csr.num_modules = header[3];
+    csr.num_pads = csr.num_modules - pad_offset - 1U;
+    const auto* eol
+        = static_cast<const char*>(std::memchr(cur, '\n', static_cast<size_t>(end - cur)));
+    const auto body = eol == nullptr ? text.size() : static_cast<size_t>(eol - base) + 1U;
+
+    // 2. Concurrent scan of the chunks
+    const auto bounds = split_lines(text, body, chunk_count(text.size() - body, num_chunks));
+    const auto count = static_cast<std::uint32_t>(bounds.size() - 1U);
+    auto chunks = std::vector<NetdChunk>(count);
+    parallel_for(count, count, [&](size_t, auto first, auto last) {
+        for (auto c = first; c != last; ++c) {
+            scan_netd_chunk(base + bounds[c], base + bounds[c + 1U], csr.num_modules, pad_offset,
+                            chunks[c]);
+        }
+    });
+
+    // 3. Prefix sums over the chunks; only the first `num_pins` pins count,
+    //    and the pins before the first net are dropped
+    auto first_pin = std::vector<size_t>(count + 1U, 0U);
+    auto first_net = std::vector<size_t>(count + 1U, 0U);
+    auto pin_begin = num_pins;
+    for (auto c = 0U; c != count; ++c) {
+        const auto& chunk = chunks[c];
+        if (chunk.out_of_range) {
+            throw std::runtime_error("Module id out of range in " + filename);
+        }
+        first_pin[c + 1U] = first_pin[c] + chunk.pins.size();
+        const auto limit = first_pin[c] < num_pins ? num_pins - first_pin[c] : 0U;
+        const auto num_starts = static_cast<size_t>(
+            std::lower_bound(chunk.starts.begin(), chunk.starts.end(), limit)
+            - chunk.starts.begin());
+        if (num_starts != 0U && pin_begin == num_pins) {
+            pin_begin = first_pin[c] + chunk.starts[0];
+        }
+        first_net[c + 1U] = first_net[c] + num_starts;
+    }
+    if (first_net[count] > csr.num_nets) {
+        throw std::runtime_error("More nets than declared in " + filename);
+    }
+    const auto pin_end = std::min(first_pin[count], num_pins);
+
+    // 4. Concurrent assembly
+    csr.net_offsets.assign(csr.num_nets + 1U, pin_end - pin_begin);
+    csr.pins.resize(pin_end - pin_begin);
+    parallel_for(count, count, [&](size_t, auto first, auto last) {
+        for (auto c = first; c != last; ++c) {
+            const auto& chunk = chunks[c];
+            for (auto i = first_net[c]; i != first_net[c + 1U]; ++i) {
+                const auto start = first_pin[c] + chunk.starts[i - first_net[c]];
+                csr.net_offsets[i] = start - pin_begin;
+            }
+            for (auto i = size_t{0U}; i != chunk.pins.size(); ++i) {
+                const auto pos = first_pin[c] + i;
+                if (pos >= pin_begin && pos < pin_end) {
+                    csr.pins[pos - pin_begin] = chunk.pins[i];
+                }
+            }
+        }
+    });
+    return csr;
+}
+
+/**
+ * @brief The weights of a chunk of an .are file
+ */
+struct AreChunk {
+    /// @brief The modules and their weights, in the order of the file
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> weights;
+};
+
+/**
+ * @brief Scans the lines of a chunk of an .are file.
+ *
+ * @param[in] first The start of the chunk
+ * @param[in] last The end of the chunk
+ * @param[in] pad_offset The id of pad 0
+ * @param[out] chunk The weights
+ */
+static void scan_are_chunk(const char* first, const char* last, std::uint32_t pad_offset,
+                           AreChunk& chunk) {
+    for_each_line(first, last, [&](const char* cur, const char* eol) {
+        cur = skip_blanks(cur, eol);
+        if (cur == eol) {
+            return;
+        }
+        const auto is_pad = *cur == 'p';
+        auto v = std::uint32_t{0U};
+        auto weight = std::uint32_t{0U};
+        if (!scan_uint(cur, eol, v) || !scan_uint(cur, eol, weight)) {
+            return;
+        }
+        if (is_pad) {
+            v += pad_offset;
+        }
+        chunk.weights.emplace_back(v, weight);
+    });
+}
+
+/**
+ * @brief Reads the module weights of an .are file in parallel.
+ *
+ * The lines are scanned concurrently; the weights are stored serially, so
+ * that the last weight of a module wins as in `readAre`.
+ *
+ * @param[in] filename The file name
+ * @param[in] num_modules The number of modules
+ * @param[in] num_pads The number of pads
+ * @param[in] num_chunks The number of chunks (0 = automatic)
+ * @return The module weights
+ */
+auto read_are_weights(const std::string& filename, std::uint32_t num_modules,
+                      std::uint32_t num_pads, size_t num_chunks) -> std::vector<unsigned int> {
+    const auto file = MappedFile{filename};
+    const auto text = file.view();
+    const auto* const base = text.data();
+    const auto pad_offset = num_modules - num_pads - 1U;
+
+    const auto bounds = split_lines(text, 0U, chunk_count(text.size(), num_chunks));
+    const auto count = static_cast<std::uint32_t>(bounds.size() - 1U);
+    auto chunks = std::vector<AreChunk>(count);
+    parallel_for(count, count, [&](size_t, auto first, auto last) {
+        for (auto c = first; c != last; ++c) {
+            scan_are_chunk(base + bounds[c], base + bounds[c + 1U], pad_offset, chunks[c]);
+        }
+    });
+
+    auto module_weight = std::vector<unsigned int>(num_modules, 0U);
+    for (const auto& chunk : chunks) {
+        for (const auto& [v, weight] : chunk.weights) {
+            if (v >= num_modules) {
+                throw std::runtime_error("Module id out of range in " + filename);
+            }
+            module_weight[v] = weight;
+        }
+    }
+    return module_weight;
+}
+
+/**
+ * @brief Builds a `SimpleNetlist` from a CSR hypergraph.
+ *
+ * `SimpleGraph` can only grow edge by edge, so this step is serial.
+ *
+ * @param[in] csr The hypergraph
+ * @return The netlist
+ */
+auto to_netlist(const HypergraphCsr& csr) -> SimpleNetlist {
+    auto gr = graph_t(csr.num_modules + csr.num_nets);
+    for (auto i_net = 0U; i_net != csr.num_nets; ++i_net) {
+        for (auto pos = csr.net_offsets[i_net]; pos != csr.net_offsets[i_net + 1U]; ++pos) {
+            gr.add_edge(csr.pins[pos], csr.num_modules + i_net);
+        }
+    }
+    auto hyprgraph = SimpleNetlist(std::move(gr), csr.num_modules, csr.num_nets);
+    hyprgraph.num_pads = csr.num_pads;
+    hyprgraph.module_weight = csr.module_weight;
+    return hyprgraph;
+}
+
+/**
+ * @brief Reads the module weights of an .are file in parallel.
+ *
+ * @param[in,out] hyprgraph The netlist
+ * @param[in] filename The file name
+ */
+void read_are_parallel(SimpleNetlist& hyprgraph, const std::string& filename) {
+    const auto num_modules = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+    const auto num_pads = static_cast<std::uint32_t>(hyprgraph.num_pads);
+    hyprgraph.module_weight = read_are_weights(filename, num_modules, num_pads);
+}
+
+/**
+ * @brief Reads a hypergraph, in parallel for the hMetis and netD formats.
+ *
+ * @param[in] filename The file name
+ * @param[in] input_format The format of the file
+ * @return The netlist
+ */
+auto read_hypergraph_parallel(const std::string& filename, InputFormat input_format)
+    -> SimpleNetlist {
+    if (input_format == InputFormat::auto_detect) {
+        if (ends_with(filename, ".hgr")) {
+            input_format = InputFormat::hmetis;
+        } else if (ends_with(filename, ".net") || ends_with(filename, ".netD")) {
+            input_format = InputFormat::netD;
+        }
+    }
+    switch (input_format) {
+        case InputFormat::hmetis:
+            return to_netlist(read_hmetis_csr(filename));
+        case InputFormat::netD:
+            return to_netlist(read_netd_csr(filename));
+        default:
+            return read_hypergraph(filename, input_format);
+    }
+}
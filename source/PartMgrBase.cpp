@@ -167,6 +167,7 @@ void PartMgrBase<Gnl, GainMgr, ConstrMgr>::optimize(std::span<std::uint8_t> part
     }
 }
 
+#include <ckpttn/CsrNetlist.hpp>       // for CsrNetlist
 #include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
 #include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
 #include <ckpttn/FMPartMgr.hpp>        // for FMPartMgr
@@ -175,8 +176,10 @@ void PartMgrBase<Gnl, GainMgr, ConstrMgr>::optimize(std::span<std::uint8_t> part
 
 template class PartMgrBase<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
                            FMKWayConstrMgr<SimpleNetlist>>;
+template class PartMgrBase<CsrNetlist, FMKWayGainMgr<CsrNetlist>, FMKWayConstrMgr<CsrNetlist>>;
 
 #include <ckpttn/FMBiConstrMgr.hpp>  // for FMBiConstrMgr
 #include <ckpttn/FMBiGainMgr.hpp>    // for FMBiGainMgr
 
-template class PartMgrBase<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>;
\ No newline at end of file
+template class PartMgrBase<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>;
+template class PartMgrBase<CsrNetlist, FMBiGainMgr<CsrNetlist>, FMBiConstrMgr<CsrNetlist>>;
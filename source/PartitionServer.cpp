@@ -0,0 +1,490 @@
+#include <ckpttn/CoarseningCtrl.hpp>       // for CoarseningCtrl
+#include <ckpttn/CoarseningHierarchy.hpp>  // for CoarseningHierarchy
+#include <ckpttn/FMBiConstrMgr.hpp>        // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>          // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>      // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>        // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>            // for FMPartMgr
+#include <ckpttn/MLPartMgr.hpp>            // for MLPartMgr
+#include <ckpttn/ParallelReader.hpp>       // for read_hypergraph_parallel
+#include <ckpttn/PartitionServer.hpp>      // for PartitionServer, NetlistCache
+#include <ckpttn/PreprocessedNetlist.hpp>  // for preprocess_netlist
+#include <ckpttn/RecursiveBisection.hpp>   // for RecursiveBisection
+#include <ckpttn/TaskScheduler.hpp>        // for TaskScheduler
+#include <ckpttn/YosysStreamReader.hpp>    // for read_yosys_json_stream
+#include <cerrno>                          // for errno, EINTR
+#include <cstdint>                         // for uint8_t, uint32_t, uint64_t
+#include <cstring>                         // for strerror
+#include <fstream>                         // for ifstream
+#include <memory>                          // for make_shared, unique_ptr
+#include <mutex>                           // for lock_guard, unique_lock
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <netlistx/readwrite.hpp>          // for InputFormat
+#include <random>                          // for mt19937, uniform_int_distri...
+#include <sstream>                         // for istringstream, ostringstream
+#include <stdexcept>                       // for runtime_error, invalid_argu...
+#include <string>                          // for string, stoul, stod
+#include <thread>                          // for thread
+#include <utility>                         // for move, pair
+#include <vector>                          // for vector
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <poll.h>        // for poll, POLLIN
+#    include <sys/socket.h>  // for socket, bind, listen, accept, send, recv
+#    include <sys/un.h>      // for sockaddr_un
+#    include <unistd.h>      // for close, unlink
+#endif
+
+/// @brief Number of bytes of a file hashed at a time
+static constexpr size_t HASH_BLOCK_BYTES = size_t{1U} << 16U;
+
+/**
+ * @brief Hashes the content of a file and its format (64-bit FNV-1a).
+ *
+ * @param[in] filename The file name
+ * @param[in] format The format
+ * @return The hash
+ * @throw std::runtime_error if the file cannot be read
+ */
+static auto hash_file(const std::string& filename, const std::string& format) -> std::uint64_t {
+    constexpr auto FNV_PRIME = std::uint64_t{0x100000001b3U};
+    auto hash = std::uint64_t{0xcbf29ce484222325U};
+    const auto mix = [&hash](const char* data, size_t size) {
+        for (auto i = 0U; i != size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= FNV_PRIME;
+        }
+    };
+
+    auto file = std::ifstream{filename, std::ios::binary};
+    if (file.fail()) {
+        throw std::runtime_error("Can't open " + filename);
+    }
+    auto buffer = std::vector<char>(HASH_BLOCK_BYTES);
+    while (file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))
+           || file.gcount() > 0) {
+        mix(buffer.data(), static_cast<size_t>(file.gcount()));
+    }
+    mix(format.data(), format.size());
+    return hash;
+}
+
+/**
+ * @brief Reads a netlist in one of the formats of `PartitionJob::format`.
+ *
+ * @param[in] filename The file name
+ * @param[in] format The format
+ * @return The netlist
+ * @throw std::runtime_error if the format is unknown, or if the file cannot
+ * be read or is malformed
+ */
+static auto read_netlist(const std::string& filename, const std::string& format)
+    -> SimpleNetlist {
+    if (format == "yosys") {
+        return read_yosys_json_stream(filename);
+    }
+    auto input_format = InputFormat::auto_detect;
+    if (format == "hmetis") {
+        input_format = InputFormat::hmetis;
+    } else if (format == "json") {
+        input_format = InputFormat::json;
+    } else if (format == "dimacs") {
+        input_format = InputFormat::dimacs;
+    } else if (format == "netd") {
+        input_format = InputFormat::netD;
+    } else if (format != "auto") {
+        throw std::runtime_error("Unknown format " + format);
+    }
+    return read_hypergraph_parallel(filename, input_format);
+}
+
+auto NetlistCache::get(const std::string& filename, const std::string& format, bool& hit)
+    -> std::shared_ptr<const Entry> {
+    const auto key = hash_file(filename, format);
+    {
+        auto lock = std::lock_guard<std::mutex>{this->mutex};
+        const auto it = this->index.find(key);
+        if (it != this->index.end()) {
+            this->lru.splice(this->lru.begin(), this->lru, it->second);
+            ++this->num_hits;
+            hit = true;
+            return it->second->second;
+        }
+        ++this->num_misses;
+    }
+
+    // read outside the lock, so that the jobs on cached netlists go on
+    auto entry
+        = std::make_shared<Entry>(Entry{read_netlist(filename, format), nullptr, nullptr});
+    entry->preprocessed = preprocess_netlist(entry->netlist);
+    entry->hierarchy = std::make_unique<CoarseningHierarchy>(*entry->preprocessed);
+    const auto job = PartitionJob{};
+    auto ctrl = CoarseningCtrl{job.bal_tol, job.num_parts};
+    entry->hierarchy->build(ctrl);
+
+    auto lock = std::lock_guard<std::mutex>{this->mutex};
+    hit = false;
+    const auto it = this->index.find(key);
+    if (it != this->index.end()) {
+        // read concurrently by another job
+        this->lru.splice(this->lru.begin(), this->lru, it->second);
+        return it->second->second;
+    }
+    this->lru.emplace_front(key, std::move(entry));
+    this->index[key] = this->lru.begin();
+    while (this->lru.size() > this->capacity) {
+        this->index.erase(this->lru.back().first);
+        this->lru.pop_back();
+    }
+    return this->lru.front().second;
+}
+
+auto NetlistCache::size() const -> size_t {
+    auto lock = std::lock_guard<std::mutex>{this->mutex};
+    return this->lru.size();
+}
+
+auto NetlistCache::stats() const -> std::pair<size_t, size_t> {
+    auto lock = std::lock_guard<std::mutex>{this->mutex};
+    return {this->num_hits, this->num_misses};
+}
+
+auto run_partition_job(const NetlistCache::Entry& entry, const PartitionJob& job)
+    -> PartitionResult {
+    using BiPartMgr = FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                                FMBiConstrMgr<SimpleNetlist>>;
+    using KWayPartMgr = FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                  FMKWayConstrMgr<SimpleNetlist>>;
+
+    // the fixed modules change the reduction, so they need a copy of the netlist
+    auto fixed_netlist = std::unique_ptr<SimpleNetlist>{};
+    auto fixed_preprocessed = std::unique_ptr<PreprocessedNetlist>{};
+    if (!job.fixed_file.empty()) {
+        fixed_netlist = std::make_unique<SimpleNetlist>(entry.netlist);
+        auto fix_fs = std::ifstream{job.fixed_file};
+        if (fix_fs.fail()) {
+            throw std::runtime_error("Can't open " + job.fixed_file);
+        }
+        std::uint32_t module_id = 0;
+        while (fix_fs >> module_id) {
+            if (module_id >= fixed_netlist->number_of_modules()) {
+                throw std::runtime_error("Fixed module out of range in " + job.fixed_file);
+            }
+            fixed_netlist->module_fixed.insert(module_id);
+        }
+        fixed_netlist->has_fixed_modules = true;
+        fixed_preprocessed = preprocess_netlist(*fixed_netlist);
+    }
+    const auto& preprocessed = fixed_preprocessed ? *fixed_preprocessed : *entry.preprocessed;
+    const SimpleNetlist& work_hgr = preprocessed;
+
+    auto best_part = std::vector<std::uint8_t>(work_hgr.number_of_modules(), 0);
+    auto gen = std::mt19937{job.seed};
+    auto dist = std::uniform_int_distribution<int>(0, job.num_parts - 1);
+    for (auto i = 0U; i != work_hgr.number_of_modules(); ++i) {
+        if (!work_hgr.module_fixed.contains(i)) {
+            best_part[i] = static_cast<std::uint8_t>(dist(gen));
+        }
+    }
+
+    auto result = PartitionResult{};
+    if (job.recursive && job.num_parts > 2) {
+        RecursiveBisection rb_mgr(job.bal_tol, job.num_parts);
+        rb_mgr.set_num_vcycles(job.num_vcycles);
+        rb_mgr.run_Partition<SimpleNetlist, BiPartMgr>(work_hgr, best_part);
+        result.cost = rb_mgr.total_cost;
+    } else {
+        MLPartMgr ml_mgr(job.bal_tol, job.num_parts);
+        ml_mgr.set_num_vcycles(job.num_vcycles);
+        if (!fixed_preprocessed) {
+            ml_mgr.get_coarsening().set_hierarchy(entry.hierarchy.get());
+        }
+        if (job.num_parts == 2) {
+            ml_mgr.run_Partition<SimpleNetlist, BiPartMgr>(work_hgr, best_part);
+        } else {
+            ml_mgr.run_Partition<SimpleNetlist, KWayPartMgr>(work_hgr, best_part);
+        }
+        result.cost = ml_mgr.total_cost;
+    }
+
+    result.part.resize(entry.netlist.number_of_modules(), 0);
+    preprocessed.projection_down(best_part, result.part);
+    result.cost += preprocessed.detached_cost(result.part);
+    return result;
+}
+
+auto parse_partition_job(std::istream& args) -> PartitionJob {
+    auto job = PartitionJob{};
+    auto token = std::string{};
+    while (args >> token) {
+        const auto pos = token.find('=');
+        if (pos == std::string::npos) {
+            throw std::runtime_error("Expected key=value, got " + token);
+        }
+        const auto key = token.substr(0, pos);
+        const auto value = token.substr(pos + 1);
+        try {
+            if (key == "file") {
+                job.filename = value;
+            } else if (key == "format") {
+                job.format = value;
+            } else if (key == "fixed") {
+                job.fixed_file = value;
+            } else if (key == "k") {
+                const auto num_parts = std::stoul(value);
+                if (num_parts < 2 || num_parts > 255) {
+                    throw std::runtime_error("k must be between 2 and 255");
+                }
+                job.num_parts = static_cast<std::uint8_t>(num_parts);
+            } else if (key == "epsilon") {
+                // a percentage as in the command line
+                job.bal_tol = std::stod(value);
+                if (job.bal_tol > 1.0) {
+                    job.bal_tol /= 100.0;
+                }
+                if (job.bal_tol < 0.0 || job.bal_tol > 1.0) {
+                    throw std::runtime_error("epsilon must be between 0 and 1");
+                }
+            } else if (key == "seed") {
+                job.seed = static_cast<std::uint32_t>(std::stoul(value));
+            } else if (key == "mode") {
+                if (value != "direct" && value != "recursive") {
+                    throw std::runtime_error("Unknown mode " + value);
+                }
+                job.recursive = value == "recursive";
+            } else if (key == "vcycles") {
+                job.num_vcycles = std::stoul(value);
+            } else {
+                throw std::runtime_error("Unknown argument " + key);
+            }
+        } catch (const std::logic_error&) {
+            // std::invalid_argument and std::out_of_range of the conversions
+            throw std::runtime_error("Invalid value of " + key);
+        }
+    }
+    if (job.filename.empty()) {
+        throw std::runtime_error("Missing file=");
+    }
+    return job;
+}
+
+auto PartitionServer::handle_request(const std::string& request) -> std::string {
+    auto args = std::istringstream{request};
+    auto command = std::string{};
+    args >> command;
+    auto response = std::ostringstream{};
+    try {
+        if (command == "partition") {
+            const auto job = parse_partition_job(args);
+            auto hit = false;
+            const auto entry = this->cache.get(job.filename, job.format, hit);
+            const auto result = run_partition_job(*entry, job);
+            response << "ok cost=" << result.cost << " cached=" << (hit ? 1 : 0) << " part=";
+            auto sep = "";
+            for (const auto p : result.part) {
+                response << sep << static_cast<unsigned int>(p);
+                sep = ",";
+            }
+        } else if (command == "stats") {
+            const auto [hits, misses] = this->cache.stats();
+            response << "ok entries=" << this->cache.size() << " hits=" << hits
+                     << " misses=" << misses;
+        } else if (command == "shutdown") {
+            this->stop();
+            response << "ok";
+        } else {
+            response << "error Unknown command " << command;
+        }
+    } catch (const std::exception& e) {
+        response.str("");
+        response << "error " << e.what();
+    }
+    return response.str();
+}
+
+void PartitionServer::stop() { this->stopping = true; }
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#    ifdef MSG_NOSIGNAL
+static constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#    else
+static constexpr int SEND_FLAGS = 0;
+#    endif
+
+/// @brief Timeout of `poll` in milliseconds, to check for `stop`
+static constexpr int POLL_TIMEOUT_MS = 100;
+
+/**
+ * @brief Builds the address of a Unix domain socket.
+ *
+ * @param[in] socket_path The path of the socket
+ * @return The address
+ * @throw std::runtime_error if the path is too long
+ */
+static auto make_address(const std::string& socket_path) -> sockaddr_un {
+    auto address = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + socket_path);
+    }
+    socket_path.copy(address.sun_path, socket_path.size());
+    return address;
+}
+
+/**
+ * @brief Sends a whole line.
+ *
+ * @param[in] fd The socket
+ * @param[in] line The line, without the line feed
+ * @return Whether the line was sent
+ */
+static auto send_line(int fd, std::string line) -> bool {
+    line.push_back('\n');
+    auto sent = size_t{0U};
+    while (sent != line.size()) {
+        const auto count = ::send(fd, line.data() + sent, line.size() - sent, SEND_FLAGS);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+/**
+ * @brief Receives the next line.
+ *
+ * @param[in] fd The socket
+ * @param[in,out] buffer The bytes received after the previous line
+ * @param[out] line The line, without the line feed
+ * @return Whether a line was received (false at the end of the stream)
+ */
+static auto receive_line(int fd, std::string& buffer, std::string& line) -> bool {
+    auto pos = buffer.find('\n');
+    while (pos == std::string::npos) {
+        char chunk[4096];
+        const auto count = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(count));
+        pos = buffer.find('\n');
+    }
+    line = buffer.substr(0, pos);
+    buffer.erase(0, pos + 1);
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    return true;
+}
+
+void PartitionServer::_serve_connection(int fd) {
+    auto buffer = std::string{};
+    auto request = std::string{};
+    while (!this->stopping && receive_line(fd, buffer, request)) {
+        if (request.empty()) {
+            continue;
+        }
+        if (!send_line(fd, this->handle_request(request))) {
+            break;
+        }
+    }
+    // closed under the lock, so that a new connection cannot reuse the
+    // descriptor before it is erased
+    auto lock = std::lock_guard<std::mutex>{this->connections_mutex};
+    std::erase(this->connections, fd);
+    ::close(fd);
+    --this->num_running;
+    this->connections_done.notify_all();
+}
+
+void PartitionServer::serve() {
+    const auto address = make_address(this->socket_path);
+    const auto listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw std::runtime_error(std::string{"Can't create socket: "} + std::strerror(errno));
+    }
+    ::unlink(this->socket_path.c_str());
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listener, SOMAXCONN) != 0) {
+        const auto error = std::string{std::strerror(errno)};
+        ::close(listener);
+        throw std::runtime_error("Can't listen on " + this->socket_path + ": " + error);
+    }
+
+    // the jobs of all connections share the scheduler of the caller; each
+    // connection has a detached thread, counted until it finishes
+    auto* scheduler = &TaskScheduler::current();
+    while (!this->stopping) {
+        auto pfd = pollfd{listener, POLLIN, 0};
+        if (::poll(&pfd, 1, POLL_TIMEOUT_MS) <= 0) {
+            continue;
+        }
+        const auto fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        {
+            auto lock = std::lock_guard<std::mutex>{this->connections_mutex};
+            this->connections.push_back(fd);
+            ++this->num_running;
+        }
+        std::thread{[this, fd, scheduler]() {
+            auto scope = TaskScheduler::Scope{scheduler};
+            this->_serve_connection(fd);
+        }}.detach();
+    }
+
+    ::close(listener);
+    ::unlink(this->socket_path.c_str());
+    // wake up the connections waiting for a request; running jobs finish
+    auto lock = std::unique_lock<std::mutex>{this->connections_mutex};
+    for (const auto fd : this->connections) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+    this->connections_done.wait(lock, [this]() { return this->num_running == 0U; });
+}
+
+auto send_partition_request(const std::string& socket_path, const std::string& request)
+    -> std::string {
+    const auto address = make_address(socket_path);
+    const auto fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string{"Can't create socket: "} + std::strerror(errno));
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        const auto error = std::string{std::strerror(errno)};
+        ::close(fd);
+        throw std::runtime_error("Can't connect to " + socket_path + ": " + error);
+    }
+    auto buffer = std::string{};
+    auto response = std::string{};
+    const auto ok = send_line(fd, request) && receive_line(fd, buffer, response);
+    ::close(fd);
+    if (!ok) {
+        throw std::runtime_error("No response from " + socket_path);
+    }
+    return response;
+}
+
+#else
+
+void PartitionServer::serve() {
+    throw std::runtime_error("Unix domain sockets are not supported on this platform");
+}
+
+void PartitionServer::_serve_connection(int /* fd */) {}
+
+auto send_partition_request(const std::string& /* socket_path */,
+                            const std::string& /* request */) -> std::string {
+    throw std::runtime_error("Unix domain sockets are not supported on this platform");
+}
+
+#endif
@@ -0,0 +1,232 @@
+#include <algorithm>                       // for sort, unique, max
+#include <bitset>                          // for bitset
+#include <ckpttn/CsrNetlist.hpp>           // for CsrNetlist
+#include <ckpttn/PreprocessedNetlist.hpp>  // for PreprocessedNetlist
+#include <cstdint>                         // for uint8_t, uint32_t, uint64_t
+#include <memory>                          // for unique_ptr, make_unique
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <span>                            // for span
+#include <unordered_map>                   // for unordered_map
+#include <utility>                         // for move
+#include <vector>                          // for vector
+#include <xnetwork/classes/graph.hpp>      // for SimpleGraph
+
+using node_t = SimpleNetlist::node_t;
+
+/**
+ * @brief Projects a partition of the original netlist onto the reduced netlist.
+ *
+ * @param[in] part The partition of the original netlist
+ * @param[out] part_up The partition of the reduced netlist
+ */
+void PreprocessedNetlist::projection_up(std::span<const std::uint8_t> part,
+                                        std::span<std::uint8_t> part_up) const {
+    for (const auto& v : *this->parent) {
+        part_up[this->node_up_map[v]] = part[v];
+    }
+}
+
+/**
+ * @brief Restores a full-size partition from a partition of the reduced netlist.
+ *
+ * Every module of a supermodule gets the part of its supermodule.
+ *
+ * @param[in] part The partition of the reduced netlist
+ * @param[out] part_down The partition of the original netlist
+ */
+void PreprocessedNetlist::projection_down(std::span<const std::uint8_t> part,
+                                          std::span<std::uint8_t> part_down) const {
+    for (const auto& v : *this->parent) {
+        part_down[v] = part[this->node_up_map[v]];
+    }
+}
+
+/**
+ * @brief Returns the (lambda - 1) cost of a net.
+ *
+ * @tparam Gnl The netlist type
+ * @param[in] hyprgraph The netlist
+ * @param[in] net The net
+ * @param[in] part The partition
+ * @return The net weight times the number of parts it spans, minus one
+ */
+template <typename Gnl>
+static auto net_km1_cost(const Gnl& hyprgraph, const typename Gnl::node_t& net,
+                         std::span<const std::uint8_t> part) -> int {
+    auto spanned = std::bitset<256>{};
+    for (const auto& w : hyprgraph.gr[net]) {
+        spanned.set(part[w]);
+    }
+    if (spanned.count() < 2) {
+        return 0;
+    }
+    return static_cast<int>(spanned.count() - 1) * static_cast<int>(hyprgraph.get_net_weight(net));
+}
+
+/**
+ * @brief Returns the cost contributed by the detached nets.
+ *
+ * @param[in] part The partition of the original netlist
+ * @return The (lambda - 1) cost of the detached nets
+ */
+auto PreprocessedNetlist::detached_cost(std::span<const std::uint8_t> part) const -> int {
+    auto cost = 0;
+    for (const auto& net : this->detached_nets) {
+        cost += net_km1_cost(*this->parent, net, part);
+    }
+    return cost;
+}
+
+template <typename Gnl>
+auto large_net_cost(const Gnl& hyprgraph, std::span<const std::uint8_t> part, size_t max_degree)
+    -> int {
+    auto cost = 0;
+    for (const auto& net : hyprgraph.nets) {
+        if (hyprgraph.gr.degree(net) > max_degree) {
+            cost += net_km1_cost(hyprgraph, net, part);
+        }
+    }
+    return cost;
+}
+
+/**
+ * @brief Hashes a sorted list of nets.
+ *
+ * @param[in] nets The sorted nets of a module
+ * @return The hash value
+ */
+static auto hash_nets(const std::vector<node_t>& nets) noexcept -> std::uint64_t {
+    auto hash = std::uint64_t{14695981039346656037ULL};  // FNV-1a
+    for (const auto& net : nets) {
+        hash ^= static_cast<std::uint64_t>(net);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Builds the reduced netlist of the preprocessing stage.
+ *
+ * 1. Classifies nets into single-pin (removed), huge (detached) and kept nets
+ * 2. Merges modules whose kept nets are identical, up to the weight limit
+ * 3. Rebuilds the kept nets over the supermodules, dropping the ones that
+ *    collapse into a single supermodule
+ *
+ * @param[in] hyprgraph The original netlist
+ * @param[in] max_degree Nets with more pins than this are detached
+ * @param[in] max_twin_weight Weight limit of a supermodule (0 = 1% of the total weight)
+ * @return The reduced netlist with the information to undo the reduction
+ */
+auto preprocess_netlist(const SimpleNetlist& hyprgraph, size_t max_degree,
+                        unsigned int max_twin_weight) -> std::unique_ptr<PreprocessedNetlist> {
+    const auto num_modules = hyprgraph.number_of_modules();
+
+    auto is_kept = std::vector<std::uint8_t>(hyprgraph.number_of_nets(), 0U);
+    auto detached_nets = std::vector<node_t>{};
+    auto num_removed_nets = size_t{0U};
+    for (const auto& net : hyprgraph.nets) {
+        const auto degree = hyprgraph.gr.degree(net);
+        if (degree < 2) {
+            ++num_removed_nets;
+        } else if (degree > max_degree) {
+            detached_nets.emplace_back(net);
+        } else {
+            is_kept[net - num_modules] = 1U;
+        }
+    }
+
+    auto total_weight = 0U;
+    for (const auto& v : hyprgraph) {
+        total_weight += hyprgraph.get_module_weight(v);
+    }
+    if (max_twin_weight == 0U) {
+        max_twin_weight = std::max(total_weight / 100U, 1U);
+    }
+
+    // Merge twin modules: group leaders are bucketed by the hash of their nets
+    auto node_up_map = std::vector<node_t>(num_modules, 0U);
+    auto module_weight = std::vector<unsigned int>{};
+    auto leader_nets = std::vector<std::vector<node_t>>{};
+    auto buckets = std::unordered_map<std::uint64_t, std::vector<node_t>>{};
+    auto module_fixed = py::set<node_t>{};
+    auto nets_v = std::vector<node_t>{};
+    for (const auto& v : hyprgraph) {
+        const auto weight_v = hyprgraph.get_module_weight(v);
+        nets_v.clear();
+        for (const auto& net : hyprgraph.gr[v]) {
+            if (is_kept[net - num_modules] != 0U) {
+                nets_v.emplace_back(net);
+            }
+        }
+        std::sort(nets_v.begin(), nets_v.end());
+
+        const auto is_fixed = hyprgraph.module_fixed.contains(v);
+        if (!is_fixed && !nets_v.empty()) {
+            auto& bucket = buckets[hash_nets(nets_v)];
+            auto found = false;
+            for (const auto& v2 : bucket) {
+                if (module_weight[v2] + weight_v <= max_twin_weight && leader_nets[v2] == nets_v) {
+                    node_up_map[v] = v2;
+                    module_weight[v2] += weight_v;
+                    found = true;
+                    break;
+                }
+            }
+            if (found) {
+                continue;
+            }
+            bucket.emplace_back(static_cast<node_t>(module_weight.size()));
+        }
+        const auto v2 = static_cast<node_t>(module_weight.size());
+        node_up_map[v] = v2;
+        module_weight.emplace_back(weight_v);
+        leader_nets.emplace_back(is_fixed ? std::vector<node_t>{} : nets_v);
+        if (is_fixed) {
+            module_fixed.insert(v2);
+        }
+    }
+    const auto num_modules2 = static_cast<uint32_t>(module_weight.size());
+
+    // Rebuild the kept nets over the supermodules
+    auto net_pins = std::vector<std::vector<node_t>>{};
+    auto pins = std::vector<node_t>{};
+    for (const auto& net : hyprgraph.nets) {
+        if (is_kept[net - num_modules] == 0U) {
+            continue;
+        }
+        pins.clear();
+        for (const auto& v : hyprgraph.gr[net]) {
+            pins.emplace_back(node_up_map[v]);
+        }
+        std::sort(pins.begin(), pins.end());
+        pins.erase(std::unique(pins.begin(), pins.end()), pins.end());
+        if (pins.size() < 2) {
+            ++num_removed_nets;  // all pins merged into one supermodule
+            continue;
+        }
+        net_pins.emplace_back(pins);
+    }
+    const auto num_nets2 = static_cast<uint32_t>(net_pins.size());
+
+    auto gr2 = graph_t(num_modules2 + num_nets2);
+    for (auto i_net = 0U; i_net != num_nets2; ++i_net) {
+        for (const auto& v2 : net_pins[i_net]) {
+            gr2.add_edge(v2, num_modules2 + i_net);
+        }
+    }
+
+    auto hgr2 = std::make_unique<PreprocessedNetlist>(std::move(gr2), num_modules2, num_nets2);
+    hgr2->module_weight = std::move(module_weight);
+    hgr2->module_fixed = std::move(module_fixed);
+    hgr2->has_fixed_modules = !hgr2->module_fixed.empty();
+    hgr2->parent = &hyprgraph;
+    hgr2->node_up_map = std::move(node_up_map);
+    hgr2->detached_nets = std::move(detached_nets);
+    hgr2->num_removed_nets = num_removed_nets;
+    return hgr2;
+}
+
+template auto large_net_cost(const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> part,
+                             size_t max_degree) -> int;
+template auto large_net_cost(const CsrNetlist& hyprgraph, std::span<const std::uint8_t> part,
+                             size_t max_degree) -> int;
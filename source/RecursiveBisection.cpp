@@ -0,0 +1,285 @@
+#include <algorithm>                      // for min
+#include <bit>                            // for bit_width
+#include <ckpttn/ConnectivityInfo.hpp>    // for ConnectivityInfo
+#include <ckpttn/FMConstrMgr.hpp>         // for LegalCheck
+#include <ckpttn/FMKWayConstrMgr.hpp>     // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>       // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>           // for FMPartMgr
+#include <ckpttn/MLPartMgr.hpp>           // for MLPartMgr
+#include <ckpttn/RecursiveBisection.hpp>  // for RecursiveBisection
+#include <ckpttn/TaskScheduler.hpp>       // for TaskScheduler, TaskGroup
+#include <cmath>                          // for pow
+#include <cstdint>                        // for uint8_t, uint32_t
+#include <memory>                         // for unique_ptr, shared_ptr, make_unique
+#include <span>                           // for span
+#include <type_traits>                    // for remove_cvref_t
+#include <utility>                        // for move
+#include <vector>                         // for vector
+
+/**
+ * @brief A block of the recursion: a sub-hypergraph to be split into some parts
+ *
+ * @tparam Gnl The hypergraph type
+ */
+template <typename Gnl> struct BisectionBlock {
+    /// @brief The extracted sub-hypergraph (null for the input hypergraph)
+    std::unique_ptr<Gnl> owned;
+    /// @brief The hypergraph of the block
+    const Gnl* hyprgraph;
+    /// @brief Module of the input hypergraph of each module of the block
+    std::vector<typename Gnl::node_t> modules;
+    /// @brief First part of the block
+    std::uint8_t first_part;
+    /// @brief Number of parts of the block
+    std::uint8_t num_parts;
+};
+
+/**
+ * @brief Returns the balance tolerance of one bisection.
+ *
+ * A block of weight `weight` must eventually give `num_parts` parts of at
+ * least `lowerbound` each. The ratio `num_parts * lowerbound / weight` is the
+ * fraction of a perfect split that every final part must keep; it is spread
+ * evenly over the ceil(log2(num_parts)) remaining levels. The constraint is
+ * symmetric, so it is set for the smaller side.
+ *
+ * @param[in] weight The weight of the block
+ * @param[in] lowerbound The lower bound of the weight of every final part
+ * @param[in] num_parts The number of parts of the block
+ * @return The balance tolerance for `FMBiConstrMgr`
+ */
+static auto bisection_bal_tol(unsigned int weight, unsigned int lowerbound, std::uint8_t num_parts)
+    -> double {
+    const auto num_levels = static_cast<double>(std::bit_width(num_parts - 1U));
+    const auto ratio = weight == 0U ? 0.0
+                                    : std::min(static_cast<double>(num_parts) * lowerbound / weight,
+                                               1.0);
+    const auto small_share = static_cast<double>(num_parts / 2U) / num_parts;
+    return small_share * std::pow(ratio, 1.0 / num_levels);
+}
+
+/**
+ * @brief Extracts one side of a bisection as a sub-hypergraph.
+ *
+ * Nets with less than 2 pins in the side are dropped; module weights and
+ * fixed modules are kept.
+ *
+ * @tparam Gnl The hypergraph type
+ * @param[in] hyprgraph The hypergraph of the bisected block
+ * @param[in] part The bisection
+ * @param[in] side The side to extract
+ * @param[out] module_map The module of `hyprgraph` of each extracted module
+ * @return The sub-hypergraph
+ */
+template <typename Gnl>
+static auto extract_side(const Gnl& hyprgraph, std::span<const std::uint8_t> part,
+                         std::uint8_t side, std::vector<typename Gnl::node_t>& module_map)
+    -> std::unique_ptr<Gnl> {
+    using node_t = typename Gnl::node_t;
+    using graph_t = std::remove_cvref_t<decltype(hyprgraph.gr)>;
+
+    const auto num_modules = static_cast<node_t>(hyprgraph.number_of_modules());
+    auto local_id = std::vector<node_t>(num_modules, 0U);
+    module_map.clear();
+    for (const auto& v : hyprgraph) {
+        if (part[v] == side) {
+            local_id[v] = static_cast<node_t>(module_map.size());
+            module_map.emplace_back(v);
+        }
+    }
+    const auto num_modules2 = static_cast<std::uint32_t>(module_map.size());
+
+    auto net_pins = std::vector<std::vector<node_t>>{};
+    auto pins = std::vector<node_t>{};
+    for (const auto& net : hyprgraph.nets) {
+        pins.clear();
+        for (const auto& v : hyprgraph.gr[net]) {
+            if (part[v] == side) {
+                pins.emplace_back(local_id[v]);
+            }
+        }
+        if (pins.size() >= 2) {
+            net_pins.emplace_back(pins);
+        }
+    }
+    const auto num_nets2 = static_cast<std::uint32_t>(net_pins.size());
+
+    auto gr2 = graph_t(num_modules2 + num_nets2);
+    for (auto i_net = 0U; i_net != num_nets2; ++i_net) {
+        for (const auto& v2 : net_pins[i_net]) {
+            gr2.add_edge(v2, num_modules2 + i_net);
+        }
+    }
+    auto hgr2 = std::make_unique<Gnl>(std::move(gr2), num_modules2, num_nets2);
+    hgr2->module_weight.reserve(num_modules2);
+    for (auto v2 = 0U; v2 != num_modules2; ++v2) {
+        const auto& v = module_map[v2];
+        hgr2->module_weight.emplace_back(hyprgraph.get_module_weight(v));
+        if (hyprgraph.module_fixed.contains(v)) {
+            hgr2->module_fixed.insert(v2);
+        }
+    }
+    hgr2->has_fixed_modules = !hgr2->module_fixed.empty();
+    return hgr2;
+}
+
+/**
+ * @brief Runs the recursive bisection.
+ *
+ * 1. Bisects the input hypergraph as the root task; for an odd number of
+ *    parts, the heavier side is given the extra part
+ * 2. Each task assigns the sides with one part, and spawns a task for every
+ *    side with more parts
+ * 3. Legalizes the K-way partition if needed and computes its cost
+ *
+ * @tparam Gnl The type of the hypergraph
+ * @tparam PartMgr The 2-way partition manager used at every level of `MLPartMgr`
+ * @param[in] hyprgraph The input hypergraph to partition
+ * @param[in,out] part The partition vector to store the partitioning results
+ * @return LegalCheck The legality check result of the final partition
+ */
+template <typename Gnl, typename PartMgr>
+auto RecursiveBisection::run_Partition(const Gnl& hyprgraph, std::span<std::uint8_t> part)
+    -> LegalCheck {
+    using node_t = typename Gnl::node_t;
+    using Block = BisectionBlock<Gnl>;
+
+    auto validator = FMKWayConstrMgr<Gnl>(hyprgraph, this->bal_tol, this->num_parts);
+    const auto lowerbound = validator.get_lowerbound();
+    const auto fixed_part = std::vector<std::uint8_t>(part.begin(), part.end());
+
+    auto own_scheduler = std::unique_ptr<TaskScheduler>{};
+    if (this->num_threads != 0U) {
+        own_scheduler = std::make_unique<TaskScheduler>(this->num_threads);
+        own_scheduler->set_deterministic(TaskScheduler::current().is_deterministic());
+    }
+    const auto scope = TaskScheduler::Scope(own_scheduler.get());
+    auto group = TaskGroup{};
+    auto bisect = [&](auto& self, const std::shared_ptr<Block>& block) -> void {
+        const auto& hgr = *block->hyprgraph;
+        const auto num_modules = hgr.number_of_modules();
+        const auto num_parts0 = static_cast<std::uint8_t>((block->num_parts + 1U) / 2U);
+        const auto middle = static_cast<std::uint8_t>(block->first_part + num_parts0);
+
+        auto sub_part = std::vector<std::uint8_t>(num_modules, 0U);
+        auto weight = 0U;
+        for (const auto& v : hgr) {
+            weight += hgr.get_module_weight(v);
+            sub_part[v] = hgr.module_fixed.contains(v)
+                              ? static_cast<std::uint8_t>(fixed_part[block->modules[v]] >= middle)
+                              : static_cast<std::uint8_t>(v % 2U);
+        }
+        if (num_modules >= 2U) {
+            MLPartMgr ml_mgr(bisection_bal_tol(weight, lowerbound, block->num_parts), 2);
+            ml_mgr.set_num_vcycles(this->num_vcycles);
+            ml_mgr.run_Partition<Gnl, PartMgr>(hgr, sub_part);
+        }
+        // The bisection constraint is symmetric, so for an odd number of
+        // parts side 0 (ceil(k/2) parts) may come out lighter than side 1
+        if (num_parts0 != block->num_parts / 2U && !hgr.has_fixed_modules) {
+            auto weight0 = 0U;
+            for (const auto& v : hgr) {
+                if (sub_part[v] == 0U) {
+                    weight0 += hgr.get_module_weight(v);
+                }
+            }
+            if (2U * weight0 < weight) {
+                for (auto& side : sub_part) {
+                    side ^= 1U;
+                }
+            }
+        }
+
+        for (auto side = std::uint8_t{0U}; side != 2U; ++side) {
+            const auto first_part = side == 0U ? block->first_part : middle;
+            const auto num_parts_side
+                = static_cast<std::uint8_t>(side == 0U ? num_parts0 : block->num_parts / 2U);
+            if (num_parts_side == 1U) {
+                for (const auto& v : hgr) {
+                    if (sub_part[v] == side) {
+                        part[block->modules[v]] = first_part;
+                    }
+                }
+                continue;
+            }
+            auto child = std::make_shared<Block>();
+            auto module_map = std::vector<node_t>{};
+            child->owned = extract_side(hgr, sub_part, side, module_map);
+            child->hyprgraph = child->owned.get();
+            child->modules.reserve(module_map.size());
+            for (const auto& v : module_map) {
+                child->modules.emplace_back(block->modules[v]);
+            }
+            child->first_part = first_part;
+            child->num_parts = num_parts_side;
+            group.run([&self, child]() { self(self, child); });
+        }
+    };
+
+    auto root = std::make_shared<Block>();
+    root->hyprgraph = &hyprgraph;
+    root->modules.reserve(hyprgraph.number_of_modules());
+    for (const auto& v : hyprgraph) {
+        root->modules.emplace_back(v);
+    }
+    root->first_part = 0U;
+    root->num_parts = this->num_parts;
+    group.run([&bisect, root]() { bisect(bisect, root); });
+    group.wait();
+
+    auto legalcheck = LegalCheck::AllSatisfied;
+    if (!validator.final_check(part)) {
+        using GainMgr = FMKWayGainMgr<Gnl>;
+        using ConstrMgr = FMKWayConstrMgr<Gnl>;
+        GainMgr gain_mgr(hyprgraph, this->num_parts);
+        ConstrMgr constr_mgr(hyprgraph, this->bal_tol, this->num_parts);
+        FMPartMgr<Gnl, GainMgr, ConstrMgr> part_mgr(hyprgraph, gain_mgr, constr_mgr,
+                                                     this->num_parts);
+        legalcheck = part_mgr.legalize(part);
+    }
+
+    auto conn = ConnectivityInfo<Gnl>(hyprgraph, this->num_parts);
+    conn.init(part, 1U);
+    this->total_cost = conn.cost();
+    return legalcheck;
+}
+
+#include <ckpttn/FMBiConstrMgr.hpp>        // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>          // for FMBiGainMgr
+#include <ckpttn/FlowPartMgr.hpp>          // for FlowPartMgr
+#include <ckpttn/LPPartMgr.hpp>            // for LPPartMgr
+#include <ckpttn/LocalFMPartMgr.hpp>       // for LocalFMPartMgr
+#include <ckpttn/MidLvlWindowPartMgr.hpp>  // for MidLvlWindowPartMgr
+#include <ckpttn/NNPartMgr.hpp>            // for NNPartMgr
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <xnetwork/classes/graph.hpp>
+
+template auto RecursiveBisection::run_Partition<
+    SimpleNetlist,
+    FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto RecursiveBisection::run_Partition<
+    SimpleNetlist,
+    NNPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto RecursiveBisection::run_Partition<
+    SimpleNetlist,
+    LPPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto RecursiveBisection::run_Partition<
+    SimpleNetlist,
+    LocalFMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto RecursiveBisection::run_Partition<
+    SimpleNetlist,
+    FlowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
+
+template auto RecursiveBisection::run_Partition<
+    SimpleNetlist,
+    MidLvlWindowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+    const SimpleNetlist& hyprgraph, std::span<std::uint8_t> part) -> LegalCheck;
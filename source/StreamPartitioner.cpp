@@ -0,0 +1,471 @@
+#include <algorithm>                     // for fill, min, max, min_element
+#include <ckpttn/StreamPartitioner.hpp>  // for partition_stream, StreamPartition
+#include <cmath>                         // for ceil, pow
+#include <cstdint>                       // for uint8_t, uint32_t
+#include <fstream>                       // for ifstream, ofstream
+#include <limits>                        // for numeric_limits
+#include <netlistx/readwrite.hpp>        // for InputFormat
+#include <span>                          // for span
+#include <stdexcept>                     // for runtime_error, invalid_argument
+#include <string>                        // for string, getline, to_string
+#include <unordered_map>                 // for unordered_map
+#include <utility>                       // for move
+#include <vector>                        // for vector
+
+#include "TextScan.hpp"  // for scan_uint, skip_blanks, ends_with
+
+/// @brief Width of the header of a partial netlist, rewritten at the end
+static constexpr size_t BLOCK_HEADER_WIDTH = 24U;
+
+/**
+ * @brief Online assignment of the modules of a stream of nets
+ */
+class StreamAssigner {
+  public:
+    /// @brief Marks a module that is not assigned yet
+    static constexpr std::uint8_t UNASSIGNED = std::numeric_limits<std::uint8_t>::max();
+
+    /**
+     * @brief Constructs a new StreamAssigner object.
+     *
+     * @param[in] num_modules The number of modules
+     * @param[in] num_nets The number of nets
+     * @param[in] one_based_ids Whether the ids may also be 1-based, in which
+     * case id `num_modules` is accepted too
+     * @param[in] options The options
+     */
+    StreamAssigner(std::uint32_t num_modules, std::uint32_t num_nets, bool one_based_ids,
+                   const StreamPartitionOptions& options)
+        : num_modules{num_modules},
+          num_parts{options.num_parts},
+          gamma{options.gamma},
+          part(size_t{num_modules} + (one_based_ids ? 1U : 0U), UNASSIGNED),
+          load(options.num_parts, 0U),
+          count(options.num_parts, 0U),
+          window(std::max(options.window, size_t{1U})),
+          block_pins(options.num_parts) {
+        const auto average = static_cast<double>(num_modules) / this->num_parts;
+        this->capacity
+            = static_cast<std::uint32_t>(std::ceil((1.0 + options.imbalance) * average));
+        if (num_modules != 0U) {
+            this->alpha = num_nets * std::pow(this->num_parts, this->gamma - 1.0)
+                          / std::pow(num_modules, this->gamma);
+        }
+        if (!options.block_prefix.empty()) {
+            this->local_id.assign(this->part.size(), 0U);
+            this->block_nets.assign(this->num_parts, 0U);
+            for (auto b = 0U; b != this->num_parts; ++b) {
+                const auto prefix = options.block_prefix + std::to_string(b);
+                this->hgr_files.emplace_back(prefix + ".hgr", std::ios::binary);
+                this->map_files.emplace_back(prefix + ".map", std::ios::binary);
+                this->map_names.push_back(prefix + ".map");
+                if (this->hgr_files.back().fail() || this->map_files.back().fail()) {
+                    throw std::runtime_error("Can't write " + prefix + ".hgr/.map");
+                }
+                this->hgr_files.back() << std::string(BLOCK_HEADER_WIDTH, ' ') << '\n';
+            }
+        }
+    }
+
+    /**
+     * @brief Adds a net to the window, and retires the oldest net of a full
+     * window.
+     *
+     * @param[in] pins The modules of the net
+     * @return false if a module id is out of range
+     */
+    auto add_net(std::span<const std::uint32_t> pins) -> bool {
+        for (const auto& v : pins) {
+            if (v >= this->part.size()) {
+                return false;
+            }
+            this->lowest = std::min(this->lowest, v);
+            this->highest = std::max(this->highest, v);
+        }
+        if (this->next_net - this->first_net == this->window.size()) {
+            this->retire_net();
+        }
+        auto& net = this->window[this->next_net % this->window.size()];
+        net.pins.assign(pins.begin(), pins.end());
+        net.count.assign(this->num_parts, 0U);
+        for (const auto& v : pins) {
+            if (this->part[v] != UNASSIGNED) {
+                ++net.count[this->part[v]];
+            } else {
+                this->pending[v].push_back(this->next_net);
+            }
+        }
+        ++this->next_net;
+        return true;
+    }
+
+    /**
+     * @brief Assigns the modules on no net and closes the partial netlists.
+     *
+     * @param[in] one_based Whether the module ids start at 1
+     * @return The partition
+     */
+    auto finish(bool one_based) -> StreamPartition {
+        while (this->first_net != this->next_net) {
+            this->retire_net();
+        }
+        const auto first = one_based ? 1U : 0U;
+        for (auto v = first; v != first + this->num_modules; ++v) {
+            if (this->part[v] == UNASSIGNED) {
+                const auto lightest = std::min_element(this->load.begin(), this->load.end());
+                this->assign(v, static_cast<std::uint8_t>(lightest - this->load.begin()));
+            }
+        }
+        for (auto b = 0U; b != this->hgr_files.size(); ++b) {
+            auto& file = this->hgr_files[b];
+            file.seekp(0);
+            const auto header = std::to_string(this->block_nets[b]) + ' '
+                                + std::to_string(this->load[b]);
+            file << header.substr(0, BLOCK_HEADER_WIDTH);
+            file.close();
+            this->map_files[b].close();
+            if (file.fail() || this->map_files[b].fail()) {
+                throw std::runtime_error("Can't write " + this->map_names[b]);
+            }
+            if (one_based) {
+                this->shift_map(this->map_names[b]);
+            }
+        }
+
+        auto result = StreamPartition{};
+        result.part.assign(this->part.begin() + first,
+                           this->part.begin() + first + this->num_modules);
+        result.block_size = std::move(this->load);
+        result.num_nets = this->num_nets;
+        result.cost = this->cost;
+        return result;
+    }
+
+    /// @brief The lowest module id seen
+    std::uint32_t lowest{std::numeric_limits<std::uint32_t>::max()};
+    /// @brief The highest module id seen
+    std::uint32_t highest{0U};
+
+  private:
+    /**
+     * @brief A net of the window
+     */
+    struct WindowNet {
+        /// @brief The modules of the net
+        std::vector<std::uint32_t> pins;
+        /// @brief The number of its modules assigned to each block
+        std::vector<std::uint32_t> count;
+    };
+
+    /**
+     * @brief Assigns the unassigned modules of the oldest net of the window
+     * and retires it.
+     *
+     * A module is scored by its pins in each block over all its nets in the
+     * window, not only the retired one.
+     */
+    void retire_net() {
+        auto& net = this->window[this->first_net % this->window.size()];
+        for (const auto& v : net.pins) {
+            if (this->part[v] != UNASSIGNED) {
+                continue;
+            }
+            const auto& nets = this->pending[v];
+            std::fill(this->count.begin(), this->count.end(), 0U);
+            for (const auto& seq : nets) {
+                const auto& other = this->window[seq % this->window.size()];
+                for (auto b = 0U; b != this->num_parts; ++b) {
+                    this->count[b] += other.count[b];
+                }
+            }
+            const auto b = this->best_block();
+            this->assign(v, b);
+            for (const auto& seq : nets) {
+                ++this->window[seq % this->window.size()].count[b];
+            }
+            this->pending.erase(v);
+        }
+
+        // all its modules are assigned: its cost is final
+        auto num_blocks = 0;
+        for (const auto& c : net.count) {
+            num_blocks += c != 0U ? 1 : 0;
+        }
+        this->cost += std::max(num_blocks, 1) - 1;
+        ++this->num_nets;
+        if (!this->hgr_files.empty()) {
+            this->write_net(net.pins);
+        }
+        ++this->first_net;
+    }
+
+    /**
+     * @brief Returns the block of a module.
+     *
+     * @return The block with the best score for the counts of `count`
+     * below its capacity (or the lightest block if all are full)
+     */
+    auto best_block() const -> std::uint8_t {
+        auto best = -1;
+        auto best_score = 0.0;
+        for (auto b = 0; b != this->num_parts; ++b) {
+            if (this->load[b] >= this->capacity) {
+                continue;
+            }
+            const auto score = this->count[b]
+                               - this->alpha * this->gamma
+                                     * std::pow(this->load[b], this->gamma - 1.0);
+            if (best < 0 || score > best_score
+                || (score == best_score && this->load[b] < this->load[best])) {
+                best = b;
+                best_score = score;
+            }
+        }
+        if (best < 0) {
+            const auto lightest = std::min_element(this->load.begin(), this->load.end());
+            return static_cast<std::uint8_t>(lightest - this->load.begin());
+        }
+        return static_cast<std::uint8_t>(best);
+    }
+
+    /**
+     * @brief Assigns a module to a block.
+     *
+     * @param[in] v The module
+     * @param[in] b The block
+     */
+    void assign(std::uint32_t v, std::uint8_t b) {
+        this->part[v] = b;
+        if (!this->map_files.empty()) {
+            this->local_id[v] = this->load[b];
+            this->map_files[b] << v << '\n';
+        }
+        ++this->load[b];
+    }
+
+    /**
+     * @brief Writes the pins of a net inside each block.
+     *
+     * @param[in] pins The modules of the net
+     */
+    void write_net(std::span<const std::uint32_t> pins) {
+        for (const auto& v : pins) {
+            this->block_pins[this->part[v]].push_back(this->local_id[v]);
+        }
+        for (auto b = 0U; b != this->num_parts; ++b) {
+            auto& local_pins = this->block_pins[b];
+            if (local_pins.size() >= 2U) {
+                auto& file = this->hgr_files[b];
+                for (auto i = 0U; i != local_pins.size(); ++i) {
+                    file << (i == 0U ? "" : " ") << local_pins[i];
+                }
+                file << '\n';
+                ++this->block_nets[b];
+            }
+            local_pins.clear();
+        }
+    }
+
+    /**
+     * @brief Rewrites a module map with 0-based module ids.
+     *
+     * @param[in] filename The file name of the map
+     */
+    static void shift_map(const std::string& filename) {
+        auto modules = std::vector<std::uint32_t>{};
+        {
+            auto input = std::ifstream{filename, std::ios::binary};
+            auto v = std::uint32_t{0U};
+            while (input >> v) {
+                modules.push_back(v - 1U);
+            }
+        }
+        auto output = std::ofstream{filename, std::ios::binary | std::ios::trunc};
+        for (const auto& v : modules) {
+            output << v << '\n';
+        }
+        if (output.fail()) {
+            throw std::runtime_error("Can't write " + filename);
+        }
+    }
+
+    std::uint32_t num_modules;
+    std::uint8_t num_parts;
+    double gamma;
+    double alpha{0.0};
+    std::uint32_t capacity{};
+    std::uint32_t num_nets{0U};
+    int cost{0};
+    std::vector<std::uint8_t> part;
+    std::vector<std::uint32_t> load;
+    std::vector<std::uint32_t> count;
+    // the window of nets, as a ring; `pending` lists the nets in the window
+    // of each module that is not assigned yet
+    std::vector<WindowNet> window;
+    size_t first_net{0U};
+    size_t next_net{0U};
+    std::unordered_map<std::uint32_t, std::vector<size_t>> pending;
+    // the partial netlists
+    std::vector<std::vector<std::uint32_t>> block_pins;
+    std::vector<std::uint32_t> local_id;
+    std::vector<std::uint32_t> block_nets;
+    std::vector<std::ofstream> hgr_files;
+    std::vector<std::ofstream> map_files;
+    std::vector<std::string> map_names;
+};
+
+/**
+ * @brief Partitions an hMetis file in a single pass.
+ *
+ * The net lines are read one at a time; the module weights that may follow
+ * them are not read.
+ *
+ * @param[in] input The file
+ * @param[in] filename The file name, for the error messages
+ * @param[in] options The options
+ * @return The partition
+ */
+static auto stream_hmetis(std::istream& input, const std::string& filename,
+                          const StreamPartitionOptions& options) -> StreamPartition {
+    auto line = std::string{};
+    auto header = std::vector<std::uint32_t>{};
+    while (header.empty() && std::getline(input, line)) {
+        const auto* cur = skip_blanks(line.data(), line.data() + line.size());
+        if (cur == line.data() + line.size() || *cur == '%') {
+            continue;
+        }
+        auto value = std::uint32_t{0U};
+        while (scan_uint(cur, line.data() + line.size(), value)) {
+            header.push_back(value);
+        }
+    }
+    if (header.size() < 2U) {
+        throw std::runtime_error("Missing hMetis header in " + filename);
+    }
+    const auto num_nets = header[0];
+    const auto num_modules = header[1];
+    const auto fmt = header.size() > 2U ? header[2] : 0U;
+    const auto skip = fmt % 10U == 1U ? size_t{1U} : size_t{0U};
+
+    auto assigner = StreamAssigner{num_modules, num_nets, true, options};
+    auto pins = std::vector<std::uint32_t>{};
+    for (auto net = 0U; net != num_nets && std::getline(input, line);) {
+        const auto* cur = skip_blanks(line.data(), line.data() + line.size());
+        if (cur == line.data() + line.size() || *cur == '%') {
+            continue;  // empty or comment line
+        }
+        pins.clear();
+        auto value = std::uint32_t{0U};
+        while (scan_uint(cur, line.data() + line.size(), value)) {
+            pins.push_back(value);
+        }
+        const auto first = std::min(skip, pins.size());
+        if (!assigner.add_net(std::span{pins}.subspan(first))) {
+            throw std::runtime_error("Module id out of range in " + filename);
+        }
+        ++net;
+    }
+
+    // 0-based, unless there is no module 0 and module `num_modules` occurs
+    const auto one_based = assigner.lowest >= 1U && assigner.highest == num_modules;
+    if (!one_based && assigner.highest == num_modules && num_modules != 0U) {
+        throw std::runtime_error("Module id out of range in " + filename);
+    }
+    return assigner.finish(one_based);
+}
+
+/**
+ * @brief Partitions a netD file in a single pass.
+ *
+ * @param[in] input The file
+ * @param[in] filename The file name, for the error messages
+ * @param[in] options The options
+ * @return The partition
+ */
+static auto stream_netd(std::istream& input, const std::string& filename,
+                        const StreamPartitionOptions& options) -> StreamPartition {
+    // Header: 0, num_pins, num_nets, num_modules, pad_offset
+    auto header = std::vector<std::uint32_t>(5U, 0U);
+    for (auto& value : header) {
+        if (!(input >> value)) {
+            throw std::runtime_error("Missing netD header in " + filename);
+        }
+    }
+    const auto num_nets = header[2];
+    const auto num_modules = header[3];
+    const auto pad_offset = header[4];
+
+    auto assigner = StreamAssigner{num_modules, num_nets, false, options};
+    auto line = std::string{};
+    auto pins = std::vector<std::uint32_t>{};
+    auto num_read = 0U;
+    auto in_net = false;
+    auto flush = [&]() {
+        if (!in_net) {
+            return;
+        }
+        if (++num_read > num_nets) {
+            throw std::runtime_error("More nets than declared in " + filename);
+        }
+        if (!assigner.add_net(pins)) {
+            throw std::runtime_error("Module id out of range in " + filename);
+        }
+        pins.clear();
+    };
+    while (std::getline(input, line)) {
+        const auto* last = line.data() + line.size();
+        const auto* cur = skip_blanks(line.data(), last);
+        if (cur == last) {
+            continue;
+        }
+        const auto is_pad = *cur == 'p';
+        auto v = std::uint32_t{0U};
+        if (!scan_uint(cur, last, v)) {
+            continue;
+        }
+        if (is_pad) {
+            v += pad_offset;
+        }
+        cur = skip_blanks(cur, last);
+        if (cur != last && *cur == 's') {
+            flush();  // the source of a new net
+            in_net = true;
+        }
+        if (in_net) {
+            pins.push_back(v);
+        }
+    }
+    flush();
+    return assigner.finish(false);
+}
+
+/**
+ * @brief Partitions a hypergraph file in a single pass.
+ *
+ * @param[in] filename The file name
+ * @param[in] input_format The format of the file
+ * @param[in] options The options
+ * @return The partition
+ */
+auto partition_stream(const std::string& filename, InputFormat input_format,
+                      const StreamPartitionOptions& options) -> StreamPartition {
+    if (options.num_parts < 2U || options.num_parts == StreamAssigner::UNASSIGNED) {
+        throw std::invalid_argument("The number of parts must be in 2 to 254");
+    }
+    if (input_format == InputFormat::auto_detect) {
+        if (ends_with(filename, ".hgr")) {
+            input_format = InputFormat::hmetis;
+        } else if (ends_with(filename, ".net") || ends_with(filename, ".netD")) {
+            input_format = InputFormat::netD;
+        }
+    }
+    if (input_format != InputFormat::hmetis && input_format != InputFormat::netD) {
+        throw std::invalid_argument("Only hMetis and netD files can be streamed");
+    }
+    auto input = std::ifstream{filename, std::ios::binary};
+    if (input.fail()) {
+        throw std::runtime_error("Can't open " + filename);
+    }
+    return input_format == InputFormat::hmetis ? stream_hmetis(input, filename, options)
+                                               : stream_netd(input, filename, options);
+}
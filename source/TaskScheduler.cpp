@@ -0,0 +1,251 @@
+#include <algorithm>                 // for max
+#include <ckpttn/TaskScheduler.hpp>  // for TaskScheduler, TaskGroup
+#include <cstddef>                   // for size_t
+#include <exception>                 // for current_exception, rethrow_exception
+#include <memory>                    // for make_unique, unique_ptr
+#include <mutex>                     // for lock_guard, unique_lock
+#include <thread>                    // for thread
+#include <utility>                   // for move, swap
+
+/// @brief Scheduler of the worker running on this thread (if any)
+static thread_local TaskScheduler* worker_scheduler = nullptr;
+/// @brief Index of the worker running on this thread
+static thread_local size_t worker_index_tls = 0U;
+/// @brief Scheduler installed by a TaskScheduler::Scope on this thread (if any)
+static thread_local TaskScheduler* scoped_scheduler = nullptr;
+
+/// @brief Number of threads of the process-wide scheduler (0 = hardware concurrency)
+static size_t global_num_threads = 0U;
+/// @brief Protects the creation of the process-wide scheduler
+static std::mutex global_mutex;
+/// @brief The process-wide scheduler
+static std::unique_ptr<TaskScheduler> global_scheduler;
+
+/**
+ * @brief Constructs a new TaskScheduler object.
+ *
+ * @param[in] num_threads The number of threads, including the waiting thread
+ * (0 = hardware concurrency)
+ */
+TaskScheduler::TaskScheduler(size_t num_threads) {
+    if (num_threads == 0U) {
+        num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    for (auto index = size_t{0U}; index != num_threads; ++index) {
+        this->workers.emplace_back(std::make_unique<Worker>());
+    }
+    for (auto index = size_t{1U}; index != num_threads; ++index) {
+        this->threads.emplace_back([this, index]() { this->worker_loop(index); });
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+    }
+    this->cond.notify_all();
+    for (auto& thread : this->threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Returns the process-wide scheduler.
+ *
+ * @return TaskScheduler& The process-wide scheduler
+ */
+auto TaskScheduler::global() -> TaskScheduler& {
+    std::lock_guard<std::mutex> lock(global_mutex);
+    if (!global_scheduler) {
+        global_scheduler = std::make_unique<TaskScheduler>(global_num_threads);
+    }
+    return *global_scheduler;
+}
+
+/**
+ * @brief Sets the number of threads of the process-wide scheduler.
+ *
+ * @param[in] num_threads The number of threads (0 = hardware concurrency)
+ */
+void TaskScheduler::set_global_num_threads(size_t num_threads) {
+    std::lock_guard<std::mutex> lock(global_mutex);
+    global_num_threads = num_threads;
+    global_scheduler.reset();
+}
+
+/**
+ * @brief Returns the scheduler that parallel code should run on.
+ *
+ * @return TaskScheduler& The scheduler
+ */
+auto TaskScheduler::current() -> TaskScheduler& {
+    if (scoped_scheduler != nullptr) {
+        return *scoped_scheduler;
+    }
+    if (worker_scheduler != nullptr) {
+        return *worker_scheduler;
+    }
+    return TaskScheduler::global();
+}
+
+/**
+ * @brief Queues a task.
+ *
+ * @param[in] task The task
+ */
+void TaskScheduler::spawn(Task task) {
+    const auto index = this->worker_index();
+    {
+        // counted before it is queued, so that num_queued never falls below the real count
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->num_queued.fetch_add(1U);
+        auto& worker = *this->workers[index];
+        std::lock_guard<std::mutex> lock_worker(worker.mutex);
+        worker.tasks.emplace_back(std::move(task));
+    }
+    this->cond.notify_all();
+}
+
+/**
+ * @brief Takes a task from the own deque, or steals one.
+ *
+ * @param[in] index The index of the worker
+ * @param[out] task The task
+ * @return true if a task was taken
+ */
+auto TaskScheduler::take(size_t index, Task& task) -> bool {
+    {
+        auto& worker = *this->workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.tasks.empty()) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            this->num_queued.fetch_sub(1U);
+            return true;
+        }
+    }
+    const auto num_workers = this->workers.size();
+    for (auto offset = size_t{1U}; offset != num_workers; ++offset) {
+        auto& victim = *this->workers[(index + offset) % num_workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            this->num_queued.fetch_sub(1U);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Returns the index of the calling thread as a worker.
+ *
+ * @return size_t The index (0 for the threads outside the scheduler)
+ */
+auto TaskScheduler::worker_index() const -> size_t {
+    return worker_scheduler == this ? worker_index_tls : size_t{0U};
+}
+
+/**
+ * @brief Main loop of a background thread.
+ *
+ * @param[in] index The index of the worker
+ */
+void TaskScheduler::worker_loop(size_t index) {
+    worker_scheduler = this;
+    worker_index_tls = index;
+    auto task = Task{};
+    while (true) {
+        if (this->take(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->cond.wait(lock, [this]() { return this->stop || this->num_queued != 0U; });
+        if (this->stop && this->num_queued == 0U) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Installs a scheduler.
+ *
+ * @param[in] scheduler The scheduler (may be null)
+ */
+TaskScheduler::Scope::Scope(TaskScheduler* scheduler) : saved{scoped_scheduler} {
+    if (scheduler != nullptr) {
+        scoped_scheduler = scheduler;
+    }
+}
+
+TaskScheduler::Scope::~Scope() { scoped_scheduler = this->saved; }
+
+TaskGroup::~TaskGroup() { this->help(); }
+
+/**
+ * @brief Spawns a task of the group.
+ *
+ * @param[in] task The task
+ */
+void TaskGroup::run(TaskScheduler::Task task) {
+    this->num_pending.fetch_add(1U);
+    this->scheduler.spawn([this, task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(this->error_mutex);
+            if (!this->error) {
+                this->error = std::current_exception();
+            }
+        }
+        auto& scheduler = this->scheduler;
+        auto is_last = false;
+        {
+            // under the lock, so that a waiting thread cannot miss the notification
+            std::lock_guard<std::mutex> lock(scheduler.mutex);
+            is_last = this->num_pending.fetch_sub(1U) == 1U;
+        }
+        if (is_last) {
+            scheduler.cond.notify_all();
+        }
+    });
+}
+
+/**
+ * @brief Runs tasks until all tasks of the group are finished.
+ */
+void TaskGroup::wait() {
+    this->help();
+    auto first_error = std::exception_ptr{};
+    {
+        std::lock_guard<std::mutex> lock(this->error_mutex);
+        std::swap(first_error, this->error);
+    }
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
+
+/**
+ * @brief Runs queued tasks until all tasks of the group are finished.
+ */
+void TaskGroup::help() {
+    auto& scheduler = this->scheduler;
+    const auto index = scheduler.worker_index();
+    auto task = TaskScheduler::Task{};
+    while (this->num_pending != 0U) {
+        if (scheduler.take(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(scheduler.mutex);
+        scheduler.cond.wait(lock, [this, &scheduler]() {
+            return this->num_pending == 0U || scheduler.num_queued != 0U;
+        });
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file TextScan.hpp
+ * @brief Scanning helpers shared by the hypergraph readers (internal)
+ */
+
+#pragma once
+
+#include <cstdint>      // for uint32_t
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+/**
+ * @brief Returns whether a character is a decimal digit.
+ *
+ * @param[in] c The character
+ * @return true if `c` is in `0` to `9`
+ */
+inline auto is_digit(char c) -> bool { return static_cast<unsigned char>(c - '0') <= 9U; }
+
+/**
+ * @brief Scans the next unsigned integer of `[cur, last)`.
+ *
+ * Skips the characters up to the next digit, then accumulates the digits;
+ * both loops are branch-light, so a chunk is scanned at close to memory
+ * speed.
+ *
+ * @param[in,out] cur The position, moved past the integer
+ * @param[in] last The end of the text
+ * @param[out] value The integer
+ * @return false if there is no more integer
+ */
+inline auto scan_uint(const char*& cur, const char* last, std::uint32_t& value) -> bool {
+    while (cur != last && !is_digit(*cur)) {
+        ++cur;
+    }
+    if (cur == last) {
+        return false;
+    }
+    auto result = std::uint32_t{0U};
+    for (; cur != last && is_digit(*cur); ++cur) {
+        result = result * 10U + static_cast<std::uint32_t>(*cur - '0');
+    }
+    value = result;
+    return true;
+}
+
+/**
+ * @brief Skips spaces, tabs and carriage returns.
+ *
+ * @param[in] cur The position
+ * @param[in] last The end of the line
+ * @return The first other position
+ */
+inline auto skip_blanks(const char* cur, const char* last) -> const char* {
+    while (cur != last && (*cur == ' ' || *cur == '\t' || *cur == '\r')) {
+        ++cur;
+    }
+    return cur;
+}
+
+/**
+ * @brief Returns whether a file name ends with a suffix.
+ *
+ * @param[in] filename The file name
+ * @param[in] suffix The suffix
+ * @return true if `filename` ends with `suffix`
+ */
+inline auto ends_with(const std::string& filename, std::string_view suffix) -> bool {
+    return filename.size() >= suffix.size()
+           && std::string_view{filename}.substr(filename.size() - suffix.size()) == suffix;
+}
@@ -0,0 +1,744 @@
+#include <algorithm>                     // for sort, unique, find_if, min
+#include <ckpttn/YosysStreamReader.hpp>  // for read_yosys_json_stream
+#include <cstdint>                       // for uint32_t, int64_t
+#include <fstream>                       // for ifstream
+#include <istream>                       // for istream
+#include <netlistx/netlist.hpp>          // for SimpleNetlist, graph_t
+#include <stdexcept>                     // for runtime_error
+#include <string>                        // for string
+#include <unordered_map>                 // for unordered_map
+#include <utility>                       // for move, pair
+#include <vector>                        // for vector
+#include <xnetwork/classes/graph.hpp>    // for SimpleGraph
+
+/// @brief Size of the read buffer of the JSON parser
+static constexpr size_t JSON_BUFFER_SIZE = size_t{1U} << 16U;
+
+/**
+ * @brief A pull parser of JSON text read through a fixed-size buffer
+ *
+ * The caller walks the document with `member` and `element` and either
+ * reads a value or skips it; nothing is kept beyond the current token.
+ */
+class JsonPullParser {
+  public:
+    /**
+     * @brief Constructs a new JsonPullParser object
+     *
+     * @param[in,out] input The input stream
+     */
+    explicit JsonPullParser(std::istream& input) : input{input}, buffer(JSON_BUFFER_SIZE) {}
+
+    /**
+     * @brief Returns the next non-blank character without consuming it.
+     *
+     * @return The character, or `'\0'` at the end of the input
+     */
+    auto peek() -> char {
+        while (true) {
+            if (this->pos == this->size && !this->_fill()) {
+                return '\0';
+            }
+            const auto c = this->buffer[this->pos];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                return c;
+            }
+            ++this->pos;
+        }
+    }
+
+    /**
+     * @brief Consumes the next non-blank character, which must be `c`.
+     *
+     * @param[in] c The expected character
+     */
+    void expect(char c) {
+        if (this->peek() != c) {
+            throw std::runtime_error(std::string("Malformed JSON: expected '") + c + "'");
+        }
+        ++this->pos;
+    }
+
+    /**
+     * @brief Advances to the next member of an object.
+     *
+     * Call after `expect('{')` with `first` set to true.
+     *
+     * @param[out] key The key of the member
+     * @param[in,out] first Whether no member was read yet
+     * @return false at the end of the object
+     */
+    auto member(std::string& key, bool& first) -> bool {
+        if (this->peek() == '}') {
+            ++this->pos;
+            return false;
+        }
+        if (!first) {
+            this->expect(',');
+        }
+        first = false;
+        this->read_string(key);
+        this->expect(':');
+        return true;
+    }
+
+    /**
+     * @brief Advances to the next element of an array.
+     *
+     * Call after `expect('[')` with `first` set to true.
+     *
+     * @param[in,out] first Whether no element was read yet
+     * @return false at the end of the array
+     */
+    auto element(bool& first) -> bool {
+        if (this->peek() == ']') {
+            ++this->pos;
+            return false;
+        }
+        if (!first) {
+            this->expect(',');
+        }
+        first = false;
+        return true;
+    }
+
+    /**
+     * @brief Reads a string (escapes are decoded, except `\u`).
+     *
+     * @param[out] value The string
+     */
+    void read_string(std::string& value) {
+        this->expect('"');
+        value.clear();
+        while (true) {
+            auto c = this->_get();
+            if (c == '"') {
+                return;
+            }
+            if (c == '\\') {
+                c = this->_get();
+                if (c == 'u') {
+                    for (auto i = 0; i != 4; ++i) {
+                        this->_get();
+                    }
+                    c = '?';
+                }
+            }
+            value.push_back(c);
+        }
+    }
+
+    /**
+     * @brief Reads a non-negative integer, or a string.
+     *
+     * @param[out] is_number Whether the value is a number
+     * @return The number (0 for a string)
+     */
+    auto read_bit(bool& is_number) -> std::int64_t {
+        if (this->peek() == '"') {
+            this->read_string(this->scratch);
+            is_number = false;
+            return 0;
+        }
+        is_number = true;
+        auto value = std::int64_t{0};
+        while (true) {
+            if (this->pos == this->size && !this->_fill()) {
+                return value;
+            }
+            const auto c = this->buffer[this->pos];
+            if (c < '0' || c > '9') {
+                return value;
+            }
+            value = value * 10 + (c - '0');
+            ++this->pos;
+        }
+    }
+
+    /**
+     * @brief Skips a value of any type, including nested objects and arrays.
+     */
+    void skip_value() {
+        auto depth = 0;
+        do {
+            const auto c = this->peek();
+            if (c == '"') {
+                this->read_string(this->scratch);
+            } else if (c == '{' || c == '[') {
+                ++this->pos;
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                ++this->pos;
+                --depth;
+            } else if (c == ',' || c == ':') {
+                ++this->pos;
+            } else if (c == '\0') {
+                throw std::runtime_error("Malformed JSON: unexpected end");
+            } else {
+                // number, true, false or null
+                while (this->pos != this->size || this->_fill()) {
+                    const auto d = this->buffer[this->pos];
+                    if (d == ',' || d == '}' || d == ']' || d == ' ' || d == '\n' || d == '\r'
+                        || d == '\t') {
+                        break;
+                    }
+                    ++this->pos;
+                }
+            }
+        } while (depth > 0);
+    }
+
+  private:
+    std::istream& input;
+    std::vector<char> buffer;
+    size_t pos{};
+    size_t size{};
+    /// @brief Storage for the strings that are skipped
+    std::string scratch;
+
+    auto _fill() -> bool {
+        this->input.read(this->buffer.data(), static_cast<std::streamsize>(this->buffer.size()));
+        this->size = static_cast<size_t>(this->input.gcount());
+        this->pos = 0U;
+        return this->size != 0U;
+    }
+
+    auto _get() -> char {
+        if (this->pos == this->size && !this->_fill()) {
+            throw std::runtime_error("Malformed JSON: unexpected end");
+        }
+        return this->buffer[this->pos++];
+    }
+};
+
+/// @brief Marks the node of a pin as a port (pad) rather than a cell
+static constexpr std::uint32_t PORT_FLAG = std::uint32_t{1U} << 31U;
+
+/**
+ * @brief A pin: a bit id and the cell or port that uses it
+ */
+struct YosysPin {
+    std::uint32_t bit;
+    /// @brief The cell index, or the port index with `PORT_FLAG`
+    std::uint32_t node;
+};
+
+/**
+ * @brief Reads the bits of an array and appends a pin for each bit id.
+ *
+ * @param[in,out] parser The parser, before the array
+ * @param[in] node The cell or port
+ * @param[in,out] pins The pins
+ */
+static void read_bits(JsonPullParser& parser, std::uint32_t node, std::vector<YosysPin>& pins) {
+    parser.expect('[');
+    auto first = true;
+    while (parser.element(first)) {
+        auto is_number = false;
+        const auto bit = parser.read_bit(is_number);
+        if (is_number) {
+            pins.push_back({static_cast<std::uint32_t>(bit), node});
+        }
+    }
+}
+
+/**
+ * @brief Reads the ports of a module.
+ *
+ * @param[in,out] parser The parser, before the object of the ports
+ * @param[in,out] pins The pins
+ * @return The number of ports
+ */
+static auto read_ports(JsonPullParser& parser, std::vector<YosysPin>& pins) -> std::uint32_t {
+    auto num_ports = std::uint32_t{0U};
+    auto name = std::string{};
+    auto key = std::string{};
+    parser.expect('{');
+    auto first = true;
+    while (parser.member(name, first)) {
+        const auto node = num_ports++ | PORT_FLAG;
+        parser.expect('{');
+        auto first_field = true;
+        while (parser.member(key, first_field)) {
+            if (key == "bits") {
+                read_bits(parser, node, pins);
+            } else {
+                parser.skip_value();
+            }
+        }
+    }
+    return num_ports;
+}
+
+/**
+ * @brief Reads the cells of a module.
+ *
+ * @param[in,out] parser The parser, before the object of the cells
+ * @param[in,out] pins The pins
+ * @return The number of cells
+ */
+static auto read_cells(JsonPullParser& parser, std::vector<YosysPin>& pins) -> std::uint32_t {
+    auto num_cells = std::uint32_t{0U};
+    auto name = std::string{};
+    auto key = std::string{};
+    parser.expect('{');
+    auto first = true;
+    while (parser.member(name, first)) {
+        const auto node = num_cells++;
+        parser.expect('{');
+        auto first_field = true;
+        while (parser.member(key, first_field)) {
+            if (key != "connections") {
+                parser.skip_value();
+                continue;
+            }
+            parser.expect('{');
+            auto first_port = true;
+            while (parser.member(name, first_port)) {
+                read_bits(parser, node, pins);
+            }
+        }
+    }
+    return num_cells;
+}
+
+
+/**
+ * @brief Builds the netlist of a list of pins.
+ *
+ * Sorts the pins by bit id; each distinct bit id becomes a net, in
+ * increasing order, and the repeated pins of a node are merged. The cells
+ * come first and the ports are the pads.
+ *
+ * @param[in,out] pins The pins, released on return
+ * @param[in] num_cells The number of cells
+ * @param[in] num_ports The number of ports
+ * @return The netlist
+ */
+static auto build_netlist(std::vector<YosysPin>& pins, std::uint32_t num_cells,
+                          std::uint32_t num_ports) -> SimpleNetlist {
+    auto node_id = [&](std::uint32_t node) {
+        return (node & PORT_FLAG) != 0U ? num_cells + (node & ~PORT_FLAG) : node;
+    };
+    std::sort(pins.begin(), pins.end(), [&](const YosysPin& lhs, const YosysPin& rhs) {
+        return lhs.bit != rhs.bit ? lhs.bit < rhs.bit : node_id(lhs.node) < node_id(rhs.node);
+    });
+    pins.erase(std::unique(pins.begin(), pins.end(),
+                           [](const YosysPin& lhs, const YosysPin& rhs) {
+                               return lhs.bit == rhs.bit && lhs.node == rhs.node;
+                           }),
+               pins.end());
+    auto num_nets = std::uint32_t{0U};
+    for (auto i = size_t{0U}; i != pins.size(); ++i) {
+        if (i == 0U || pins[i].bit != pins[i - 1U].bit) {
+            ++num_nets;
+        }
+    }
+
+    const auto num_modules = num_cells + num_ports;
+    auto gr = graph_t(num_modules + num_nets);
+    auto net = num_modules - 1U;
+    for (auto i = size_t{0U}; i != pins.size(); ++i) {
+        if (i == 0U || pins[i].bit != pins[i - 1U].bit) {
+            ++net;
+        }
+        gr.add_edge(node_id(pins[i].node), net);
+    }
+    pins = std::vector<YosysPin>{};
+    auto hyprgraph = SimpleNetlist(std::move(gr), num_modules, num_nets);
+    hyprgraph.num_pads = num_ports;
+    return hyprgraph;
+}
+
+/**
+ * @brief Reads a Yosys JSON netlist without materializing the document.
+ *
+ * 1. Streams the first module and collects one (bit, node) pair per pin
+ * 2. Builds the netlist (see `build_netlist`)
+ *
+ * @param[in] filename The file name
+ * @return The netlist
+ */
+auto read_yosys_json_stream(const std::string& filename) -> SimpleNetlist {
+    auto input = std::ifstream{filename, std::ios::binary};
+    if (input.fail()) {
+        throw std::runtime_error("Can't open " + filename);
+    }
+    auto parser = JsonPullParser{input};
+
+    // 1. Pins of the first module
+    auto pins = std::vector<YosysPin>{};
+    auto num_cells = std::uint32_t{0U};
+    auto num_ports = std::uint32_t{0U};
+    auto found = false;
+    auto key = std::string{};
+    parser.expect('{');
+    auto first = true;
+    while (parser.member(key, first)) {
+        if (key != "modules") {
+            parser.skip_value();
+            continue;
+        }
+        parser.expect('{');
+        auto first_module = true;
+        while (parser.member(key, first_module)) {
+            if (found) {
+                parser.skip_value();
+                continue;
+            }
+            found = true;
+            parser.expect('{');
+            auto first_field = true;
+            while (parser.member(key, first_field)) {
+                if (key == "ports") {
+                    num_ports = read_ports(parser, pins);
+                } else if (key == "cells") {
+                    num_cells = read_cells(parser, pins);
+                } else {
+                    parser.skip_value();
+                }
+            }
+        }
+    }
+    if (!found) {
+        throw std::runtime_error("No module in " + filename);
+    }
+
+    // 2. Netlist
+    return build_netlist(pins, num_cells, num_ports);
+}
+
+/// @brief A constant bit (`"0"`, `"1"`, `"x"` or `"z"`), or no net
+static constexpr std::int64_t CONSTANT_BIT = -1;
+
+/// @brief The named bits of a port or of a connection
+using YosysBits = std::pair<std::string, std::vector<std::int64_t>>;
+
+/**
+ * @brief A cell of a module definition
+ */
+struct YosysCellDef {
+    std::string type;
+    std::vector<YosysBits> connections;
+};
+
+/**
+ * @brief A module definition, reduced to its ports and cells
+ */
+struct YosysModuleDef {
+    std::string name;
+    bool is_top{false};
+    bool is_blackbox{false};
+    std::vector<YosysBits> ports;
+    std::vector<YosysCellDef> cells;
+};
+
+/**
+ * @brief Reads an array of bits; the constant bits become `CONSTANT_BIT`.
+ *
+ * @param[in,out] parser The parser, before the array
+ * @return The bits
+ */
+static auto read_bit_list(JsonPullParser& parser) -> std::vector<std::int64_t> {
+    auto bits = std::vector<std::int64_t>{};
+    parser.expect('[');
+    auto first = true;
+    while (parser.element(first)) {
+        auto is_number = false;
+        const auto bit = parser.read_bit(is_number);
+        bits.push_back(is_number ? bit : CONSTANT_BIT);
+    }
+    return bits;
+}
+
+/**
+ * @brief Reads a boolean attribute, written as a number or as a bit string.
+ *
+ * @param[in,out] parser The parser, before the value
+ * @return Whether the value is non-zero
+ */
+static auto read_flag(JsonPullParser& parser) -> bool {
+    const auto c = parser.peek();
+    if (c == '"') {
+        auto value = std::string{};
+        parser.read_string(value);
+        return value.find('1') != std::string::npos;
+    }
+    if (c >= '0' && c <= '9') {
+        auto is_number = false;
+        return parser.read_bit(is_number) != 0;
+    }
+    parser.skip_value();
+    return false;
+}
+
+/**
+ * @brief Reads the cells of a module definition.
+ *
+ * @param[in,out] parser The parser, before the object of the cells
+ * @param[in,out] def The module definition
+ */
+static void read_cell_defs(JsonPullParser& parser, YosysModuleDef& def) {
+    auto name = std::string{};
+    auto key = std::string{};
+    parser.expect('{');
+    auto first = true;
+    while (parser.member(name, first)) {
+        auto& cell = def.cells.emplace_back();
+        parser.expect('{');
+        auto first_field = true;
+        while (parser.member(key, first_field)) {
+            if (key == "type") {
+                parser.read_string(cell.type);
+            } else if (key == "connections") {
+                parser.expect('{');
+                auto first_port = true;
+                while (parser.member(name, first_port)) {
+                    cell.connections.emplace_back(name, read_bit_list(parser));
+                }
+            } else {
+                parser.skip_value();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reads a module definition.
+ *
+ * @param[in,out] parser The parser, before the object of the module
+ * @param[in] name The name of the module
+ * @return The module definition
+ */
+static auto read_module_def(JsonPullParser& parser, std::string name) -> YosysModuleDef {
+    auto def = YosysModuleDef{};
+    def.name = std::move(name);
+    auto key = std::string{};
+    auto item = std::string{};
+    parser.expect('{');
+    auto first = true;
+    while (parser.member(key, first)) {
+        if (key == "attributes") {
+            parser.expect('{');
+            auto first_attr = true;
+            while (parser.member(item, first_attr)) {
+                if (item == "top") {
+                    def.is_top = read_flag(parser);
+                } else if (item == "blackbox") {
+                    def.is_blackbox = read_flag(parser);
+                } else {
+                    parser.skip_value();
+                }
+            }
+        } else if (key == "ports") {
+            parser.expect('{');
+            auto first_port = true;
+            while (parser.member(item, first_port)) {
+                auto& port = def.ports.emplace_back(item, std::vector<std::int64_t>{});
+                parser.expect('{');
+                auto first_field = true;
+                while (parser.member(key, first_field)) {
+                    if (key == "bits") {
+                        port.second = read_bit_list(parser);
+                    } else {
+                        parser.skip_value();
+                    }
+                }
+            }
+        } else if (key == "cells") {
+            read_cell_defs(parser, def);
+        } else {
+            parser.skip_value();
+        }
+    }
+    return def;
+}
+
+/**
+ * @brief The state of the flattening of a design
+ *
+ * The global nets are numbered as they are met. A net of an instance that
+ * is tied to two nets of its parent (e.g. a feed-through `assign y = a`)
+ * merges them, with a union-find.
+ */
+struct YosysFlattener {
+    const std::vector<YosysModuleDef>& defs;
+    /// @brief The index of each module definition that is expanded
+    std::unordered_map<std::string, std::uint32_t> def_index;
+    /// @brief The union-find forest of the global nets
+    std::vector<std::uint32_t> net_parent;
+    std::vector<YosysPin> pins;
+    /// @brief The instance of each cell
+    std::vector<std::uint32_t> instance;
+    std::uint32_t num_instances{0U};
+    /// @brief Whether each module definition is being expanded
+    std::vector<std::uint8_t> on_stack;
+
+    /**
+     * @brief Returns the representative of a global net.
+     *
+     * @param[in] net The global net
+     * @return The representative
+     */
+    auto find(std::uint32_t net) -> std::uint32_t {
+        while (this->net_parent[net] != net) {
+            this->net_parent[net] = this->net_parent[this->net_parent[net]];
+            net = this->net_parent[net];
+        }
+        return net;
+    }
+
+    /**
+     * @brief Returns the global net of a local bit, allocating it if needed.
+     *
+     * @param[in,out] bit_map The global net of each local bit of the module
+     * @param[in] bit The local bit
+     * @return The global net, or `CONSTANT_BIT` for a constant bit
+     */
+    auto global_net(std::unordered_map<std::int64_t, std::uint32_t>& bit_map, std::int64_t bit)
+        -> std::int64_t {
+        if (bit == CONSTANT_BIT) {
+            return CONSTANT_BIT;
+        }
+        const auto [it, inserted]
+            = bit_map.emplace(bit, static_cast<std::uint32_t>(this->net_parent.size()));
+        if (inserted) {
+            this->net_parent.push_back(it->second);
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Expands a module definition into cells, recursively.
+     *
+     * @param[in] def The module definition
+     * @param[in,out] bit_map The global net of each local bit of the module
+     * @param[in] inst The instance of the cells of the module (`CONSTANT_BIT`
+     * = a new instance per cell, for the top module)
+     */
+    void expand(std::uint32_t def, std::unordered_map<std::int64_t, std::uint32_t>& bit_map,
+                std::int64_t inst) {
+        if (this->on_stack[def] != 0U) {
+            throw std::runtime_error("Recursive instantiation of " + this->defs[def].name);
+        }
+        this->on_stack[def] = 1U;
+        for (const auto& cell : this->defs[def].cells) {
+            const auto it = this->def_index.find(cell.type);
+            if (it == this->def_index.end()) {
+                const auto node = static_cast<std::uint32_t>(this->instance.size());
+                this->instance.push_back(inst == CONSTANT_BIT ? this->num_instances++
+                                                              : static_cast<std::uint32_t>(inst));
+                for (const auto& [port, bits] : cell.connections) {
+                    for (const auto& bit : bits) {
+                        const auto net = this->global_net(bit_map, bit);
+                        if (net != CONSTANT_BIT) {
+                            this->pins.push_back({static_cast<std::uint32_t>(net), node});
+                        }
+                    }
+                }
+                continue;
+            }
+            // an instance: the bits of its ports are the nets of the connections
+            const auto& sub_def = this->defs[it->second];
+            auto sub_map = std::unordered_map<std::int64_t, std::uint32_t>{};
+            for (const auto& [port, sub_bits] : sub_def.ports) {
+                const auto conn
+                    = std::find_if(cell.connections.begin(), cell.connections.end(),
+                                   [&](const YosysBits& bits) { return bits.first == port; });
+                if (conn == cell.connections.end()) {
+                    continue;
+                }
+                const auto size = std::min(sub_bits.size(), conn->second.size());
+                for (auto i = size_t{0U}; i != size; ++i) {
+                    const auto net = this->global_net(bit_map, conn->second[i]);
+                    if (net == CONSTANT_BIT || sub_bits[i] == CONSTANT_BIT) {
+                        continue;
+                    }
+                    const auto [sub_it, inserted]
+                        = sub_map.emplace(sub_bits[i], static_cast<std::uint32_t>(net));
+                    if (!inserted) {
+                        this->net_parent[this->find(static_cast<std::uint32_t>(net))]
+                            = this->find(sub_it->second);
+                    }
+                }
+            }
+            this->expand(it->second, sub_map, this->num_instances++);
+        }
+        this->on_stack[def] = 0U;
+    }
+};
+
+/**
+ * @brief Reads a hierarchical Yosys JSON netlist and flattens it.
+ *
+ * 1. Streams all the module definitions, keeping their ports and the types
+ *    and connections of their cells only
+ * 2. Expands the top module recursively
+ * 3. Builds the netlist (see `build_netlist`)
+ *
+ * @param[in] filename The file name
+ * @param[out] instance The instance of each module of the netlist
+ * @return The netlist
+ */
+auto read_yosys_json_hier(const std::string& filename, std::vector<std::uint32_t>& instance)
+    -> SimpleNetlist {
+    auto input = std::ifstream{filename, std::ios::binary};
+    if (input.fail()) {
+        throw std::runtime_error("Can't open " + filename);
+    }
+    auto parser = JsonPullParser{input};
+
+    // 1. Module definitions
+    auto defs = std::vector<YosysModuleDef>{};
+    auto key = std::string{};
+    parser.expect('{');
+    auto first = true;
+    while (parser.member(key, first)) {
+        if (key != "modules") {
+            parser.skip_value();
+            continue;
+        }
+        parser.expect('{');
+        auto first_module = true;
+        while (parser.member(key, first_module)) {
+            defs.push_back(read_module_def(parser, key));
+        }
+    }
+    if (defs.empty()) {
+        throw std::runtime_error("No module in " + filename);
+    }
+
+    // 2. Flattening
+    auto flattener = YosysFlattener{defs, {}, {}, {}, {}, 0U, {}};
+    auto top = std::uint32_t{0U};
+    for (auto i = 0U; i != defs.size(); ++i) {
+        if (!defs[i].is_blackbox) {
+            flattener.def_index.emplace(defs[i].name, i);
+        }
+        if (defs[i].is_top) {
+            top = i;
+        }
+    }
+    flattener.on_stack.assign(defs.size(), 0U);
+    auto top_map = std::unordered_map<std::int64_t, std::uint32_t>{};
+    flattener.expand(top, top_map, CONSTANT_BIT);
+    const auto num_cells = static_cast<std::uint32_t>(flattener.instance.size());
+    auto num_ports = std::uint32_t{0U};
+    for (const auto& [port, bits] : defs[top].ports) {
+        const auto node = num_ports++ | PORT_FLAG;
+        for (const auto& bit : bits) {
+            const auto net = flattener.global_net(top_map, bit);
+            if (net != CONSTANT_BIT) {
+                flattener.pins.push_back({static_cast<std::uint32_t>(net), node});
+            }
+        }
+        flattener.instance.push_back(flattener.num_instances++);
+    }
+    for (auto& pin : flattener.pins) {
+        pin.bit = flattener.find(pin.bit);
+    }
+
+    // 3. Netlist
+    instance = std::move(flattener.instance);
+    return build_netlist(flattener.pins, num_cells, num_ports);
+}
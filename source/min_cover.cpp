@@ -1,7 +1,10 @@
-#include <algorithm>
+#include <algorithm>                   // for any_of, all_of, count_if, sort
 #include <array>                       // for array
-#include <ckpttn/HierNetlist.hpp>      // for SimpleHierNetlist, HierNetlist
-#include <cstdint>                     // for uint32_t
+#include <ckpttn/CsrNetlist.hpp>       // for CsrNetlist
+#include <ckpttn/FMPmrConfig.hpp>      // for FM_MAX_DEGREE
+#include <ckpttn/HierNetlist.hpp>      // for SimpleHierNetlist, CsrHierNetlist
+#include <ckpttn/parallel_for.hpp>     // for parallel_for, num_parallel_tasks
+#include <cstdint>                     // for uint32_t, uint8_t
 #include <limits>                      // for numeric_limits
 #include <memory>                      // for unique_ptr, make_unique
 #include <netlistx/netlist.hpp>        // for SimpleNetlist, index_t, Netlist
@@ -9,6 +12,8 @@
 #include <py2cpp/dict.hpp>             // for dict
 #include <py2cpp/range.hpp>            // for range
 #include <py2cpp/set.hpp>              // for set
+#include <span>                        // for span
+#include <tuple>                       // for tuple
 #include <unordered_map>               // for unordered_map
 #include <utility>                     // for pair, move
 #include <vector>                      // for vector
@@ -20,6 +25,8 @@ static constexpr uint32_t LOW_PIN_NET_THRESHOLD = 5;
 static constexpr uint32_t MINHASH_SIG_SIZE = 64;
 static constexpr double MINHASH_SIMILARITY = 0.8;
 static constexpr uint32_t MINHASH_MAX_DEGREE = 200;
+/// @brief Minimum number of nets per task of the parallel steps
+static constexpr size_t CONTRACT_BLOCK_SIZE = 4096U;
 
 using minhash_sig_t = std::array<uint64_t, MINHASH_SIG_SIZE>;
 
@@ -54,25 +61,91 @@ static auto jaccard_similarity(const minhash_sig_t& sig1, const minhash_sig_t& s
 }
 
 /**
- * @brief Setup function: find minimum maximal matching and create clusters, nets, cell_list.
+ * @brief Build a per-level bitmap of the fixed modules.
  *
- * This function performs the initial setup for clustering by:
- * 1. Finding a minimum maximal matching in the hypergraph
- * 2. Creating clusters from the matched nets
- * 3. Separating remaining nets that weren't clustered
- * 4. Collecting cells that weren't included in any clusters
+ * @param[in] hyprgraph The input hypergraph
+ * @return One flag per module, set if the module is fixed
+ */
+template <typename Gnl>
+static auto fixed_bitmap(const Gnl& hyprgraph) -> std::vector<std::uint8_t> {
+    auto fixed = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0U);
+    for (const auto& v : hyprgraph.module_fixed) {
+        fixed[v] = 1U;
+    }
+    return fixed;
+}
+
+/**
+ * @brief Select cluster nets among the candidate nets only.
+ *
+ * Runs the minimum maximal matching on the sub-hypergraph induced by the
+ * nets accepted by `is_candidate`, and maps the selected nets back. The
+ * predicate is evaluated in parallel, so it must be safe to call concurrently.
  *
  * @param[in] hyprgraph The input hypergraph
  * @param[in] cluster_weight Weight of each net for matching
  * @param[in,out] forbid Set of forbidden vertices (dependents), modified in-place
- * @return Tuple of {clusters, nets, cell_list}
+ * @param[in] is_candidate Predicate telling whether a net may become a cluster
+ * @return The set of selected cluster nets
  */
-static auto setup(const SimpleNetlist& hyprgraph,
-                  const py::dict<node_t, unsigned int>& cluster_weight, py::set<node_t>& forbid)
-    -> std::tuple<std::vector<node_t>, std::vector<node_t>, std::vector<node_t>> {
+template <typename Gnl, typename Pred>
+static auto select_clusters_among(const Gnl& hyprgraph,
+                                  const py::dict<node_t, unsigned int>& cluster_weight,
+                                  py::set<node_t>& forbid, Pred&& is_candidate)
+    -> py::set<node_t> {
+    const auto num_modules = static_cast<uint32_t>(hyprgraph.number_of_modules());
+    const auto num_all_nets = static_cast<uint32_t>(hyprgraph.number_of_nets());
+    auto accepted = std::vector<std::uint8_t>(num_all_nets, 0U);
+    const auto num_tasks = num_parallel_tasks(0U, num_all_nets, CONTRACT_BLOCK_SIZE);
+    parallel_for(num_tasks, num_all_nets, [&](size_t, auto first, auto last) {
+        for (auto i_net = first; i_net != last; ++i_net) {
+            const auto net = node_t{num_modules + i_net};
+            accepted[i_net] = hyprgraph.gr.degree(net) != 0U && is_candidate(net) ? 1U : 0U;
+        }
+    });
+    auto candidates = std::vector<node_t>{};
+    for (auto i_net = 0U; i_net != num_all_nets; ++i_net) {
+        if (accepted[i_net] != 0U) {
+            candidates.emplace_back(num_modules + i_net);
+        }
+    }
+
+    const auto num_nets = static_cast<uint32_t>(candidates.size());
+    auto g = graph_t(num_modules + num_nets);
+    auto sub_weight = py::dict<node_t, unsigned int>{};
+    for (auto i_net = 0U; i_net < num_nets; ++i_net) {
+        const auto net = candidates[i_net];
+        for (const auto& v : hyprgraph.gr[net]) {
+            g.add_edge(v, num_modules + i_net);
+        }
+        sub_weight[num_modules + i_net] = cluster_weight.at(net);
+    }
+    const auto sub_hgr = SimpleNetlist(std::move(g), num_modules, num_nets);
+
+    py::set<node_t> s_sub;
+    min_maximal_matching(sub_hgr, sub_weight, s_sub, forbid);
+
     py::set<node_t> s1;
-    min_maximal_matching(hyprgraph, cluster_weight, s1, forbid);
+    for (const auto& net : s_sub) {
+        s1.insert(candidates[net - num_modules]);
+    }
+    return s1;
+}
 
+/**
+ * @brief Setup function: create clusters, nets, cell_list from the selected cluster nets.
+ *
+ * This function performs the initial setup for clustering by:
+ * 1. Creating clusters from the matched nets
+ * 2. Separating remaining nets that weren't clustered
+ * 3. Collecting cells that weren't included in any clusters
+ *
+ * @param[in] hyprgraph The input hypergraph
+ * @param[in] s1 Set of cluster nets selected by the matching
+ * @return Tuple of {clusters, nets, cell_list}
+ */
+template <typename Gnl> static auto setup(const Gnl& hyprgraph, const py::set<node_t>& s1)
+    -> std::tuple<std::vector<node_t>, std::vector<node_t>, std::vector<node_t>> {
     py::set<node_t> covered;
     auto nets = std::vector<node_t>{};
     auto clusters = std::vector<node_t>{};
@@ -107,7 +180,8 @@ static auto setup(const SimpleNetlist& hyprgraph,
  * @param[in] clusters Cluster nets from the matching
  * @return Pair of {bipartite graph, node_up_map}
  */
-static auto construct_graph(const SimpleNetlist& hyprgraph, const std::vector<node_t>& nets,
+template <typename Gnl>
+static auto construct_graph(const Gnl& hyprgraph, const std::vector<node_t>& nets,
                             const std::vector<node_t>& cell_list,
                             const std::vector<node_t>& clusters)
     -> std::pair<graph_t, std::vector<node_t>> {
@@ -156,7 +230,8 @@ static auto construct_graph(const SimpleNetlist& hyprgraph, const std::vector<no
  * @param[in] num_modules Total number of modules (cells + clusters)
  * @return Pair of {net_weight map, updated list of net indices}
  */
-static auto purge_duplicate_nets(const SimpleNetlist& hyprgraph, const graph_t& ugraph,
+template <typename Gnl>
+static auto purge_duplicate_nets(const Gnl& hyprgraph, const graph_t& ugraph,
                                  const std::vector<node_t>& nets, uint32_t num_clusters,
                                  uint32_t num_modules)
     -> std::pair<py::dict<uint32_t, unsigned int>, std::vector<uint32_t>> {
@@ -270,7 +345,8 @@ static auto purge_duplicate_nets(const SimpleNetlist& hyprgraph, const graph_t&
  * @param[in] num_modules Total number of modules
  * @return Tuple of {reconstructed graph, net_weight map, number of nets}
  */
-static auto reconstruct_graph(const SimpleNetlist& hyprgraph, const graph_t& ugraph,
+template <typename Gnl>
+static auto reconstruct_graph(const Gnl& hyprgraph, const graph_t& ugraph,
                               const std::vector<node_t>& nets, uint32_t num_clusters,
                               uint32_t num_modules)
     -> std::tuple<graph_t, py::dict<uint32_t, unsigned int>, uint32_t> {
@@ -299,32 +375,57 @@ static auto reconstruct_graph(const SimpleNetlist& hyprgraph, const graph_t& ugr
 }
 
 /**
- * @brief Create a contracted subgraph from a hierarchical netlist.
+ * @brief Calculate the cluster weight of each net.
  *
- * The main function that orchestrates the entire clustering process:
- * 1. Calculating initial cluster weights
- * 2. Setting up initial clusters and nets
- * 3. Constructing the intermediate graph
- * 4. Purging duplicates and reconstructing the final graph
- * 5. Creating the hierarchical netlist structure with updated weights
+ * The sums are computed in parallel; only the dictionary is filled serially.
  *
  * @param[in] hyprgraph The input hypergraph
- * @param[in] dont_select Set of nets that should not be contracted
- * @return The contracted hierarchical netlist
+ * @return The total module weight of the pins of each net
  */
-auto create_contracted_subgraph(const SimpleNetlist& hyprgraph, py::set<node_t> dont_select)
-    -> std::unique_ptr<SimpleHierNetlist> {
-    auto cluster_weight = py::dict<node_t, unsigned int>{};
-    for (const auto& net : hyprgraph.nets) {
-        auto sum = 0U;
-        for (const auto& v : hyprgraph.gr[net]) {
-            sum += hyprgraph.get_module_weight(v);
+template <typename Gnl>
+static auto calc_cluster_weight(const Gnl& hyprgraph) -> py::dict<node_t, unsigned int> {
+    const auto num_modules = static_cast<uint32_t>(hyprgraph.number_of_modules());
+    const auto num_nets = static_cast<uint32_t>(hyprgraph.number_of_nets());
+    auto sums = std::vector<unsigned int>(num_nets, 0U);
+    const auto num_tasks = num_parallel_tasks(0U, num_nets, CONTRACT_BLOCK_SIZE);
+    parallel_for(num_tasks, num_nets, [&](size_t, auto first, auto last) {
+        for (auto i_net = first; i_net != last; ++i_net) {
+            auto sum = 0U;
+            for (const auto& v : hyprgraph.gr[num_modules + i_net]) {
+                sum += hyprgraph.get_module_weight(v);
+            }
+            sums[i_net] = sum;
         }
-        cluster_weight[net] = sum;
+    });
+    auto cluster_weight = py::dict<node_t, unsigned int>{};
+    cluster_weight.reserve(num_nets);
+    for (auto i_net = 0U; i_net != num_nets; ++i_net) {
+        cluster_weight[num_modules + i_net] = sums[i_net];
     }
+    return cluster_weight;
+}
 
-    auto [clusters, nets, cell_list] = setup(hyprgraph, cluster_weight, dont_select);
-
+/**
+ * @brief Contract the selected cluster nets into a hierarchical netlist.
+ *
+ * 1. Setting up initial clusters and nets
+ * 2. Constructing the intermediate graph
+ * 3. Purging duplicates and reconstructing the final graph
+ * 4. Creating the hierarchical netlist structure with updated weights
+ * 5. Propagating the fixed status: a cluster is fixed if one of its modules is
+ *
+ * @param[in] hyprgraph The input hypergraph
+ * @param[in] cluster_weight Weight of each net
+ * @param[in] s1 Set of cluster nets selected by the matching
+ * @param[in] fixed Bitmap of the fixed modules
+ * @return The contracted hierarchical netlist
+ */
+template <typename Gnl>
+static auto contract_clusters(const Gnl& hyprgraph,
+                              const py::dict<node_t, unsigned int>& cluster_weight,
+                              const py::set<node_t>& s1, const std::vector<std::uint8_t>& fixed)
+    -> std::unique_ptr<HierNetlist<graph_t, Gnl>> {
+    auto [clusters, nets, cell_list] = setup(hyprgraph, s1);
     auto [ugraph, node_up_map] = construct_graph(hyprgraph, nets, cell_list, clusters);
 
     auto num_modules = static_cast<uint32_t>(cell_list.size() + clusters.size());
@@ -333,8 +434,8 @@ auto create_contracted_subgraph(const SimpleNetlist& hyprgraph, py::set<node_t>
     auto [gr2, net_weight2, num_nets]
         = reconstruct_graph(hyprgraph, ugraph, nets, num_clusters, num_modules);
 
-    auto hgr2 = std::make_unique<SimpleHierNetlist>(std::move(gr2), py::range(num_modules),
-                                                    py::range(num_modules, num_modules + num_nets));
+    auto hgr2 = std::make_unique<HierNetlist<graph_t, Gnl>>(
+        std::move(gr2), py::range(num_modules), py::range(num_modules, num_modules + num_nets));
 
     auto module_weight2 = std::vector<unsigned int>(num_modules, 0U);
     auto num_cells = num_modules - num_clusters;
@@ -343,7 +444,7 @@ auto create_contracted_subgraph(const SimpleNetlist& hyprgraph, py::set<node_t>
         module_weight2[v] = hyprgraph.get_module_weight(cell_list[v]);
     }
     for (auto i_v = 0U; i_v < num_clusters; ++i_v) {
-        module_weight2[num_cells + i_v] = cluster_weight[clusters[i_v]];
+        module_weight2[num_cells + i_v] = cluster_weight.at(clusters[i_v]);
     }
 
     auto node_down_map = std::vector<node_t>(cell_list.begin(), cell_list.end());
@@ -374,6 +475,270 @@ auto create_contracted_subgraph(const SimpleNetlist& hyprgraph, py::set<node_t>
         }
     }
 
+    if (hyprgraph.has_fixed_modules) {
+        for (auto v = 0U; v < num_cells; ++v) {
+            if (fixed[cell_list[v]] != 0U) {
+                hgr2->module_fixed.insert(v);
+            }
+        }
+        for (auto i_v = 0U; i_v < num_clusters; ++i_v) {
+            const auto& pins = hyprgraph.gr[clusters[i_v]];
+            const auto is_fixed = std::any_of(pins.begin(), pins.end(),
+                                              [&](const auto& v) { return fixed[v] != 0U; });
+            if (is_fixed) {
+                hgr2->module_fixed.insert(num_cells + i_v);
+            }
+        }
+        hgr2->has_fixed_modules = !hgr2->module_fixed.empty();
+    }
+
+    hgr2->parent = &hyprgraph;
+    return hgr2;
+}
+
+/**
+ * @brief Create a contracted subgraph with a bound on the cluster weight.
+ *
+ * The general form of the contraction:
+ * 1. Calculating initial cluster weights
+ * 2. Finding a minimum maximal matching among the admissible nets
+ * 3. Contracting the matched nets into clusters
+ *
+ * A net is admissible if its cluster weight does not exceed
+ * `max_cluster_weight` and, when `part` is given, if it is not cut by `part`.
+ * Without a partition, the parts of fixed modules are unknown, so a net with
+ * two or more fixed modules is never contracted. Hence a cluster never merges
+ * modules fixed to different parts.
+ *
+ * @tparam Gnl The hypergraph type
+ * @tparam Label The type of the labels of `part`
+ * @param[in] hyprgraph The input hypergraph
+ * @param[in] dont_select Set of modules that should not be contracted
+ * @param[in] part The partition (or labels) to be preserved (empty = none)
+ * @param[in] max_cluster_weight The maximum weight of a new cluster
+ * @return The contracted hierarchical netlist
+ */
+template <typename Gnl, typename Label>
+static auto contract_preserving(const Gnl& hyprgraph, py::set<node_t> dont_select,
+                                std::span<const Label> part, unsigned int max_cluster_weight)
+    -> std::unique_ptr<HierNetlist<graph_t, Gnl>> {
+    const auto cluster_weight = calc_cluster_weight(hyprgraph);
+    const auto fixed = fixed_bitmap(hyprgraph);
+    const auto s1 = select_clusters_among(
+        hyprgraph, cluster_weight, dont_select, [&](const auto& net) {
+            if (cluster_weight.at(net) > max_cluster_weight) {
+                return false;
+            }
+            const auto& pins = hyprgraph.gr[net];
+            if (!part.empty()) {
+                const auto part_net = part[*pins.begin()];
+                return std::all_of(pins.begin(), pins.end(),
+                                   [&](const auto& v) { return part[v] == part_net; });
+            }
+            return std::count_if(pins.begin(), pins.end(),
+                                 [&](const auto& v) { return fixed[v] != 0U; })
+                   < 2;
+        });
+    return contract_clusters(hyprgraph, cluster_weight, s1, fixed);
+}
+
+/**
+ * @brief Create a contracted subgraph with a bound on the cluster weight.
+ *
+ * @param[in] hyprgraph The input hypergraph
+ * @param[in] dont_select Set of modules that should not be contracted
+ * @param[in] part The partition to be preserved (empty = none)
+ * @param[in] max_cluster_weight The maximum weight of a new cluster
+ * @return The contracted hierarchical netlist
+ */
+auto create_contracted_subgraph(const SimpleNetlist& hyprgraph, py::set<node_t> dont_select,
+                                std::span<const std::uint8_t> part,
+                                unsigned int max_cluster_weight)
+    -> std::unique_ptr<SimpleHierNetlist> {
+    return contract_preserving(hyprgraph, std::move(dont_select), part, max_cluster_weight);
+}
+
+/**
+ * @brief Create a contracted subgraph with a bound on the cluster weight.
+ *
+ * Same as above, for labels that do not fit in a byte, e.g. the overlay of
+ * two partitions.
+ *
+ * @param[in] hyprgraph The input hypergraph
+ * @param[in] dont_select Set of modules that should not be contracted
+ * @param[in] label The labels to be preserved (empty = none)
+ * @param[in] max_cluster_weight The maximum weight of a new cluster
+ * @return The contracted hierarchical netlist
+ */
+auto create_contracted_subgraph(const SimpleNetlist& hyprgraph, py::set<node_t> dont_select,
+                                std::span<const std::uint32_t> label,
+                                unsigned int max_cluster_weight)
+    -> std::unique_ptr<SimpleHierNetlist> {
+    return contract_preserving(hyprgraph, std::move(dont_select), label, max_cluster_weight);
+}
+
+/**
+ * @brief Create a contracted subgraph of a CSR netlist.
+ *
+ * Same as above, for the finest level of `partition_csr`. The contracted
+ * netlist is a `SimpleGraph` netlist, whose parent is `hyprgraph`.
+ *
+ * @param[in] hyprgraph The input hypergraph
+ * @param[in] dont_select Set of modules that should not be contracted
+ * @param[in] label The labels to be preserved (empty = none)
+ * @param[in] max_cluster_weight The maximum weight of a new cluster
+ * @return The contracted hierarchical netlist
+ */
+auto create_contracted_subgraph(const CsrNetlist& hyprgraph, py::set<node_t> dont_select,
+                                std::span<const std::uint32_t> label,
+                                unsigned int max_cluster_weight)
+    -> std::unique_ptr<CsrHierNetlist> {
+    return contract_preserving(hyprgraph, std::move(dont_select), label, max_cluster_weight);
+}
+
+/**
+ * @brief Create a contracted subgraph from a hierarchical netlist.
+ *
+ * Same as above, without a partition and without a weight bound.
+ *
+ * @param[in] hyprgraph The input hypergraph
+ * @param[in] dont_select Set of modules that should not be contracted
+ * @return The contracted hierarchical netlist
+ */
+auto create_contracted_subgraph(const SimpleNetlist& hyprgraph, py::set<node_t> dont_select)
+    -> std::unique_ptr<SimpleHierNetlist> {
+    if (hyprgraph.has_fixed_modules) {
+        return contract_preserving<SimpleNetlist, std::uint8_t>(
+            hyprgraph, std::move(dont_select), {}, std::numeric_limits<unsigned int>::max());
+    }
+    const auto cluster_weight = calc_cluster_weight(hyprgraph);
+    const auto fixed = fixed_bitmap(hyprgraph);
+    py::set<node_t> s1;
+    min_maximal_matching(hyprgraph, cluster_weight, s1, dont_select);
+    return contract_clusters(hyprgraph, cluster_weight, s1, fixed);
+}
+
+/**
+ * @brief Create a contracted subgraph that preserves a given partition.
+ *
+ * Same as above, except that nets cut by `part` are never contracted, so
+ * that every cluster lies entirely within one part. This is the coarsening
+ * used by the iterated V-cycles of the multilevel partitioner. Fixed modules
+ * of the same cluster are then necessarily fixed to the same part.
+ *
+ * @param[in] hyprgraph The input hypergraph
+ * @param[in] dont_select Set of modules that should not be contracted
+ * @param[in] part The partition to be preserved
+ * @return The contracted hierarchical netlist
+ */
+auto create_contracted_subgraph(const SimpleNetlist& hyprgraph, py::set<node_t> dont_select,
+                                std::span<const std::uint8_t> part)
+    -> std::unique_ptr<SimpleHierNetlist> {
+    return create_contracted_subgraph(hyprgraph, std::move(dont_select), part,
+                                      std::numeric_limits<unsigned int>::max());
+}
+
+/**
+ * @brief Create a contracted subgraph from a clustering of the modules.
+ *
+ * 1. Growing the clusters: each cluster starts from the first module not yet
+ *    assigned and grows breadth-first through the nets of at most
+ *    `FM_MAX_DEGREE` pins, taking the modules with the same label (and,
+ *    when `part` is given, in the same part) while its weight stays within
+ *    `max_cluster_weight`. A label heavier than that is thus split into
+ *    connected pieces. Fixed modules are kept alone.
+ * 2. Rebuilding the nets over the clusters, dropping the ones that end up
+ *    with a single pin
+ *
+ * The level has no `node_down_map` and no `cluster_down_map`; it is
+ * projected through `node_up_map`.
+ *
+ * @param[in] hyprgraph The input hypergraph
+ * @param[in] cluster The cluster label of each module
+ * @param[in] part The partition (or labels) to be preserved (empty = none)
+ * @param[in] max_cluster_weight The maximum weight of a cluster of several modules
+ * @return The contracted hierarchical netlist
+ */
+auto create_clustered_subgraph(const SimpleNetlist& hyprgraph,
+                               std::span<const std::uint32_t> cluster,
+                               std::span<const std::uint32_t> part,
+                               unsigned int max_cluster_weight)
+    -> std::unique_ptr<SimpleHierNetlist> {
+    const auto fixed = fixed_bitmap(hyprgraph);
+
+    // 1. Clusters
+    constexpr auto unassigned = std::numeric_limits<node_t>::max();
+    auto key = [&](const node_t& v) {
+        return (static_cast<std::uint64_t>(cluster[v]) << 32U) | (part.empty() ? 0U : part[v]);
+    };
+    auto node_up_map = std::vector<node_t>(hyprgraph.number_of_modules(), unassigned);
+    auto module_weight2 = std::vector<unsigned int>{};
+    auto module_fixed2 = py::set<node_t>{};
+    auto queue = std::vector<node_t>{};
+    for (const auto& v : hyprgraph) {
+        if (node_up_map[v] != unassigned) {
+            continue;
+        }
+        const auto v2 = static_cast<node_t>(module_weight2.size());
+        node_up_map[v] = v2;
+        auto weight = hyprgraph.get_module_weight(v);
+        if (fixed[v] != 0U) {
+            module_fixed2.insert(v2);
+            module_weight2.emplace_back(weight);
+            continue;
+        }
+        const auto key_v = key(v);
+        queue.assign(1U, v);
+        for (auto head = size_t{0U}; head != queue.size(); ++head) {
+            for (const auto& net : hyprgraph.gr[queue[head]]) {
+                if (hyprgraph.gr.degree(net) > FM_MAX_DEGREE) {
+                    continue;
+                }
+                for (const auto& w : hyprgraph.gr[net]) {
+                    const auto weight_w = hyprgraph.get_module_weight(w);
+                    if (node_up_map[w] != unassigned || fixed[w] != 0U || key(w) != key_v
+                        || weight + weight_w > max_cluster_weight) {
+                        continue;
+                    }
+                    node_up_map[w] = v2;
+                    weight += weight_w;
+                    queue.emplace_back(w);
+                }
+            }
+        }
+        module_weight2.emplace_back(weight);
+    }
+    const auto num_modules = static_cast<uint32_t>(module_weight2.size());
+
+    // 2. Nets
+    auto net_pins = std::vector<std::vector<node_t>>{};
+    auto pins = std::vector<node_t>{};
+    for (const auto& net : hyprgraph.nets) {
+        pins.clear();
+        for (const auto& v : hyprgraph.gr[net]) {
+            pins.emplace_back(node_up_map[v]);
+        }
+        std::sort(pins.begin(), pins.end());
+        pins.erase(std::unique(pins.begin(), pins.end()), pins.end());
+        if (pins.size() >= 2) {
+            net_pins.emplace_back(pins);
+        }
+    }
+    const auto num_nets = static_cast<uint32_t>(net_pins.size());
+
+    auto gr2 = graph_t(num_modules + num_nets);
+    for (auto i_net = 0U; i_net != num_nets; ++i_net) {
+        for (const auto& v2 : net_pins[i_net]) {
+            gr2.add_edge(v2, num_modules + i_net);
+        }
+    }
+
+    auto hgr2 = std::make_unique<SimpleHierNetlist>(std::move(gr2), py::range(num_modules),
+                                                    py::range(num_modules, num_modules + num_nets));
+    hgr2->node_up_map = std::move(node_up_map);
+    hgr2->module_weight = std::move(module_weight2);
+    hgr2->module_fixed = std::move(module_fixed2);
+    hgr2->has_fixed_modules = !hgr2->module_fixed.empty();
     hgr2->parent = &hyprgraph;
     return hgr2;
 }
@@ -1,24 +1,39 @@
 #define CKPTTN_VERSION "1.0"
 
+#include <ckpttn/BatchPipeline.hpp>
+#include <ckpttn/CoarseningHierarchy.hpp>
 #include <ckpttn/FMBiConstrMgr.hpp>
 #include <ckpttn/FMBiGainMgr.hpp>
 #include <ckpttn/FMKWayConstrMgr.hpp>
 #include <ckpttn/FMKWayGainMgr.hpp>
 #include <ckpttn/FMPartMgr.hpp>
+#include <ckpttn/FlowPartMgr.hpp>
+#include <ckpttn/LPPartMgr.hpp>
+#include <ckpttn/LocalFMPartMgr.hpp>
 #include <ckpttn/MLPartMgr.hpp>
+#include <ckpttn/MemeticPartMgr.hpp>
+#include <ckpttn/MidLvlWindowPartMgr.hpp>
 #include <ckpttn/NNPartMgr.hpp>
+#include <ckpttn/ParallelReader.hpp>
+#include <ckpttn/PartitionServer.hpp>
+#include <ckpttn/PreprocessedNetlist.hpp>
+#include <ckpttn/RecursiveBisection.hpp>
+#include <ckpttn/StreamPartitioner.hpp>
+#include <ckpttn/TaskScheduler.hpp>
+#include <ckpttn/YosysStreamReader.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <cxxopts.hpp>
 #include <fstream>
-#include <future>
 #include <iostream>
 #include <limits>
 #include <netlistx/netlist.hpp>
 #include <netlistx/readwrite.hpp>
+#include <optional>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <xnetwork/classes/graph.hpp>
-#include <xnetwork/thread_pool.hpp>
 
 using graph_t = xnetwork::SimpleGraph;
 using index_t = std::uint32_t;
@@ -29,71 +44,324 @@ struct PresetConfig {
     double balance_tolerance;
     std::uint8_t num_parts;
     bool use_recursive;
+    std::size_t num_vcycles;
+    double time_limit;
+    bool deterministic;
+    /// @brief Seed clusters of the first coarsening level (empty = none)
+    std::span<const std::uint32_t> seed_clusters{};
+    /// @brief Prebuilt coarsening hierarchy (null = none)
+    const CoarseningHierarchy* hierarchy{nullptr};
 };
 
 enum class Preset { default_preset, quality, highest_quality, deterministic, large_k };
 
+enum class Refiner { fm, nn, lp, local_fm, flow, window };
+
 auto get_preset_config(Preset preset, std::uint8_t k) -> PresetConfig {
     switch (preset) {
         case Preset::default_preset:
-            return {.balance_tolerance = 0.03, .num_parts = k, .use_recursive = true};
+            return {.balance_tolerance = 0.03,
+                    .num_parts = k,
+                    .use_recursive = true,
+                    .num_vcycles = 0,
+                    .time_limit = 0.0,
+                    .deterministic = false};
         case Preset::quality:
-            return {.balance_tolerance = 0.01, .num_parts = k, .use_recursive = false};
+            return {.balance_tolerance = 0.01,
+                    .num_parts = k,
+                    .use_recursive = false,
+                    .num_vcycles = 3,
+                    .time_limit = 0.0,
+                    .deterministic = false};
         case Preset::highest_quality:
-            return {.balance_tolerance = 0.005, .num_parts = k, .use_recursive = false};
+            return {.balance_tolerance = 0.005,
+                    .num_parts = k,
+                    .use_recursive = false,
+                    .num_vcycles = 10,
+                    .time_limit = 0.0,
+                    .deterministic = false};
         case Preset::deterministic:
-            return {.balance_tolerance = 0.03, .num_parts = k, .use_recursive = true};
+            return {.balance_tolerance = 0.03,
+                    .num_parts = k,
+                    .use_recursive = true,
+                    .num_vcycles = 0,
+                    .time_limit = 0.0,
+                    .deterministic = true};
         case Preset::large_k:
-            return {.balance_tolerance = 0.03, .num_parts = k, .use_recursive = true};
+            return {.balance_tolerance = 0.03,
+                    .num_parts = k,
+                    .use_recursive = true,
+                    .num_vcycles = 0,
+                    .time_limit = 0.0,
+                    .deterministic = false};
         default:
-            return {.balance_tolerance = 0.03, .num_parts = k, .use_recursive = true};
+            return {.balance_tolerance = 0.03,
+                    .num_parts = k,
+                    .use_recursive = true,
+                    .num_vcycles = 0,
+                    .time_limit = 0.0,
+                    .deterministic = false};
+    }
+}
+
+auto seed_hierarchy(MLPartMgr& ml_mgr, const SimpleNetlist& hyprgraph, const PresetConfig& config)
+    -> void {
+    if (!config.seed_clusters.empty()) {
+        ml_mgr.get_coarsening().set_seed_clusters(
+            hyprgraph, {config.seed_clusters.begin(), config.seed_clusters.end()});
     }
+    ml_mgr.get_coarsening().set_hierarchy(config.hierarchy);
 }
 
-auto run_binary_partition(const SimpleNetlist& hyprgraph, double balance_tol,
+auto run_binary_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
                           std::span<std::uint8_t> part) -> int {
     using GainMgr = FMBiGainMgr<SimpleNetlist>;
     using ConstrMgr = FMBiConstrMgr<SimpleNetlist>;
     using PartMgr = FMPartMgr<SimpleNetlist, GainMgr, ConstrMgr>;
 
-    MLPartMgr ml_mgr(balance_tol, 2);
+    MLPartMgr ml_mgr(config.balance_tolerance, 2);
+    ml_mgr.set_num_vcycles(config.num_vcycles);
+    ml_mgr.set_time_limit(config.time_limit);
+    seed_hierarchy(ml_mgr, hyprgraph, config);
     ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
     return ml_mgr.total_cost;
 }
 
-auto run_kway_partition(const SimpleNetlist& hyprgraph, double balance_tol,
-                        std::span<std::uint8_t> part, std::uint8_t num_parts) -> int {
+auto run_kway_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
+                        std::span<std::uint8_t> part) -> int {
     using GainMgr = FMKWayGainMgr<SimpleNetlist>;
     using ConstrMgr = FMKWayConstrMgr<SimpleNetlist>;
     using PartMgr = FMPartMgr<SimpleNetlist, GainMgr, ConstrMgr>;
 
-    MLPartMgr ml_mgr(balance_tol, num_parts);
+    MLPartMgr ml_mgr(config.balance_tolerance, config.num_parts);
+    ml_mgr.set_num_vcycles(config.num_vcycles);
+    ml_mgr.set_time_limit(config.time_limit);
+    seed_hierarchy(ml_mgr, hyprgraph, config);
     ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
     return ml_mgr.total_cost;
 }
 
-auto run_nn_binary_partition(const SimpleNetlist& hyprgraph, double balance_tol,
+auto run_nn_binary_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
                              std::span<std::uint8_t> part) -> int {
     using GainMgr = FMBiGainMgr<SimpleNetlist>;
     using ConstrMgr = FMBiConstrMgr<SimpleNetlist>;
     using PartMgr = NNPartMgr<SimpleNetlist, GainMgr, ConstrMgr>;
 
-    MLPartMgr ml_mgr(balance_tol, 2);
+    MLPartMgr ml_mgr(config.balance_tolerance, 2);
+    ml_mgr.set_num_vcycles(config.num_vcycles);
+    ml_mgr.set_time_limit(config.time_limit);
+    seed_hierarchy(ml_mgr, hyprgraph, config);
     ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
     return ml_mgr.total_cost;
 }
 
-auto run_nn_kway_partition(const SimpleNetlist& hyprgraph, double balance_tol,
-                           std::span<std::uint8_t> part, std::uint8_t num_parts) -> int {
+auto run_nn_kway_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
+                           std::span<std::uint8_t> part) -> int {
     using GainMgr = FMKWayGainMgr<SimpleNetlist>;
     using ConstrMgr = FMKWayConstrMgr<SimpleNetlist>;
     using PartMgr = NNPartMgr<SimpleNetlist, GainMgr, ConstrMgr>;
 
-    MLPartMgr ml_mgr(balance_tol, num_parts);
+    MLPartMgr ml_mgr(config.balance_tolerance, config.num_parts);
+    ml_mgr.set_num_vcycles(config.num_vcycles);
+    ml_mgr.set_time_limit(config.time_limit);
+    seed_hierarchy(ml_mgr, hyprgraph, config);
     ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
     return ml_mgr.total_cost;
 }
 
+auto run_lp_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
+                      std::span<std::uint8_t> part) -> int {
+    MLPartMgr ml_mgr(config.balance_tolerance, config.num_parts);
+    ml_mgr.set_num_vcycles(config.num_vcycles);
+    ml_mgr.set_time_limit(config.time_limit);
+    seed_hierarchy(ml_mgr, hyprgraph, config);
+    if (config.num_parts == 2) {
+        using PartMgr = LPPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                                  FMBiConstrMgr<SimpleNetlist>>;
+        ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    } else {
+        using PartMgr = LPPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                  FMKWayConstrMgr<SimpleNetlist>>;
+        ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    }
+    return ml_mgr.total_cost;
+}
+
+auto run_local_fm_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
+                            std::span<std::uint8_t> part) -> int {
+    MLPartMgr ml_mgr(config.balance_tolerance, config.num_parts);
+    ml_mgr.set_num_vcycles(config.num_vcycles);
+    ml_mgr.set_time_limit(config.time_limit);
+    seed_hierarchy(ml_mgr, hyprgraph, config);
+    if (config.num_parts == 2) {
+        using PartMgr = LocalFMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                                       FMBiConstrMgr<SimpleNetlist>>;
+        ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    } else {
+        using PartMgr = LocalFMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                       FMKWayConstrMgr<SimpleNetlist>>;
+        ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    }
+    return ml_mgr.total_cost;
+}
+
+auto run_flow_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
+                        std::span<std::uint8_t> part) -> int {
+    MLPartMgr ml_mgr(config.balance_tolerance, config.num_parts);
+    ml_mgr.set_num_vcycles(config.num_vcycles);
+    ml_mgr.set_time_limit(config.time_limit);
+    seed_hierarchy(ml_mgr, hyprgraph, config);
+    if (config.num_parts == 2) {
+        using PartMgr = FlowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                                    FMBiConstrMgr<SimpleNetlist>>;
+        ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    } else {
+        using PartMgr = FlowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                    FMKWayConstrMgr<SimpleNetlist>>;
+        ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    }
+    return ml_mgr.total_cost;
+}
+
+auto run_window_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
+                          std::span<std::uint8_t> part) -> int {
+    MLPartMgr ml_mgr(config.balance_tolerance, config.num_parts);
+    ml_mgr.set_num_vcycles(config.num_vcycles);
+    ml_mgr.set_time_limit(config.time_limit);
+    seed_hierarchy(ml_mgr, hyprgraph, config);
+    if (config.num_parts == 2) {
+        using PartMgr = MidLvlWindowPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                                            FMBiConstrMgr<SimpleNetlist>>;
+        ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    } else {
+        using PartMgr = MidLvlWindowPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                                            FMKWayConstrMgr<SimpleNetlist>>;
+        ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    }
+    return ml_mgr.total_cost;
+}
+
+auto run_recursive_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
+                             Refiner refiner, std::span<std::uint8_t> part) -> int {
+    using GainMgr = FMBiGainMgr<SimpleNetlist>;
+    using ConstrMgr = FMBiConstrMgr<SimpleNetlist>;
+
+    RecursiveBisection rb_mgr(config.balance_tolerance, config.num_parts);
+    rb_mgr.set_num_vcycles(config.num_vcycles);
+    switch (refiner) {
+        case Refiner::lp:
+            rb_mgr.run_Partition<SimpleNetlist, LPPartMgr<SimpleNetlist, GainMgr, ConstrMgr>>(
+                hyprgraph, part);
+            break;
+        case Refiner::local_fm:
+            rb_mgr.run_Partition<SimpleNetlist, LocalFMPartMgr<SimpleNetlist, GainMgr, ConstrMgr>>(
+                hyprgraph, part);
+            break;
+        case Refiner::flow:
+            rb_mgr.run_Partition<SimpleNetlist, FlowPartMgr<SimpleNetlist, GainMgr, ConstrMgr>>(
+                hyprgraph, part);
+            break;
+        case Refiner::window:
+            rb_mgr.run_Partition<SimpleNetlist,
+                                 MidLvlWindowPartMgr<SimpleNetlist, GainMgr, ConstrMgr>>(hyprgraph,
+                                                                                        part);
+            break;
+        case Refiner::nn:
+            rb_mgr.run_Partition<SimpleNetlist, NNPartMgr<SimpleNetlist, GainMgr, ConstrMgr>>(
+                hyprgraph, part);
+            break;
+        default:
+            rb_mgr.run_Partition<SimpleNetlist, FMPartMgr<SimpleNetlist, GainMgr, ConstrMgr>>(
+                hyprgraph, part);
+            break;
+    }
+    return rb_mgr.total_cost;
+}
+
+auto run_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config, Refiner refiner,
+                   std::span<std::uint8_t> part) -> int {
+    if (config.use_recursive && config.num_parts > 2) {
+        return run_recursive_partition(hyprgraph, config, refiner, part);
+    }
+    switch (refiner) {
+        case Refiner::lp:
+            return run_lp_partition(hyprgraph, config, part);
+        case Refiner::local_fm:
+            return run_local_fm_partition(hyprgraph, config, part);
+        case Refiner::flow:
+            return run_flow_partition(hyprgraph, config, part);
+        case Refiner::window:
+            return run_window_partition(hyprgraph, config, part);
+        case Refiner::nn:
+            return config.num_parts == 2 ? run_nn_binary_partition(hyprgraph, config, part)
+                                         : run_nn_kway_partition(hyprgraph, config, part);
+        default:
+            return config.num_parts == 2 ? run_binary_partition(hyprgraph, config, part)
+                                         : run_kway_partition(hyprgraph, config, part);
+    }
+}
+
+template <typename PartMgr>
+auto run_memetic(const SimpleNetlist& hyprgraph, const PresetConfig& config,
+                 std::uint32_t population, std::uint32_t seed, std::span<std::uint8_t> part)
+    -> int {
+    MemeticPartMgr memetic_mgr(config.balance_tolerance, config.num_parts);
+    memetic_mgr.set_population_size(population);
+    memetic_mgr.set_num_vcycles(config.num_vcycles);
+    memetic_mgr.set_seed(seed);
+    if (config.time_limit > 0.0) {
+        // the time budget drives the evolution
+        memetic_mgr.set_num_generations(0);
+        memetic_mgr.set_time_limit(config.time_limit);
+    }
+    memetic_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    return memetic_mgr.total_cost;
+}
+
+auto run_memetic_partition(const SimpleNetlist& hyprgraph, const PresetConfig& config,
+                           Refiner refiner, std::uint32_t population, std::uint32_t seed,
+                           std::span<std::uint8_t> part) -> int {
+    using BiGainMgr = FMBiGainMgr<SimpleNetlist>;
+    using BiConstrMgr = FMBiConstrMgr<SimpleNetlist>;
+    using KWayGainMgr = FMKWayGainMgr<SimpleNetlist>;
+    using KWayConstrMgr = FMKWayConstrMgr<SimpleNetlist>;
+
+    const auto bi = config.num_parts == 2;
+    switch (refiner) {
+        case Refiner::lp:
+            return bi ? run_memetic<LPPartMgr<SimpleNetlist, BiGainMgr, BiConstrMgr>>(
+                       hyprgraph, config, population, seed, part)
+                      : run_memetic<LPPartMgr<SimpleNetlist, KWayGainMgr, KWayConstrMgr>>(
+                          hyprgraph, config, population, seed, part);
+        case Refiner::local_fm:
+            return bi ? run_memetic<LocalFMPartMgr<SimpleNetlist, BiGainMgr, BiConstrMgr>>(
+                       hyprgraph, config, population, seed, part)
+                      : run_memetic<LocalFMPartMgr<SimpleNetlist, KWayGainMgr, KWayConstrMgr>>(
+                          hyprgraph, config, population, seed, part);
+        case Refiner::flow:
+            return bi ? run_memetic<FlowPartMgr<SimpleNetlist, BiGainMgr, BiConstrMgr>>(
+                       hyprgraph, config, population, seed, part)
+                      : run_memetic<FlowPartMgr<SimpleNetlist, KWayGainMgr, KWayConstrMgr>>(
+                          hyprgraph, config, population, seed, part);
+        case Refiner::window:
+            return bi ? run_memetic<MidLvlWindowPartMgr<SimpleNetlist, BiGainMgr, BiConstrMgr>>(
+                       hyprgraph, config, population, seed, part)
+                      : run_memetic<
+                          MidLvlWindowPartMgr<SimpleNetlist, KWayGainMgr, KWayConstrMgr>>(
+                          hyprgraph, config, population, seed, part);
+        case Refiner::nn:
+            return bi ? run_memetic<NNPartMgr<SimpleNetlist, BiGainMgr, BiConstrMgr>>(
+                       hyprgraph, config, population, seed, part)
+                      : run_memetic<NNPartMgr<SimpleNetlist, KWayGainMgr, KWayConstrMgr>>(
+                          hyprgraph, config, population, seed, part);
+        default:
+            return bi ? run_memetic<FMPartMgr<SimpleNetlist, BiGainMgr, BiConstrMgr>>(
+                       hyprgraph, config, population, seed, part)
+                      : run_memetic<FMPartMgr<SimpleNetlist, KWayGainMgr, KWayConstrMgr>>(
+                          hyprgraph, config, population, seed, part);
+    }
+}
+
 template <typename Gen> auto random_init_part(std::span<std::uint8_t> part,
                                               const SimpleNetlist& hyprgraph,
                                               std::uint8_t num_parts, Gen& gen) -> void {
@@ -105,6 +373,26 @@ template <typename Gen> auto random_init_part(std::span<std::uint8_t> part,
     }
 }
 
+/**
+ * @brief Writes a partition to a file, or to stdout if the file name is empty.
+ *
+ * @return false if the file cannot be opened
+ */
+auto write_output(std::span<const std::uint8_t> part, const std::string& output_file,
+                  OutputFormat output_format) -> bool {
+    if (output_file.empty()) {
+        write_partition(part, std::cout, output_format);
+        return true;
+    }
+    auto file = std::ofstream{output_file};
+    if (file.fail()) {
+        std::cerr << "Error: Can't open output file " << output_file << ".\n";
+        return false;
+    }
+    write_partition(part, file, output_format);
+    return true;
+}
+
 auto main(int argc, char** argv) -> int {
     cxxopts::Options options(
         *argv, "ckpttn - A hypergraph partitioner compatible with hMetis and KaHyPar");
@@ -123,12 +411,22 @@ auto main(int argc, char** argv) -> int {
     std::string preset_str = "default";
     std::string objective = "cut";
     std::string mode_str = "recursive";
-    std::uint32_t threads = 1;
+    std::string refiner_str = "auto";
+    std::uint32_t jobs = 0;
+    std::uint32_t starts = 1;
+    bool evolve = false;
 
     std::uint32_t seed = 0;
     bool verbose = false;
     double time_limit = 0.0;
     std::uint32_t max_quality = 0;
+    std::uint32_t vcycles = 0;
+    std::string serve_socket;
+    std::uint32_t cache_size = 8;
+    std::string save_hierarchy_file;
+    std::string load_hierarchy_file;
+    std::string stream_blocks_prefix;
+    std::string batch_manifest;
 
     options.add_options()("h,help", "Show help")("v,version", "Print the current version number")
 
@@ -146,26 +444,78 @@ auto main(int argc, char** argv) -> int {
                  cxxopts::value<std::string>(output_file)->default_value(""))(
                     "output-format", "Output format: hmetis, json",
                     cxxopts::value<std::string>(output_format_str)->default_value("hmetis"))(
-                    "q,quiet", "Suppress output")
+                    "q,quiet", "Suppress output")("no-preprocess",
+                                                  "Disable net removal and twin-module merging")
 
                     ("p,preset",
                      "Preset: default, quality, highest_quality, deterministic, large_k",
                      cxxopts::value<std::string>(preset_str)->default_value("default"))(
                         "objective", "Objective: cut, km1, soed, km1a",
                         cxxopts::value<std::string>(objective)->default_value("cut"))(
-                        "mode", "Mode: direct, recursive",
-                        cxxopts::value<std::string>(mode_str)->default_value("recursive"))(
-                        "t,threads", "Number of starts (multi-start)",
-                        cxxopts::value<std::uint32_t>(threads)->default_value("1"))
-
-                        ("s,seed", "Random seed (0 = use random device)",
+                        "mode",
+                        "Mode: direct, recursive (recursive bisection for k > 2; default: by "
+                        "preset)",
+                        cxxopts::value<std::string>(mode_str))(
+                        "refiner",
+                        "Refiner: auto, fm, nn, lp, lfm, flow, window (lp = parallel label "
+                        "propagation, lfm = localized parallel FM, flow = FM and max-flow "
+                        "refinement between block pairs, window = FM and exact refinement "
+                        "of small windows around the cut; auto = fm in recursive mode, nn "
+                        "in direct mode)",
+                        cxxopts::value<std::string>(refiner_str)->default_value("auto"))(
+                        "j,jobs", "Number of threads (0 = all cores)",
+                        cxxopts::value<std::uint32_t>(jobs)->default_value("0"))(
+                        "t,starts", "Number of starts (multi-start)",
+                        cxxopts::value<std::uint32_t>(starts)->default_value("1"))(
+                        "threads", "Alias of --starts (use -j for the number of threads)",
+                        cxxopts::value<std::uint32_t>())(
+                        "evolve",
+                        "Evolve a population of --starts partitions (at least 2) by "
+                        "recombination and mutation until --time-limit (direct mode)")
+
+                        ("s,seed", "Random seed (0 = random device, or 1 if deterministic)",
                          cxxopts::value<std::uint32_t>(seed)->default_value("0"))("verbose",
                                                                                   "Verbose output")
 
                             ("time-limit", "Time limit in seconds",
                              cxxopts::value<double>(time_limit)->default_value("0"))(
                                 "max-quality", "Maximum quality",
-                                cxxopts::value<std::uint32_t>(max_quality)->default_value("0"));
+                                cxxopts::value<std::uint32_t>(max_quality)->default_value("0"))(
+                                "vcycles", "Number of V-cycles (overrides the preset)",
+                                cxxopts::value<std::uint32_t>(vcycles))(
+                                "hierarchy",
+                                "Flatten the design hierarchy of a Yosys input and use its "
+                                "instances as the first coarsening level (direct mode)")(
+                                "serve",
+                                "Serve partitioning requests on a Unix domain socket, caching "
+                                "the parsed netlists",
+                                cxxopts::value<std::string>(serve_socket)->default_value(""))(
+                                "cache-size",
+                                "Maximum number of parsed netlists kept by --serve and --batch",
+                                cxxopts::value<std::uint32_t>(cache_size)->default_value("8"))(
+                                "batch",
+                                "Run the jobs of a manifest (one 'file=<path> [k=<K>] "
+                                "[epsilon=<tol>] ... [output=<path>]' per line, - = stdin), "
+                                "overlapping parsing, partitioning and writing",
+                                cxxopts::value<std::string>(batch_manifest)->default_value(""))(
+                                "save-hierarchy",
+                                "Save the coarsening hierarchy to a file (direct mode)",
+                                cxxopts::value<std::string>(save_hierarchy_file)
+                                    ->default_value(""))(
+                                "load-hierarchy",
+                                "Reuse a saved coarsening hierarchy instead of coarsening "
+                                "(direct mode)",
+                                cxxopts::value<std::string>(load_hierarchy_file)
+                                    ->default_value(""))(
+                                "stream",
+                                "Partition an hMetis or netD file in one pass without loading "
+                                "it (epsilon = block capacity above the average, by module "
+                                "count)")(
+                                "stream-blocks",
+                                "With --stream, write the netlist of each block to "
+                                "<prefix><block>.hgr and its modules to <prefix><block>.map",
+                                cxxopts::value<std::string>(stream_blocks_prefix)
+                                    ->default_value(""));
 
     options.parse_positional({"hypergraph_file", "k", "epsilon"});
 
@@ -182,11 +532,20 @@ Examples:
   ckpttn circuit.hgr 2 5
   ckpttn circuit.hgr 4 10 -o partition.txt
   ckpttn circuit.hgr -k 4 -e 0.03 -p quality
+  ckpttn circuit.hgr 2 5 --vcycles 5 --time-limit 60
   ckpttn circuit.hgr 2 5 -f fix.txt
   ckpttn circuit.hgr 2 5 -s 42
   ckpttn circuit.hgr 2 5 --mode direct --verbose
-  ckpttn circuit.hgr 2 5 -t 8 -s 42
+  ckpttn circuit.hgr 4 5 --refiner lp
+  ckpttn circuit.hgr 2 5 -j 8 -t 4 -s 42
+  ckpttn circuit.hgr 4 5 --evolve --starts 8 --time-limit 3600
   ckpttn circuit.json 2 5 -i yosys --verbose
+  ckpttn design.json 4 5 -i yosys --hierarchy --mode direct
+  ckpttn circuit.hgr 2 5 --mode direct --save-hierarchy circuit.hier
+  ckpttn circuit.hgr 4 3 --mode direct --load-hierarchy circuit.hier
+  ckpttn huge.hgr 8 3 --stream --stream-blocks huge.block -o huge.part
+  ckpttn --serve /tmp/ckpttn.sock -j 8 --cache-size 16
+  ckpttn --batch jobs.txt -j 8 > report.txt
 
 Compatible with hMetis and KaHyPar CLI.
 )";
@@ -198,6 +557,17 @@ Compatible with hMetis and KaHyPar CLI.
         return 0;
     }
 
+    if (result.count("threads") != 0U) {
+        if (result.count("starts") != 0U) {
+            std::cerr << "Error: --threads is an alias of --starts; give only one of them.\n";
+            return 1;
+        }
+        starts = result["threads"].as<std::uint32_t>();
+    }
+
+    // one pool for the whole run: the starts and all parallel steps share it
+    TaskScheduler::set_global_num_threads(jobs);
+
     auto use_yosys = false;
     InputFormat input_format = InputFormat::auto_detect;
     if (input_format_str == "hmetis") {
@@ -229,7 +599,26 @@ Compatible with hMetis and KaHyPar CLI.
         preset = Preset::default_preset;
     }
 
-    const auto use_recursive = (mode_str == "recursive");
+    // an explicit --mode overrides the preset
+    const auto use_recursive
+        = result.count("mode") != 0U
+              ? (mode_str == "recursive")
+              : get_preset_config(preset, static_cast<std::uint8_t>(k)).use_recursive;
+
+    auto refiner = use_recursive ? Refiner::fm : Refiner::nn;
+    if (refiner_str == "fm") {
+        refiner = Refiner::fm;
+    } else if (refiner_str == "nn") {
+        refiner = Refiner::nn;
+    } else if (refiner_str == "lp") {
+        refiner = Refiner::lp;
+    } else if (refiner_str == "lfm") {
+        refiner = Refiner::local_fm;
+    } else if (refiner_str == "flow") {
+        refiner = Refiner::flow;
+    } else if (refiner_str == "window") {
+        refiner = Refiner::window;
+    }
 
     OutputFormat output_format;
     if (output_format_str == "json") {
@@ -240,10 +629,48 @@ Compatible with hMetis and KaHyPar CLI.
 
     verbose = result["verbose"].as<bool>();
     quiet = result["quiet"].as<bool>();
+    evolve = result["evolve"].as<bool>();
+    const auto use_hierarchy = result["hierarchy"].as<bool>();
+    const auto use_preprocess = !result["no-preprocess"].as<bool>();
     if (quiet) {
         verbose = false;
     }
 
+    if (!serve_socket.empty()) {
+        // one request per line, see PartitionServer
+        try {
+            auto server = PartitionServer{serve_socket, cache_size};
+            if (verbose) {
+                std::cerr << "Serving on " << serve_socket << "...\n";
+            }
+            server.serve();
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Error: " << e.what() << ".\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!batch_manifest.empty()) {
+        // one report line per job, see run_batch_pipeline
+        auto manifest_file = std::ifstream{};
+        if (batch_manifest != "-") {
+            manifest_file.open(batch_manifest);
+            if (manifest_file.fail()) {
+                std::cerr << "Error: Can't open manifest " << batch_manifest << ".\n";
+                return 1;
+            }
+        }
+        auto& manifest = batch_manifest == "-" ? std::cin : manifest_file;
+        auto pipeline_options = PipelineOptions{};
+        pipeline_options.cache_capacity = cache_size;
+        const auto summary = run_batch_pipeline(manifest, std::cout, pipeline_options);
+        if (verbose) {
+            std::cerr << summary.num_jobs << " jobs, " << summary.num_failed << " failed\n";
+        }
+        return summary.num_failed == 0U ? 0 : 1;
+    }
+
     if (hypergraph_file.empty()) {
         std::cerr << "Error: hypergraph_file is required.\n";
         std::cerr << "Use --help for usage information.\n";
@@ -263,15 +690,74 @@ Compatible with hMetis and KaHyPar CLI.
         return 1;
     }
 
+    if (result["stream"].as<bool>()) {
+        // one pass over the file: only the partition is kept in memory
+        auto stream_options = StreamPartitionOptions{};
+        stream_options.num_parts = static_cast<std::uint8_t>(k);
+        stream_options.imbalance = epsilon;
+        stream_options.block_prefix = stream_blocks_prefix;
+        auto streamed = StreamPartition{};
+        try {
+            streamed = partition_stream(hypergraph_file, input_format, stream_options);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << ".\n";
+            return 1;
+        }
+        if (verbose) {
+            std::cerr << "Hypergraph: " << streamed.part.size() << " vertices, "
+                      << streamed.num_nets << " nets\n";
+            std::cerr << "Partitioning cost (km1): " << streamed.cost << '\n';
+        }
+        return write_output(streamed.part, output_file, output_format) ? 0 : 1;
+    }
+
     auto config = get_preset_config(preset, static_cast<std::uint8_t>(k));
+    config.use_recursive = use_recursive;
     config.balance_tolerance = epsilon;
+    config.time_limit = time_limit;
+    if (result.count("vcycles") != 0U) {
+        config.num_vcycles = vcycles;
+    }
+    if (config.deterministic) {
+        // same partition for any number of threads: no timing and no random device
+        if (config.time_limit > 0.0) {
+            std::cerr << "Warning: the time limit is ignored in deterministic mode\n";
+            config.time_limit = 0.0;
+        }
+        if (seed == 0) {
+            seed = 1;
+        }
+        TaskScheduler::global().set_deterministic(true);
+    }
 
     if (verbose) {
         std::cerr << "Reading hypergraph from " << hypergraph_file << "...\n";
     }
 
-    auto hyprgraph = use_yosys ? read_yosys_json(hypergraph_file)
-                               : read_hypergraph(hypergraph_file, input_format);
+    if (use_hierarchy && (!use_yosys || evolve || (use_recursive && k > 2))) {
+        std::cerr << "Warning: --hierarchy applies to Yosys inputs in direct mode only\n";
+    }
+    const auto reuse_hierarchy = !save_hierarchy_file.empty() || !load_hierarchy_file.empty();
+    if (reuse_hierarchy && use_recursive && k > 2) {
+        std::cerr << "Warning: --save-hierarchy and --load-hierarchy apply to direct mode only\n";
+    }
+
+    // hMetis and netD files are parsed in parallel over a memory map, and Yosys JSON
+    // files are streamed
+    auto input = std::optional<SimpleNetlist>{};
+    auto instance = std::vector<std::uint32_t>{};
+    try {
+        if (use_yosys && use_hierarchy) {
+            input.emplace(read_yosys_json_hier(hypergraph_file, instance));
+        } else {
+            input.emplace(use_yosys ? read_yosys_json_stream(hypergraph_file)
+                                    : read_hypergraph_parallel(hypergraph_file, input_format));
+        }
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: " << e.what() << ".\n";
+        return 1;
+    }
+    auto& hyprgraph = *input;
 
     if (!fixed_file.empty()) {
         auto fix_fs = std::ifstream{fixed_file};
@@ -295,8 +781,58 @@ Compatible with hMetis and KaHyPar CLI.
         std::cerr << "K=" << k << ", epsilon=" << epsilon << ", preset=" << preset_str << '\n';
     }
 
-    auto num_modules = hyprgraph.number_of_modules();
-    const auto num_starts = std::max(threads, 1U);
+    auto preprocessed = use_preprocess ? preprocess_netlist(hyprgraph) : nullptr;
+    const SimpleNetlist& work_hgr = preprocessed ? *preprocessed : hyprgraph;
+    if (verbose && preprocessed) {
+        std::cerr << "Preprocessed: " << work_hgr.number_of_modules() << " vertices, "
+                  << work_hgr.number_of_nets() << " nets (" << preprocessed->num_removed_nets
+                  << " single-pin nets removed, " << preprocessed->detached_nets.size()
+                  << " large nets detached)\n";
+    }
+
+    // the instances seed the coarsening of the netlist that is partitioned
+    auto seed_clusters = std::vector<std::uint32_t>{};
+    if (!instance.empty()) {
+        if (preprocessed) {
+            seed_clusters.resize(work_hgr.number_of_modules(), 0U);
+            for (const auto& v : hyprgraph) {
+                seed_clusters[preprocessed->node_up_map[v]] = instance[v];
+            }
+        } else {
+            seed_clusters = std::move(instance);
+        }
+        config.seed_clusters = seed_clusters;
+    }
+
+    // a loaded hierarchy replaces the coarsening of the initial pass of every start
+    auto hierarchy = CoarseningHierarchy{work_hgr};
+    try {
+        if (!load_hierarchy_file.empty()) {
+            hierarchy.load(load_hierarchy_file);
+        } else if (!save_hierarchy_file.empty()) {
+            auto ctrl = CoarseningCtrl{config.balance_tolerance, config.num_parts};
+            if (!config.seed_clusters.empty()) {
+                ctrl.set_seed_clusters(work_hgr, {config.seed_clusters.begin(),
+                                                  config.seed_clusters.end()});
+            }
+            hierarchy.build(ctrl);
+        }
+        if (!save_hierarchy_file.empty()) {
+            hierarchy.save(save_hierarchy_file);
+        }
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: " << e.what() << ".\n";
+        return 1;
+    }
+    if (reuse_hierarchy) {
+        config.hierarchy = &hierarchy;
+        if (verbose) {
+            std::cerr << "Coarsening hierarchy: " << hierarchy.size() << " levels\n";
+        }
+    }
+
+    auto num_modules = work_hgr.number_of_modules();
+    const auto num_starts = std::max(starts, 1U);
 
     if (verbose) {
         if (seed != 0) {
@@ -308,57 +844,45 @@ Compatible with hMetis and KaHyPar CLI.
         if (seed != 0 || num_starts > 1) {
             std::cerr << '\n';
         }
+        std::cerr << "Threads: " << TaskScheduler::global().num_threads() << '\n';
         std::cerr << "Running partitioning (preset: " << preset_str
-                  << ", mode: " << (use_recursive ? "recursive" : "direct") << ")...\n";
+                  << ", mode: " << (evolve ? "evolve" : use_recursive ? "recursive" : "direct")
+                  << ")...\n";
     }
 
     auto best_part = std::vector<std::uint8_t>(num_modules, 0);
     auto best_cost = std::numeric_limits<int>::max();
 
-    if (num_starts == 1) {
+    if (evolve) {
+        // every member of the population is a direct multilevel run
+        const auto evolve_seed = seed != 0 ? seed : std::random_device{}();
+        auto local_gen = std::mt19937{evolve_seed};
+        random_init_part(best_part, work_hgr, static_cast<std::uint8_t>(k), local_gen);
+        best_cost = run_memetic_partition(work_hgr, config, refiner, std::max(num_starts, 2U),
+                                          evolve_seed, best_part);
+    } else if (num_starts == 1) {
         const auto start_seed = seed != 0 ? seed : std::random_device{}();
         auto local_gen = std::mt19937{start_seed};
-        random_init_part(best_part, hyprgraph, static_cast<std::uint8_t>(k), local_gen);
-        best_cost
-            = k == 2
-                  ? (use_recursive
-                         ? run_binary_partition(hyprgraph, config.balance_tolerance, best_part)
-                         : run_nn_binary_partition(hyprgraph, config.balance_tolerance, best_part))
-                  : (use_recursive
-                         ? run_kway_partition(hyprgraph, config.balance_tolerance, best_part,
-                                              static_cast<std::uint8_t>(k))
-                         : run_nn_kway_partition(hyprgraph, config.balance_tolerance, best_part,
-                                                 static_cast<std::uint8_t>(k)));
+        random_init_part(best_part, work_hgr, static_cast<std::uint8_t>(k), local_gen);
+        best_cost = run_partition(work_hgr, config, refiner, best_part);
     } else {
-        xnetwork::thread_pool pool(num_starts);
-        std::vector<std::future<std::pair<int, std::vector<std::uint8_t>>>> futures;
-        futures.reserve(num_starts);
-
+        // the starts share the scheduler with the parallel steps inside them
+        auto results = std::vector<std::pair<int, std::vector<std::uint8_t>>>(num_starts);
+        auto group = TaskGroup{};
         for (auto start = 0U; start < num_starts; ++start) {
             const auto start_seed = seed != 0 ? seed + start * 104729U : std::random_device{}();
-            futures.emplace_back(pool.enqueue([&hyprgraph, &config, k, use_recursive, start_seed,
-                                               num_modules]()
-                                                  -> std::pair<int, std::vector<std::uint8_t>> {
+            group.run([&work_hgr, &config, &results, k, refiner, start, start_seed, num_modules]() {
                 auto local_gen = std::mt19937{start_seed};
                 auto local_part = std::vector<std::uint8_t>(num_modules, 0);
-                random_init_part(local_part, hyprgraph, static_cast<std::uint8_t>(k), local_gen);
-                const auto local_cost
-                    = k == 2
-                          ? (use_recursive ? run_binary_partition(
-                                                 hyprgraph, config.balance_tolerance, local_part)
-                                           : run_nn_binary_partition(
-                                                 hyprgraph, config.balance_tolerance, local_part))
-                          : (use_recursive
-                                 ? run_kway_partition(hyprgraph, config.balance_tolerance,
-                                                      local_part, static_cast<std::uint8_t>(k))
-                                 : run_nn_kway_partition(hyprgraph, config.balance_tolerance,
-                                                         local_part, static_cast<std::uint8_t>(k)));
-                return {local_cost, std::move(local_part)};
-            }));
+                random_init_part(local_part, work_hgr, static_cast<std::uint8_t>(k), local_gen);
+                const auto local_cost = run_partition(work_hgr, config, refiner, local_part);
+                results[start] = {local_cost, std::move(local_part)};
+            });
         }
+        group.wait();
 
         for (auto start = 0U; start < num_starts; ++start) {
-            auto [local_cost, local_part] = futures[start].get();
+            auto& [local_cost, local_part] = results[start];
             if (verbose) {
                 std::cerr << "  Start " << start + 1 << '/' << num_starts << " cost: " << local_cost
                           << '\n';
@@ -369,7 +893,14 @@ Compatible with hMetis and KaHyPar CLI.
             }
         }
     }
-    auto part = std::move(best_part);
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+    if (preprocessed) {
+        preprocessed->projection_down(best_part, part);
+        best_cost += preprocessed->detached_cost(part);
+    } else {
+        part = std::move(best_part);
+        best_cost += large_net_cost(hyprgraph, part);
+    }
 
     {
         const auto balanced
@@ -388,16 +919,5 @@ Compatible with hMetis and KaHyPar CLI.
         std::cerr << "Partition written to stdout\n";
     }
 
-    if (output_file.empty()) {
-        write_partition(part, std::cout, output_format);
-    } else {
-        auto file = std::ofstream{output_file};
-        if (file.fail()) {
-            std::cerr << "Error: Can't open output file " << output_file << ".\n";
-            return 1;
-        }
-        write_partition(part, file, output_format);
-    }
-
-    return 0;
+    return write_output(part, output_file, output_format) ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include <algorithm>                    // for max
+#include <ckpttn/BatchPartitioner.hpp>  // for partition_batch, BatchOptions
+#include <ckpttn/TaskScheduler.hpp>     // for TaskScheduler
+#include <cstddef>                      // for size_t
+#include <cstdint>                      // for uint8_t
+#include <stdexcept>                    // for invalid_argument
+#include <utility>                      // for pair
+#include <vector>                       // for vector
+
+#include "test_common.hpp"
+
+static auto small_netlists() -> std::vector<SimpleNetlist> {
+    auto netlists = std::vector<SimpleNetlist>{};
+    const auto p1 = readNetD("../../testcases/p1.net");
+    for (auto i = 0; i != 4; ++i) {
+        netlists.push_back(create_test_netlist());
+        netlists.push_back(create_dwarf());
+        netlists.push_back(p1);
+    }
+    return netlists;
+}
+
+TEST_CASE("Test partition_batch") {
+    const auto netlists = small_netlists();
+    auto options = BatchOptions{};
+    options.num_parts = 3;
+    options.bal_tol = 0.4;
+
+    auto parts = std::vector<std::vector<std::uint8_t>>(netlists.size());
+    auto costs = std::vector<int>{};
+    {
+        auto scheduler = TaskScheduler{4};
+        const auto scope = TaskScheduler::Scope{&scheduler};
+        costs = partition_batch(netlists, parts, options);
+    }
+    REQUIRE_EQ(costs.size(), netlists.size());
+    for (auto i = 0U; i != netlists.size(); ++i) {
+        REQUIRE_EQ(parts[i].size(), netlists[i].number_of_modules());
+        auto max_part = std::uint8_t{0};
+        for (const auto p : parts[i]) {
+            max_part = std::max(max_part, p);
+        }
+        CHECK_LT(max_part, options.num_parts);
+        CHECK_GE(costs[i], 0);
+    }
+
+    // the same results on one thread, where one partitioner runs the whole batch
+    auto parts1 = std::vector<std::vector<std::uint8_t>>(netlists.size());
+    auto costs1 = std::vector<int>{};
+    {
+        auto scheduler = TaskScheduler{1};
+        const auto scope = TaskScheduler::Scope{&scheduler};
+        costs1 = partition_batch(netlists, parts1, options);
+    }
+    CHECK(costs1 == costs);
+    CHECK(parts1 == parts);
+
+    auto too_few = std::vector<std::vector<std::uint8_t>>(1);
+    CHECK_THROWS_AS(partition_batch(netlists, too_few, options), std::invalid_argument);
+}
+
+// the address and capacity of each buffer of a worker
+static auto buffer_state(const FMGainScratch<SimpleNetlist::node_t>& scratch)
+    -> std::vector<std::pair<const void*, size_t>> {
+    auto state = std::vector<std::pair<const void*, size_t>>{
+        {scratch.gain_bucket.data(), scratch.gain_bucket.capacity()},
+        {nullptr, static_cast<size_t>(scratch.bucket_range)},
+        {scratch.bi_vertex_list.data(), scratch.bi_vertex_list.capacity()},
+        {scratch.bi_init_gain_list.data(), scratch.bi_init_gain_list.capacity()},
+        {scratch.kway_vertex_list.data(), scratch.kway_vertex_list.capacity()},
+        {scratch.kway_init_gain_list.data(), scratch.kway_init_gain_list.capacity()},
+        {scratch.batch_slot.data(), scratch.batch_slot.capacity()},
+        {scratch.batch_nodes.data(), scratch.batch_nodes.capacity()},
+        {scratch.batch_delta.data(), scratch.batch_delta.capacity()}};
+    for (const auto& list : scratch.kway_vertex_list) {
+        state.emplace_back(list.data(), list.capacity());
+    }
+    for (const auto& list : scratch.kway_init_gain_list) {
+        state.emplace_back(list.data(), list.capacity());
+    }
+    return state;
+}
+
+TEST_CASE("Test partition_batch reuses the gain buffers") {
+    const auto netlists = small_netlists();
+    const auto num_p1 = netlists[2].number_of_modules();
+    auto scheduler = TaskScheduler{1};
+    const auto scope = TaskScheduler::Scope{&scheduler};
+    for (const auto num_parts : {2U, 3U}) {
+        auto options = BatchOptions{};
+        options.num_parts = static_cast<std::uint8_t>(num_parts);
+        options.bal_tol = 0.4;
+        auto scratch = BatchScratch{};
+        auto parts = std::vector<std::vector<std::uint8_t>>(netlists.size());
+        const auto costs = partition_batch(netlists, parts, options, scratch);
+        REQUIRE_EQ(scratch.workers.size(), 1U);
+        const auto& buffers = scratch.workers[0];
+        CHECK_EQ(buffers.gain_bucket.size(), num_parts);
+        CHECK_GE(buffers.batch_slot.capacity(), num_p1);
+        if (num_parts == 2) {
+            CHECK_GE(buffers.bi_vertex_list.capacity(), num_p1);
+        } else {
+            CHECK_GE(buffers.kway_vertex_list[0].capacity(), num_p1);
+        }
+
+        // sized by the first batch: the second one allocates no gain buffer
+        const auto state = buffer_state(buffers);
+        const auto costs2 = partition_batch(netlists, parts, options, scratch);
+        CHECK(buffer_state(scratch.workers[0]) == state);
+        CHECK(costs2 == costs);
+    }
+}
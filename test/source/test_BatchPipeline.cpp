@@ -0,0 +1,79 @@
+#include <ckpttn/BatchPipeline.hpp>  // for run_batch_pipeline, PipelineOptions
+#include <cstddef>                   // for size_t
+#include <filesystem>                // for temp_directory_path
+#include <fstream>                   // for ifstream
+#include <map>                       // for map
+#include <sstream>                   // for istringstream, ostringstream
+#include <string>                    // for string, getline
+
+#include "test_common.hpp"
+
+// the number of lines of a partition file, or 0 if a part is not below `num_parts`
+static auto partition_lines(const std::string& filename, unsigned int num_parts) -> size_t {
+    auto input = std::ifstream{filename};
+    auto num_lines = size_t{0U};
+    auto p = 0U;
+    while (input >> p) {
+        if (p >= num_parts) {
+            return 0U;
+        }
+        ++num_lines;
+    }
+    return num_lines;
+}
+
+TEST_CASE("Test run_batch_pipeline") {
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto out1 = (dir / "ckpttn_batch1.part").string();
+    const auto out2 = (dir / "ckpttn_batch2.part").string();
+    const auto out3 = (dir / "ckpttn_batch3.part").string();
+    auto text = std::ostringstream{};
+    text << "# regression jobs\n"
+         << "file=../../testcases/p1.net k=2 epsilon=5 output=" << out1 << "\n\n"
+         << "file=../../testcases/ibm01.net k=2 seed=3 output=" << out2 << '\n'
+         << "file=../../testcases/p1.net k=3 mode=direct seed=7 output=" << out3 << '\n'
+         << "file=../../testcases/p1.net k=1\n"
+         << "file=no_such_file.net\n";
+    auto manifest = std::istringstream{text.str()};
+    auto report = std::ostringstream{};
+    auto options = PipelineOptions{};
+    options.num_workers = 2;
+    options.queue_capacity = 1;
+    const auto summary = run_batch_pipeline(manifest, report, options);
+    CHECK_EQ(summary.num_jobs, 5U);
+    CHECK_EQ(summary.num_failed, 2U);
+
+    // one report line per job, by line number of the manifest
+    auto lines = std::map<int, std::string>{};
+    auto input = std::istringstream{report.str()};
+    auto line = 0;
+    auto status = std::string{};
+    while (input >> line && std::getline(input, status)) {
+        lines[line] = status;
+    }
+    REQUIRE_EQ(lines.size(), 5U);
+    CHECK_EQ(lines[2].rfind(" ok cost=", 0), 0U);
+    CHECK_EQ(lines[4].rfind(" ok cost=", 0), 0U);
+    CHECK_EQ(lines[5].rfind(" ok cost=", 0), 0U);
+    CHECK_EQ(lines[6].rfind(" error ", 0), 0U);
+    CHECK_EQ(lines[7].rfind(" error ", 0), 0U);
+    CHECK_NE(lines[2].find(" output=" + out1), std::string::npos);
+
+    const auto num_p1 = readNetD("../../testcases/p1.net").number_of_modules();
+    const auto num_ibm01 = readNetD("../../testcases/ibm01.net").number_of_modules();
+    CHECK_EQ(partition_lines(out1, 2), num_p1);
+    CHECK_EQ(partition_lines(out2, 2), num_ibm01);
+    CHECK_EQ(partition_lines(out3, 3), num_p1);
+    for (const auto& filename : {out1, out2, out3}) {
+        std::filesystem::remove(filename);
+    }
+}
+
+TEST_CASE("Test run_batch_pipeline empty manifest") {
+    auto manifest = std::istringstream{"# nothing to do\n"};
+    auto report = std::ostringstream{};
+    const auto summary = run_batch_pipeline(manifest, report, PipelineOptions{});
+    CHECK_EQ(summary.num_jobs, 0U);
+    CHECK_EQ(summary.num_failed, 0U);
+    CHECK(report.str().empty());
+}
@@ -0,0 +1,89 @@
+#include <algorithm>                  // for max
+#include <ckpttn/CoarseningCtrl.hpp>  // for CoarseningCtrl, CoarseningLevel
+#include <ckpttn/FMBiConstrMgr.hpp>   // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>     // for FMBiGainMgr
+#include <ckpttn/FMPartMgr.hpp>       // for FMPartMgr
+#include <ckpttn/MLPartMgr.hpp>       // for MLPartMgr
+#include <cstdint>                    // for uint8_t, uint32_t
+#include <vector>                     // for vector
+
+#include "test_common.hpp"
+
+TEST_CASE("Test CoarseningCtrl ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    CoarseningCtrl ctrl{0.45, 2};
+    CHECK_EQ(ctrl.coarsest_size(), 320);
+    CHECK(ctrl.should_coarsen(hyprgraph));
+
+    const auto bound = ctrl.max_cluster_weight(hyprgraph);
+    const auto hgr2 = ctrl.coarsen(hyprgraph);
+    REQUIRE(hgr2 != nullptr);
+    const auto& levels = ctrl.get_levels();
+    REQUIRE_EQ(levels.size(), 1);
+    CHECK_EQ(levels[0].num_modules, hyprgraph.number_of_modules());
+    CHECK_EQ(levels[0].num_modules2, hgr2->number_of_modules());
+    CHECK_LE(levels[0].ratio, 2.0 / 3.0);
+    CHECK_GE(levels[0].max_cluster_weight, bound);
+    CHECK_LE(levels[0].max_cluster_weight, std::max(bound, ctrl.max_part_weight(hyprgraph)));
+}
+
+TEST_CASE("Test CoarseningCtrl stalls within the balance bound") {
+    auto hyprgraph = readNetD("../../testcases/p1.net");
+    CoarseningCtrl ctrl{0.5, 2};
+    ctrl.set_max_ratio(0.01);  // unreachable without clusters heavier than a part
+    CHECK(ctrl.coarsen(hyprgraph) == nullptr);
+    CHECK(ctrl.get_levels().empty());
+}
+
+TEST_CASE("Test CoarseningCtrl keeps labels wider than a byte") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    CoarseningCtrl ctrl{0.45, 2};
+    ctrl.set_max_ratio(1.0);
+    // 256 and 512 share their low byte, so a truncated label would merge them
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto keep = std::vector<std::uint32_t>(num_modules, 0U);
+    for (auto v = 0U; v != num_modules; ++v) {
+        keep[v] = v < num_modules / 2U ? 256U : 512U;
+    }
+    const auto hgr2 = ctrl.coarsen(hyprgraph, keep);
+    REQUIRE(hgr2 != nullptr);
+    CHECK_LT(hgr2->number_of_modules(), num_modules);
+
+    auto keep2 = std::vector<std::uint32_t>(hgr2->number_of_modules(), 0U);
+    hgr2->projection_up(keep, keep2);
+    for (auto v = 0U; v != num_modules; ++v) {
+        CHECK_EQ(keep2[hgr2->node_up_map[v]], keep[v]);
+    }
+}
+
+TEST_CASE("Test MLPartMgr coarsening levels ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto bal_tol = 0.4;
+    MLPartMgr part_mgr{bal_tol};
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+    auto legal_check = part_mgr.run_Partition<
+        SimpleNetlist,
+        FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+        hyprgraph, part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+
+    // every level shrinks enough with clusters that fit in a part, and
+    // coarsening stops near the coarsest size
+    const auto& ctrl = part_mgr.get_coarsening();
+    const auto cap
+        = std::max(ctrl.max_cluster_weight(hyprgraph), ctrl.max_part_weight(hyprgraph));
+    const auto& levels = part_mgr.get_coarsening_levels();
+    REQUIRE_FALSE(levels.empty());
+    CHECK_EQ(levels.front().num_modules, hyprgraph.number_of_modules());
+    for (auto idx = 0U; idx != levels.size(); ++idx) {
+        CHECK_LE(levels[idx].ratio, 2.0 / 3.0);
+        CHECK_GE(levels[idx].num_modules, 320);
+        CHECK_LE(levels[idx].max_cluster_weight, cap);
+        if (idx != 0U) {
+            CHECK_EQ(levels[idx].num_modules, levels[idx - 1].num_modules2);
+        }
+    }
+}
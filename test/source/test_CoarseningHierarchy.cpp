@@ -0,0 +1,105 @@
+#include <ckpttn/CoarseningCtrl.hpp>       // for CoarseningCtrl
+#include <ckpttn/CoarseningHierarchy.hpp>  // for CoarseningHierarchy
+#include <ckpttn/FMKWayConstrMgr.hpp>      // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>        // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>            // for FMPartMgr
+#include <ckpttn/MLPartMgr.hpp>            // for MLPartMgr
+#include <cstdint>                         // for uint8_t
+#include <filesystem>                      // for temp_directory_path
+#include <stdexcept>                       // for runtime_error
+#include <string>                          // for string
+#include <vector>                          // for vector
+
+#include "test_common.hpp"
+
+static auto temp_hierarchy_file() -> std::string {
+    return (std::filesystem::temp_directory_path() / "ckpttn_test_ibm01.hier").string();
+}
+
+TEST_CASE("Test CoarseningHierarchy save and load ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    auto ctrl = CoarseningCtrl{0.4, 2};
+    auto hierarchy = CoarseningHierarchy{hyprgraph};
+    hierarchy.build(ctrl);
+    REQUIRE_GT(hierarchy.size(), 1U);
+    CHECK_EQ(hierarchy.get_stats().size(), hierarchy.size());
+    CHECK_EQ(hierarchy.find_coarser(hyprgraph), 0U);
+    CHECK_EQ(hierarchy.find_coarser(hierarchy.get_level(0)), 1U);
+    hierarchy.save(temp_hierarchy_file());
+
+    auto loaded = CoarseningHierarchy{hyprgraph};
+    loaded.load(temp_hierarchy_file());
+    REQUIRE_EQ(loaded.size(), hierarchy.size());
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules());
+    for (const auto& v : hyprgraph) {
+        part[v] = static_cast<std::uint8_t>(v % 3U);
+    }
+    for (auto i = 0U; i != hierarchy.size(); ++i) {
+        const auto& level = hierarchy.get_level(i);
+        const auto& level2 = loaded.get_level(i);
+        CHECK_EQ(level2.number_of_modules(), level.number_of_modules());
+        CHECK_EQ(level2.number_of_nets(), level.number_of_nets());
+        CHECK_EQ(level2.gr.number_of_edges(), level.gr.number_of_edges());
+        CHECK(level2.node_up_map == level.node_up_map);
+        CHECK_EQ(loaded.get_stats()[i].num_modules2, hierarchy.get_stats()[i].num_modules2);
+        auto weight_diffs = 0;
+        for (const auto& v : level) {
+            weight_diffs += level.get_module_weight(v) == level2.get_module_weight(v) ? 0 : 1;
+        }
+        CHECK_EQ(weight_diffs, 0);
+
+        // the loaded level projects the partitions as the original one
+        auto part_up = std::vector<std::uint8_t>(level.number_of_modules());
+        auto part_up2 = std::vector<std::uint8_t>(level.number_of_modules());
+        level.projection_up(part, part_up);
+        level2.projection_up(part, part_up2);
+        CHECK(part_up == part_up2);
+        auto part_down = std::vector<std::uint8_t>(part.size());
+        level2.projection_down(part_up2, part_down);
+        level.projection_down(part_up2, part);
+        CHECK(part_down == part);
+        part = std::move(part_up);
+    }
+
+    // the hierarchy of another netlist is rejected
+    const auto other = readNetD("../../testcases/p1.net");
+    auto mismatched = CoarseningHierarchy{other};
+    CHECK_THROWS_AS(mismatched.load(temp_hierarchy_file()), std::runtime_error);
+    CHECK_EQ(mismatched.size(), 0U);
+    std::filesystem::remove(temp_hierarchy_file());
+}
+
+TEST_CASE("Test MLPartMgr reusing a CoarseningHierarchy ibm01") {
+    using PartMgr
+        = FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>;
+
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    // built for 2 parts, reused for 3 parts and another balance tolerance
+    auto ctrl = CoarseningCtrl{0.4, 2};
+    auto hierarchy = CoarseningHierarchy{hyprgraph};
+    hierarchy.build(ctrl);
+
+    MLPartMgr part_mgr{0.3, 3};
+    part_mgr.get_coarsening().set_hierarchy(&hierarchy);
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+    for (const auto& v : hyprgraph) {
+        part[v] = static_cast<std::uint8_t>(v % 3U);
+    }
+    const auto legal_check = part_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+    CHECK_GT(part_mgr.total_cost, 0);
+
+    // the levels above the coarsest size of 3 parts are the ones of the hierarchy
+    const auto& levels = part_mgr.get_coarsening_levels();
+    const auto& stats = hierarchy.get_stats();
+    REQUIRE_FALSE(levels.empty());
+    auto num_reused = 0U;
+    while (num_reused != levels.size() && num_reused != stats.size()
+           && levels[num_reused].num_modules2 == stats[num_reused].num_modules2) {
+        ++num_reused;
+    }
+    CHECK_GT(num_reused, 0U);
+    CHECK_GE(levels.back().num_modules, part_mgr.get_coarsening().coarsest_size());
+}
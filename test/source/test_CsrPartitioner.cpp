@@ -0,0 +1,142 @@
+#include <algorithm>                  // for count, fill
+#include <ckpttn/CsrPartitioner.hpp>  // for partition_csr, to_csr_netlist, HypergraphCsrView
+#include <cstdint>                    // for int64_t, uint8_t, uint32_t
+#include <stdexcept>                  // for invalid_argument
+#include <vector>                     // for vector
+
+#include "test_common.hpp"
+
+// the CSR arrays of a netlist
+static void netlist_arrays(const SimpleNetlist& hyprgraph, std::vector<std::int64_t>& offsets,
+                           std::vector<std::int64_t>& pins) {
+    offsets.assign(1U, 0);
+    pins.clear();
+    for (const auto& net : hyprgraph.nets) {
+        for (const auto& v : hyprgraph.gr[net]) {
+            pins.push_back(v);
+        }
+        offsets.push_back(static_cast<std::int64_t>(pins.size()));
+    }
+}
+
+// the sum over the nets of the number of parts they span minus one
+static auto km1_cost(const SimpleNetlist& hyprgraph, const std::vector<std::uint8_t>& part,
+                     std::uint8_t num_parts) -> int {
+    auto cost = 0;
+    auto spanned = std::vector<bool>(num_parts);
+    for (const auto& net : hyprgraph.nets) {
+        std::fill(spanned.begin(), spanned.end(), false);
+        for (const auto& v : hyprgraph.gr[net]) {
+            spanned[part[v]] = true;
+        }
+        cost += static_cast<int>(std::count(spanned.begin(), spanned.end(), true)) - 1;
+    }
+    return cost;
+}
+
+TEST_CASE("Test partition_csr p1") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    auto offsets = std::vector<std::int64_t>{};
+    auto pins = std::vector<std::int64_t>{};
+    netlist_arrays(hyprgraph, offsets, pins);
+    const auto num_modules = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+    const auto csr = HypergraphCsrView<std::int64_t>{num_modules, offsets, pins, {}};
+
+    const auto hgr2 = to_netlist(csr);
+    CHECK_EQ(hgr2.number_of_modules(), hyprgraph.number_of_modules());
+    CHECK_EQ(hgr2.number_of_nets(), hyprgraph.number_of_nets());
+    CHECK_EQ(hgr2.gr.number_of_edges(), hyprgraph.gr.number_of_edges());
+
+    auto part = std::vector<std::uint8_t>(num_modules);
+    for (const auto refiner : {CsrRefiner::FM, CsrRefiner::NN, CsrRefiner::KWay}) {
+        for (const std::uint8_t num_parts : {2, 3}) {
+            auto options = CsrPartitionOptions{};
+            options.num_parts = num_parts;
+            options.bal_tol = 0.1;
+            options.refiner = refiner;
+            const auto cost = partition_csr(csr, std::span<std::uint8_t>{part}, options);
+            CHECK_GT(cost, 0);
+            CHECK_EQ(cost, km1_cost(hyprgraph, part, num_parts));
+            auto sizes = std::vector<std::uint32_t>(num_parts, 0U);
+            for (const auto p : part) {
+                REQUIRE_LT(p, num_parts);
+                ++sizes[p];
+            }
+            for (const auto size : sizes) {
+                CHECK_GT(size, 0U);
+            }
+
+            // the result as the initial partition of another run
+            options.use_initial = true;
+            const auto cost2 = partition_csr(csr, std::span<std::uint8_t>{part}, options);
+            CHECK_EQ(cost2, km1_cost(hyprgraph, part, num_parts));
+        }
+    }
+}
+
+TEST_CASE("Test to_csr_netlist p1") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    auto offsets = std::vector<std::int64_t>{};
+    auto pins = std::vector<std::int64_t>{};
+    netlist_arrays(hyprgraph, offsets, pins);
+    const auto num_modules = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+    const auto offsets32 = std::vector<std::uint32_t>(offsets.begin(), offsets.end());
+    const auto pins32 = std::vector<std::uint32_t>(pins.begin(), pins.end());
+
+    // the 64-bit arrays are copied, the 32-bit ones are read in place
+    const auto hgr64
+        = to_csr_netlist(HypergraphCsrView<std::int64_t>{num_modules, offsets, pins, {}});
+    const auto hgr32
+        = to_csr_netlist(HypergraphCsrView<std::uint32_t>{num_modules, offsets32, pins32, {}});
+    for (const auto* hgr2 : {&hgr64, &hgr32}) {
+        CHECK_EQ(hgr2->number_of_modules(), hyprgraph.number_of_modules());
+        CHECK_EQ(hgr2->number_of_nets(), hyprgraph.number_of_nets());
+        CHECK_EQ(hgr2->gr.number_of_edges(), hyprgraph.gr.number_of_edges());
+        CHECK_EQ(hgr2->get_max_degree(), hyprgraph.get_max_degree());
+        CHECK_EQ(hgr2->get_max_net_degree(), hyprgraph.get_max_net_degree());
+        for (auto node = 0U; node != hyprgraph.number_of_nodes(); ++node) {
+            const auto nbrs = hgr2->gr[node];
+            REQUIRE_EQ(nbrs.size(), hyprgraph.gr.degree(node));
+            for (const auto& w : nbrs) {
+                CHECK(hyprgraph.gr[node].contains(w));
+            }
+        }
+    }
+    CHECK_EQ(hgr32.gr[num_modules].data(), pins32.data());
+
+    // a repeated pin is dropped, as by to_netlist
+    const auto dup_offsets = std::vector<std::uint32_t>{0U, 3U, 5U};
+    const auto dup_pins = std::vector<std::uint32_t>{0U, 1U, 0U, 1U, 2U};
+    const auto dup = HypergraphCsrView<std::uint32_t>{3U, dup_offsets, dup_pins, {}};
+    const auto hgr_dup = to_csr_netlist(dup);
+    CHECK_EQ(hgr_dup.gr.degree(3U), 2U);
+    CHECK_EQ(hgr_dup.gr.degree(0U), 1U);
+    CHECK_EQ(hgr_dup.gr.number_of_edges(), to_netlist(dup).gr.number_of_edges());
+}
+
+TEST_CASE("Test partition_csr on malformed arrays") {
+    const auto offsets = std::vector<std::uint32_t>{0U, 3U, 6U, 9U};
+    const auto pins = std::vector<std::uint32_t>{0U, 1U, 2U, 0U, 3U, 4U, 1U, 2U, 4U};
+    const auto weights = std::vector<std::uint32_t>{10U, 1U, 1U, 1U, 1U};
+    auto part = std::vector<std::uint8_t>(5U);
+    const auto options = CsrPartitionOptions{};
+    const auto csr = HypergraphCsrView<std::uint32_t>{5U, offsets, pins, weights};
+    CHECK_EQ(to_netlist(csr).get_module_weight(0), 10U);
+    partition_csr(csr, std::span<std::uint8_t>{part}, options);
+
+    auto short_part = std::vector<std::uint8_t>(4U);
+    CHECK_THROWS_AS(partition_csr(csr, std::span<std::uint8_t>{short_part}, options),
+                    std::invalid_argument);
+    const auto bad_pin = HypergraphCsrView<std::uint32_t>{4U, offsets, pins, {}};
+    CHECK_THROWS_AS(to_netlist(bad_pin), std::invalid_argument);
+    const auto bad_offsets = std::vector<std::uint32_t>{0U, 6U, 3U, 9U};
+    CHECK_THROWS_AS(to_netlist(HypergraphCsrView<std::uint32_t>{5U, bad_offsets, pins, {}}),
+                    std::invalid_argument);
+    const auto short_offsets = std::vector<std::uint32_t>{0U, 3U, 6U};
+    CHECK_THROWS_AS(to_netlist(HypergraphCsrView<std::uint32_t>{5U, short_offsets, pins, {}}),
+                    std::invalid_argument);
+    const auto negative = std::vector<std::int32_t>{0, 2, -1, 0, 3, 4, 1, 2, 4};
+    const auto offsets2 = std::vector<std::int32_t>{0, 3, 6, 9};
+    CHECK_THROWS_AS(to_netlist(HypergraphCsrView<std::int32_t>{5U, offsets2, negative, {}}),
+                    std::invalid_argument);
+}
@@ -6,6 +6,8 @@
 #include <span>                    // for span
 #include <vector>                  // for vector
 
+#include "test_common.hpp"  // for check_gains_after_moves
+
 extern auto create_test_netlist() -> SimpleNetlist;  // import create_test_netlist
 extern auto create_dwarf() -> SimpleNetlist;         // import create_dwarf
 
@@ -46,3 +48,14 @@ TEST_CASE("Test FMBiGainMgr 2") {
     auto part_test = vector<uint8_t>{0, 0, 0, 0, 1, 1, 1};
     run_FMBiGainMgr(hyprgraph, part_test);
 }
+
+TEST_CASE("Test FMBiGainMgr update_move matches init") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    check_gains_after_moves<FMBiGainMgr<SimpleNetlist>>(hyprgraph, 2, 50);
+}
+
+TEST_CASE("Test FMBiGainMgr update_move matches init ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    check_gains_after_moves<FMBiGainMgr<SimpleNetlist>>(hyprgraph, 2, 500);
+}
@@ -0,0 +1,16 @@
+#include <ckpttn/FMKWayGainMgr.hpp>  // for FMKWayGainMgr
+#include <ckpttn/moveinfo.hpp>       // for MoveInfoV
+#include <netlistx/netlist.hpp>      // for SimpleNetlist
+
+#include "test_common.hpp"  // for check_gains_after_moves
+
+TEST_CASE("Test FMKWayGainMgr update_move matches init") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    check_gains_after_moves<FMKWayGainMgr<SimpleNetlist>>(hyprgraph, 3, 50);
+}
+
+TEST_CASE("Test FMKWayGainMgr update_move matches init ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    check_gains_after_moves<FMKWayGainMgr<SimpleNetlist>>(hyprgraph, 4, 500);
+}
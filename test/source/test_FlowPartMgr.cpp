@@ -0,0 +1,146 @@
+#include <ckpttn/BlockPairs.hpp>       // for BlockPair, disjoint_pair_rounds
+#include <ckpttn/FlowNetwork.hpp>      // for FlowNetwork
+#include <ckpttn/FlowPartMgr.hpp>      // for FlowPartMgr, refine_block_pair
+#include <cstdint>                     // for uint8_t
+#include <span>                        // for span
+#include <utility>                     // for move
+#include <vector>                      // for vector
+#include <xnetwork/classes/graph.hpp>  // for SimpleGraph
+
+#include "test_common.hpp"
+
+TEST_CASE("Test FlowNetwork max flow and minimum cuts") {
+    // s = 0, t = 5; the only minimum cut is {1 -> 3, 2 -> 4}, with capacity 5
+    auto network = FlowNetwork(6U);
+    network.add_edge(0U, 1U, 10);
+    network.add_edge(0U, 2U, 10);
+    network.add_edge(1U, 3U, 3);
+    network.add_edge(2U, 4U, 2);
+    network.add_edge(1U, 2U, 1);
+    network.add_edge(3U, 5U, 10);
+    network.add_edge(4U, 5U, 10);
+    CHECK_EQ(network.max_flow(0U, 5U), 5);
+
+    const auto expected_source = std::vector<std::uint8_t>{1U, 1U, 1U, 0U, 0U, 0U};
+    const auto expected_sink = std::vector<std::uint8_t>{0U, 0U, 0U, 1U, 1U, 1U};
+    CHECK(network.source_side() == expected_source);
+    CHECK(network.sink_side() == expected_sink);
+
+    // two saturated edges in a row: node 1 may be on either side
+    auto chain = FlowNetwork(4U);
+    chain.add_edge(0U, 1U, 1);
+    chain.add_edge(1U, 2U, 1);
+    chain.add_edge(2U, 3U, 5);
+    CHECK_EQ(chain.max_flow(0U, 3U), 1);
+    const auto chain_source = std::vector<std::uint8_t>{1U, 0U, 0U, 0U};
+    const auto chain_sink = std::vector<std::uint8_t>{0U, 0U, 1U, 1U};
+    CHECK(chain.source_side() == chain_source);
+    CHECK(chain.sink_side() == chain_sink);
+}
+
+TEST_CASE("Test disjoint_pair_rounds") {
+    const auto pairs = std::vector<BlockPair>{{0U, 1U}, {2U, 3U}, {0U, 2U}, {1U, 3U}, {0U, 3U}};
+    const auto rounds = disjoint_pair_rounds(pairs, 4U);
+    CHECK_EQ(rounds.size(), 3U);
+    const auto round0 = std::vector<BlockPair>{{0U, 1U}, {2U, 3U}};
+    const auto round1 = std::vector<BlockPair>{{0U, 2U}, {1U, 3U}};
+    const auto round2 = std::vector<BlockPair>{{0U, 3U}};
+    CHECK(rounds[0] == round0);
+    CHECK(rounds[1] == round1);
+    CHECK(rounds[2] == round2);
+}
+
+/**
+ * @brief Creates a chain of 8 modules whose links are bundles of 2-pin nets.
+ *
+ * The links 0-1, ..., 6-7 have 5, 5, 1, 3, 5, 1 and 5 nets. With modules
+ * 0-3 in block 0 and 4-7 in block 1, the cut is 3, and the links 2-3 and
+ * 5-6 are the two minimum cuts, of 1.
+ *
+ * @param[out] cut_nets The nets of the link 3-4
+ */
+static auto create_flow_chain(std::vector<SimpleNetlist::node_t>& cut_nets) -> SimpleNetlist {
+    constexpr auto num_modules = 8U;
+    constexpr auto num_nets = 25U;
+    auto gr = xnetwork::SimpleGraph(num_modules + num_nets);
+    auto i_net = num_modules;
+    auto v = 0U;
+    for (const auto num_links : {5U, 5U, 1U, 3U, 5U, 1U, 5U}) {
+        for (auto i = 0U; i != num_links; ++i) {
+            gr.add_edge(v, i_net);
+            gr.add_edge(v + 1U, i_net);
+            if (v == 3U) {
+                cut_nets.push_back(SimpleNetlist::node_t(i_net));
+            }
+            ++i_net;
+        }
+        ++v;
+    }
+    return SimpleNetlist(std::move(gr), num_modules, num_nets);
+}
+
+TEST_CASE("Test refine_block_pair takes the more balanced minimum cut") {
+    auto cut_nets = std::vector<SimpleNetlist::node_t>{};
+    const auto hyprgraph = create_flow_chain(cut_nets);
+    const auto snapshot = std::vector<std::uint8_t>{0U, 0U, 0U, 0U, 1U, 1U, 1U, 1U};
+    const auto fixed = std::vector<std::uint8_t>(8U, 0U);
+
+    // cutting 2-3 moves module 3 (weights 3 and 5); cutting 5-6 moves modules
+    // 4 and 5 (weights 6 and 2). Block 0 as the source finds the first one as
+    // the smallest source side, block 1 as the source as the largest one.
+    const auto expected = std::vector<std::uint8_t>{0U, 0U, 0U, 1U, 1U, 1U, 1U, 1U};
+    for (const auto& pair : {BlockPair{0U, 1U}, BlockPair{1U, 0U}}) {
+        auto part = snapshot;
+        auto part_weight = std::vector<unsigned int>{4U, 4U};
+        const auto gain = refine_block_pair(
+            hyprgraph, std::span<const std::uint8_t>(snapshot), std::span<std::uint8_t>(part),
+            std::span<const std::uint8_t>(fixed), pair,
+            std::span<const SimpleNetlist::node_t>(cut_nets), std::span<unsigned int>(part_weight),
+            2U, 2000U);
+        CHECK_EQ(gain, 2);
+        CHECK(part == expected);
+        CHECK_EQ(part_weight[0], 3U);
+        CHECK_EQ(part_weight[1], 5U);
+    }
+}
+
+TEST_CASE("Test refine_block_pair keeps the region within the weight budget") {
+    auto cut_nets = std::vector<SimpleNetlist::node_t>{};
+    auto hyprgraph = create_flow_chain(cut_nets);
+    hyprgraph.module_weight = {1U, 1U, 1U, 2U, 2U, 1U, 1U, 1U};
+    const auto snapshot = std::vector<std::uint8_t>{0U, 0U, 0U, 0U, 1U, 1U, 1U, 1U};
+    const auto fixed = std::vector<std::uint8_t>(8U, 0U);
+
+    // blocks of weight 5; module 3 (weight 2) may only move if the budget of
+    // block 0 is at least 2
+    for (const auto lowerbound : {2U, 3U, 4U, 5U}) {
+        auto part = snapshot;
+        auto part_weight = std::vector<unsigned int>{5U, 5U};
+        const auto gain = refine_block_pair(
+            hyprgraph, std::span<const std::uint8_t>(snapshot), std::span<std::uint8_t>(part),
+            std::span<const std::uint8_t>(fixed), BlockPair{0U, 1U},
+            std::span<const SimpleNetlist::node_t>(cut_nets), std::span<unsigned int>(part_weight),
+            lowerbound, 2000U);
+        CHECK_EQ(gain, lowerbound <= 3U ? 2 : 0);
+        CHECK_GE(part_weight[0], lowerbound);
+        CHECK_GE(part_weight[1], lowerbound);
+        auto weight = std::vector<unsigned int>{0U, 0U};
+        for (auto v = 0U; v != 8U; ++v) {
+            weight[part[v]] += hyprgraph.get_module_weight(v);
+        }
+        CHECK(weight == part_weight);
+    }
+}
+
+TEST_CASE("Test FlowPartMgr ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto bal_tol = 0.45;
+    const auto cost = check_bi_refiner<FlowPartMgr>(hyprgraph, bal_tol);
+    CHECK_LE(cost, fm_bi_cost(hyprgraph, bal_tol));
+}
+
+TEST_CASE("Test MLPartMgr with FlowPartMgr p1 4-way") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    check_ml_refiner<FlowPartMgr>(hyprgraph, 0.4, 4);
+}
@@ -0,0 +1,107 @@
+#include <ckpttn/ConnectivityInfo.hpp>    // for ConnectivityInfo
+#include <ckpttn/FMBiConstrMgr.hpp>       // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>         // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>     // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>       // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>           // for FMPartMgr
+#include <ckpttn/IncrementalPartMgr.hpp>  // for IncrementalPartMgr, NetlistDelta
+#include <ckpttn/MLPartMgr.hpp>           // for MLPartMgr
+#include <cstdint>                        // for uint8_t, uint32_t
+#include <stdexcept>                      // for invalid_argument
+#include <vector>                         // for vector
+
+#include "test_common.hpp"
+
+using BiPartMgr
+    = FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>;
+using KWayPartMgr
+    = FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>;
+
+/**
+ * @brief Returns a small change of a netlist: two added modules on an added
+ * net, a removed module, a removed net and a moved pin.
+ */
+static auto small_delta(const SimpleNetlist& hyprgraph) -> NetlistDelta {
+    const auto num_modules = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+    auto delta = NetlistDelta{};
+    delta.num_added_modules = 2U;
+    delta.added_nets = {{num_modules, num_modules + 1U, 0U}};
+    delta.added_pins = {{1U, num_modules}, {2U, num_modules + 1U}};
+    delta.removed_modules = {5U};
+    delta.removed_nets = {3U};
+    const auto v = *hyprgraph.gr[num_modules + 4U].begin();
+    delta.removed_pins = {{4U, static_cast<std::uint32_t>(v)}};
+    return delta;
+}
+
+template <typename PartMgr>
+static void check_eco(const SimpleNetlist& hyprgraph, double bal_tol, std::uint8_t num_parts) {
+    auto prev_part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+    MLPartMgr ml_mgr{bal_tol, num_parts};
+    auto legal_check = ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, prev_part);
+    REQUIRE_EQ(legal_check, LegalCheck::AllSatisfied);
+
+    const auto patched = apply_netlist_delta(hyprgraph, small_delta(hyprgraph));
+    const auto& hgr = patched.netlist;
+    CHECK_EQ(hgr.number_of_modules(), hyprgraph.number_of_modules() + 1U);
+    CHECK_EQ(hgr.number_of_nets(), hyprgraph.number_of_nets());
+    CHECK_EQ(patched.module_map[5], PatchedNetlist::REMOVED);
+    CHECK_EQ(patched.module_map[6], 5U);
+    CHECK_FALSE(patched.affected.empty());
+
+    IncrementalPartMgr eco_mgr{bal_tol, num_parts};
+    auto part = std::vector<std::uint8_t>(hgr.number_of_modules(), 0);
+    legal_check = eco_mgr.run_Partition<PartMgr>(hyprgraph, prev_part, patched, part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+    CHECK_EQ(eco_mgr.previous_cost, ml_mgr.total_cost);
+    CHECK_FALSE(eco_mgr.full_run);
+
+    using ConstrMgr = typename PartMgr::ConstrMgr_;
+    auto constr_mgr = ConstrMgr(hgr, bal_tol, num_parts);
+    CHECK(constr_mgr.final_check(part));
+    auto conn = ConnectivityInfo<SimpleNetlist>(hgr, num_parts);
+    conn.init(part, 1U);
+    CHECK_EQ(conn.cost(), eco_mgr.total_cost);
+
+    // a tolerance of -100% forces a full run
+    eco_mgr.set_max_degradation(-1.0);
+    legal_check = eco_mgr.run_Partition<PartMgr>(hyprgraph, prev_part, patched, part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+    CHECK(eco_mgr.full_run);
+    CHECK(constr_mgr.final_check(part));
+    conn.init(part, 1U);
+    CHECK_EQ(conn.cost(), eco_mgr.total_cost);
+}
+
+TEST_CASE("Test IncrementalPartMgr ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    check_eco<BiPartMgr>(hyprgraph, 0.45, 2);
+}
+
+TEST_CASE("Test IncrementalPartMgr p1 3-way") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    check_eco<KWayPartMgr>(hyprgraph, 0.4, 3);
+}
+
+TEST_CASE("Test apply_netlist_delta errors") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto num_modules = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+    auto delta = NetlistDelta{};
+    delta.removed_modules = {num_modules};
+    CHECK_THROWS_AS(apply_netlist_delta(hyprgraph, delta), std::invalid_argument);
+    delta = NetlistDelta{};
+    delta.added_pins = {{static_cast<std::uint32_t>(hyprgraph.number_of_nets()), 0U}};
+    CHECK_THROWS_AS(apply_netlist_delta(hyprgraph, delta), std::invalid_argument);
+    delta = NetlistDelta{};
+    delta.num_added_modules = 2U;
+    delta.added_module_weight = {1U};
+    CHECK_THROWS_AS(apply_netlist_delta(hyprgraph, delta), std::invalid_argument);
+
+    IncrementalPartMgr eco_mgr{0.4, 2};
+    const auto patched = apply_netlist_delta(hyprgraph, NetlistDelta{});
+    auto prev_part = std::vector<std::uint8_t>(num_modules, 0);
+    auto part = std::vector<std::uint8_t>(num_modules + 1U, 0);
+    CHECK_THROWS_AS(eco_mgr.run_Partition<BiPartMgr>(hyprgraph, prev_part, patched, part),
+                    std::invalid_argument);
+}
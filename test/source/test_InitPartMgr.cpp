@@ -0,0 +1,54 @@
+#include <ckpttn/FMBiConstrMgr.hpp>    // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>      // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
+#include <ckpttn/InitPartMgr.hpp>      // for InitPartMgr
+#include <cstdint>                     // for uint8_t
+#include <vector>                      // for vector
+
+#include "test_common.hpp"
+
+TEST_CASE("Test InitPartMgr dwarf") {
+    const auto hyprgraph = create_dwarf();
+    const auto bal_tol = 0.3;
+    InitPartMgr init_mgr{bal_tol, 2};
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+    auto legal_check = init_mgr.run_Partition<
+        SimpleNetlist,
+        FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+        hyprgraph, part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+
+    auto constr_mgr = FMBiConstrMgr<SimpleNetlist>(hyprgraph, bal_tol);
+    CHECK(constr_mgr.final_check(part));
+    CHECK_LE(init_mgr.total_cost, 2);
+}
+
+TEST_CASE("Test InitPartMgr p1 3-way") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto bal_tol = 0.4;
+    const auto num_parts = std::uint8_t{3};
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+
+    InitPartMgr serial_mgr{bal_tol, num_parts};
+    serial_mgr.set_num_threads(1);
+    auto part1 = part;
+    serial_mgr.run_Partition<
+        SimpleNetlist,
+        FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+        hyprgraph, part1);
+
+    InitPartMgr parallel_mgr{bal_tol, num_parts};
+    parallel_mgr.set_num_threads(4);
+    auto part2 = part;
+    auto legal_check = parallel_mgr.run_Partition<
+        SimpleNetlist,
+        FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>, FMKWayConstrMgr<SimpleNetlist>>>(
+        hyprgraph, part2);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+
+    auto constr_mgr = FMKWayConstrMgr<SimpleNetlist>(hyprgraph, bal_tol, num_parts);
+    CHECK(constr_mgr.final_check(part2));
+    CHECK_EQ(part1, part2);
+    CHECK_EQ(serial_mgr.total_cost, parallel_mgr.total_cost);
+}
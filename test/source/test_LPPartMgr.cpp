@@ -0,0 +1,14 @@
+#include <ckpttn/LPPartMgr.hpp>  // for LPPartMgr
+
+#include "test_common.hpp"
+
+TEST_CASE("Test LPPartMgr ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    check_bi_refiner<LPPartMgr>(hyprgraph, 0.45);
+}
+
+TEST_CASE("Test MLPartMgr with LPPartMgr p1 3-way") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    check_ml_refiner<LPPartMgr>(hyprgraph, 0.4, 3);
+}
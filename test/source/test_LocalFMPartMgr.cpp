@@ -0,0 +1,57 @@
+#include <ckpttn/FMBiConstrMgr.hpp>   // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>     // for FMBiGainMgr
+#include <ckpttn/LocalFMPartMgr.hpp>  // for LocalFMPartMgr
+#include <cstdint>                    // for uint8_t, uint32_t
+#include <span>                       // for span
+#include <vector>                     // for vector
+
+#include "test_common.hpp"
+
+TEST_CASE("Test LocalFMPartMgr ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    check_bi_refiner<LocalFMPartMgr>(hyprgraph, 0.45);
+}
+
+TEST_CASE("Test LocalFMPartMgr ibm01 only moves the region") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto bal_tol = 0.45;
+    using GainMgr = FMBiGainMgr<SimpleNetlist>;
+    using ConstrMgr = FMBiConstrMgr<SimpleNetlist>;
+    using node_t = SimpleNetlist::node_t;
+
+    GainMgr gain_mgr{hyprgraph};
+    ConstrMgr constr_mgr{hyprgraph, bal_tol};
+    LocalFMPartMgr<SimpleNetlist, GainMgr, ConstrMgr> part_mgr{hyprgraph, gain_mgr, constr_mgr, 2};
+    auto part = alternating_part(hyprgraph);
+    CHECK_EQ(part_mgr.legalize(part), LegalCheck::AllSatisfied);
+    const auto totalcostbefore = part_mgr.total_cost;
+    const auto before = part;
+
+    // the first half of the modules
+    const auto num_modules = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+    auto region = std::vector<node_t>{};
+    for (auto v = 0U; v != num_modules / 2U; ++v) {
+        region.push_back(node_t(v));
+    }
+    part_mgr.set_region(std::span<const node_t>(region));
+    part_mgr.optimize(part);
+    CHECK_LT(part_mgr.total_cost, totalcostbefore);
+    CHECK(constr_mgr.final_check(part));
+
+    auto num_moved_outside = 0U;
+    for (auto v = num_modules / 2U; v != num_modules; ++v) {
+        num_moved_outside += part[v] != before[v] ? 1U : 0U;
+    }
+    CHECK_EQ(num_moved_outside, 0U);
+
+    // the cost agrees with the FM gain calculation
+    GainMgr gain_mgr2{hyprgraph};
+    CHECK_EQ(gain_mgr2.init(part), part_mgr.total_cost);
+}
+
+TEST_CASE("Test MLPartMgr with LocalFMPartMgr p1 3-way") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    check_ml_refiner<LocalFMPartMgr>(hyprgraph, 0.4, 3);
+}
@@ -126,6 +126,64 @@ TEST_CASE("Test MLBiPartMgr ibm01") {
     CHECK_LE(mincost, 1000U);
 }
 
+TEST_CASE("Test MLBiPartMgr ibm01 vcycles") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto bal_tol = 0.4;
+    using PartMgr
+        = FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>;
+
+    auto part0 = vector<uint8_t>(hyprgraph.number_of_modules(), 0);
+    auto whichPart = static_cast<uint8_t>(0);
+    for (auto& elem : part0) {
+        whichPart ^= 1;
+        elem = whichPart;
+    }
+
+    MLPartMgr single_mgr{bal_tol};
+    single_mgr.set_limitsize(10);
+    auto part1 = part0;
+    single_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part1);
+
+    MLPartMgr vcycle_mgr{bal_tol};
+    vcycle_mgr.set_limitsize(10);
+    vcycle_mgr.set_num_vcycles(3);
+    auto part2 = part0;
+    auto legal_check = vcycle_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part2);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+
+    auto constr_mgr = FMBiConstrMgr<SimpleNetlist>(hyprgraph, bal_tol);
+    CHECK(constr_mgr.final_check(part2));
+    CHECK_LE(vcycle_mgr.total_cost, single_mgr.total_cost);
+}
+
+TEST_CASE("Test MLBiPartMgr p1 fixed modules") {
+    auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto bal_tol = 0.4;
+    MLPartMgr part_mgr{bal_tol};
+    part_mgr.set_limitsize(10);
+
+    auto part = vector<uint8_t>(hyprgraph.number_of_modules(), 0);
+    for (auto v = 0U; v < hyprgraph.number_of_modules(); v += 7) {
+        hyprgraph.module_fixed.insert(v);
+        part[v] = static_cast<uint8_t>((v / 7) % 2);
+    }
+    hyprgraph.has_fixed_modules = true;
+    const auto part0 = part;
+
+    auto legal_check = part_mgr.run_Partition<
+        SimpleNetlist,
+        FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>>(
+        hyprgraph, part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+
+    auto constr_mgr = FMBiConstrMgr<SimpleNetlist>(hyprgraph, bal_tol);
+    CHECK(constr_mgr.final_check(part));
+    for (const auto& v : hyprgraph.module_fixed) {
+        CHECK_EQ(part[v], part0[v]);
+    }
+}
+
 TEST_CASE("Test MLBiPartMgr ibm03") {
     auto hyprgraph = readNetD("../../testcases/ibm03.net");
     readAre(hyprgraph, "../../testcases/ibm03.are");
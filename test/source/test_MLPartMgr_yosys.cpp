@@ -7,6 +7,7 @@
 #include <ckpttn/FMKWayGainMgr.hpp>
 #include <ckpttn/FMPartMgr.hpp>
 #include <ckpttn/MLPartMgr.hpp>
+#include <ckpttn/YosysStreamReader.hpp>
 #include <cstdint>
 #include <netlistx/netlist.hpp>
 #include <netlistx/readwrite.hpp>
@@ -79,3 +80,29 @@ TEST_CASE("Test MLKWayPartMgr sphere3hopf_netlist") {
     CHECK(constr_mgr.final_check(part));
     CHECK_GE(part_mgr.total_cost, 0);
 }
+
+TEST_CASE("Test MLBiPartMgr sphere_netlist seeded by the design hierarchy") {
+    auto instance = vector<uint32_t>{};
+    const auto hyprgraph
+        = read_yosys_json_hier("../../yosys_testcases/sphere_netlist.json", instance);
+    const auto bal_tol = 0.3;
+    MLPartMgr part_mgr{bal_tol};
+    part_mgr.get_coarsening().set_seed_clusters(hyprgraph, instance);
+    vector<uint8_t> part(hyprgraph.number_of_modules(), 0);
+    auto legal_check
+        = part_mgr.run_Partition<SimpleNetlist, FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                                                          FMBiConstrMgr<SimpleNetlist>>>(hyprgraph,
+                                                                                         part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+
+    auto constr_mgr = FMBiConstrMgr<SimpleNetlist>(hyprgraph, bal_tol);
+    CHECK(constr_mgr.final_check(part));
+    CHECK_GE(part_mgr.total_cost, 0);
+
+    // the first level merges the instances, split by the cluster weight bound
+    const auto& levels = part_mgr.get_coarsening_levels();
+    REQUIRE_FALSE(levels.empty());
+    CHECK_EQ(levels[0].num_modules, hyprgraph.number_of_modules());
+    CHECK_GE(levels[0].num_modules2, 107U);
+    CHECK_LT(levels[0].num_modules2, 200U);
+}
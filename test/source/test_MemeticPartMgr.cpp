@@ -0,0 +1,91 @@
+#include <ckpttn/FMBiConstrMgr.hpp>    // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>      // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
+#include <ckpttn/MLPartMgr.hpp>        // for MLPartMgr
+#include <ckpttn/MemeticPartMgr.hpp>   // for MemeticPartMgr
+#include <cstdint>                     // for uint8_t
+#include <vector>                      // for vector
+
+#include "test_common.hpp"
+
+TEST_CASE("Test MLPartMgr recombination ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto num_modules = hyprgraph.number_of_modules();
+    using PartMgr = FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                              FMBiConstrMgr<SimpleNetlist>>;
+
+    auto parent1 = std::vector<std::uint8_t>(num_modules, 0U);
+    auto parent2 = std::vector<std::uint8_t>(num_modules, 0U);
+    for (auto v = 0U; v != num_modules; ++v) {
+        parent2[v] = static_cast<std::uint8_t>(v % 2U);
+    }
+    MLPartMgr ml_mgr{0.4};
+    ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, parent1);
+    const auto cost1 = ml_mgr.total_cost;
+    ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, parent2);
+
+    auto child = parent1;
+    ml_mgr.run_Recombine<SimpleNetlist, PartMgr>(hyprgraph, child, parent2);
+    CHECK_LE(ml_mgr.total_cost, cost1);
+    auto constr_mgr = FMBiConstrMgr<SimpleNetlist>(hyprgraph, 0.4);
+    CHECK(constr_mgr.final_check(child));
+    FMBiGainMgr<SimpleNetlist> gain_mgr{hyprgraph};
+    CHECK_EQ(gain_mgr.init(child), ml_mgr.total_cost);
+}
+
+TEST_CASE("Test MLPartMgr recombination p1 20-way") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto num_parts = std::uint8_t{20};
+    using PartMgr = FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                              FMKWayConstrMgr<SimpleNetlist>>;
+
+    // the overlay of two 20-way partitions has up to 400 labels
+    auto parent1 = std::vector<std::uint8_t>(num_modules, 0U);
+    auto parent2 = std::vector<std::uint8_t>(num_modules, 0U);
+    for (auto v = 0U; v != num_modules; ++v) {
+        parent1[v] = static_cast<std::uint8_t>(v % num_parts);
+        parent2[v] = static_cast<std::uint8_t>(v / 3U % num_parts);
+    }
+    MLPartMgr ml_mgr{0.4, num_parts};
+    ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, parent1);
+    const auto cost1 = ml_mgr.total_cost;
+    ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, parent2);
+
+    auto child = parent1;
+    ml_mgr.run_Recombine<SimpleNetlist, PartMgr>(hyprgraph, child, parent2);
+    CHECK_LE(ml_mgr.total_cost, cost1);
+    auto constr_mgr = FMKWayConstrMgr<SimpleNetlist>(hyprgraph, 0.4, num_parts);
+    CHECK(constr_mgr.final_check(child));
+    FMKWayGainMgr<SimpleNetlist> gain_mgr{hyprgraph, num_parts};
+    CHECK_EQ(gain_mgr.init(child), ml_mgr.total_cost);
+}
+
+TEST_CASE("Test MemeticPartMgr p1") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto num_parts = std::uint8_t{3};
+    using PartMgr = FMPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                              FMKWayConstrMgr<SimpleNetlist>>;
+
+    // a single multilevel run from the same start is the first member
+    auto part_ml = std::vector<std::uint8_t>(num_modules, 0U);
+    MLPartMgr ml_mgr{0.4, num_parts};
+    ml_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part_ml);
+
+    auto part = std::vector<std::uint8_t>(num_modules, 0U);
+    MemeticPartMgr memetic_mgr{0.4, num_parts};
+    memetic_mgr.set_population_size(4);
+    memetic_mgr.set_num_generations(2);
+    const auto legalcheck = memetic_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, part);
+    CHECK_EQ(legalcheck, LegalCheck::AllSatisfied);
+    CHECK_EQ(memetic_mgr.num_generations_run, 2U);
+    CHECK_LE(memetic_mgr.total_cost, ml_mgr.total_cost);
+
+    auto constr_mgr = FMKWayConstrMgr<SimpleNetlist>(hyprgraph, 0.4, num_parts);
+    CHECK(constr_mgr.final_check(part));
+    FMKWayGainMgr<SimpleNetlist> gain_mgr{hyprgraph, num_parts};
+    CHECK_EQ(gain_mgr.init(part), memetic_mgr.total_cost);
+}
@@ -1,3 +1,5 @@
+#include <ckpttn/BlockPairs.hpp>
+#include <ckpttn/FMKWayGainMgr.hpp>
 #include <ckpttn/MidLvlKWayPartMgr.hpp>
 #include <cstdint>
 #include <netlistx/netlist.hpp>
@@ -19,3 +21,69 @@ TEST_CASE("Test MidLvlKWayPartMgr dwarf 3-way") {
     part_mgr.optimize(part, hyprgraph);
     CHECK_GE(part_mgr.total_cost, 0);
 }
+
+TEST_CASE("Test round_robin_rounds") {
+    const auto rounds = round_robin_rounds(4U);
+    CHECK_EQ(rounds.size(), 3U);
+    const auto round0 = std::vector<BlockPair>{{0U, 3U}, {1U, 2U}};
+    const auto round1 = std::vector<BlockPair>{{1U, 3U}, {0U, 2U}};
+    const auto round2 = std::vector<BlockPair>{{2U, 3U}, {0U, 1U}};
+    CHECK(rounds[0] == round0);
+    CHECK(rounds[1] == round1);
+    CHECK(rounds[2] == round2);
+
+    // every pair occurs exactly once, and no block twice in a round
+    for (const auto num_parts : {3U, 7U, 8U}) {
+        const auto schedule = round_robin_rounds(static_cast<std::uint8_t>(num_parts));
+        auto seen = std::vector<int>(num_parts * num_parts, 0);
+        for (const auto& round : schedule) {
+            CHECK_EQ(round.size(), num_parts / 2U);
+            auto used = std::vector<int>(num_parts, 0);
+            for (const auto& [a, b] : round) {
+                CHECK_LT(a, b);
+                ++seen[a * num_parts + b];
+                ++used[a];
+                ++used[b];
+            }
+            for (const auto& count : used) {
+                CHECK_LE(count, 1);
+            }
+        }
+        for (auto a = 0U; a != num_parts; ++a) {
+            for (auto b = a + 1U; b != num_parts; ++b) {
+                CHECK_EQ(seen[a * num_parts + b], 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test MidLvlKWayPartMgr dwarf 4-way cost and threads") {
+    const auto hyprgraph = create_dwarf();
+    const auto N = hyprgraph.number_of_modules();
+    const auto num_parts = std::uint8_t{4};
+
+    std::vector<std::uint8_t> init_part(N, 0);
+    for (auto i = 0U; i < N; ++i) {
+        init_part[i] = static_cast<std::uint8_t>(i % num_parts);
+    }
+    FMKWayGainMgr<SimpleNetlist> init_gain_mgr{hyprgraph, num_parts};
+    const auto init_cost = init_gain_mgr.init(init_part);
+
+    auto part = init_part;
+    MidLvlKWayPartMgr part_mgr{0.4, num_parts};
+    part_mgr.set_num_threads(1);
+    part_mgr.optimize(part, hyprgraph);
+    CHECK_LE(part_mgr.total_cost, init_cost);
+
+    // the cost agrees with the FM gain calculation
+    FMKWayGainMgr<SimpleNetlist> gain_mgr{hyprgraph, num_parts};
+    CHECK_EQ(gain_mgr.init(part), part_mgr.total_cost);
+
+    // the result does not depend on the number of threads
+    auto part2 = init_part;
+    MidLvlKWayPartMgr part_mgr2{0.4, num_parts};
+    part_mgr2.set_num_threads(4);
+    part_mgr2.optimize(part2, hyprgraph);
+    CHECK(part2 == part);
+    CHECK_EQ(part_mgr2.total_cost, part_mgr.total_cost);
+}
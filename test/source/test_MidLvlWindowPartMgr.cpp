@@ -0,0 +1,86 @@
+#include <algorithm>                       // for min
+#include <bit>                             // for popcount
+#include <ckpttn/FMBiConstrMgr.hpp>        // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>          // for FMBiGainMgr
+#include <ckpttn/MidLvlWindowPartMgr.hpp>  // for MidLvlWindowPartMgr
+#include <cstdint>                         // for uint8_t, uint32_t
+#include <limits>                          // for numeric_limits
+#include <utility>                         // for move
+#include <vector>                          // for vector
+#include <xnetwork/classes/graph.hpp>      // for SimpleGraph
+
+#include "test_common.hpp"
+
+/**
+ * @brief Creates a netlist of 10 modules and 15 nets of 2 or 3 pins.
+ */
+static auto create_window_netlist() -> SimpleNetlist {
+    constexpr auto num_modules = 10U;
+    const auto nets = std::vector<std::vector<std::uint32_t>>{
+        {0, 3}, {3, 6}, {6, 9}, {0, 6}, {1, 4}, {4, 7}, {1, 7}, {2, 5},
+        {5, 8}, {2, 8}, {0, 1, 2}, {3, 4}, {7, 8, 9}, {5, 9}, {2, 6}};
+    auto gr = xnetwork::SimpleGraph(num_modules + static_cast<std::uint32_t>(nets.size()));
+    auto i_net = num_modules;
+    for (const auto& net : nets) {
+        for (const auto& v : net) {
+            gr.add_edge(v, i_net);
+        }
+        ++i_net;
+    }
+    return SimpleNetlist(std::move(gr), num_modules, static_cast<std::uint32_t>(nets.size()));
+}
+
+TEST_CASE("Test MidLvlWindowPartMgr is exact on a single window") {
+    // with bal_tol 0.5 both blocks must keep 5 modules, so FM cannot move
+    // anything; the whole netlist fits in one window, whose Gray code visits
+    // every balanced swap
+    const auto hyprgraph = create_window_netlist();
+    const auto bal_tol = 0.5;
+    using GainMgr = FMBiGainMgr<SimpleNetlist>;
+    using ConstrMgr = FMBiConstrMgr<SimpleNetlist>;
+
+    // the minimum cut over all bipartitions into 5 and 5 modules, by brute force
+    auto min_cost = std::numeric_limits<int>::max();
+    for (auto mask = 0U; mask != 1U << 10U; ++mask) {
+        if (std::popcount(mask) != 5) {
+            continue;
+        }
+        auto part = std::vector<std::uint8_t>(10U);
+        for (auto v = 0U; v != 10U; ++v) {
+            part[v] = static_cast<std::uint8_t>((mask >> v) & 1U);
+        }
+        GainMgr gain_mgr{hyprgraph};
+        min_cost = std::min(min_cost, gain_mgr.init(part));
+    }
+
+    GainMgr gain_mgr{hyprgraph};
+    ConstrMgr constr_mgr{hyprgraph, bal_tol};
+    MidLvlWindowPartMgr<SimpleNetlist, GainMgr, ConstrMgr> part_mgr{hyprgraph, gain_mgr,
+                                                                    constr_mgr, 2};
+    part_mgr.set_max_window_modules(12);
+    auto part = alternating_part(hyprgraph);
+    part_mgr.legalize(part);  // finds no legal move, but the partition is legal already
+    CHECK(constr_mgr.final_check(part));
+    CHECK_GT(part_mgr.total_cost, min_cost);
+    part_mgr.optimize(part);
+    CHECK_EQ(part_mgr.total_cost, min_cost);
+    CHECK(constr_mgr.final_check(part));
+
+    // the cost agrees with the FM gain calculation
+    GainMgr gain_mgr2{hyprgraph};
+    CHECK_EQ(gain_mgr2.init(part), part_mgr.total_cost);
+}
+
+TEST_CASE("Test MidLvlWindowPartMgr ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto bal_tol = 0.45;
+    const auto cost = check_bi_refiner<MidLvlWindowPartMgr>(
+        hyprgraph, bal_tol, [](auto& part_mgr) { part_mgr.set_max_window_modules(12); });
+    CHECK_LE(cost, fm_bi_cost(hyprgraph, bal_tol));
+}
+
+TEST_CASE("Test MLPartMgr with MidLvlWindowPartMgr p1 3-way") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    check_ml_refiner<MidLvlWindowPartMgr>(hyprgraph, 0.4, 3);
+}
@@ -0,0 +1,88 @@
+#include <algorithm>                  // for sort
+#include <ckpttn/ParallelReader.hpp>  // for read_netd_csr, read_hmetis_csr, ...
+#include <cstdint>                    // for uint32_t
+#include <filesystem>                 // for temp_directory_path
+#include <fstream>                    // for ofstream
+#include <string>                     // for string
+#include <vector>                     // for vector
+
+#include "test_common.hpp"
+
+// the pins of a net, sorted
+static auto sorted_pins(const SimpleNetlist& hyprgraph, std::uint32_t net)
+    -> std::vector<std::uint32_t> {
+    auto pins = std::vector<std::uint32_t>{};
+    for (const auto& v : hyprgraph.gr[net]) {
+        pins.push_back(v);
+    }
+    std::sort(pins.begin(), pins.end());
+    return pins;
+}
+
+// checks that two netlists have the same modules, nets and pins
+static void check_same_netlist(const SimpleNetlist& lhs, const SimpleNetlist& rhs) {
+    REQUIRE_EQ(lhs.number_of_modules(), rhs.number_of_modules());
+    REQUIRE_EQ(lhs.number_of_nets(), rhs.number_of_nets());
+    CHECK_EQ(lhs.num_pads, rhs.num_pads);
+    auto num_diffs = 0;
+    for (const auto& net : lhs.nets) {
+        num_diffs += sorted_pins(lhs, net) == sorted_pins(rhs, net) ? 0 : 1;
+    }
+    CHECK_EQ(num_diffs, 0);
+}
+
+TEST_CASE("Test read_netd_csr ibm01") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    for (const auto num_chunks : {1U, 7U, 64U}) {
+        const auto csr = read_netd_csr("../../testcases/ibm01.net", num_chunks);
+        CHECK_EQ(csr.net_offsets.size(), csr.num_nets + 1U);
+        CHECK_EQ(csr.net_offsets.back(), csr.pins.size());
+        check_same_netlist(to_netlist(csr), hyprgraph);
+    }
+}
+
+TEST_CASE("Test read_are_weights ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto num_modules = static_cast<std::uint32_t>(hyprgraph.number_of_modules());
+    const auto num_pads = static_cast<std::uint32_t>(hyprgraph.num_pads);
+    for (const auto num_chunks : {1U, 5U}) {
+        const auto weights
+            = read_are_weights("../../testcases/ibm01.are", num_modules, num_pads, num_chunks);
+        CHECK(weights == hyprgraph.module_weight);
+    }
+}
+
+TEST_CASE("Test read_hmetis_csr") {
+    const auto csr = read_hmetis_csr("../../testcases/test_balance.hgr");
+    CHECK_EQ(csr.num_nets, 3U);
+    CHECK_EQ(csr.num_modules, 5U);
+    const auto offsets = std::vector<size_t>{0U, 3U, 6U, 9U};
+    const auto pins = std::vector<std::uint32_t>{0U, 1U, 2U, 0U, 3U, 4U, 1U, 2U, 4U};
+    const auto weights = std::vector<unsigned int>{10000000U, 1U, 1U, 1U, 1U};
+    CHECK(csr.net_offsets == offsets);
+    CHECK(csr.pins == pins);
+    CHECK(csr.module_weight == weights);
+
+    // comments, net weights and 1-based ids, split into many chunks
+    const auto filename = (std::filesystem::temp_directory_path() / "ckpttn_test.hgr").string();
+    {
+        auto out = std::ofstream{filename};
+        out << "% a comment\n3 5 11\n7 1 2 3\n% another comment\n\n2 1 4 5\r\n1 2 3 5\n"
+            << "10000000\n1\n1\n1\n1\n";
+    }
+    for (const auto num_chunks : {1U, 3U, 16U}) {
+        const auto csr2 = read_hmetis_csr(filename, num_chunks);
+        CHECK(csr2.net_offsets == offsets);
+        CHECK(csr2.pins == pins);
+        CHECK(csr2.module_weight == weights);
+    }
+    std::filesystem::remove(filename);
+
+    const auto hyprgraph
+        = read_hypergraph_parallel("../../testcases/test.hgr", InputFormat::auto_detect);
+    CHECK_EQ(hyprgraph.number_of_modules(), 5U);
+    CHECK_EQ(hyprgraph.number_of_nets(), 4U);
+    const auto net3 = std::vector<std::uint32_t>{0U, 1U, 3U, 4U};
+    CHECK(sorted_pins(hyprgraph, 5U + 3U) == net3);
+}
@@ -0,0 +1,117 @@
+#include <algorithm>                   // for count
+#include <chrono>                      // for milliseconds
+#include <ckpttn/PartitionServer.hpp>  // for PartitionServer, send_partition_...
+#include <cstddef>                     // for size_t
+#include <filesystem>                  // for temp_directory_path
+#include <stdexcept>                   // for runtime_error
+#include <string>                      // for string
+#include <thread>                      // for thread, sleep_for
+#include <vector>                      // for vector
+
+#include "test_common.hpp"
+
+// the value of `key=` in a response
+static auto field(const std::string& response, const std::string& key) -> std::string {
+    const auto pos = response.find(' ' + key + '=');
+    if (pos == std::string::npos) {
+        return {};
+    }
+    const auto start = pos + key.size() + 2;
+    return response.substr(start, response.find(' ', start) - start);
+}
+
+// the number of entries of the `part=` list of a response
+static auto part_size(const std::string& response) -> size_t {
+    const auto part = field(response, "part");
+    return part.empty() ? 0U : static_cast<size_t>(std::count(part.begin(), part.end(), ',')) + 1;
+}
+
+TEST_CASE("Test PartitionServer handle_request p1") {
+    const auto num_modules = readNetD("../../testcases/p1.net").number_of_modules();
+    auto server = PartitionServer{"unused.sock", 2};
+
+    const auto first = server.handle_request("partition file=../../testcases/p1.net k=2 epsilon=5");
+    CHECK_EQ(first.rfind("ok ", 0), 0U);
+    CHECK_EQ(field(first, "cached"), "0");
+    CHECK_GT(std::stoi(field(first, "cost")), 0);
+    CHECK_EQ(part_size(first), num_modules);
+
+    const auto second
+        = server.handle_request("partition file=../../testcases/p1.net k=3 mode=direct seed=7");
+    CHECK_EQ(second.rfind("ok ", 0), 0U);
+    CHECK_EQ(field(second, "cached"), "1");
+    CHECK_EQ(part_size(second), num_modules);
+
+    CHECK_EQ(server.handle_request("stats"), "ok entries=1 hits=1 misses=1");
+    CHECK_EQ(server.handle_request("partition k=2").rfind("error ", 0), 0U);
+    CHECK_EQ(server.handle_request("partition file=../../testcases/p1.net k=1").rfind("error ", 0),
+             0U);
+    CHECK_EQ(server.handle_request("partition file=no_such_file.net").rfind("error ", 0), 0U);
+    CHECK_EQ(server.handle_request("frobnicate").rfind("error ", 0), 0U);
+}
+
+TEST_CASE("Test NetlistCache eviction") {
+    auto cache = NetlistCache{1};
+    auto hit = false;
+    const auto p1 = cache.get("../../testcases/p1.net", "auto", hit);
+    CHECK(!hit);
+    cache.get("../../testcases/dwarf1.netD", "netd", hit);
+    CHECK(!hit);
+    CHECK_EQ(cache.size(), 1U);
+    // the evicted entry stays alive for its users
+    CHECK_GT(p1->netlist.number_of_modules(), 0U);
+    cache.get("../../testcases/p1.net", "auto", hit);
+    CHECK(!hit);
+    // the key is the content and the format, not the name
+    cache.get("../../testcases/p1.net", "netd", hit);
+    CHECK(!hit);
+    CHECK_EQ(cache.stats().second, 4U);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("Test PartitionServer over a Unix domain socket") {
+    const auto socket_path
+        = (std::filesystem::temp_directory_path() / "ckpttn_test_server.sock").string();
+    const auto num_modules = readNetD("../../testcases/p1.net").number_of_modules();
+    auto server = PartitionServer{socket_path, 4};
+    auto serving = std::thread{[&server]() { server.serve(); }};
+
+    // wait until the server listens
+    auto reply = std::string{};
+    for (auto attempt = 0; attempt != 100 && reply.empty(); ++attempt) {
+        try {
+            reply = send_partition_request(socket_path, "stats");
+        } catch (const std::runtime_error&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    REQUIRE_EQ(reply, "ok entries=0 hits=0 misses=0");
+
+    // concurrent jobs on the same netlist
+    auto responses = std::vector<std::string>(4);
+    auto clients = std::vector<std::thread>{};
+    for (auto i = 0U; i != responses.size(); ++i) {
+        clients.emplace_back([&socket_path, &responses, i]() {
+            responses[i] = send_partition_request(
+                socket_path, "partition file=../../testcases/p1.net k=" + std::to_string(2 + i % 2)
+                                 + " seed=" + std::to_string(i + 1));
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    for (const auto& response : responses) {
+        CHECK_EQ(response.rfind("ok ", 0), 0U);
+        CHECK_EQ(part_size(response), num_modules);
+    }
+
+    // once cached, the netlist is not read again
+    const auto again = send_partition_request(socket_path, "partition file=../../testcases/p1.net");
+    CHECK_EQ(field(again, "cached"), "1");
+    CHECK_EQ(field(send_partition_request(socket_path, "stats"), "entries"), "1");
+
+    CHECK_EQ(send_partition_request(socket_path, "shutdown"), "ok");
+    serving.join();
+    CHECK(!std::filesystem::exists(socket_path));
+}
+#endif
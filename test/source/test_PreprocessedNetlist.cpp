@@ -0,0 +1,103 @@
+#include <ckpttn/PreprocessedNetlist.hpp>  // for preprocess_netlist, large_net_cost
+#include <cstdint>                         // for uint8_t
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <set>                             // for set
+#include <span>                            // for span
+#include <vector>                          // for vector
+
+#include "test_common.hpp"
+
+/**
+ * @brief Counts the cut nets of a netlist (including nets ignored by FM).
+ */
+static auto count_cut_nets(const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> part)
+    -> int {
+    auto cost = 0;
+    for (const auto& net : hyprgraph.nets) {
+        auto net_cur = hyprgraph.gr[net].begin();
+        if (net_cur == hyprgraph.gr[net].end()) {
+            continue;
+        }
+        const auto part_net = part[*net_cur];
+        for (++net_cur; net_cur != hyprgraph.gr[net].end(); ++net_cur) {
+            if (part[*net_cur] != part_net) {
+                ++cost;
+                break;
+            }
+        }
+    }
+    return cost;
+}
+
+/**
+ * @brief Computes the (lambda - 1) cost of a netlist (including nets ignored by FM).
+ */
+static auto count_km1_cost(const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> part)
+    -> int {
+    auto cost = 0;
+    for (const auto& net : hyprgraph.nets) {
+        auto spanned = std::set<std::uint8_t>{};
+        for (const auto& w : hyprgraph.gr[net]) {
+            spanned.insert(part[w]);
+        }
+        if (spanned.size() > 1) {
+            cost += static_cast<int>(spanned.size()) - 1;
+        }
+    }
+    return cost;
+}
+
+TEST_CASE("Test PreprocessedNetlist test netlist") {
+    const auto hyprgraph = create_test_netlist();
+    const auto hgr2 = preprocess_netlist(hyprgraph, 500, 10);
+    // a1 and a2 are twins; n3 is a single-pin net and n1 collapses after merging
+    CHECK_EQ(hgr2->number_of_modules(), 2);
+    CHECK_EQ(hgr2->number_of_nets(), 1);
+    CHECK_EQ(hgr2->num_removed_nets, 2);
+    CHECK_EQ(hgr2->get_module_weight(hgr2->node_up_map[0]), 7);
+
+    auto part2 = std::vector<std::uint8_t>{0, 1};
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+    auto part3 = std::vector<std::uint8_t>(hgr2->number_of_modules(), 0);
+    hgr2->projection_down(part2, part);
+    hgr2->projection_up(part, part3);
+    CHECK_EQ(part2, part3);
+    CHECK_EQ(part[0], part[1]);
+}
+
+TEST_CASE("Test PreprocessedNetlist ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto hgr2 = preprocess_netlist(hyprgraph, 20);
+    CHECK_LE(hgr2->number_of_modules(), hyprgraph.number_of_modules());
+    CHECK_LT(hgr2->number_of_nets(), hyprgraph.number_of_nets());
+    CHECK_LE(hgr2->get_max_net_degree(), 20);
+
+    auto part2 = std::vector<std::uint8_t>(hgr2->number_of_modules(), 0);
+    for (auto idx = 0U; idx != part2.size(); ++idx) {
+        part2[idx] = static_cast<std::uint8_t>(idx % 3 == 0);
+    }
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+    hgr2->projection_down(part2, part);
+    CHECK_EQ(count_cut_nets(*hgr2, part2) + hgr2->detached_cost(part),
+             count_cut_nets(hyprgraph, part));
+}
+
+TEST_CASE("Test PreprocessedNetlist ibm01 3-way cost") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto hgr2 = preprocess_netlist(hyprgraph, 20);
+    REQUIRE_FALSE(hgr2->detached_nets.empty());
+
+    auto part2 = std::vector<std::uint8_t>(hgr2->number_of_modules(), 0);
+    for (auto idx = 0U; idx != part2.size(); ++idx) {
+        part2[idx] = static_cast<std::uint8_t>(idx % 3);
+    }
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+    hgr2->projection_down(part2, part);
+    // a detached net spanning three parts costs twice its weight
+    CHECK_GT(hgr2->detached_cost(part), static_cast<int>(hgr2->detached_nets.size()));
+    CHECK_EQ(hgr2->detached_cost(part), large_net_cost(hyprgraph, part, 20));
+    CHECK_EQ(count_km1_cost(*hgr2, part2) + hgr2->detached_cost(part),
+             count_km1_cost(hyprgraph, part));
+}
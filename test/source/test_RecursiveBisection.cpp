@@ -0,0 +1,104 @@
+#include <ckpttn/FMBiConstrMgr.hpp>       // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>         // for FMBiGainMgr
+#include <ckpttn/FMConstrMgr.hpp>         // for LegalCheck
+#include <ckpttn/FMKWayConstrMgr.hpp>     // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>       // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>           // for FMPartMgr
+#include <ckpttn/RecursiveBisection.hpp>  // for RecursiveBisection
+#include <cstdint>                        // for uint8_t
+#include <utility>                        // for move
+#include <vector>                         // for vector
+#include <xnetwork/classes/graph.hpp>     // for SimpleGraph
+
+#include "test_common.hpp"
+
+using BiPartMgr
+    = FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>;
+
+TEST_CASE("Test RecursiveBisection ibm01 4-way") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto bal_tol = 0.4;
+    const auto num_parts = std::uint8_t{4};
+
+    auto part1 = std::vector<std::uint8_t>{};
+    for (const auto num_threads : {1U, 4U}) {
+        RecursiveBisection part_mgr{bal_tol, num_parts};
+        part_mgr.set_num_threads(num_threads);
+        auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+        auto legal_check = part_mgr.run_Partition<SimpleNetlist, BiPartMgr>(hyprgraph, part);
+        CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+
+        auto constr_mgr = FMKWayConstrMgr<SimpleNetlist>(hyprgraph, bal_tol, num_parts);
+        CHECK(constr_mgr.final_check(part));
+        FMKWayGainMgr<SimpleNetlist> gain_mgr{hyprgraph, num_parts};
+        CHECK_EQ(gain_mgr.init(part), part_mgr.total_cost);
+
+        // the sub-bisections are independent of the scheduling
+        if (part1.empty()) {
+            part1 = part;
+        } else {
+            CHECK(part == part1);
+        }
+    }
+}
+
+TEST_CASE("Test RecursiveBisection p1 3-way") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto bal_tol = 0.4;
+    const auto num_parts = std::uint8_t{3};
+    RecursiveBisection part_mgr{bal_tol, num_parts};
+    part_mgr.set_num_threads(2);
+    auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+    auto legal_check = part_mgr.run_Partition<SimpleNetlist, BiPartMgr>(hyprgraph, part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+
+    auto constr_mgr = FMKWayConstrMgr<SimpleNetlist>(hyprgraph, bal_tol, num_parts);
+    CHECK(constr_mgr.final_check(part));
+    FMKWayGainMgr<SimpleNetlist> gain_mgr{hyprgraph, num_parts};
+    CHECK_EQ(gain_mgr.init(part), part_mgr.total_cost);
+}
+
+/**
+ * @brief Creates disconnected clusters of 5, 3 and 4 modules.
+ *
+ * Each cluster is a chain of 2-pin nets plus one net over all its modules.
+ *
+ * @param[in] shift Rotates the module numbering
+ */
+static auto create_three_clusters(std::uint32_t shift) -> SimpleNetlist {
+    constexpr auto num_modules = 12U;
+    constexpr auto num_nets = 12U;
+    auto gr = xnetwork::SimpleGraph(num_modules + num_nets);
+    auto i_net = num_modules;
+    auto first = 0U;
+    for (const auto size : {5U, 3U, 4U}) {
+        const auto module = [&](std::uint32_t i) { return (first + i + shift) % num_modules; };
+        for (auto i = 0U; i + 1U != size; ++i) {
+            gr.add_edge(module(i), i_net);
+            gr.add_edge(module(i + 1U), i_net);
+            ++i_net;
+        }
+        for (auto i = 0U; i != size; ++i) {
+            gr.add_edge(module(i), i_net);
+        }
+        ++i_net;
+        first += size;
+    }
+    return SimpleNetlist(std::move(gr), num_modules, num_nets);
+}
+
+TEST_CASE("Test RecursiveBisection 3-way gives the heavier side two parts") {
+    // a cost-free 3-way partition needs the side with two parts to hold two
+    // clusters, which is the heavier side of a cost-free bisection
+    const auto bal_tol = 0.4;
+    const auto num_parts = std::uint8_t{3};
+    for (auto shift = 0U; shift != 12U; ++shift) {
+        const auto hyprgraph = create_three_clusters(shift);
+        RecursiveBisection part_mgr{bal_tol, num_parts};
+        auto part = std::vector<std::uint8_t>(hyprgraph.number_of_modules(), 0);
+        auto legal_check = part_mgr.run_Partition<SimpleNetlist, BiPartMgr>(hyprgraph, part);
+        CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+        CHECK_EQ(part_mgr.total_cost, 0);
+    }
+}
@@ -0,0 +1,167 @@
+#include <ckpttn/ConnectivityInfo.hpp>   // for ConnectivityInfo
+#include <ckpttn/FMBiConstrMgr.hpp>      // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>        // for FMBiGainMgr
+#include <ckpttn/FMPartMgr.hpp>          // for FMPartMgr
+#include <ckpttn/MLPartMgr.hpp>          // for MLPartMgr
+#include <ckpttn/ParallelReader.hpp>     // for read_hmetis_csr
+#include <ckpttn/StreamPartitioner.hpp>  // for partition_stream, StreamPartition
+#include <cmath>                         // for ceil
+#include <cstdint>                       // for uint8_t, uint32_t
+#include <filesystem>                    // for temp_directory_path
+#include <fstream>                       // for ifstream, ofstream
+#include <stdexcept>                     // for invalid_argument, runtime_error
+#include <string>                        // for string, to_string
+#include <vector>                        // for vector
+
+#include "test_common.hpp"
+
+// the K-1 connectivity cost of a partition
+static auto km1_cost(const SimpleNetlist& hyprgraph, std::span<const std::uint8_t> part,
+                     std::uint8_t num_parts) -> int {
+    auto conn = ConnectivityInfo<SimpleNetlist>(hyprgraph, num_parts);
+    conn.init(part, 1U);
+    return conn.cost();
+}
+
+TEST_CASE("Test partition_stream ibm01") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto num_modules = hyprgraph.number_of_modules();
+    for (const auto num_parts : {std::uint8_t{2}, std::uint8_t{4}}) {
+        auto options = StreamPartitionOptions{};
+        options.num_parts = num_parts;
+        const auto result
+            = partition_stream("../../testcases/ibm01.net", InputFormat::auto_detect, options);
+        REQUIRE_EQ(result.part.size(), num_modules);
+        CHECK_EQ(result.num_nets, hyprgraph.number_of_nets());
+        CHECK_EQ(result.cost, km1_cost(hyprgraph, result.part, num_parts));
+
+        // balanced by module count
+        const auto capacity = std::ceil(1.03 * static_cast<double>(num_modules) / num_parts);
+        auto sizes = std::vector<std::uint32_t>(num_parts, 0U);
+        for (const auto& p : result.part) {
+            ++sizes[p];
+        }
+        CHECK(sizes == result.block_size);
+        for (const auto& size : sizes) {
+            CHECK_LE(size, capacity);
+        }
+
+        // far better than a round-robin assignment
+        auto round_robin = std::vector<std::uint8_t>(num_modules);
+        for (auto v = 0U; v != num_modules; ++v) {
+            round_robin[v] = static_cast<std::uint8_t>(v % num_parts);
+        }
+        CHECK_LT(2 * result.cost, km1_cost(hyprgraph, round_robin, num_parts));
+    }
+}
+
+TEST_CASE("Test partition_stream as the initial partition of MLPartMgr") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    auto result = partition_stream("../../testcases/ibm01.net", InputFormat::netD,
+                                   StreamPartitionOptions{});
+    MLPartMgr part_mgr{0.45, 2};
+    using PartMgr
+        = FMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>, FMBiConstrMgr<SimpleNetlist>>;
+    const auto legal_check = part_mgr.run_Partition<SimpleNetlist, PartMgr>(hyprgraph, result.part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+    CHECK_LE(part_mgr.total_cost, result.cost);
+}
+
+TEST_CASE("Test partition_stream partial netlists") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto prefix = (std::filesystem::temp_directory_path() / "ckpttn_block").string();
+    auto options = StreamPartitionOptions{};
+    options.num_parts = 3;
+    options.block_prefix = prefix;
+    const auto result = partition_stream("../../testcases/ibm01.net", InputFormat::netD, options);
+
+    auto total_nets = size_t{0U};
+    for (auto b = 0U; b != 3U; ++b) {
+        const auto name = prefix + std::to_string(b);
+        const auto csr = read_hmetis_csr(name + ".hgr");
+        CHECK_EQ(csr.num_modules, result.block_size[b]);
+        total_nets += csr.num_nets;
+
+        // the modules of the block, in the order of their ids in the block
+        auto modules = std::vector<std::uint32_t>{};
+        {
+            auto input = std::ifstream{name + ".map"};
+            auto v = std::uint32_t{0U};
+            while (input >> v) {
+                modules.push_back(v);
+            }
+        }
+        REQUIRE_EQ(modules.size(), result.block_size[b]);
+        auto num_wrong = 0;
+        for (const auto& v : modules) {
+            num_wrong += result.part[v] == b ? 0 : 1;
+        }
+        CHECK_EQ(num_wrong, 0);
+
+        // each net of the block is part of a net of the input
+        auto num_missing = 0;
+        for (auto net = 0U; net != csr.num_nets; ++net) {
+            const auto first = modules[csr.pins[csr.net_offsets[net]]];
+            const auto second = modules[csr.pins[csr.net_offsets[net] + 1U]];
+            auto found = false;
+            for (const auto& net2 : hyprgraph.gr[first]) {
+                for (const auto& u : hyprgraph.gr[net2]) {
+                    found |= u == second;
+                }
+            }
+            num_missing += found ? 0 : 1;
+        }
+        CHECK_EQ(num_missing, 0);
+        std::filesystem::remove(name + ".hgr");
+        std::filesystem::remove(name + ".map");
+    }
+    CHECK_LE(total_nets, hyprgraph.number_of_nets());
+    CHECK_GT(total_nets, 0U);
+}
+
+TEST_CASE("Test partition_stream hMetis") {
+    // comments, net weights, 1-based ids and a module on no net
+    const auto filename = (std::filesystem::temp_directory_path() / "ckpttn_stream.hgr").string();
+    {
+        auto out = std::ofstream{filename};
+        out << "% a comment\n3 6 11\n7 1 2 3\n% another comment\n\n2 1 4 5\r\n1 2 3 5\n"
+            << "10000000\n1\n1\n1\n1\n1\n";
+    }
+    auto options = StreamPartitionOptions{};
+    options.imbalance = 0.0;
+    options.block_prefix = filename + ".block";
+    const auto result = partition_stream(filename, InputFormat::hmetis, options);
+    CHECK_EQ(result.part.size(), 6U);
+    CHECK_EQ(result.num_nets, 3U);
+    CHECK_EQ(result.block_size[0], 3U);
+    CHECK_EQ(result.block_size[1], 3U);
+    for (auto b = 0U; b != 2U; ++b) {
+        const auto name = filename + ".block" + std::to_string(b);
+        auto input = std::ifstream{name + ".map"};
+        auto v = std::uint32_t{0U};
+        while (input >> v) {
+            CHECK_LT(v, 6U);
+            CHECK_EQ(result.part[v], b);
+        }
+        input.close();
+        std::filesystem::remove(name + ".hgr");
+        std::filesystem::remove(name + ".map");
+    }
+
+    // module id 0 and `num_modules` cannot both occur
+    {
+        auto out = std::ofstream{filename};
+        out << "2 3\n0 1\n1 3\n";
+    }
+    CHECK_THROWS_AS(partition_stream(filename, InputFormat::hmetis, StreamPartitionOptions{}),
+                    std::runtime_error);
+    std::filesystem::remove(filename);
+
+    CHECK_THROWS_AS(partition_stream("../../testcases/p1.json", InputFormat::auto_detect,
+                                     StreamPartitionOptions{}),
+                    std::invalid_argument);
+    options = StreamPartitionOptions{};
+    options.num_parts = 1;
+    CHECK_THROWS_AS(partition_stream("../../testcases/test.hgr", InputFormat::hmetis, options),
+                    std::invalid_argument);
+}
@@ -0,0 +1,151 @@
+#include <ckpttn/FMBiConstrMgr.hpp>       // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>         // for FMBiGainMgr
+#include <ckpttn/FMKWayConstrMgr.hpp>     // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>       // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>           // for FMPartMgr
+#include <ckpttn/LPPartMgr.hpp>           // for LPPartMgr
+#include <ckpttn/LocalFMPartMgr.hpp>      // for LocalFMPartMgr
+#include <ckpttn/MLPartMgr.hpp>           // for MLPartMgr
+#include <ckpttn/RecursiveBisection.hpp>  // for RecursiveBisection
+#include <ckpttn/TaskScheduler.hpp>       // for TaskScheduler, TaskGroup
+#include <ckpttn/parallel_for.hpp>        // for parallel_reduce
+#include <cstdint>                        // for uint8_t, uint32_t
+#include <stdexcept>                      // for runtime_error
+#include <vector>                         // for vector
+
+#include "test_common.hpp"
+
+/**
+ * @brief Sums [first, last) by recursive splitting into nested task groups.
+ */
+static auto nested_sum(std::uint32_t first, std::uint32_t last) -> std::uint64_t {
+    if (last - first <= 16U) {
+        auto sum = std::uint64_t{0U};
+        for (auto i = first; i != last; ++i) {
+            sum += i;
+        }
+        return sum;
+    }
+    const auto middle = first + (last - first) / 2U;
+    auto lower = std::uint64_t{0U};
+    auto group = TaskGroup{};
+    group.run([&lower, first, middle]() { lower = nested_sum(first, middle); });
+    const auto upper = nested_sum(middle, last);
+    group.wait();
+    return lower + upper;
+}
+
+TEST_CASE("Test TaskScheduler nested task groups") {
+    for (const auto num_threads : {1U, 4U}) {
+        auto scheduler = TaskScheduler(num_threads);
+        const auto scope = TaskScheduler::Scope(&scheduler);
+        CHECK_EQ(&TaskScheduler::current(), &scheduler);
+        CHECK_EQ(nested_sum(0U, 100000U), std::uint64_t{100000U} * 99999U / 2U);
+
+        auto group = TaskGroup{};
+        group.run([]() { throw std::runtime_error("task failed"); });
+        CHECK_THROWS_AS(group.wait(), std::runtime_error);
+    }
+}
+
+TEST_CASE("Test parallel_reduce is deterministic") {
+    auto results = std::vector<double>{};
+    for (const auto num_threads : {1U, 3U, 8U}) {
+        auto scheduler = TaskScheduler(num_threads);
+        const auto scope = TaskScheduler::Scope(&scheduler);
+        results.emplace_back(parallel_reduce(
+            1000000U, 1000U, 0.0,
+            [](auto first, auto last) {
+                auto sum = 0.0;
+                for (auto i = first; i != last; ++i) {
+                    sum += 1.0 / (1.0 + i);
+                }
+                return sum;
+            },
+            [](double lhs, double rhs) { return lhs + rhs; }));
+    }
+    CHECK_EQ(results[0], results[1]);
+    CHECK_EQ(results[0], results[2]);
+}
+
+TEST_CASE("Test parallel gain initialization ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto num_modules = hyprgraph.number_of_modules();
+
+    // 2-way: the gains and the cost do not depend on the number of threads
+    auto part = std::vector<std::uint8_t>(num_modules, 0U);
+    for (auto v = 0U; v != num_modules; ++v) {
+        part[v] = static_cast<std::uint8_t>((v / 7U) % 2U);
+    }
+    auto bi_gains = std::vector<std::vector<int>>{};
+    auto bi_costs = std::vector<int>{};
+    for (const auto num_threads : {1U, 4U}) {
+        auto scheduler = TaskScheduler(num_threads);
+        const auto scope = TaskScheduler::Scope(&scheduler);
+        FMBiGainMgr<SimpleNetlist> gain_mgr{hyprgraph};
+        bi_costs.emplace_back(gain_mgr.init(part));
+        bi_gains.emplace_back(gain_mgr.gain_calc.get_init_gain_list());
+    }
+    CHECK_EQ(bi_costs[0], bi_costs[1]);
+    CHECK(bi_gains[0] == bi_gains[1]);
+
+    // 4-way: the same gains give the same FM refinement
+    const auto num_parts = std::uint8_t{4};
+    using GainMgr = FMKWayGainMgr<SimpleNetlist>;
+    using ConstrMgr = FMKWayConstrMgr<SimpleNetlist>;
+    auto kway_parts = std::vector<std::vector<std::uint8_t>>{};
+    auto kway_costs = std::vector<int>{};
+    for (const auto num_threads : {1U, 4U}) {
+        auto scheduler = TaskScheduler(num_threads);
+        const auto scope = TaskScheduler::Scope(&scheduler);
+        auto part_k = std::vector<std::uint8_t>(num_modules, 0U);
+        for (auto v = 0U; v != num_modules; ++v) {
+            part_k[v] = static_cast<std::uint8_t>(v % num_parts);
+        }
+        GainMgr gain_mgr{hyprgraph, num_parts};
+        kway_costs.emplace_back(gain_mgr.init(part_k));
+        ConstrMgr constr_mgr{hyprgraph, 0.4, num_parts};
+        FMPartMgr<SimpleNetlist, GainMgr, ConstrMgr> part_mgr{hyprgraph, gain_mgr, constr_mgr,
+                                                              num_parts};
+        part_mgr.optimize(part_k);
+        kway_parts.emplace_back(std::move(part_k));
+    }
+    CHECK_EQ(kway_costs[0], kway_costs[1]);
+    CHECK(kway_parts[0] == kway_parts[1]);
+}
+
+TEST_CASE("Test deterministic mode ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto num_parts = std::uint8_t{4};
+    using LPMgr = LPPartMgr<SimpleNetlist, FMKWayGainMgr<SimpleNetlist>,
+                            FMKWayConstrMgr<SimpleNetlist>>;
+    using LocalFMMgr = LocalFMPartMgr<SimpleNetlist, FMBiGainMgr<SimpleNetlist>,
+                                      FMBiConstrMgr<SimpleNetlist>>;
+
+    auto lp_parts = std::vector<std::vector<std::uint8_t>>{};
+    auto rb_parts = std::vector<std::vector<std::uint8_t>>{};
+    for (const auto num_threads : {1U, 4U, 16U}) {
+        auto scheduler = TaskScheduler(num_threads);
+        scheduler.set_deterministic(true);
+        const auto scope = TaskScheduler::Scope(&scheduler);
+
+        auto part = std::vector<std::uint8_t>(num_modules, 0U);
+        MLPartMgr ml_mgr{0.4, num_parts};
+        const auto lp_legal = ml_mgr.run_Partition<SimpleNetlist, LPMgr>(hyprgraph, part);
+        CHECK_EQ(lp_legal, LegalCheck::AllSatisfied);
+        lp_parts.emplace_back(std::move(part));
+
+        part = std::vector<std::uint8_t>(num_modules, 0U);
+        RecursiveBisection rb_mgr{0.4, num_parts};
+        const auto rb_legal = rb_mgr.run_Partition<SimpleNetlist, LocalFMMgr>(hyprgraph, part);
+        CHECK_EQ(rb_legal, LegalCheck::AllSatisfied);
+        rb_parts.emplace_back(std::move(part));
+    }
+    CHECK(lp_parts[0] == lp_parts[1]);
+    CHECK(lp_parts[0] == lp_parts[2]);
+    CHECK(rb_parts[0] == rb_parts[1]);
+    CHECK(rb_parts[0] == rb_parts[2]);
+}
@@ -2,12 +2,19 @@
 
 #include <doctest/doctest.h>
 
-#include <ckpttn/FMConstrMgr.hpp>  // for FMConstrMgr, LegalCheck, move_info_v
-#include <ckpttn/FMPartMgr.hpp>    // for FMPartMgr
-#include <cstdint>                 // for uint8_t
-#include <netlistx/netlist.hpp>    // for SimpleNetlist
-#include <string_view>             // for std::string_view
-#include <vector>                  // for vector
+#include <ckpttn/FMBiConstrMgr.hpp>    // for FMBiConstrMgr
+#include <ckpttn/FMBiGainMgr.hpp>      // for FMBiGainMgr
+#include <ckpttn/FMConstrMgr.hpp>      // for FMConstrMgr, LegalCheck, move_info_v
+#include <ckpttn/FMKWayConstrMgr.hpp>  // for FMKWayConstrMgr
+#include <ckpttn/FMKWayGainMgr.hpp>    // for FMKWayGainMgr
+#include <ckpttn/FMPartMgr.hpp>        // for FMPartMgr
+#include <ckpttn/MLPartMgr.hpp>        // for MLPartMgr
+#include <cstddef>                     // for size_t
+#include <cstdint>                     // for uint8_t
+#include <limits>                      // for numeric_limits
+#include <netlistx/netlist.hpp>        // for SimpleNetlist
+#include <string_view>                 // for std::string_view
+#include <vector>                      // for vector
 
 extern auto create_test_netlist() -> SimpleNetlist;  // import create_test_netlist
 extern auto create_dwarf() -> SimpleNetlist;         // import create_dwarf
@@ -50,3 +57,178 @@ void run_PartMgr(const SimpleNetlist& hyprgraph, uint8_t num_parts) {
     part_mgr.init(part);
     CHECK_EQ(part_mgr.total_cost, totalcostbefore);
 }
+
+/**
+ * @brief Returns the gain of each module in each bucket, emptying the buckets.
+ *
+ * @param[in,out] gain_mgr The gain manager
+ * @param[in] num_modules The number of modules
+ * @param[in] num_parts The number of partitions
+ * @return The gains, by part then module (`numeric_limits<int>::min()` if
+ * the module is not in the bucket)
+ */
+template <typename GainMgr>
+auto drain_gains(GainMgr& gain_mgr, size_t num_modules, uint8_t num_parts)
+    -> std::vector<std::vector<int>> {
+    auto gains = std::vector<std::vector<int>>(
+        num_parts, std::vector<int>(num_modules, std::numeric_limits<int>::min()));
+    for (auto k = uint8_t{0U}; k != num_parts; ++k) {
+        while (!gain_mgr.is_empty_togo(k)) {
+            const auto [v, gain] = gain_mgr.select_togo(k);
+            gains[k][v] = gain;
+        }
+    }
+    return gains;
+}
+
+/**
+ * @brief Checks the incremental gains against a fresh `init` after some moves.
+ *
+ * The moves are made as in an FM pass, without the balance constraint:
+ * select, lock, `update_move`, `update_move_v`. Every gain still in the
+ * buckets must then equal the gain computed from scratch for the resulting
+ * partition.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in] num_parts The number of partitions
+ * @param[in] num_moves The number of moves
+ */
+template <typename GainMgr>
+void check_gains_after_moves(const SimpleNetlist& hyprgraph, uint8_t num_parts,
+                             size_t num_moves) {
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto part = std::vector<uint8_t>(num_modules);
+    for (auto v = 0U; v != num_modules; ++v) {
+        part[v] = static_cast<uint8_t>(v % num_parts);
+    }
+    GainMgr gain_mgr{hyprgraph, num_parts};
+    gain_mgr.init(part);
+    for (auto i = size_t{0U}; i != num_moves && !gain_mgr.is_empty(); ++i) {
+        const auto [move_info_v, gain] = gain_mgr.select(part);
+        gain_mgr.lock(move_info_v.to_part, move_info_v.v);
+        gain_mgr.update_move(part, move_info_v);
+        gain_mgr.update_move_v(move_info_v, gain);
+        part[move_info_v.v] = move_info_v.to_part;
+    }
+
+    GainMgr fresh_mgr{hyprgraph, num_parts};
+    fresh_mgr.init(part);
+    const auto gains = drain_gains(gain_mgr, num_modules, num_parts);
+    const auto expected = drain_gains(fresh_mgr, num_modules, num_parts);
+    auto num_checked = size_t{0U};
+    for (auto k = 0U; k != num_parts; ++k) {
+        for (auto v = 0U; v != num_modules; ++v) {
+            if (gains[k][v] != std::numeric_limits<int>::min()) {
+                CHECK_EQ(gains[k][v], expected[k][v]);
+                ++num_checked;
+            }
+        }
+    }
+    CHECK_GT(num_checked, num_modules / 2U);
+}
+
+/**
+ * @brief Returns the alternating bipartition `0, 1, 0, 1, ...`.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @return The partition
+ */
+inline auto alternating_part(const SimpleNetlist& hyprgraph) -> std::vector<uint8_t> {
+    auto part = std::vector<uint8_t>(hyprgraph.number_of_modules(), 0);
+    for (auto idx = 0U; idx != part.size(); ++idx) {
+        part[idx] = static_cast<uint8_t>(idx % 2);
+    }
+    return part;
+}
+
+/**
+ * @brief Returns the cost of FM from the alternating bipartition.
+ *
+ * @param[in] hyprgraph The hypergraph
+ * @param[in] bal_tol The balance tolerance
+ * @return The cost after the legalization and the optimization
+ */
+inline auto fm_bi_cost(const SimpleNetlist& hyprgraph, double bal_tol) -> int {
+    using GainMgr = FMBiGainMgr<SimpleNetlist>;
+    using ConstrMgr = FMBiConstrMgr<SimpleNetlist>;
+    auto part = alternating_part(hyprgraph);
+    GainMgr gain_mgr{hyprgraph};
+    ConstrMgr constr_mgr{hyprgraph, bal_tol};
+    FMPartMgr<SimpleNetlist, GainMgr, ConstrMgr> part_mgr{hyprgraph, gain_mgr, constr_mgr};
+    part_mgr.legalize(part);
+    part_mgr.optimize(part);
+    return part_mgr.total_cost;
+}
+
+/**
+ * @brief Checks a bipartition refiner with 1 and 4 threads.
+ *
+ * From the alternating bipartition, legalizes and optimizes; the result
+ * must be legal, better than the legalized partition, and its cost must
+ * agree with the FM gain calculation.
+ *
+ * @tparam PartMgr The refiner, e.g. `LocalFMPartMgr`
+ * @param[in] hyprgraph The hypergraph
+ * @param[in] bal_tol The balance tolerance
+ * @param[in] setup Called on the refiner before the legalization
+ * @return The cost with 4 threads
+ */
+template <template <typename, typename, typename> class PartMgr, typename Setup>
+auto check_bi_refiner(const SimpleNetlist& hyprgraph, double bal_tol, Setup setup) -> int {
+    using GainMgr = FMBiGainMgr<SimpleNetlist>;
+    using ConstrMgr = FMBiConstrMgr<SimpleNetlist>;
+    auto cost = 0;
+    for (const auto num_threads : {1U, 4U}) {
+        GainMgr gain_mgr{hyprgraph};
+        ConstrMgr constr_mgr{hyprgraph, bal_tol};
+        PartMgr<SimpleNetlist, GainMgr, ConstrMgr> part_mgr{hyprgraph, gain_mgr, constr_mgr, 2};
+        part_mgr.set_num_threads(num_threads);
+        setup(part_mgr);
+        auto part = alternating_part(hyprgraph);
+        auto legal_check = part_mgr.legalize(part);
+        CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+        const auto totalcostbefore = part_mgr.total_cost;
+        part_mgr.optimize(part);
+        CHECK_LT(part_mgr.total_cost, totalcostbefore);
+        CHECK(constr_mgr.final_check(part));
+
+        // the cost agrees with the FM gain calculation
+        GainMgr gain_mgr2{hyprgraph};
+        CHECK_EQ(gain_mgr2.init(part), part_mgr.total_cost);
+        cost = part_mgr.total_cost;
+    }
+    return cost;
+}
+
+template <template <typename, typename, typename> class PartMgr>
+auto check_bi_refiner(const SimpleNetlist& hyprgraph, double bal_tol) -> int {
+    return check_bi_refiner<PartMgr>(hyprgraph, bal_tol, [](auto&) {});
+}
+
+/**
+ * @brief Checks a K-way refiner as the `PartMgr` of `MLPartMgr`.
+ *
+ * The result must be legal and its cost must agree with the FM gain
+ * calculation.
+ *
+ * @tparam PartMgr The refiner, e.g. `LocalFMPartMgr`
+ * @param[in] hyprgraph The hypergraph
+ * @param[in] bal_tol The balance tolerance
+ * @param[in] num_parts The number of partitions
+ */
+template <template <typename, typename, typename> class PartMgr>
+void check_ml_refiner(const SimpleNetlist& hyprgraph, double bal_tol, uint8_t num_parts) {
+    using GainMgr = FMKWayGainMgr<SimpleNetlist>;
+    using ConstrMgr = FMKWayConstrMgr<SimpleNetlist>;
+    using Refiner = PartMgr<SimpleNetlist, GainMgr, ConstrMgr>;
+    MLPartMgr part_mgr{bal_tol, num_parts};
+    part_mgr.set_limitsize(10);
+    auto part = std::vector<uint8_t>(hyprgraph.number_of_modules(), 0);
+    auto legal_check = part_mgr.run_Partition<SimpleNetlist, Refiner>(hyprgraph, part);
+    CHECK_EQ(legal_check, LegalCheck::AllSatisfied);
+
+    auto constr_mgr = ConstrMgr(hyprgraph, bal_tol, num_parts);
+    CHECK(constr_mgr.final_check(part));
+    GainMgr gain_mgr{hyprgraph, num_parts};
+    CHECK_EQ(gain_mgr.init(part), part_mgr.total_cost);
+}
@@ -1,10 +1,12 @@
 #include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase
 // #include <__config>                // for std
+#include <algorithm>               // for max
 #include <ckpttn/HierNetlist.hpp>  // for HierNetlist, SimpleHierNetlist
 #include <cstdint>                 // for uint8_t
 #include <memory>                  // for unique_ptr
 #include <netlistx/netlist.hpp>    // for Netlist, SimpleNetlist
 #include <py2cpp/set.hpp>          // for set
+#include <span>                    // for span
 #include <string_view>             // for std::string_view
 #include <vector>                  // for vector, operator==
 
@@ -20,6 +22,10 @@ extern void readAre(SimpleNetlist& hyprgraph, std::string_view areFileName);
 using node_t = SimpleNetlist::node_t;
 extern auto create_contracted_subgraph(const SimpleNetlist&, py::set<node_t>)
     -> unique_ptr<SimpleHierNetlist>;
+extern auto create_contracted_subgraph(const SimpleNetlist&, py::set<node_t>,
+                                       span<const uint8_t>) -> unique_ptr<SimpleHierNetlist>;
+extern auto create_contracted_subgraph(const SimpleNetlist&, py::set<node_t>, span<const uint8_t>,
+                                       unsigned int) -> unique_ptr<SimpleHierNetlist>;
 
 //
 // Primal-dual algorithm for minimum vertex cover problem
@@ -80,6 +86,64 @@ TEST_CASE("Test contraction subgraph ibm01") {
     CHECK_EQ(part3, part4);
 }
 
+TEST_CASE("Test partition-preserving contraction ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+
+    auto part = vector<uint8_t>(hyprgraph.number_of_modules(), 0);
+    for (auto idx = 0U; idx != hyprgraph.number_of_modules(); ++idx) {
+        part[idx] = static_cast<uint8_t>(idx % 3 == 0);
+    }
+    auto hgr2 = create_contracted_subgraph(hyprgraph, py::set<node_t>{}, part);
+    CHECK_LT(hgr2->number_of_modules(), hyprgraph.number_of_modules());
+
+    auto part2 = vector<uint8_t>(hgr2->number_of_modules(), 0);
+    auto part3 = vector<uint8_t>(hyprgraph.number_of_modules(), 0);
+    hgr2->projection_up(part, part2);
+    hgr2->projection_down(part2, part3);
+    CHECK_EQ(part, part3);
+}
+
+TEST_CASE("Test weight-bounded contraction ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    auto max_weight = 0U;
+    for (const auto& v : hyprgraph) {
+        max_weight = std::max(max_weight, hyprgraph.get_module_weight(v));
+    }
+    const auto bound = max_weight + 10U;
+    auto hgr2 = create_contracted_subgraph(hyprgraph, py::set<node_t>{}, {}, bound);
+    CHECK_LT(hgr2->number_of_modules(), hyprgraph.number_of_modules());
+    for (const auto& v : *hgr2) {
+        CHECK_LE(hgr2->get_module_weight(v), bound);
+    }
+}
+
+TEST_CASE("Test contraction subgraph with fixed modules ibm01") {
+    auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    readAre(hyprgraph, "../../testcases/ibm01.are");
+    auto part = vector<uint8_t>(hyprgraph.number_of_modules(), 0);
+    for (auto v = 0U; v < hyprgraph.number_of_modules(); v += 5) {
+        hyprgraph.module_fixed.insert(v);
+        part[v] = static_cast<uint8_t>(v % 2);
+    }
+    hyprgraph.has_fixed_modules = true;
+
+    auto hgr2 = create_contracted_subgraph(hyprgraph, py::set<node_t>{});
+    CHECK_LT(hgr2->number_of_modules(), hyprgraph.number_of_modules());
+    CHECK(hgr2->has_fixed_modules);
+
+    // every fixed module ends up in a fixed cluster of its own part
+    auto part2 = vector<uint8_t>(hgr2->number_of_modules(), 0);
+    auto part3 = vector<uint8_t>(hyprgraph.number_of_modules(), 0);
+    hgr2->projection_up(part, part2);
+    hgr2->projection_down(part2, part3);
+    for (const auto& v : hyprgraph.module_fixed) {
+        CHECK(hgr2->module_fixed.contains(hgr2->node_up_map[v]));
+        CHECK_EQ(part3[v], part[v]);
+    }
+}
+
 TEST_CASE("Test contraction subgraph ibm18") {
     auto hyprgraph = readNetD("../../testcases/ibm18.net");
     readAre(hyprgraph, "../../testcases/ibm18.are");
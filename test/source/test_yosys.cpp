@@ -1,9 +1,12 @@
 #include <doctest/doctest.h>
 
+#include <ckpttn/YosysStreamReader.hpp>
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <netlistx/netlist.hpp>
 #include <netlistx/readwrite.hpp>
+#include <vector>
 
 using namespace std;
 
@@ -87,3 +90,80 @@ TEST_CASE("Test yosys sphere3hopf_netlist_simple k-pin nets") {
     CHECK_EQ(kpin_counts[25], 1);
     CHECK_EQ(kpin_counts[32], 2);
 }
+
+TEST_CASE("Test streaming yosys sphere_netlist k-pin nets") {
+    const auto hyprgraph = read_yosys_json_stream("../../yosys_testcases/sphere_netlist.json");
+
+    CHECK_EQ(hyprgraph.number_of_modules(), 65);
+    CHECK_EQ(hyprgraph.number_of_nets(), 623);
+    CHECK_EQ(hyprgraph.num_pads, 9);
+
+    map<size_t, size_t> kpin_counts;
+    for (const auto& net : hyprgraph.nets) {
+        auto deg = hyprgraph.gr.degree(net);
+        kpin_counts[deg]++;
+    }
+
+    CHECK_EQ(kpin_counts[1], 1);
+    CHECK_EQ(kpin_counts[2], 467);
+    CHECK_EQ(kpin_counts[3], 84);
+    CHECK_EQ(kpin_counts[4], 66);
+    CHECK_EQ(kpin_counts[13], 2);
+    CHECK_EQ(kpin_counts[26], 3);
+}
+
+TEST_CASE("Test streaming yosys sphere3hopf_netlist k-pin nets") {
+    const auto hyprgraph
+        = read_yosys_json_stream("../../yosys_testcases/sphere3hopf_netlist.json");
+
+    CHECK_EQ(hyprgraph.number_of_modules(), 188);
+    CHECK_EQ(hyprgraph.number_of_nets(), 2825);
+    CHECK_EQ(hyprgraph.num_pads, 8);
+
+    map<size_t, size_t> kpin_counts;
+    for (const auto& net : hyprgraph.nets) {
+        auto deg = hyprgraph.gr.degree(net);
+        kpin_counts[deg]++;
+    }
+
+    CHECK_EQ(kpin_counts[1], 28);
+    CHECK_EQ(kpin_counts[2], 2314);
+    CHECK_EQ(kpin_counts[3], 323);
+    CHECK_EQ(kpin_counts[5], 81);
+    CHECK_EQ(kpin_counts[11], 35);
+    CHECK_EQ(kpin_counts[32], 2);
+}
+
+TEST_CASE("Test hierarchical yosys sphere_netlist instances") {
+    auto instance = vector<uint32_t>{};
+    const auto hyprgraph
+        = read_yosys_json_hier("../../yosys_testcases/sphere_netlist.json", instance);
+
+    CHECK_EQ(hyprgraph.number_of_modules(), 529);
+    CHECK_EQ(hyprgraph.number_of_nets(), 7368);
+    CHECK_EQ(hyprgraph.num_pads, 11);
+    REQUIRE_EQ(instance.size(), 529);
+
+    map<size_t, size_t> kpin_counts;
+    for (const auto& net : hyprgraph.nets) {
+        auto deg = hyprgraph.gr.degree(net);
+        kpin_counts[deg]++;
+    }
+    CHECK_EQ(kpin_counts[1], 220);
+    CHECK_EQ(kpin_counts[2], 5636);
+    CHECK_EQ(kpin_counts[3], 694);
+
+    // the cordic instance (180 cells), two vdcorput and two circle instances, ...
+    map<uint32_t, size_t> instance_size;
+    for (const auto& label : instance) {
+        instance_size[label]++;
+    }
+    map<size_t, size_t> size_counts;
+    for (const auto& [label, size] : instance_size) {
+        size_counts[size]++;
+    }
+    CHECK_EQ(instance_size.size(), 107);
+    CHECK_EQ(size_counts[1], 99);
+    CHECK_EQ(size_counts[76], 2);
+    CHECK_EQ(size_counts[180], 1);
+}